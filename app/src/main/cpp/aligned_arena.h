@@ -0,0 +1,128 @@
+//
+// Bump allocator over one 64-byte aligned block for the tables and scratch buffers of an extractor.
+//
+// An MFCC instance sizes its arena from the arenaBytes() of its parts and makes one allocation
+// for all of them, so that its working set is contiguous and every buffer starts on a cache line.
+// The SIMD kernels can then tell the compiler that their 4-lane loads are aligned.
+// The block can also be carved out of a larger arena shared by many instances, e.g., one per
+// worker of a pool, with a single allocation for all of them.
+//
+// Nothing is freed individually. The whole block goes with the arena.
+//
+
+#ifndef ANDROIDMFCC_ALIGNED_ARENA_H
+#define ANDROIDMFCC_ALIGNED_ARENA_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+#include "logging_macros.h"
+
+class AlignedArena {
+
+public:
+    static constexpr size_t cAlignment = 64;
+
+    /** @brief constructor
+     *
+     *  @param parent        : arena to carve the block from, or nullptr for an own block.
+     *                         If the parent is exhausted, an own block is allocated.
+     *  @param capacityBytes : size of the block
+     */
+    AlignedArena( AlignedArena* parent, const size_t capacityBytes )
+        :mOwnedBlock ( nullptr )
+        ,mBase       ( nullptr )
+        ,mCapacity   ( roundUp( capacityBytes ) )
+        ,mUsed       ( 0 )
+    {
+        if ( parent != nullptr ) {
+            mBase = parent->take( mCapacity );
+        }
+        if ( mBase == nullptr ) {
+            if ( posix_memalign( &mOwnedBlock, cAlignment, mCapacity ) != 0 ) {
+                LOGE( "AlignedArena: could not allocate %zu bytes", mCapacity );
+                mOwnedBlock = nullptr;
+                mCapacity   = 0;
+            }
+            mBase = static_cast< uint8_t* >( mOwnedBlock );
+        }
+    }
+
+    explicit AlignedArena( const size_t capacityBytes )
+        :AlignedArena( nullptr, capacityBytes )
+    {
+        ;
+    }
+
+    ~AlignedArena() {
+        free( mOwnedBlock );
+    }
+
+    /** @brief count elements of T from the block, zero filled and aligned to cAlignment.
+     *         Thread safe, so that instances on different threads can share a parent.
+     *         Aborts if the block is exhausted, or could not be allocated, as the users
+     *         size it from their arenaBytes() and write to the buffers unchecked.
+     */
+    template< class T >
+    T* allocate( const size_t count ) {
+
+        uint8_t* const p = take( roundUp( sizeof(T) * count ) );
+        ASSERT( p != nullptr, "AlignedArena: %zu bytes requested, %zu of %zu left", sizeof(T) * count, mCapacity - used(), mCapacity );
+        return reinterpret_cast< T* >( p );
+    }
+
+    /** @brief bytes taken by count elements of T, for the arenaBytes() of the users.
+     */
+    template< class T >
+    static size_t bytesFor( const size_t count ) {
+        return roundUp( sizeof(T) * count );
+    }
+
+    static size_t roundUp( const size_t bytes ) {
+        return ( bytes + cAlignment - 1 ) / cAlignment * cAlignment;
+    }
+
+    size_t capacity() const { return mCapacity; }
+    size_t used()     const { return mUsed.load(); }
+    bool   ownsBlock() const { return mOwnedBlock != nullptr; }
+
+private:
+    AlignedArena( const AlignedArena& ) = delete;
+    AlignedArena& operator=( const AlignedArena& ) = delete;
+
+    /** @brief bytes, a multiple of cAlignment, from the block zero filled, or nullptr.
+     */
+    uint8_t* take( const size_t bytes ) {
+
+        size_t used = mUsed.load();
+        do {
+            if ( used + bytes > mCapacity ) {
+                return nullptr;
+            }
+        } while ( !mUsed.compare_exchange_weak( used, used + bytes ) );
+
+        memset( mBase + used, 0, bytes );
+        return mBase + used;
+    }
+
+    void*                 mOwnedBlock;
+    uint8_t*              mBase;
+    size_t                mCapacity;
+    std::atomic< size_t > mUsed;
+};
+
+/** @brief p as a pointer the compiler may assume to be 16-byte aligned, so that the 4-lane
+ *         loads and stores through it can be emitted as aligned ones.
+ */
+template< class T >
+static inline T* assumeAligned16( T* p ) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast< T* >( __builtin_assume_aligned( p, 16 ) );
+#else
+    return p;
+#endif
+}
+
+#endif //ANDROIDMFCC_ALIGNED_ARENA_H
@@ -0,0 +1,360 @@
+//
+// Capture trace: the chunks of PCM as AudioRecord.read() returned them, with their sizes and
+// arrival times, for replaying the timing of a device on the host (host/trace_replay.cpp).
+//
+// A trace is one file:
+//
+//   [ CaptureTraceHeader        ]  offset 0, 64 bytes
+//   [ CaptureTraceChunk         ]  16 bytes
+//   [ numSamples int16 samples  ]  interleaved if numChannels > 1, zero padded to 8 bytes
+//   [ CaptureTraceChunk         ]
+//   ...
+//
+// The chunks are appended as they arrive and nothing is updated afterwards, so a trace cut
+// short, e.g., by the app being killed, is still read up to its last complete chunk.
+// The writer only copies a chunk into memory on the capture thread. Its own thread does the
+// file writes, so that the disk does not distort the read timing being traced.
+// All the fields are in the byte order of the writer, which is recorded in byteOrderMark.
+//
+
+#ifndef ANDROIDMFCC_CAPTURE_TRACE_H
+#define ANDROIDMFCC_CAPTURE_TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "logging_macros.h"
+
+static constexpr char     cCaptureTraceMagic[ 8 ] = { 'M', 'F', 'C', 'C', 'T', 'R', 'A', 'C' };
+static constexpr uint32_t cCaptureTraceVersion    = 1;
+static constexpr uint32_t cCaptureTraceByteOrder  = 0x01020304;
+
+struct CaptureTraceHeader {
+    char     magic[ 8 ];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t sampleRate;          // capture rate, before any resampling
+    uint32_t numChannels;
+    uint32_t requestedSamples;    // samples asked of each read, e.g., getMinBufferSize() / 2
+    uint32_t reserved0;
+    int64_t  startTimeNs;         // monotonic clock of the device when the trace was opened
+    uint8_t  reserved1[ 24 ];
+};
+static_assert( sizeof(CaptureTraceHeader) == 64, "CaptureTraceHeader must be 64 bytes" );
+
+/** @brief one read as it returned.
+ */
+struct CaptureTraceChunk {
+    int64_t  timestampNs;         // monotonic clock of the device right after the read returned
+    uint32_t numSamples;          // over all the channels
+    int32_t  readResult;          // value returned by the read, negative for an error
+};
+static_assert( sizeof(CaptureTraceChunk) == 16, "CaptureTraceChunk must be 16 bytes" );
+
+
+/** @brief appends chunks to a trace as they arrive. append() and the other functions may be
+ *         called from different threads, but not concurrently with open() or close().
+ */
+class CaptureTraceWriter {
+
+public:
+    static constexpr size_t cInitialBufferBytes = 1 << 20; // about 30 seconds of 16KHz mono
+
+    CaptureTraceWriter()
+        :mFp          ( nullptr )
+        ,mNumChunks   ( 0 )
+        ,mClosing     ( false )
+        ,mWriteFailed ( false )
+    {
+        ;
+    }
+
+    ~CaptureTraceWriter() {
+        close();
+    }
+
+    /** @brief creates the file, writes the header and starts the writer thread.
+     *
+     *  @param path             : file name
+     *  @param sampleRate       : capture rate
+     *  @param numChannels      : number of interleaved channels
+     *  @param requestedSamples : samples asked of each read, 0 if unknown
+     *  @param startTimeNs      : monotonic clock now, in the time base of the chunk timestamps
+     *  @return true on success
+     */
+    bool open(
+        const char*    path,
+        const uint32_t sampleRate,
+        const uint32_t numChannels,
+        const uint32_t requestedSamples,
+        const int64_t  startTimeNs
+    ) {
+        close();
+
+        mFp = fopen( path, "wb" );
+        if ( mFp == nullptr ) {
+            LOGE( "CaptureTraceWriter: cannot create %s", path );
+            return false;
+        }
+
+        CaptureTraceHeader h;
+        memset( &h, 0, sizeof(h) );
+        memcpy( h.magic, cCaptureTraceMagic, sizeof(h.magic) );
+        h.version          = cCaptureTraceVersion;
+        h.byteOrderMark    = cCaptureTraceByteOrder;
+        h.sampleRate       = sampleRate;
+        h.numChannels      = numChannels;
+        h.requestedSamples = requestedSamples;
+        h.startTimeNs      = startTimeNs;
+
+        mNumChunks   = 0;
+        mClosing     = false;
+        mWriteFailed = !writeBytes( &h, sizeof(h) );
+
+        mPending.clear();
+        mPending.reserve( cInitialBufferBytes );
+        mWriter = std::thread( &CaptureTraceWriter::writerLoop, this );
+
+        return !mWriteFailed;
+    }
+
+    /** @brief queues one chunk for the writer thread. It only copies the chunk into memory.
+     *
+     *  @param timestampNs : arrival time of the chunk
+     *  @param samples     : numSamples samples, interleaved if there are more channels
+     *  @param numSamples  : number of samples over all the channels
+     *  @param readResult  : value returned by the read
+     *  @return false if no trace is open or an earlier write failed
+     */
+    bool append( const int64_t timestampNs, const int16_t* samples, const uint32_t numSamples, const int32_t readResult ) {
+
+        if ( mFp == nullptr ) {
+            return false;
+        }
+
+        CaptureTraceChunk c;
+        c.timestampNs = timestampNs;
+        c.numSamples  = numSamples;
+        c.readResult  = readResult;
+
+        const size_t sampleBytes = sizeof(int16_t) * numSamples;
+        const size_t paddedBytes = sizeof(int16_t) * paddedSamples( numSamples );
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+
+            const size_t pos = mPending.size();
+            mPending.resize( pos + sizeof(c) + paddedBytes );
+            memcpy( &mPending[ pos ], &c, sizeof(c) );
+            if ( sampleBytes > 0 ) {
+                memcpy( &mPending[ pos + sizeof(c) ], samples, sampleBytes );
+            }
+            memset( &mPending[ pos + sizeof(c) + sampleBytes ], 0, paddedBytes - sampleBytes );
+            mNumChunks++;
+        }
+        mPendingCond.notify_one();
+
+        return !mWriteFailed;
+    }
+
+    /** @brief writes the queued chunks, stops the writer thread and closes the file.
+     *
+     *  @return true if all the chunks were written
+     */
+    bool close() {
+
+        if ( mFp == nullptr ) {
+            return true;
+        }
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mClosing = true;
+        }
+        mPendingCond.notify_one();
+        mWriter.join();
+
+        const bool ok = ( fclose( mFp ) == 0 ) && !mWriteFailed;
+        mFp = nullptr;
+
+        if ( !ok ) {
+            LOGE( "CaptureTraceWriter: failed to write the trace" );
+        }
+        return ok;
+    }
+
+    bool     isOpen()    const { return mFp != nullptr; }
+    uint64_t numChunks() const { return mNumChunks.load(); }
+
+    static uint32_t paddedSamples( const uint32_t numSamples ) {
+        return ( numSamples + 3 ) / 4 * 4;
+    }
+
+private:
+
+    /** @brief takes what append() queued and writes it, until close().
+     */
+    void writerLoop() {
+
+        std::vector< uint8_t > batch;
+        batch.reserve( cInitialBufferBytes );
+
+        while ( true ) {
+
+            bool closing;
+            {
+                std::unique_lock< std::mutex > lock( mMutex );
+                mPendingCond.wait( lock, [ this ] { return !mPending.empty() || mClosing; } );
+                batch.swap( mPending );
+                closing = mClosing;
+            }
+
+            if ( !mWriteFailed && !writeBytes( batch.data(), batch.size() ) ) {
+                mWriteFailed = true;
+            }
+            batch.clear();
+
+            if ( closing ) {
+                return;
+            }
+        }
+    }
+
+    bool writeBytes( const void* p, const size_t n ) {
+
+        if ( n > 0 && fwrite( p, 1, n, mFp ) != n ) {
+            LOGE( "CaptureTraceWriter: write error" );
+            return false;
+        }
+        return true;
+    }
+
+    FILE*                   mFp;
+    std::atomic< uint64_t > mNumChunks;
+    std::thread             mWriter;
+    std::mutex              mMutex;
+    std::condition_variable mPendingCond;
+    std::vector< uint8_t >  mPending;      // chunks queued by append(), taken by writerLoop()
+    bool                    mClosing;      // guarded by mMutex
+    std::atomic< bool >     mWriteFailed;
+};
+
+
+/** @brief maps a trace read-only and indexes its complete chunks.
+ */
+class CaptureTraceReader {
+
+public:
+
+    CaptureTraceReader() : mBase( nullptr ), mSize( 0 ), mHeader( nullptr ) {;}
+
+    ~CaptureTraceReader() {
+        close();
+    }
+
+    /** @brief maps the file, validates the header and finds the chunks.
+     *
+     *  @param path : file name
+     *  @return true on success
+     */
+    bool open( const char* path ) {
+
+        close();
+
+        const int fd = ::open( path, O_RDONLY );
+        if ( fd < 0 ) {
+            LOGE( "CaptureTraceReader: cannot open %s", path );
+            return false;
+        }
+
+        struct stat st;
+        if ( fstat( fd, &st ) != 0 || (uint64_t)st.st_size < sizeof(CaptureTraceHeader) ) {
+            LOGE( "CaptureTraceReader: %s is too short", path );
+            ::close( fd );
+            return false;
+        }
+
+        void* base = mmap( nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+        ::close( fd );
+
+        if ( base == MAP_FAILED ) {
+            LOGE( "CaptureTraceReader: cannot map %s", path );
+            return false;
+        }
+
+        mBase   = static_cast< const uint8_t* >( base );
+        mSize   = st.st_size;
+        mHeader = reinterpret_cast< const CaptureTraceHeader* >( mBase );
+
+        const CaptureTraceHeader& h = *mHeader;
+        if ( memcmp( h.magic, cCaptureTraceMagic, sizeof(h.magic) ) != 0
+             || h.version       != cCaptureTraceVersion
+             || h.byteOrderMark != cCaptureTraceByteOrder
+             || h.sampleRate    == 0
+             || h.numChannels   == 0 ) {
+            LOGE( "CaptureTraceReader: %s is not a compatible capture trace", path );
+            close();
+            return false;
+        }
+
+        uint64_t offset = sizeof(CaptureTraceHeader);
+        while ( offset + sizeof(CaptureTraceChunk) <= mSize ) {
+
+            const CaptureTraceChunk* c     = reinterpret_cast< const CaptureTraceChunk* >( mBase + offset );
+            const uint64_t           bytes = sizeof(CaptureTraceChunk)
+                                           + sizeof(int16_t) * (uint64_t)CaptureTraceWriter::paddedSamples( c->numSamples );
+            if ( offset + bytes > mSize ) {
+                LOGW( "CaptureTraceReader: %s ends in a partial chunk", path );
+                break;
+            }
+            mChunkOffsets.push_back( offset );
+            offset += bytes;
+        }
+        return true;
+    }
+
+    void close() {
+
+        if ( mBase != nullptr ) {
+            munmap( const_cast< uint8_t* >( mBase ), mSize );
+        }
+        mBase   = nullptr;
+        mSize   = 0;
+        mHeader = nullptr;
+        mChunkOffsets.clear();
+    }
+
+    const CaptureTraceHeader& header()      const { return *mHeader;              }
+    uint32_t                  sampleRate()  const { return mHeader->sampleRate;   }
+    uint32_t                  numChannels() const { return mHeader->numChannels;  }
+    size_t                    numChunks()   const { return mChunkOffsets.size();  }
+
+    const CaptureTraceChunk& chunk( const size_t i ) const {
+
+        return *reinterpret_cast< const CaptureTraceChunk* >( mBase + mChunkOffsets[ i ] );
+    }
+
+    /** @brief the samples of the i-th chunk, chunk( i ).numSamples of them.
+     */
+    const int16_t* samples( const size_t i ) const {
+
+        return reinterpret_cast< const int16_t* >( mBase + mChunkOffsets[ i ] + sizeof(CaptureTraceChunk) );
+    }
+
+private:
+
+    const uint8_t*            mBase;
+    uint64_t                  mSize;
+    const CaptureTraceHeader* mHeader;
+    std::vector< uint64_t >   mChunkOffsets;  // offsets of the complete chunks
+};
+
+#endif //ANDROIDMFCC_CAPTURE_TRACE_H
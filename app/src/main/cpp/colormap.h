@@ -0,0 +1,162 @@
+//
+// Colormap rendering of feature columns into RGBA_8888 pixels.
+//
+// Same colors as ScrollingHeatMapView.heatColorRGB() and heatColorMonoColorLimeGreen(),
+// sampled into lookup tables of cLUTSize entries. The value to index conversion
+// ( v * scale + bias, clamped to [0, 1] ) is done 4 values at a time with NEON,
+// followed by the table lookups.
+// Pixels are in the memory order R, G, B, A as in Android ARGB_8888 bitmaps,
+// i.e., 0xAABBGGRR as a little-endian uint32_t.
+//
+
+#ifndef ANDROIDMFCC_COLORMAP_H
+#define ANDROIDMFCC_COLORMAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+
+#if defined(HAVE_NEON) && defined(HAVE_NEON_X86)
+#include "NEON_2_SSE.h"
+#elif defined(HAVE_NEON)
+#include <arm_neon.h>
+#endif
+
+class ColormapRenderer {
+
+public:
+
+    static constexpr int cLUTSize        = 1024;
+
+    // Color types. Must match ScrollingHeatMapView.setColorType().
+    static constexpr int cColorHeat      = 0; // black, blue, cyan, green, yellow, red, white
+    static constexpr int cColorLimeGreen = 1; // black to cyan
+    static constexpr int cNumColorTypes  = 2;
+
+    ColormapRenderer() {
+        makeLUTs();
+    }
+
+    /** @brief renders one column of values.
+     *
+     *  @param values      : values
+     *  @param count       : number of values
+     *  @param scale       : applied as v * scale + bias, and then [0, 1] is mapped to the colormap.
+     *  @param bias        : see above
+     *  @param colorType   : cColor*
+     *  @param pixels      : (out) pixel of values[ 0 ]
+     *  @param pixelStride : distance from the pixel of values[ i ] to that of values[ i + 1 ] in pixels.
+     *                       Negative to render upwards, 1 to render a row.
+     */
+    void renderColumn_cpp(
+        const float*    values,
+        const int       count,
+        const float     scale,
+        const float     bias,
+        const int       colorType,
+        uint32_t*       pixels,
+        const ptrdiff_t pixelStride
+    ) const {
+        const uint32_t* lut = mLUTs[ clampColorType( colorType ) ];
+
+        for ( int i = 0; i < count; i++ ) {
+
+            const float t = std::min( 1.0f, std::max( 0.0f, values[ i ] * scale + bias ) );
+            pixels[ i * pixelStride ] = lut[ (uint32_t)( t * ( cLUTSize - 1 ) ) ];
+        }
+    }
+
+#ifdef HAVE_NEON
+    void renderColumn_neon(
+        const float*    values,
+        const int       count,
+        const float     scale,
+        const float     bias,
+        const int       colorType,
+        uint32_t*       pixels,
+        const ptrdiff_t pixelStride
+    ) const {
+        const uint32_t* lut = mLUTs[ clampColorType( colorType ) ];
+
+        const float32x4_t zero  = vdupq_n_f32( 0.0 );
+        const float32x4_t one   = vdupq_n_f32( 1.0 );
+        const float32x4_t biasv = vdupq_n_f32( bias );
+
+        int i = 0;
+        for ( ; i + 4 <= count; i += 4 ) {
+
+            float32x4_t t = vmlaq_n_f32( biasv, vld1q_f32( &values[ i ] ), scale );
+            t = vminq_f32( one, vmaxq_f32( zero, t ) );
+
+            const uint32x4_t index = vcvtq_u32_f32( vmulq_n_f32( t, (float)( cLUTSize - 1 ) ) );
+
+            pixels[ ( i     ) * pixelStride ] = lut[ vgetq_lane_u32( index, 0 ) ];
+            pixels[ ( i + 1 ) * pixelStride ] = lut[ vgetq_lane_u32( index, 1 ) ];
+            pixels[ ( i + 2 ) * pixelStride ] = lut[ vgetq_lane_u32( index, 2 ) ];
+            pixels[ ( i + 3 ) * pixelStride ] = lut[ vgetq_lane_u32( index, 3 ) ];
+        }
+
+        renderColumn_cpp( &values[ i ], count - i, scale, bias, colorType, &pixels[ i * pixelStride ], pixelStride );
+    }
+#endif
+
+    /** @brief color of the LUT entry, for tests and legends.
+     */
+    uint32_t lutEntry( const int colorType, const int index ) const {
+        return mLUTs[ clampColorType( colorType ) ][ index ];
+    }
+
+private:
+
+    static int clampColorType( const int colorType ) {
+        return ( colorType >= 0 && colorType < cNumColorTypes ) ? colorType : cColorHeat;
+    }
+
+    static uint32_t rgba( const int r, const int g, const int b ) {
+        return   (uint32_t)( r & 0xff )
+               | ( (uint32_t)( g & 0xff ) <<  8 )
+               | ( (uint32_t)( b & 0xff ) << 16 )
+               | ( (uint32_t)0xff         << 24 );
+    }
+
+    void makeLUTs() {
+
+        for ( int i = 0; i < cLUTSize; i++ ) {
+
+            const float v  = (float)i / (float)( cLUTSize - 1 );
+            const float v6 = v * 6.0f;
+
+            int r = 0;
+            int g = 0;
+            int b = 0;
+
+            if ( v6 < 1.0 ) {
+                b = (int)( v6 * 255.0 );
+            } else if ( v6 < 2.0 ) {
+                g = (int)( ( v6 - 1.0 ) * 255.0 );
+                b = 255;
+            } else if ( v6 < 3.0 ) {
+                g = 255;
+                b = (int)( ( 3.0 - v6 ) * 255.0 );
+            } else if ( v6 < 4.0 ) {
+                r = (int)( ( v6 - 3.0 ) * 255.0 );
+                g = 255;
+            } else if ( v6 < 5.0 ) {
+                r = 255;
+                g = (int)( ( 5.0 - v6 ) * 255.0 );
+            } else {
+                r = 255;
+                g = (int)( ( v6 - 5.0 ) * 255.0 );
+                b = (int)( ( v6 - 5.0 ) * 255.0 );
+            }
+            mLUTs[ cColorHeat ][ i ] = rgba( r, g, b );
+
+            const int intensity = std::min( 255, (int)( v * 256.0 ) );
+            mLUTs[ cColorLimeGreen ][ i ] = rgba( 0, intensity, intensity );
+        }
+    }
+
+    uint32_t mLUTs[ cNumColorTypes ][ cLUTSize ];
+};
+
+#endif //ANDROIDMFCC_COLORMAP_H
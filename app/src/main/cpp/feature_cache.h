@@ -0,0 +1,348 @@
+//
+// Content-addressed cache in front of MFCC::generateFeaturesBatch_*().
+//
+// The key is a 64-bit hash of the samples combined with MFCC::configHash( outputs, front end )
+// and the number of samples, so the same audio with a different pipeline configuration or output
+// selection does not hit. Repeated requests are served from
+//
+//   1. an in-memory LRU tier bounded in bytes, and then
+//   2. an optional on-disk tier, one feature store (feature_store.h) per key in a directory,
+//
+// before the FFT, Mel and DCT stages run again. Entries found on disk are promoted to memory.
+// The samples are not kept for comparison, so two different clips of the same length colliding
+// in 64 bits would share features. The probability is around n^2 / 2^65 for n distinct clips.
+//
+// Not thread safe, like the MFCC instance it runs. A cache and its MFCC instance are used from
+// one thread at a time.
+//
+
+#ifndef ANDROIDMFCC_FEATURE_CACHE_H
+#define ANDROIDMFCC_FEATURE_CACHE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mfcc.h"
+#include "feature_store.h"
+
+/** @brief xxHash64 of the given bytes.
+ */
+static inline uint64_t xxHash64( const void* data, const size_t len, const uint64_t seed ) {
+
+    static constexpr uint64_t P1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t P3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t P5 = 0x27D4EB2F165667C5ULL;
+
+    struct Op {
+        static uint64_t rotl ( const uint64_t x, const int r ) { return ( x << r ) | ( x >> ( 64 - r ) ); }
+        static uint64_t read64( const uint8_t* p ) { uint64_t v; memcpy( &v, p, 8 ); return v; }
+        static uint32_t read32( const uint8_t* p ) { uint32_t v; memcpy( &v, p, 4 ); return v; }
+        static uint64_t round( uint64_t acc, const uint64_t v ) { return rotl( acc + v * P2, 31 ) * P1; }
+        static uint64_t merge( const uint64_t acc, const uint64_t v ) { return ( acc ^ round( 0, v ) ) * P1 + P4; }
+    };
+
+    const uint8_t*       p   = static_cast< const uint8_t* >( data );
+    const uint8_t* const end = p + len;
+    uint64_t             h;
+
+    if ( len >= 32 ) {
+
+        uint64_t v1 = seed + P1 + P2;
+        uint64_t v2 = seed + P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - P1;
+
+        // Four independent lanes over 32-byte stripes.
+        for ( ; p + 32 <= end; p += 32 ) {
+            v1 = Op::round( v1, Op::read64( p      ) );
+            v2 = Op::round( v2, Op::read64( p +  8 ) );
+            v3 = Op::round( v3, Op::read64( p + 16 ) );
+            v4 = Op::round( v4, Op::read64( p + 24 ) );
+        }
+        h = Op::rotl( v1, 1 ) + Op::rotl( v2, 7 ) + Op::rotl( v3, 12 ) + Op::rotl( v4, 18 );
+        h = Op::merge( h, v1 );
+        h = Op::merge( h, v2 );
+        h = Op::merge( h, v3 );
+        h = Op::merge( h, v4 );
+    }
+    else {
+        h = seed + P5;
+    }
+
+    h += (uint64_t)len;
+
+    for ( ; p + 8 <= end; p += 8 ) {
+        h = Op::rotl( h ^ Op::round( 0, Op::read64( p ) ), 27 ) * P1 + P4;
+    }
+    if ( p + 4 <= end ) {
+        h = Op::rotl( h ^ ( (uint64_t)Op::read32( p ) * P1 ), 23 ) * P2 + P3;
+        p += 4;
+    }
+    for ( ; p < end; p++ ) {
+        h = Op::rotl( h ^ ( (uint64_t)*p * P5 ), 11 ) * P1;
+    }
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+
+class FeatureCache {
+
+public:
+
+    /** @brief constructor
+     *
+     *  @param mfcc                : pipeline run on misses
+     *  @param memoryCapacityBytes : upper bound of the feature bytes held in memory. 0 disables the tier.
+     *  @param diskDirectory       : existing directory for the on-disk tier, or nullptr to disable it.
+     */
+    FeatureCache( MFCC& mfcc, const size_t memoryCapacityBytes, const char* diskDirectory = nullptr )
+        :mMFCC               ( mfcc )
+        ,mMemoryCapacityBytes( memoryCapacityBytes )
+        ,mMemoryBytes        ( 0 )
+        ,mDiskDirectory      ( diskDirectory != nullptr ? diskDirectory : "" )
+        ,mNumMemoryHits      ( 0 )
+        ,mNumDiskHits        ( 0 )
+        ,mNumMisses          ( 0 )
+    {
+        ;
+    }
+
+    /** @brief same as MFCC::generateFeaturesBatch_cpp() through the cache. Bypassed while the
+     *         features depend on more than the samples and the configuration, see cacheable().
+     */
+    int generateFeaturesBatch_cpp( float* samples, const int numSamples, const unsigned int outputs, float* features ) {
+
+        if ( !cacheable() ) {
+            return mMFCC.generateFeaturesBatch_cpp( samples, numSamples, outputs, features );
+        }
+
+        const uint64_t key = makeKey( samples, numSamples, outputs );
+
+        if ( lookup( key, outputs, numSamples, features ) ) {
+            return MFCC::numFrames( numSamples );
+        }
+        const int frames = mMFCC.generateFeaturesBatch_cpp( samples, numSamples, outputs, features );
+        insert( key, outputs, features, frames );
+        return frames;
+    }
+
+#ifdef HAVE_NEON
+    int generateFeaturesBatch_neon( float* samples, const int numSamples, const unsigned int outputs, float* features ) {
+
+        if ( !cacheable() ) {
+            return mMFCC.generateFeaturesBatch_neon( samples, numSamples, outputs, features );
+        }
+
+        const uint64_t key = makeKey( samples, numSamples, outputs );
+
+        if ( lookup( key, outputs, numSamples, features ) ) {
+            return MFCC::numFrames( numSamples );
+        }
+        const int frames = mMFCC.generateFeaturesBatch_neon( samples, numSamples, outputs, features );
+        insert( key, outputs, features, frames );
+        return frames;
+    }
+#endif
+
+    /** @brief changes the memory bound, evicting as needed.
+     */
+    void setMemoryCapacity( const size_t memoryCapacityBytes ) {
+
+        mMemoryCapacityBytes = memoryCapacityBytes;
+        evict();
+    }
+
+    /** @brief changes the on-disk tier. nullptr disables it.
+     */
+    void setDiskDirectory( const char* diskDirectory ) {
+
+        mDiskDirectory = ( diskDirectory != nullptr ) ? diskDirectory : "";
+    }
+
+    /** @brief drops the in-memory tier. The on-disk tier is left as it is.
+     */
+    void clearMemory() {
+
+        mEntries.clear();
+        mIndex.clear();
+        mMemoryBytes = 0;
+    }
+
+    uint64_t numMemoryHits() const { return mNumMemoryHits; }
+    uint64_t numDiskHits()   const { return mNumDiskHits;   }
+    uint64_t numMisses()     const { return mNumMisses;     }
+    size_t   memoryBytes()   const { return mMemoryBytes;   }
+
+private:
+
+    struct Entry {
+        uint64_t             key;
+        std::vector< float > features;
+    };
+
+    /** @brief false while the features of the same samples change from call to call: with the
+     *         spectral subtraction, they depend on the noise estimate of the earlier inputs, and
+     *         with the dither of the compatible front end, on the state of its generator, which a
+     *         hit would not advance either.
+     */
+    bool cacheable() const {
+
+        const FrontEndParameters& frontEnd = mMFCC.frontEndParameters();
+
+        return !mMFCC.spectralSubtraction() && !( frontEnd.compatible && frontEnd.dither != 0.0 );
+    }
+
+    /** @brief MFCC::configHash() of the outputs with the front end of the MFCC instance, and
+     *         whether it runs PrunedFFT512, whose rounding differs slightly from FFT512.
+     */
+    uint64_t configHash( const unsigned int outputs ) const {
+
+        const uint64_t h = MFCC::configHash( outputs, mMFCC.frontEndParameters() );
+
+        return mMFCC.prunedFFT() ? ( h ^ 1 ) * 0x100000001b3ULL : h;
+    }
+
+    uint64_t makeKey( const float* samples, const int numSamples, const unsigned int outputs ) const {
+
+        return xxHash64( samples, sizeof(float) * (size_t)std::max( numSamples, 0 ), configHash( outputs ) );
+    }
+
+    bool lookup( const uint64_t key, const unsigned int outputs, const int numSamples, float* features ) {
+
+        const size_t numFloats = (size_t)MFCC::numFrames( numSamples ) * MFCC::numFeatures( outputs );
+
+        auto it = mIndex.find( key );
+        if ( it != mIndex.end() && it->second->features.size() == numFloats ) {
+
+            // Most recently used at the head.
+            mEntries.splice( mEntries.begin(), mEntries, it->second );
+            memcpy( features, it->second->features.data(), sizeof(float) * numFloats );
+            mNumMemoryHits++;
+            return true;
+        }
+
+        if ( !mDiskDirectory.empty() && loadFromDisk( key, outputs, numFloats, features ) ) {
+
+            insertMemory( key, features, numFloats );
+            mNumDiskHits++;
+            return true;
+        }
+
+        mNumMisses++;
+        return false;
+    }
+
+    void insert( const uint64_t key, const unsigned int outputs, const float* features, const int frames ) {
+
+        const size_t numFloats = (size_t)frames * MFCC::numFeatures( outputs );
+
+        insertMemory( key, features, numFloats );
+
+        if ( !mDiskDirectory.empty() ) {
+            storeToDisk( key, outputs, features, frames );
+        }
+    }
+
+    void insertMemory( const uint64_t key, const float* features, const size_t numFloats ) {
+
+        const size_t bytes = sizeof(float) * numFloats;
+        if ( bytes > mMemoryCapacityBytes ) {
+            return;
+        }
+
+        auto it = mIndex.find( key );
+        if ( it != mIndex.end() ) {
+            mMemoryBytes -= sizeof(float) * it->second->features.size();
+            mEntries.erase( it->second );
+            mIndex.erase( it );
+        }
+
+        mEntries.push_front( Entry{ key, std::vector< float >( features, features + numFloats ) } );
+        mIndex[ key ] = mEntries.begin();
+        mMemoryBytes += bytes;
+
+        evict();
+    }
+
+    void evict() {
+
+        while ( mMemoryBytes > mMemoryCapacityBytes && !mEntries.empty() ) {
+
+            const Entry& lru = mEntries.back();
+            mMemoryBytes -= sizeof(float) * lru.features.size();
+            mIndex.erase( lru.key );
+            mEntries.pop_back();
+        }
+    }
+
+    std::string pathForKey( const uint64_t key ) const {
+
+        char name[ 32 ];
+        snprintf( name, sizeof(name), "/%016llx.feat", (unsigned long long)key );
+        return mDiskDirectory + name;
+    }
+
+    bool loadFromDisk( const uint64_t key, const unsigned int outputs, const size_t numFloats, float* features ) const {
+
+        FeatureStoreReader store;
+        if ( access( pathForKey( key ).c_str(), R_OK ) != 0 || !store.open( pathForKey( key ).c_str(), configHash( outputs ) ) ) {
+            return false;
+        }
+
+        const uint32_t numFeatures = store.numFeatures();
+        if ( store.dtype() != FEATURE_DTYPE_FLOAT32 || store.numFrames() * numFeatures != numFloats ) {
+            return false;
+        }
+
+        for ( uint64_t f = 0; f < store.numFrames(); f++ ) {
+            memcpy( &features[ f * numFeatures ], store.frameFloat( f ), sizeof(float) * numFeatures );
+        }
+        return true;
+    }
+
+    void storeToDisk( const uint64_t key, const unsigned int outputs, const float* features, const int frames ) const {
+
+        // Written under a temporary name and renamed, so that concurrent readers never see a partial store.
+        const std::string path    = pathForKey( key );
+        const std::string tmpPath = path + "." + std::to_string( getpid() ) + ".tmp";
+
+        FeatureStoreWriter store;
+        if ( !store.open( tmpPath.c_str(), configHash( outputs ), outputs, (uint32_t)MFCC::cSampleRate,
+                          MFCC::cFrameSizeSamples, MFCC::cFrameShiftSamples, MFCC::numFeatures( outputs ) ) ) {
+            return;
+        }
+        if ( store.appendFrames( features, frames ) && store.close() ) {
+            rename( tmpPath.c_str(), path.c_str() );
+        }
+        else {
+            unlink( tmpPath.c_str() );
+        }
+    }
+
+    MFCC&                   mMFCC;
+    size_t                  mMemoryCapacityBytes;
+    size_t                  mMemoryBytes;
+    std::string             mDiskDirectory;
+
+    std::list< Entry >                                          mEntries; // most recently used first
+    std::unordered_map< uint64_t, std::list< Entry >::iterator > mIndex;
+
+    uint64_t                mNumMemoryHits;
+    uint64_t                mNumDiskHits;
+    uint64_t                mNumMisses;
+};
+
+#endif //ANDROIDMFCC_FEATURE_CACHE_H
@@ -0,0 +1,416 @@
+//
+// On-disk feature store.
+//
+// A store is one file:
+//
+//   [ FeatureStoreHeader        ]  offset 0
+//   [ padding                   ]
+//   [ frame matrix              ]  offset dataOffset, aligned to cFeatureStoreAlignment.
+//                                  numFrames rows of rowStrideBytes, row stride a multiple of 16 bytes.
+//   [ FeatureStoreChunk x N     ]  offset chunkIndexOffset, optional (numChunks may be 0).
+//
+// The writer appends rows sequentially and fills in the counts in the header at close().
+// The reader maps the whole file read-only, so any frame range is accessed without copying,
+// and processes reading the same store share one copy in the page cache.
+// All the fields are in the byte order of the writer, which is recorded in byteOrderMark.
+//
+
+#ifndef ANDROIDMFCC_FEATURE_STORE_H
+#define ANDROIDMFCC_FEATURE_STORE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vector>
+
+#include "logging_macros.h"
+
+static constexpr char     cFeatureStoreMagic[ 8 ]   = { 'M', 'F', 'C', 'C', 'F', 'E', 'A', 'T' };
+static constexpr uint32_t cFeatureStoreVersion      = 1;
+static constexpr uint32_t cFeatureStoreByteOrder    = 0x01020304;
+static constexpr uint32_t cFeatureStoreAlignment    = 4096;
+static constexpr uint32_t cFeatureStoreRowAlignment = 16;
+
+// Element types of the frame matrix.
+enum FeatureStoreDType : uint32_t {
+    FEATURE_DTYPE_FLOAT32 = 0,
+    FEATURE_DTYPE_FP16    = 1, // IEEE 754 binary16 as written by FeatureWriterFP16
+    FEATURE_DTYPE_INT8    = 2  // q = round( v / scale ) + zeroPoint as written by FeatureWriterInt8
+};
+
+static inline uint32_t featureStoreElementSize( const uint32_t dtype ) {
+
+    switch ( dtype ) {
+      case FEATURE_DTYPE_FLOAT32: return 4;
+      case FEATURE_DTYPE_FP16:    return 2;
+      case FEATURE_DTYPE_INT8:    return 1;
+      default:                    return 0;
+    }
+}
+
+struct FeatureStoreHeader {
+    char     magic[ 8 ];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t configHash;          // MFCC::configHash( outputs )
+    uint32_t outputs;             // MFCC::cOutput* the rows consist of
+    uint32_t sampleRate;
+    uint32_t frameSizeSamples;
+    uint32_t frameShiftSamples;
+    uint32_t numFeatures;         // dimensions per frame
+    uint32_t dtype;               // FeatureStoreDType
+    float    int8Scale;           // FEATURE_DTYPE_INT8 only
+    int32_t  int8ZeroPoint;       // FEATURE_DTYPE_INT8 only
+    uint32_t rowStrideBytes;
+    uint32_t reserved0;
+    uint64_t numFrames;
+    uint64_t dataOffset;
+    uint64_t chunkIndexOffset;
+    uint64_t numChunks;
+    uint8_t  reserved1[ 32 ];
+};
+static_assert( sizeof(FeatureStoreHeader) == 128, "FeatureStoreHeader must be 128 bytes" );
+
+/** @brief one entry of the chunk index. A chunk is a consecutive range of frames,
+ *         typically one utterance or one input file, with a caller-defined tag.
+ */
+struct FeatureStoreChunk {
+    uint64_t firstFrame;
+    uint64_t numFrames;
+    uint64_t tag;
+    uint64_t reserved;
+};
+static_assert( sizeof(FeatureStoreChunk) == 32, "FeatureStoreChunk must be 32 bytes" );
+
+
+/** @brief writes a store sequentially. The file must be seekable, as the header is
+ *         completed at close().
+ */
+class FeatureStoreWriter {
+
+public:
+
+    FeatureStoreWriter() : mFp( nullptr ), mChunkOpen( false ) {
+        memset( &mHeader, 0, sizeof(mHeader) );
+    }
+
+    ~FeatureStoreWriter() {
+        close();
+    }
+
+    /** @brief creates the file and writes a provisional header.
+     *
+     *  @param path              : file name
+     *  @param configHash        : MFCC::configHash( outputs )
+     *  @param outputs           : MFCC::cOutput* the rows consist of
+     *  @param sampleRate        : sample rate of the source audio
+     *  @param frameSizeSamples  : frame size in samples
+     *  @param frameShiftSamples : frame shift in samples
+     *  @param numFeatures       : dimensions per frame
+     *  @param dtype             : FeatureStoreDType
+     *  @param int8Scale         : scale if dtype is FEATURE_DTYPE_INT8
+     *  @param int8ZeroPoint     : zero point if dtype is FEATURE_DTYPE_INT8
+     *  @return true on success
+     */
+    bool open(
+        const char*    path,
+        const uint64_t configHash,
+        const uint32_t outputs,
+        const uint32_t sampleRate,
+        const uint32_t frameSizeSamples,
+        const uint32_t frameShiftSamples,
+        const uint32_t numFeatures,
+        const uint32_t dtype         = FEATURE_DTYPE_FLOAT32,
+        const float    int8Scale     = 1.0,
+        const int32_t  int8ZeroPoint = 0
+    ) {
+        const uint32_t elementSize = featureStoreElementSize( dtype );
+        if ( elementSize == 0 || numFeatures == 0 ) {
+            LOGE( "FeatureStoreWriter: invalid dtype %u or dimensions %u", dtype, numFeatures );
+            return false;
+        }
+
+        mFp = fopen( path, "wb" );
+        if ( mFp == nullptr ) {
+            LOGE( "FeatureStoreWriter: cannot create %s", path );
+            return false;
+        }
+
+        memset( &mHeader, 0, sizeof(mHeader) );
+        memcpy( mHeader.magic, cFeatureStoreMagic, sizeof(mHeader.magic) );
+        mHeader.version           = cFeatureStoreVersion;
+        mHeader.byteOrderMark     = cFeatureStoreByteOrder;
+        mHeader.configHash        = configHash;
+        mHeader.outputs           = outputs;
+        mHeader.sampleRate        = sampleRate;
+        mHeader.frameSizeSamples  = frameSizeSamples;
+        mHeader.frameShiftSamples = frameShiftSamples;
+        mHeader.numFeatures       = numFeatures;
+        mHeader.dtype             = dtype;
+        mHeader.int8Scale         = int8Scale;
+        mHeader.int8ZeroPoint     = int8ZeroPoint;
+        mHeader.rowStrideBytes    = roundUp( numFeatures * elementSize, cFeatureStoreRowAlignment );
+        mHeader.dataOffset        = cFeatureStoreAlignment;
+
+        mPadding.assign( mHeader.rowStrideBytes - numFeatures * elementSize, 0 );
+        mChunks.clear();
+        mChunkOpen = false;
+
+        // Provisional header and padding up to the frame matrix.
+        std::vector< uint8_t > head( mHeader.dataOffset, 0 );
+        memcpy( head.data(), &mHeader, sizeof(mHeader) );
+
+        return writeBytes( head.data(), head.size() );
+    }
+
+    /** @brief starts a new chunk at the next frame. The previous chunk, if any, ends here.
+     *
+     *  @param tag : caller-defined identifier of the chunk, e.g., utterance ID.
+     */
+    void beginChunk( const uint64_t tag ) {
+
+        endChunk();
+
+        FeatureStoreChunk chunk;
+        chunk.firstFrame = mHeader.numFrames;
+        chunk.numFrames  = 0;
+        chunk.tag        = tag;
+        chunk.reserved   = 0;
+        mChunks.push_back( chunk );
+        mChunkOpen = true;
+    }
+
+    /** @brief ends the current chunk. Frames appended afterwards belong to no chunk.
+     */
+    void endChunk() {
+
+        if ( mChunkOpen ) {
+            mChunks.back().numFrames = mHeader.numFrames - mChunks.back().firstFrame;
+            mChunkOpen = false;
+        }
+    }
+
+    /** @brief appends frames.
+     *
+     *  @param rows      : numFrames rows of numFeatures elements in dtype, packed without row padding.
+     *  @param numFrames : number of rows
+     *  @return true on success
+     */
+    bool appendFrames( const void* rows, const uint64_t numFrames ) {
+
+        const size_t rowBytes = mHeader.rowStrideBytes - mPadding.size();
+
+        if ( mPadding.empty() ) {
+            if ( !writeBytes( rows, rowBytes * numFrames ) ) {
+                return false;
+            }
+        }
+        else {
+            const uint8_t* p = static_cast< const uint8_t* >( rows );
+            for ( uint64_t i = 0; i < numFrames; i++ ) {
+                if ( !writeBytes( p + i * rowBytes, rowBytes ) || !writeBytes( mPadding.data(), mPadding.size() ) ) {
+                    return false;
+                }
+            }
+        }
+        mHeader.numFrames += numFrames;
+        return true;
+    }
+
+    /** @brief writes the chunk index and the final header, and closes the file.
+     *
+     *  @return true on success
+     */
+    bool close() {
+
+        if ( mFp == nullptr ) {
+            return true;
+        }
+        endChunk();
+
+        mHeader.numChunks        = mChunks.size();
+        mHeader.chunkIndexOffset = mChunks.empty() ? 0 : mHeader.dataOffset + mHeader.numFrames * mHeader.rowStrideBytes;
+
+        bool ok = mChunks.empty() || writeBytes( mChunks.data(), sizeof(FeatureStoreChunk) * mChunks.size() );
+
+        ok = ok && fseek( mFp, 0, SEEK_SET ) == 0 && writeBytes( &mHeader, sizeof(mHeader) );
+        ok = ( fclose( mFp ) == 0 ) && ok;
+        mFp = nullptr;
+
+        if ( !ok ) {
+            LOGE( "FeatureStoreWriter: failed to finalize the store" );
+        }
+        return ok;
+    }
+
+    uint64_t numFrames() const { return mHeader.numFrames; }
+
+private:
+
+    static uint32_t roundUp( const uint32_t v, const uint32_t align ) {
+        return ( v + align - 1 ) / align * align;
+    }
+
+    bool writeBytes( const void* p, const size_t n ) {
+
+        if ( n > 0 && fwrite( p, 1, n, mFp ) != n ) {
+            LOGE( "FeatureStoreWriter: write error" );
+            return false;
+        }
+        return true;
+    }
+
+    FILE*                            mFp;
+    FeatureStoreHeader               mHeader;
+    std::vector< uint8_t >           mPadding;
+    std::vector< FeatureStoreChunk > mChunks;
+    bool                             mChunkOpen;
+};
+
+
+/** @brief maps a store read-only for zero-copy random access.
+ */
+class FeatureStoreReader {
+
+public:
+
+    FeatureStoreReader() : mBase( nullptr ), mSize( 0 ), mHeader( nullptr ) {;}
+
+    ~FeatureStoreReader() {
+        close();
+    }
+
+    /** @brief maps the file and validates the header.
+     *
+     *  @param path               : file name
+     *  @param expectedConfigHash : MFCC::configHash() the features must have been made with, or 0 for any.
+     *  @return true on success
+     */
+    bool open( const char* path, const uint64_t expectedConfigHash = 0 ) {
+
+        close();
+
+        const int fd = ::open( path, O_RDONLY );
+        if ( fd < 0 ) {
+            LOGE( "FeatureStoreReader: cannot open %s", path );
+            return false;
+        }
+
+        struct stat st;
+        if ( fstat( fd, &st ) != 0 || (uint64_t)st.st_size < sizeof(FeatureStoreHeader) ) {
+            LOGE( "FeatureStoreReader: %s is too short", path );
+            ::close( fd );
+            return false;
+        }
+
+        void* base = mmap( nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+        ::close( fd );
+
+        if ( base == MAP_FAILED ) {
+            LOGE( "FeatureStoreReader: cannot map %s", path );
+            return false;
+        }
+
+        mBase   = static_cast< const uint8_t* >( base );
+        mSize   = st.st_size;
+        mHeader = reinterpret_cast< const FeatureStoreHeader* >( mBase );
+
+        if ( !validate( expectedConfigHash ) ) {
+            LOGE( "FeatureStoreReader: %s is not a compatible feature store", path );
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+
+        if ( mBase != nullptr ) {
+            munmap( const_cast< uint8_t* >( mBase ), mSize );
+        }
+        mBase   = nullptr;
+        mSize   = 0;
+        mHeader = nullptr;
+    }
+
+    /** @brief tells the kernel how the frames will be accessed.
+     *
+     *  @param sequential : true for a scan from the head, false for random access.
+     */
+    void adviseAccess( const bool sequential ) const {
+
+        madvise( const_cast< uint8_t* >( mBase ), mSize, sequential ? MADV_SEQUENTIAL : MADV_RANDOM );
+    }
+
+    const FeatureStoreHeader& header()  const { return *mHeader;                 }
+    uint64_t numFrames()                const { return mHeader->numFrames;       }
+    uint32_t numFeatures()              const { return mHeader->numFeatures;     }
+    uint32_t rowStrideBytes()           const { return mHeader->rowStrideBytes;  }
+    uint32_t dtype()                    const { return mHeader->dtype;           }
+    uint64_t numChunks()                const { return mHeader->numChunks;       }
+
+    /** @brief pointer to the given frame. The following frames are rowStrideBytes() apart.
+     *
+     *  @param frame : frame index less than numFrames()
+     */
+    const void* frame( const uint64_t frame ) const {
+
+        return mBase + mHeader->dataOffset + frame * mHeader->rowStrideBytes;
+    }
+
+    /** @brief same as above for FEATURE_DTYPE_FLOAT32. nullptr for other dtypes.
+     */
+    const float* frameFloat( const uint64_t frame ) const {
+
+        return ( mHeader->dtype == FEATURE_DTYPE_FLOAT32 ) ? static_cast< const float* >( this->frame( frame ) ) : nullptr;
+    }
+
+    /** @brief the i-th entry of the chunk index.
+     */
+    const FeatureStoreChunk& chunk( const uint64_t i ) const {
+
+        return reinterpret_cast< const FeatureStoreChunk* >( mBase + mHeader->chunkIndexOffset )[ i ];
+    }
+
+private:
+
+    bool validate( const uint64_t expectedConfigHash ) const {
+
+        const FeatureStoreHeader& h = *mHeader;
+
+        if ( memcmp( h.magic, cFeatureStoreMagic, sizeof(h.magic) ) != 0
+             || h.version       != cFeatureStoreVersion
+             || h.byteOrderMark != cFeatureStoreByteOrder ) {
+            return false;
+        }
+        if ( expectedConfigHash != 0 && h.configHash != expectedConfigHash ) {
+            return false;
+        }
+
+        const uint32_t elementSize = featureStoreElementSize( h.dtype );
+        // A zero stride would pass the check below for zero features, and divide by zero after.
+        if ( elementSize == 0 || h.rowStrideBytes == 0 || h.rowStrideBytes < (uint64_t)h.numFeatures * elementSize ) {
+            return false;
+        }
+        if ( h.dataOffset % cFeatureStoreAlignment != 0 || h.dataOffset > mSize
+             || h.numFrames > ( mSize - h.dataOffset ) / h.rowStrideBytes ) {
+            return false;
+        }
+        if ( h.numChunks > 0
+             && ( h.chunkIndexOffset > mSize
+                  || h.numChunks > ( mSize - h.chunkIndexOffset ) / sizeof(FeatureStoreChunk) ) ) {
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t*            mBase;
+    size_t                    mSize;
+    const FeatureStoreHeader* mHeader;
+};
+
+#endif //ANDROIDMFCC_FEATURE_STORE_H
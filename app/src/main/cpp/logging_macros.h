@@ -5,13 +5,18 @@
 #ifndef ANDROIDMFCC_LOGGING_MACROS_H
 #define ANDROIDMFCC_LOGGING_MACROS_H
 
+#if defined(__ANDROID__)
 #include <android/log.h>
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#endif
 
-#if 1
 #ifndef MODULE_NAME
 #define MODULE_NAME  "MFCC"
 #endif
 
+#if defined(__ANDROID__)
 #define LOGV(...) __android_log_print(ANDROID_LOG_VERBOSE, MODULE_NAME, __VA_ARGS__)
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, MODULE_NAME, __VA_ARGS__)
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, MODULE_NAME, __VA_ARGS__)
@@ -20,6 +25,18 @@
 #define LOGF(...) __android_log_print(ANDROID_LOG_FATAL,MODULE_NAME, __VA_ARGS__)
 
 #define ASSERT(cond, ...) if (!(cond)) {__android_log_assert(#cond, MODULE_NAME, __VA_ARGS__);}
+#elif 1
+// Host builds (host/) log to stderr.
+#define LOG_HOST_(level, ...) ( fprintf(stderr, "%s %s: ", level, MODULE_NAME), fprintf(stderr, __VA_ARGS__), fprintf(stderr, "\n") )
+
+#define LOGV(...) LOG_HOST_("V", __VA_ARGS__)
+#define LOGD(...) LOG_HOST_("D", __VA_ARGS__)
+#define LOGI(...) LOG_HOST_("I", __VA_ARGS__)
+#define LOGW(...) LOG_HOST_("W", __VA_ARGS__)
+#define LOGE(...) LOG_HOST_("E", __VA_ARGS__)
+#define LOGF(...) LOG_HOST_("F", __VA_ARGS__)
+
+#define ASSERT(cond, ...) if (!(cond)) { LOG_HOST_("F", __VA_ARGS__); abort(); }
 #else
 #define LOGV(...)
 #define LOGD(...)
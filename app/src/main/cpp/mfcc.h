@@ -0,0 +1,6026 @@
+//
+// Core MFCC pipeline shared by the JNI library and the host tools under host/.
+// Everything here is free of JNI and Android dependencies.
+//
+
+#ifndef ANDROIDMFCC_MFCC_H
+#define ANDROIDMFCC_MFCC_H
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <complex>
+#include <new>
+
+#include "logging_macros.h"
+#include "aligned_arena.h"
+
+#if defined(HAVE_NEON) && defined(HAVE_NEON_X86)
+/*
+ * The latest version and instruction for NEON_2_SSE.h is at:
+ *    https://github.com/intel/ARM_NEON_2_x86_SSE
+ */
+#include "NEON_2_SSE.h"
+#elif defined(HAVE_NEON)
+#include <arm_neon.h>
+#endif
+
+///////////////////////////////////////
+/////// DEBUGGING TOOLS BEGIN /////////
+///////////////////////////////////////
+
+static char log_samples[ 4096 ];
+
+static inline void reset_log_samples()
+{
+    log_samples[ 0 ] = '\0';
+}
+
+static inline void add_log_sample( const float& v )
+{
+    char cur_str[ 256 ];
+
+    sprintf( cur_str, " %.2lf", v );
+    strcat( log_samples, cur_str );
+}
+
+static inline void print_part(
+    const int          part_num,
+    const float* const arr,
+    const int          len
+) {
+
+    reset_log_samples();
+
+    for ( int i = 0; i < len / 4; i++ ) {
+        add_log_sample( arr[ i ] );
+    }
+
+    LOGI( "Part %d: [%s]", part_num, log_samples );
+}
+
+
+static inline void print_points( const char* message, const float* arr, int len )
+{
+    if ( len >  64 ) {
+        const int part_len = len / 4;
+        LOGI( "%s", message );
+        print_part( 1,   arr,              part_len );
+        print_part( 2, &(arr[part_len  ]), part_len );
+        print_part( 3, &(arr[part_len*2]), part_len );
+        print_part( 4, &(arr[part_len*3]), part_len );
+    }
+    else {
+
+        reset_log_samples();
+        for (int i = 0; i < len; i++) {
+            add_log_sample(arr[i]);
+        }
+        LOGI("%s [%s]", message, log_samples);
+    }
+}
+
+static inline double getTimeStampInSeconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + ((double) tv.tv_usec / 1000000);
+}
+
+///////////////////////////////////////
+/////// DEBUGGING TOOLS END   /////////
+///////////////////////////////////////
+
+
+class sampleToBin {
+
+public:
+    sampleToBin()
+            :mBin1   ( -1)
+            ,mBin2   ( -1)
+            ,mCoeff1 (0.0)
+            ,mCoeff2 (0.0) {;}
+
+    constexpr sampleToBin( const int bin1, const int bin2, const double coeff1 )
+            :mBin1   ( bin1 )
+            ,mBin2   ( bin2 )
+            ,mCoeff1 ( coeff1 )
+            ,mCoeff2 ( 1.0 - coeff1 ) {;}
+
+    void setValues( const int bin1, const int bin2, const double coeff1 ) {
+
+        mBin1   = bin1;
+        mBin2   = bin2;
+        mCoeff1 = coeff1;
+        mCoeff2 = (1.0 - coeff1);
+    }
+
+
+    int    bin1()   const { return mBin1;   }
+    int    bin2()   const { return mBin2;   }
+    double coeff1() const { return mCoeff1; }
+    double coeff2() const { return mCoeff2; }
+
+private:
+    int    mBin1;
+    int    mBin2;
+    double mCoeff1;
+    double mCoeff2;
+
+};
+
+
+#ifndef MFCC_RUNTIME_TABLES
+// Coefficient tables of the default configuration, generated by host/mfcc_gen_tables.cpp into
+// read-only data. With MFCC_RUNTIME_TABLES defined, all the tables are computed at construction.
+#include "mfcc_tables.h"
+#endif
+
+
+/** @brief options of the framing, window and energy of the front end, in the style of
+ *         Kaldi compute-mfcc-feats or HTK HCopy. The Mel filter banks are not among them and
+ *         stay at 26 bands between 300Hz and 8KHz with 1125 as the Mel constant, whereas Kaldi
+ *         has 23 from 20Hz to Nyquist with 1127, so the features are not Kaldi's.
+ *         With compatible false the original front end runs and the other fields are ignored.
+ */
+struct FrontEndParameters {
+
+    static constexpr int cWindowHamming     = 0; // 0.54 - 0.46 cos( 2 pi i / ( N - 1 ) )
+    static constexpr int cWindowHann        = 1; // 0.5  - 0.5  cos( 2 pi i / ( N - 1 ) )
+    static constexpr int cWindowPovey       = 2; // Hann to the power of 0.85 (Kaldi default)
+    static constexpr int cWindowRectangular = 3;
+
+    bool  compatible;
+    int   windowType;      // cWindow*
+    bool  removeDCOffset;  // subtracts the mean of the frame
+    float dither;          // standard deviation of the Gaussian dither in sample units. 0 for none.
+    float preemphCoeff;    // x[ i ] - k x[ i - 1 ], and x[ 0 ] - k x[ 0 ] for the first sample
+    bool  useEnergy;       // C0 is replaced by the log energy of the frame
+    bool  rawEnergy;       // the energy is taken before pre-emphasis and window, otherwise after
+    float cepstralLifter;  // L of the lifter 1 + L/2 sin( pi i / L ). 0 for none.
+    bool  orthonormalDCT;  // C0 scaled by sqrt( 1 / N ) instead of sqrt( 2 / N )
+    float melFloor;        // floor of the Mel energies before log
+
+    static FrontEndParameters original() {
+        return FrontEndParameters{ false, cWindowHamming, false, 0.0, 0.96, false, false, 0.0, false, 1.0 };
+    }
+
+    /** @brief the framing and energy defaults of Kaldi compute-mfcc-feats: Povey window, DC
+     *         removal, dither 1.0, pre-emphasis 0.97, raw energy, lifter 22. Not its Mel banks.
+     */
+    static FrontEndParameters kaldi() {
+        return FrontEndParameters{ true, cWindowPovey, true, 1.0, 0.97, true, true, 22.0, true, FLT_EPSILON };
+    }
+};
+
+
+/** @brief 4 interleaved xorshift32 generators, one per SIMD lane, for the dither.
+ *         Each output is the sum of 4 uniform numbers scaled to unit variance, which is
+ *         close enough to Gaussian for dithering and needs neither log nor cos.
+ *         The _cpp and _neon versions produce the same sequence.
+ */
+class DitherGenerator {
+
+public:
+    DitherGenerator( const uint32_t seed = 1 ) { reseed( seed ); }
+
+    void reseed( uint32_t seed ) {
+
+        for ( int l = 0; l < 4; l++ ) {
+            seed = seed * 1664525u + 1013904223u;
+            mState[ l ] = ( seed != 0 ) ? seed : 0x9e3779b9u;
+        }
+    }
+
+    /** @brief 4 values of mean 0 and variance 1.
+     */
+    void next4_cpp( float* out ) {
+
+        float sum[ 4 ] = { 0.0, 0.0, 0.0, 0.0 };
+
+        for ( int r = 0; r < 4; r++ ) {
+            for ( int l = 0; l < 4; l++ ) {
+                uint32_t x = mState[ l ];
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                mState[ l ] = x;
+                sum[ l ] += (float)x * cUniformScale;
+            }
+        }
+        for ( int l = 0; l < 4; l++ ) {
+            out[ l ] = ( sum[ l ] - 2.0f ) * cSqrt3;
+        }
+    }
+
+#ifdef HAVE_NEON
+    float32x4_t next4_neon() {
+
+        uint32x4_t  x   = vld1q_u32( mState );
+        float32x4_t sum = vdupq_n_f32( 0.0 );
+
+        for ( int r = 0; r < 4; r++ ) {
+            x   = veorq_u32( x, vshlq_n_u32( x, 13 ) );
+            x   = veorq_u32( x, vshrq_n_u32( x, 17 ) );
+            x   = veorq_u32( x, vshlq_n_u32( x,  5 ) );
+            sum = vaddq_f32( sum, vmulq_n_f32( vcvtq_f32_u32( x ), cUniformScale ) );
+        }
+        vst1q_u32( mState, x );
+
+        return vmulq_n_f32( vsubq_f32( sum, vdupq_n_f32( 2.0 ) ), cSqrt3 );
+    }
+#endif
+
+private:
+    static constexpr float cUniformScale = 1.0 / 4294967296.0; // 2^-32
+    static constexpr float cSqrt3        = 1.7320508075688772;
+
+    uint32_t mState[ 4 ];
+};
+
+
+class HammingWindow {
+
+public:
+    /** @brief constructor
+     *
+     *  @param arena             : arena for the scratch and the non-default windows, arenaBytes() or more
+     *  @param windowSizeSamples : number of samples in one input frame  (usually 400)
+     *  @param preEmphTap0       : pre-emphasis coefficient              (usually around 0.95)
+     *  @param windowType        : FrontEndParameters::cWindow*
+     */
+    HammingWindow(
+        AlignedArena& arena,
+        const int windowSizeSamples,
+        const float preEmphTap0,
+        const int windowType = FrontEndParameters::cWindowHamming
+    )
+            :mArena            ( arena             )
+            ,mWindowSizeSamples( windowSizeSamples )
+            ,mPreEmphTap0      ( preEmphTap0       )
+            ,mHammingWindow    ( nullptr           )
+            ,mOwnedWindow      ( nullptr           )
+    {
+        mScratch = arena.allocate< float >( mWindowSizeSamples );
+        setWindowType( windowType );
+    }
+
+    /** @brief arena bytes taken by an instance: the scratch and a window of another type.
+     */
+    static size_t arenaBytes( const int windowSizeSamples ) {
+
+        return 2 * AlignedArena::bytesFor< float >( windowSizeSamples );
+    }
+
+    /** @brief switches the window table to another window type. The 400-sample Hamming
+     *         window is the generated table, the others are computed here.
+     *
+     *  @param windowType : FrontEndParameters::cWindow*
+     */
+    void setWindowType( const int windowType ) {
+
+#ifndef MFCC_RUNTIME_TABLES
+        if ( windowType == FrontEndParameters::cWindowHamming && mWindowSizeSamples == cTableWindowSize ) {
+            mHammingWindow = cTableHammingWindow;
+            return;
+        }
+#endif
+        if ( mOwnedWindow == nullptr ) {
+            mOwnedWindow = mArena.allocate< float >( mWindowSizeSamples );
+        }
+        makeWindow( mOwnedWindow, mWindowSizeSamples, windowType );
+        mHammingWindow = mOwnedWindow;
+    }
+
+    /** @brief fills the window table.
+     *
+     *  @param window            : (out) windowSizeSamples coefficients
+     *  @param windowSizeSamples : number of samples in one input frame
+     *  @param windowType        : FrontEndParameters::cWindow*
+     */
+    static void makeWindow( float* window, const int windowSizeSamples, const int windowType ) {
+
+        for ( int i = 0; i < windowSizeSamples; i++ ) {
+
+            const double hann = 0.5 - 0.5 * cos( 2.0 * M_PI * (float)i / (float)(windowSizeSamples - 1) );
+
+            switch ( windowType ) {
+              case FrontEndParameters::cWindowHann:
+                window[i] = hann;
+                break;
+              case FrontEndParameters::cWindowPovey:
+                window[i] = pow( hann, 0.85 );
+                break;
+              case FrontEndParameters::cWindowRectangular:
+                window[i] = 1.0;
+                break;
+              default:
+                window[i] = 0.54 - 0.46 * cos( 2.0 * M_PI * (float)i / (float)(windowSizeSamples - 1) );
+                break;
+            }
+        }
+    }
+
+
+    /** @brief performs conversion on one real-valued frame, and generates windowed frame
+     *
+     *  @param array_in     : input  samples (frame) whose length is windowSizeSamples
+     *  @param array_out    : output samples (frame) whose length is windowSizeSamples
+     */
+    void preEmphasisHammingAndMakeComplexForFFT_cpp( float* array_in, float* array_out ) {
+
+        array_out[0] = 0.0;
+
+        for ( int i = 1; i < mWindowSizeSamples; i++ ) {
+            array_out[ i ] = mHammingWindow[ i ] * ( array_in[ i ]  - mPreEmphTap0 * array_in[ i - 1 ] );
+        }
+    }
+
+#ifdef HAVE_NEON
+    void preEmphasisHammingAndMakeComplexForFFT_neon( float* array_in, float* array_out ) {
+
+        array_out[0] = 0.0;
+
+        const float coeff1 = -1.0*mPreEmphTap0;
+
+        int i = 1;
+        for ( ; i + 4 <= mWindowSizeSamples; i += 4 ) {
+
+            const float32x4_t tap0 = vld1q_f32( &array_in[i  ] );
+            float32x4_t       tap1 = vld1q_f32( &array_in[i-1] );
+            tap1 = vmulq_n_f32( tap1, coeff1 ); // tap1 = tap1 * coeff1
+            const float32x4_t outvec = vaddq_f32(tap0, tap1); // outvec = tap0 + tap1
+            const float32x4_t window = vld1q_f32( &mHammingWindow[ i ] );
+
+            vst1q_f32( &(array_out[ i ]), vmulq_f32( outvec, window ) );
+        }
+
+        // Remainder. Neither reads nor writes beyond the frame.
+        for ( ; i < mWindowSizeSamples; i++ ) {
+            array_out[ i ] = mHammingWindow[ i ] * ( array_in[ i ]  - mPreEmphTap0 * array_in[ i - 1 ] );
+        }
+    }
+#endif
+
+    /** @brief the compatible front end. Dither, DC offset removal, energy, pre-emphasis
+     *         and window in two passes over the frame: the first one adds the dither and sums
+     *         the samples for the mean, the second one does the rest.
+     *
+     *  @param array_in     : input  samples (frame) whose length is windowSizeSamples
+     *  @param array_out    : output samples (frame) whose length is windowSizeSamples
+     *  @param params       : front end options. Only compatible ones are expected.
+     *  @param dither       : generator for the dither
+     *  @return natural log of the raw or windowed energy of the frame, floored at FLT_EPSILON
+     */
+    float compatibleFrontEnd_cpp(
+        const float*              array_in,
+        float*                    array_out,
+        const FrontEndParameters& params,
+        DitherGenerator&          dither
+    ) {
+        const float* src = array_in;
+        float        sum = 0.0;
+
+        if ( params.dither != 0.0 ) {
+
+            float d[ 4 ];
+            for ( int i = 0; i < mWindowSizeSamples; i += 4 ) {
+
+                dither.next4_cpp( d );
+                for ( int l = 0; l < 4 && i + l < mWindowSizeSamples; l++ ) {
+                    mScratch[ i + l ] = array_in[ i + l ] + params.dither * d[ l ];
+                    sum += mScratch[ i + l ];
+                }
+            }
+            src = mScratch;
+        }
+        else if ( params.removeDCOffset ) {
+
+            for ( int i = 0; i < mWindowSizeSamples; i++ ) {
+                sum += array_in[ i ];
+            }
+        }
+
+        const float mean = params.removeDCOffset ? sum / mWindowSizeSamples : 0.0f;
+        const float k    = params.preemphCoeff;
+
+        float rawEnergy = 0.0;
+        float energy    = 0.0;
+        float prev      = src[ 0 ] - mean;
+
+        for ( int i = 0; i < mWindowSizeSamples; i++ ) {
+
+            const float x = src[ i ] - mean;
+            const float y = mHammingWindow[ i ] * ( x - k * prev );
+
+            rawEnergy     += x * x;
+            energy        += y * y;
+            array_out[ i ] = y;
+            prev           = x;
+        }
+
+        return log( std::max( params.rawEnergy ? rawEnergy : energy, FLT_EPSILON ) );
+    }
+
+#ifdef HAVE_NEON
+    float compatibleFrontEnd_neon(
+        const float*              array_in,
+        float*                    array_out,
+        const FrontEndParameters& params,
+        DitherGenerator&          dither
+    ) {
+        const float* src  = array_in;
+        float32x4_t  sum4 = vdupq_n_f32( 0.0 );
+        float        sum  = 0.0;
+        int          i    = 0;
+
+        if ( params.dither != 0.0 ) {
+
+            for ( ; i + 4 <= mWindowSizeSamples; i += 4 ) {
+
+                const float32x4_t v = vmlaq_n_f32( vld1q_f32( &array_in[ i ] ), dither.next4_neon(), params.dither );
+                vst1q_f32( &mScratch[ i ], v );
+                sum4 = vaddq_f32( sum4, v );
+            }
+            if ( i < mWindowSizeSamples ) {
+
+                float d[ 4 ];
+                dither.next4_cpp( d );
+                for ( int l = 0; i + l < mWindowSizeSamples; l++ ) {
+                    mScratch[ i + l ] = array_in[ i + l ] + params.dither * d[ l ];
+                    sum += mScratch[ i + l ];
+                }
+            }
+            src = mScratch;
+        }
+        else if ( params.removeDCOffset ) {
+
+            for ( ; i + 4 <= mWindowSizeSamples; i += 4 ) {
+                sum4 = vaddq_f32( sum4, vld1q_f32( &array_in[ i ] ) );
+            }
+            for ( ; i < mWindowSizeSamples; i++ ) {
+                sum += array_in[ i ];
+            }
+        }
+
+        const float32x2_t sum2 = vadd_f32( vget_low_f32( sum4 ), vget_high_f32( sum4 ) );
+        sum += vget_lane_f32( vpadd_f32( sum2, sum2 ), 0 );
+
+        const float mean = params.removeDCOffset ? sum / mWindowSizeSamples : 0.0f;
+        const float k    = params.preemphCoeff;
+
+        // The first sample is pre-emphasized with itself.
+        const float x0   = src[ 0 ] - mean;
+        const float y0   = mHammingWindow[ 0 ] * ( x0 - k * x0 );
+        float rawEnergy  = x0 * x0;
+        float energy     = y0 * y0;
+        array_out[ 0 ]   = y0;
+
+        const float32x4_t meanv      = vdupq_n_f32( mean );
+        float32x4_t       rawEnergy4 = vdupq_n_f32( 0.0 );
+        float32x4_t       energy4    = vdupq_n_f32( 0.0 );
+
+        i = 1;
+        for ( ; i + 4 <= mWindowSizeSamples; i += 4 ) {
+
+            const float32x4_t x    = vsubq_f32( vld1q_f32( &src[ i     ] ), meanv );
+            const float32x4_t prev = vsubq_f32( vld1q_f32( &src[ i - 1 ] ), meanv );
+            const float32x4_t y    = vmulq_f32( vld1q_f32( &mHammingWindow[ i ] ), vmlsq_n_f32( x, prev, k ) );
+
+            rawEnergy4 = vmlaq_f32( rawEnergy4, x, x );
+            energy4    = vmlaq_f32( energy4,    y, y );
+            vst1q_f32( &array_out[ i ], y );
+        }
+        for ( ; i < mWindowSizeSamples; i++ ) {
+
+            const float x = src[ i ] - mean;
+            const float y = mHammingWindow[ i ] * ( x - k * ( src[ i - 1 ] - mean ) );
+
+            rawEnergy     += x * x;
+            energy        += y * y;
+            array_out[ i ] = y;
+        }
+
+        const float32x2_t raw2 = vadd_f32( vget_low_f32( rawEnergy4 ), vget_high_f32( rawEnergy4 ) );
+        const float32x2_t win2 = vadd_f32( vget_low_f32( energy4    ), vget_high_f32( energy4    ) );
+        rawEnergy += vget_lane_f32( vpadd_f32( raw2, raw2 ), 0 );
+        energy    += vget_lane_f32( vpadd_f32( win2, win2 ), 0 );
+
+        return log( std::max( params.rawEnergy ? rawEnergy : energy, FLT_EPSILON ) );
+    }
+#endif
+
+    /** @brief window coefficients and the pre-emphasis tap, for the multi-frame kernels.
+     */
+    const float* window()      const { return mHammingWindow; }
+    float        preEmphTap0() const { return mPreEmphTap0;   }
+
+private:
+    AlignedArena& mArena;
+    const int     mWindowSizeSamples;
+    const float   mPreEmphTap0;
+    const float*  mHammingWindow;
+    float*        mOwnedWindow;   // non-default windows
+    float*        mScratch;       // dithered frame
+};
+
+
+class FFT512 {
+
+public:
+
+    static constexpr int cTwiddleTableSize = 2 * ( 256 + 128 + 64 + 32 + 16 + 8 + 4 + 2 + 1 );
+    static constexpr int cNumScratchArrays = 36;  // input and output, re and im, of each level
+
+    /** @brief constructor
+     *
+     *  @param arena : arena for the scratch arrays, arenaBytes() or more
+     */
+    FFT512 ( AlignedArena& arena ) {
+
+        // Each array starts on a cache line, as 512 floats are a multiple of 64 bytes.
+        float* const scratch = arena.allocate< float >( cNumScratchArrays * 512 );
+
+        float** const arrays[ cNumScratchArrays ] = {
+            &mArrayIn512re,  &mArrayIn512im,  &mArrayIn256re,  &mArrayIn256im,  &mArrayIn128re,  &mArrayIn128im,
+            &mArrayIn64re,   &mArrayIn64im,   &mArrayIn32re,   &mArrayIn32im,   &mArrayIn16re,   &mArrayIn16im,
+            &mArrayIn8re,    &mArrayIn8im,    &mArrayIn4re,    &mArrayIn4im,    &mArrayIn2re,    &mArrayIn2im,
+            &mArrayOut512re, &mArrayOut512im, &mArrayOut256re, &mArrayOut256im, &mArrayOut128re, &mArrayOut128im,
+            &mArrayOut64re,  &mArrayOut64im,  &mArrayOut32re,  &mArrayOut32im,  &mArrayOut16re,  &mArrayOut16im,
+            &mArrayOut8re,   &mArrayOut8im,   &mArrayOut4re,   &mArrayOut4im,   &mArrayOut2re,   &mArrayOut2im
+        };
+        for ( int i = 0; i < cNumScratchArrays; i++ ) {
+            *arrays[ i ] = &scratch[ 512 * i ];
+        }
+
+#ifdef MFCC_RUNTIME_TABLES
+        float* const twiddles = arena.allocate< float >( cTwiddleTableSize );
+        makeTwiddleTable( twiddles );
+        bindTwiddles( twiddles );
+#else
+        bindTwiddles( cTableFFT512Twiddles );
+#endif
+    }
+
+    /** @brief arena bytes taken by an instance.
+     */
+    static size_t arenaBytes() {
+
+        size_t bytes = AlignedArena::bytesFor< float >( cNumScratchArrays * 512 );
+#ifdef MFCC_RUNTIME_TABLES
+        bytes += AlignedArena::bytesFor< float >( cTwiddleTableSize );
+#endif
+        return bytes;
+    }
+
+    /** @brief fills the twiddle table: real and imaginary parts of the N/2 twiddles
+     *         for N = 512, 256, ..., 2, in this order.
+     *
+     *  @param table : (out) cTwiddleTableSize values
+     */
+    static void makeTwiddleTable( float* table ) {
+
+        for ( int N = 512; N >= 2; N /= 2 ) {
+
+            makeTwiddle( table, table + N / 2, N );
+            table += N;
+        }
+    }
+
+    /** @brief main function
+     *
+     *  @param samples_re : (in)  samples real
+     *  @param samples_im : (in)  samples imaginary
+     *  @param points_re  : (out) points real
+     *  @param points_im  : (out) points imaginary
+     *
+     *  @return : frequency domain points in (re,im) pairs
+     */
+    void transform_cpp( float* samples_re, float* samples_im, float* points_re, float* points_im ) {
+
+        memcpy( mArrayIn512re, samples_re, sizeof(float)* 512 );
+        memcpy( mArrayIn512im, samples_im, sizeof(float)* 512 );
+
+        cooley_tukey_fft_512_cpp( 0 );
+
+        memcpy( points_re, mArrayOut512re, sizeof(float)* 512 );
+        memcpy( points_im, mArrayOut512im, sizeof(float)* 512 );
+
+    }
+
+#ifdef HAVE_NEON
+    void transform_neon( float* samples_re, float* samples_im, float* points_re, float* points_im ) {
+
+        memcpy( mArrayIn512re, samples_re, sizeof(float)* 512 );
+        memcpy( mArrayIn512im, samples_im, sizeof(float)* 512 );
+
+        cooley_tukey_fft_512_neon( 0 );
+
+        memcpy( points_re, mArrayOut512re, sizeof(float)* 512 );
+        memcpy( points_im, mArrayOut512im, sizeof(float)* 512 );
+
+    }
+#endif
+
+private:
+
+    /** @brief points the twiddles of each size into the table of makeTwiddleTable().
+     */
+    void bindTwiddles( const float* table ) {
+
+        mTwiddle512re = table; mTwiddle512im = table + 256; table += 512;
+        mTwiddle256re = table; mTwiddle256im = table + 128; table += 256;
+        mTwiddle128re = table; mTwiddle128im = table +  64; table += 128;
+        mTwiddle64re  = table; mTwiddle64im  = table +  32; table +=  64;
+        mTwiddle32re  = table; mTwiddle32im  = table +  16; table +=  32;
+        mTwiddle16re  = table; mTwiddle16im  = table +   8; table +=  16;
+        mTwiddle8re   = table; mTwiddle8im   = table +   4; table +=   8;
+        mTwiddle4re   = table; mTwiddle4im   = table +   2; table +=   4;
+        mTwiddle2re   = table; mTwiddle2im   = table +   1;
+    }
+
+
+    static void makeTwiddle( float re[], float im[], const int N ) {
+
+        const double dN  = (double)N;
+
+        for ( int k = 0; k < N / 2 ; k++ ) {
+
+            const double theta = -2.0 * M_PI * (double)k / dN;
+
+            re[ k ] = (float) cos( theta ); // re
+            im[ k ] = (float) sin( theta ); // im
+        }
+    }
+
+
+    const float* mTwiddle512re;    // [256]
+    const float* mTwiddle512im;
+    const float* mTwiddle256re;    // [128]
+    const float* mTwiddle256im;
+    const float* mTwiddle128re;    // [ 64]
+    const float* mTwiddle128im;
+    const float* mTwiddle64re;     // [ 32]
+    const float* mTwiddle64im;
+    const float* mTwiddle32re;     // [ 16]
+    const float* mTwiddle32im;
+    const float* mTwiddle16re;     // [  8]
+    const float* mTwiddle16im;
+    const float* mTwiddle8re;      // [  4]
+    const float* mTwiddle8im;
+    const float* mTwiddle4re;      // [  2]
+    const float* mTwiddle4im;
+    const float* mTwiddle2re;      // [  1]
+    const float* mTwiddle2im;
+
+    float* mArrayIn512re;  // Input to 512 FFT
+    float* mArrayIn512im;
+    float* mArrayIn256re;
+    float* mArrayIn256im;
+    float* mArrayIn128re;
+    float* mArrayIn128im;
+    float* mArrayIn64re;
+    float* mArrayIn64im;
+    float* mArrayIn32re;
+    float* mArrayIn32im;
+    float* mArrayIn16re;
+    float* mArrayIn16im;
+    float* mArrayIn8re;
+    float* mArrayIn8im;
+    float* mArrayIn4re;
+    float* mArrayIn4im;
+    float* mArrayIn2re;
+    float* mArrayIn2im;
+
+    float* mArrayOut512re;  // Output to 512 FFT
+    float* mArrayOut512im;
+    float* mArrayOut256re;
+    float* mArrayOut256im;
+    float* mArrayOut128re;
+    float* mArrayOut128im;
+    float* mArrayOut64re;
+    float* mArrayOut64im;
+    float* mArrayOut32re;
+    float* mArrayOut32im;
+    float* mArrayOut16re;
+    float* mArrayOut16im;
+    float* mArrayOut8re;
+    float* mArrayOut8im;
+    float* mArrayOut4re;
+    float* mArrayOut4im;
+    float* mArrayOut2re;
+    float* mArrayOut2im;
+
+    inline void cooley_tukey_fft_2( const size_t pos_base ) {
+
+        float *const array_in_re       = mArrayIn2re;
+        float *const array_in_im       = mArrayIn2im;
+        float *const array_out_re      = mArrayOut2re;
+        float *const array_out_im      = mArrayOut2im;
+
+        const float * const twiddle_re = mTwiddle2re;
+        const float * const twiddle_im = mTwiddle2im;
+
+        // Butterfly
+        const float tw_re = twiddle_re[ 0 ];
+        const float tw_im = twiddle_im[ 0 ];
+
+        const float v1_re = array_in_re [ pos_base     ];
+        const float v1_im = array_in_im [ pos_base     ];
+        const float v2_re = array_in_re [ pos_base + 1 ];
+        const float v2_im = array_in_im [ pos_base + 1 ];
+
+        array_out_re[ pos_base     ] = v1_re + v2_re;
+        array_out_im[ pos_base     ] = v1_im + v2_im;
+        array_out_re[ pos_base + 1 ] = v1_re - v2_re;
+        array_out_im[ pos_base + 1 ] = v1_im - v2_im;
+    }
+
+
+    inline void cooley_tukey_fft_4( const size_t pos_base ) {
+
+        const size_t half_width = 2;
+
+        float *const array_in_re        = mArrayIn4re;
+        float *const array_in_im        = mArrayIn4im;
+        float *const array_in_child_re  = mArrayIn2re;
+        float *const array_in_child_im  = mArrayIn2im;
+
+        float *const array_out_re       = mArrayOut4re;
+        float *const array_out_im       = mArrayOut4im;
+        float *const array_out_child_re = mArrayOut2re;
+        float *const array_out_child_im = mArrayOut2im;
+
+        const float * const twiddle_re  = mTwiddle4re;
+        const float * const twiddle_im  = mTwiddle4im;
+
+        // Splitting into even and odd.
+
+        array_in_child_re[ pos_base              ] = array_in_re[ pos_base     ]; // even re
+        array_in_child_im[ pos_base              ] = array_in_im[ pos_base     ]; // even re
+        array_in_child_re[ pos_base + half_width ] = array_in_re[ pos_base + 1 ]; // odd re
+        array_in_child_im[ pos_base + half_width ] = array_in_im[ pos_base + 1 ]; // odd re
+
+        array_in_child_re[ pos_base + 1              ] = array_in_re[ pos_base + 2 ]; // even re
+        array_in_child_im[ pos_base + 1              ] = array_in_im[ pos_base + 2 ]; // even re
+        array_in_child_re[ pos_base + half_width + 1 ] = array_in_re[ pos_base + 3 ]; // odd re
+        array_in_child_im[ pos_base + half_width + 1 ] = array_in_im[ pos_base + 3 ]; // odd re
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_2( pos_base              );
+        cooley_tukey_fft_2( pos_base + half_width );
+
+        // Butterfly
+        {
+            const float v1_re = array_out_child_re[ pos_base              ];
+            const float v1_im = array_out_child_im[ pos_base              ];
+            const float v2_re = array_out_child_re[ pos_base + half_width ];
+            const float v2_im = array_out_child_im[ pos_base + half_width ];
+
+            array_out_re[ pos_base              ] = v1_re + v2_re;
+            array_out_im[ pos_base              ] = v1_im + v2_im;
+            array_out_re[ pos_base + half_width ] = v1_re - v2_re;
+            array_out_im[ pos_base + half_width ] = v1_im - v2_im;
+        }
+        {
+            const float v1_re = array_out_child_re[ pos_base + 1              ];
+            const float v1_im = array_out_child_im[ pos_base + 1              ];
+            const float v2_re = array_out_child_re[ pos_base + half_width + 1 ];
+            const float v2_im = array_out_child_im[ pos_base + half_width + 1 ];
+
+            array_out_re[ pos_base + 1              ] = v1_re + v2_im;
+            array_out_im[ pos_base + 1              ] = v1_im - v2_re;
+            array_out_re[ pos_base + half_width + 1 ] = v1_re - v2_im;
+            array_out_im[ pos_base + half_width + 1 ] = v1_im + v2_re;
+
+        }
+
+    }
+
+
+    inline void cooley_tukey_fft_8_cpp( const size_t pos_base ) {
+
+        const size_t half_width = 4;
+
+        float *const array_in_re = mArrayIn8re;
+        float *const array_in_im = mArrayIn8im;
+        float *const array_in_child_re = mArrayIn4re;
+        float *const array_in_child_im = mArrayIn4im;
+
+        float *const array_out_re = mArrayOut8re;
+        float *const array_out_im = mArrayOut8im;
+        float *const array_out_child_re = mArrayOut4re;
+        float *const array_out_child_im = mArrayOut4im;
+
+        const float *const twiddle_re = mTwiddle8re;
+        const float *const twiddle_im = mTwiddle8im;
+
+        // Splitting into even and odd.
+
+        for (size_t i = 0; i < half_width; i++) {
+
+            array_in_child_re[ pos_base + i              ] = array_in_re[ pos_base + 2 * i     ]; // even re
+            array_in_child_im[ pos_base + i              ] = array_in_im[ pos_base + 2 * i     ]; // even re
+            array_in_child_re[ pos_base + half_width + i ] = array_in_re[ pos_base + 2 * i + 1 ]; // odd re
+            array_in_child_im[ pos_base + half_width + i ] = array_in_im[ pos_base + 2 * i + 1 ]; // odd re
+        }
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_4( pos_base );
+        cooley_tukey_fft_4( pos_base + half_width );
+
+        // Butterfly
+        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+
+#ifdef HAVE_NEON
+    inline void cooley_tukey_fft_8_neon( const size_t pos_base ) {
+
+        const size_t half_width = 4;
+
+        float *const array_in_re = mArrayIn8re;
+        float *const array_in_im = mArrayIn8im;
+        float *const array_in_child_re = mArrayIn4re;
+        float *const array_in_child_im = mArrayIn4im;
+
+        float *const array_out_re = mArrayOut8re;
+        float *const array_out_im = mArrayOut8im;
+        float *const array_out_child_re = mArrayOut4re;
+        float *const array_out_child_im = mArrayOut4im;
+
+        const float *const twiddle_re = mTwiddle8re;
+        const float *const twiddle_im = mTwiddle8im;
+
+        // Splitting into even and odd.
+        float32x4x2_t interleaved_chunk = vld2q_f32( &(array_in_re[ pos_base ]) );
+        vst1q_f32( (float32_t *)( &(array_in_child_re[pos_base    ]) ), interleaved_chunk.val[0] );
+        vst1q_f32( (float32_t *)( &(array_in_child_re[pos_base + 4]) ), interleaved_chunk.val[1] );
+
+        interleaved_chunk = vld2q_f32( &(array_in_im[ pos_base ]) );
+        vst1q_f32( (float32_t *)( &(array_in_child_im[pos_base    ]) ), interleaved_chunk.val[0] );
+        vst1q_f32( (float32_t *)( &(array_in_child_im[pos_base + 4]) ), interleaved_chunk.val[1] );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_4( pos_base );
+        cooley_tukey_fft_4( pos_base + half_width );
+
+        // Butterfly
+        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+#endif
+
+
+    inline void cooley_tukey_fft_16_cpp( const size_t pos_base ) {
+
+        const size_t half_width = 8;
+
+        float *const array_in_re        = mArrayIn16re;
+        float *const array_in_im        = mArrayIn16im;
+        float *const array_in_child_re  = mArrayIn8re;
+        float *const array_in_child_im  = mArrayIn8im;
+
+        float *const array_out_re       = mArrayOut16re;
+        float *const array_out_im       = mArrayOut16im;
+        float *const array_out_child_re = mArrayOut8re;
+        float *const array_out_child_im = mArrayOut8im;
+
+        const float * const twiddle_re  = mTwiddle16re;
+        const float * const twiddle_im  = mTwiddle16im;
+
+        // Splitting into even and odd.
+
+        deinterleave_cpp(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_cpp(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_8_cpp( pos_base              );
+        cooley_tukey_fft_8_cpp( pos_base + half_width );
+
+        // Butterfly
+        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+
+#ifdef HAVE_NEON
+    inline void cooley_tukey_fft_16_neon( const size_t pos_base ) {
+
+        const size_t half_width = 8;
+
+        float *const array_in_re        = mArrayIn16re;
+        float *const array_in_im        = mArrayIn16im;
+        float *const array_in_child_re  = mArrayIn8re;
+        float *const array_in_child_im  = mArrayIn8im;
+
+        float *const array_out_re       = mArrayOut16re;
+        float *const array_out_im       = mArrayOut16im;
+        float *const array_out_child_re = mArrayOut8re;
+        float *const array_out_child_im = mArrayOut8im;
+
+        const float * const twiddle_re  = mTwiddle16re;
+        const float * const twiddle_im  = mTwiddle16im;
+
+        // Splitting into even and odd.
+        deinterleave_neon(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_neon(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_8_neon( pos_base              );
+        cooley_tukey_fft_8_neon( pos_base + half_width );
+
+        // Butterfly
+        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+#endif
+
+
+    inline void cooley_tukey_fft_32_cpp( const size_t pos_base ) {
+
+        const size_t half_width = 16;
+
+        float *const array_in_re        = mArrayIn32re;
+        float *const array_in_im        = mArrayIn32im;
+        float *const array_in_child_re  = mArrayIn16re;
+        float *const array_in_child_im  = mArrayIn16im;
+
+        float *const array_out_re       = mArrayOut32re;
+        float *const array_out_im       = mArrayOut32im;
+        float *const array_out_child_re = mArrayOut16re;
+        float *const array_out_child_im = mArrayOut16im;
+
+        const float * const twiddle_re  = mTwiddle32re;
+        const float * const twiddle_im  = mTwiddle32im;
+
+        // Splitting into even and odd.
+
+        deinterleave_cpp(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_cpp(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_16_cpp( pos_base              );
+        cooley_tukey_fft_16_cpp( pos_base + half_width );
+
+        // Butterfly
+        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+
+#ifdef HAVE_NEON
+    inline void cooley_tukey_fft_32_neon( const size_t pos_base ) {
+
+        const size_t half_width = 16;
+
+        float *const array_in_re        = mArrayIn32re;
+        float *const array_in_im        = mArrayIn32im;
+        float *const array_in_child_re  = mArrayIn16re;
+        float *const array_in_child_im  = mArrayIn16im;
+
+        float *const array_out_re       = mArrayOut32re;
+        float *const array_out_im       = mArrayOut32im;
+        float *const array_out_child_re = mArrayOut16re;
+        float *const array_out_child_im = mArrayOut16im;
+
+        const float * const twiddle_re  = mTwiddle32re;
+        const float * const twiddle_im  = mTwiddle32im;
+
+        // Splitting into even and odd.
+        deinterleave_neon(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_neon(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_16_neon( pos_base              );
+        cooley_tukey_fft_16_neon( pos_base + half_width );
+
+        // Butterfly
+        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+#endif
+
+
+    inline void cooley_tukey_fft_64_cpp( const size_t pos_base ) {
+
+        const size_t half_width = 32;
+
+        float *const array_in_re        = mArrayIn64re;
+        float *const array_in_im        = mArrayIn64im;
+        float *const array_in_child_re  = mArrayIn32re;
+        float *const array_in_child_im  = mArrayIn32im;
+
+        float *const array_out_re       = mArrayOut64re;
+        float *const array_out_im       = mArrayOut64im;
+        float *const array_out_child_re = mArrayOut32re;
+        float *const array_out_child_im = mArrayOut32im;
+
+        const float * const twiddle_re  = mTwiddle64re;
+        const float * const twiddle_im  = mTwiddle64im;
+
+        // Splitting into even and odd.
+        deinterleave_cpp(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_cpp(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_32_cpp( pos_base              );
+        cooley_tukey_fft_32_cpp( pos_base + half_width );
+
+        // Butterfly
+        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+
+#ifdef HAVE_NEON
+    inline void cooley_tukey_fft_64_neon( const size_t pos_base ) {
+
+        const size_t half_width = 32;
+
+        float *const array_in_re        = mArrayIn64re;
+        float *const array_in_im        = mArrayIn64im;
+        float *const array_in_child_re  = mArrayIn32re;
+        float *const array_in_child_im  = mArrayIn32im;
+
+        float *const array_out_re       = mArrayOut64re;
+        float *const array_out_im       = mArrayOut64im;
+        float *const array_out_child_re = mArrayOut32re;
+        float *const array_out_child_im = mArrayOut32im;
+
+        const float * const twiddle_re  = mTwiddle64re;
+        const float * const twiddle_im  = mTwiddle64im;
+
+        // Splitting into even and odd.
+        deinterleave_neon(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_neon(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_32_neon( pos_base              );
+        cooley_tukey_fft_32_neon( pos_base + half_width );
+
+        // Butterfly
+        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+#endif
+
+    inline void cooley_tukey_fft_128_cpp( const size_t pos_base ) {
+
+        const size_t half_width = 64;
+
+        float *const array_in_re        = mArrayIn128re;
+        float *const array_in_im        = mArrayIn128im;
+        float *const array_in_child_re  = mArrayIn64re;
+        float *const array_in_child_im  = mArrayIn64im;
+
+        float *const array_out_re       = mArrayOut128re;
+        float *const array_out_im       = mArrayOut128im;
+        float *const array_out_child_re = mArrayOut64re;
+        float *const array_out_child_im = mArrayOut64im;
+
+        const float * const twiddle_re  = mTwiddle128re;
+        const float * const twiddle_im  = mTwiddle128im;
+
+        // Splitting into even and odd.
+        deinterleave_cpp(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_cpp(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_64_cpp( pos_base );
+        cooley_tukey_fft_64_cpp( pos_base + half_width );
+
+        // Butterfly
+        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+
+#ifdef HAVE_NEON
+    inline void cooley_tukey_fft_128_neon( const size_t pos_base ) {
+
+        const size_t half_width = 64;
+
+        float *const array_in_re        = mArrayIn128re;
+        float *const array_in_im        = mArrayIn128im;
+        float *const array_in_child_re  = mArrayIn64re;
+        float *const array_in_child_im  = mArrayIn64im;
+
+        float *const array_out_re       = mArrayOut128re;
+        float *const array_out_im       = mArrayOut128im;
+        float *const array_out_child_re = mArrayOut64re;
+        float *const array_out_child_im = mArrayOut64im;
+
+        const float * const twiddle_re  = mTwiddle128re;
+        const float * const twiddle_im  = mTwiddle128im;
+
+        // Splitting into even and odd.
+        deinterleave_neon(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_neon(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_64_neon(pos_base);
+        cooley_tukey_fft_64_neon(pos_base + half_width);
+
+        // Butterfly
+        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+#endif
+
+    inline void cooley_tukey_fft_256_cpp( const size_t pos_base ) {
+
+        const size_t half_width = 128;
+
+        float *const array_in_re        = mArrayIn256re;
+        float *const array_in_im        = mArrayIn256im;
+        float *const array_in_child_re  = mArrayIn128re;
+        float *const array_in_child_im  = mArrayIn128im;
+
+        float *const array_out_re       = mArrayOut256re;
+        float *const array_out_im       = mArrayOut256im;
+        float *const array_out_child_re = mArrayOut128re;
+        float *const array_out_child_im = mArrayOut128im;
+
+        const float * const twiddle_re  = mTwiddle256re;
+        const float * const twiddle_im  = mTwiddle256im;
+
+        // Splitting into even and odd.
+        deinterleave_cpp(
+            &( array_in_re      [ pos_base ] ),
+            half_width * 2,
+            &( array_in_child_re[ pos_base ] ),
+            &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_cpp(
+            &( array_in_im      [ pos_base ] ),
+            half_width * 2,
+            &( array_in_child_im[ pos_base ] ),
+            &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_128_cpp( pos_base              );
+        cooley_tukey_fft_128_cpp( pos_base + half_width );
+
+        // Butterfly
+        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+
+#ifdef HAVE_NEON
+    inline void cooley_tukey_fft_256_neon( const size_t pos_base ) {
+
+        const size_t half_width = 128;
+
+        float *const array_in_re        = mArrayIn256re;
+        float *const array_in_im        = mArrayIn256im;
+        float *const array_in_child_re  = mArrayIn128re;
+        float *const array_in_child_im  = mArrayIn128im;
+
+        float *const array_out_re       = mArrayOut256re;
+        float *const array_out_im       = mArrayOut256im;
+        float *const array_out_child_re = mArrayOut128re;
+        float *const array_out_child_im = mArrayOut128im;
+
+        const float * const twiddle_re  = mTwiddle256re;
+        const float * const twiddle_im  = mTwiddle256im;
+
+        // Splitting into even and odd.
+        deinterleave_neon(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_neon(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_128_neon( pos_base              );
+        cooley_tukey_fft_128_neon( pos_base + half_width );
+
+        // Butterfly
+        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+#endif
+
+    inline void cooley_tukey_fft_512_cpp( const size_t pos_base ) {
+
+        const size_t half_width = 256;
+
+        float * const array_in_re        = mArrayIn512re;
+        float * const array_in_im        = mArrayIn512im;
+        float * const array_in_child_re  = mArrayIn256re;
+        float * const array_in_child_im  = mArrayIn256im;
+
+        float * const array_out_re       = mArrayOut512re;
+        float * const array_out_im       = mArrayOut512im;
+        float * const array_out_child_re = mArrayOut256re;
+        float * const array_out_child_im = mArrayOut256im;
+
+        const float * const twiddle_re   = mTwiddle512re;
+        const float * const twiddle_im   = mTwiddle512im;
+
+        // Splitting into even and odd.
+        deinterleave_cpp(
+            &( array_in_re      [ pos_base ] ),
+            half_width * 2,
+            &( array_in_child_re[ pos_base ] ),
+            &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_cpp(
+            &( array_in_im      [ pos_base ] ),
+            half_width * 2,
+            &( array_in_child_im[ pos_base ] ),
+            &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_256_cpp( pos_base              );
+        cooley_tukey_fft_256_cpp( pos_base + half_width );
+
+        // Butterfly
+        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+
+#ifdef HAVE_NEON
+    inline void cooley_tukey_fft_512_neon( const size_t pos_base ) {
+
+        const size_t half_width = 256;
+
+        float * const array_in_re        = mArrayIn512re;
+        float * const array_in_im        = mArrayIn512im;
+        float * const array_in_child_re  = mArrayIn256re;
+        float * const array_in_child_im  = mArrayIn256im;
+
+        float * const array_out_re       = mArrayOut512re;
+        float * const array_out_im       = mArrayOut512im;
+        float * const array_out_child_re = mArrayOut256re;
+        float * const array_out_child_im = mArrayOut256im;
+
+        const float * const twiddle_re   = mTwiddle512re;
+        const float * const twiddle_im   = mTwiddle512im;
+
+        // Splitting into even and odd.
+        deinterleave_neon(
+                &( array_in_re      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_re[ pos_base ] ),
+                &( array_in_child_re[ pos_base + half_width ] ) );
+
+        deinterleave_neon(
+                &( array_in_im      [ pos_base ] ),
+                half_width * 2,
+                &( array_in_child_im[ pos_base ] ),
+                &( array_in_child_im[ pos_base + half_width ] ) );
+
+        // Recursive FFT expected to be expanded here.
+        cooley_tukey_fft_256_neon( pos_base              );
+        cooley_tukey_fft_256_neon( pos_base + half_width );
+
+        // Butterfly
+        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    }
+#endif
+
+    inline void butterfly_cpp(
+        const float * const twiddle_re,
+        const float * const twiddle_im,
+        float * const       array_in_re,
+        float * const       array_in_im,
+        float * const       array_out_re,
+        float * const       array_out_im,
+        const int           pos_base,
+        const int           half_width
+    ) {
+
+        for ( size_t i = 0; i < half_width; i++ ) {
+
+            const float tw_re = twiddle_re[ i ];
+            const float tw_im = twiddle_im[ i ];
+
+            const float v1_re = array_in_re[ pos_base + i              ];
+            const float v1_im = array_in_im[ pos_base + i              ];
+            const float v2_re = array_in_re[ pos_base + half_width + i ];
+            const float v2_im = array_in_im[ pos_base + half_width + i ];
+
+            const float offset_re = tw_re * v2_re - tw_im * v2_im;
+            const float offset_im = tw_re * v2_im + tw_im * v2_re;
+
+            array_out_re[ pos_base + i              ] = v1_re + offset_re;
+            array_out_im[ pos_base + i              ] = v1_im + offset_im;
+            array_out_re[ pos_base + half_width + i ] = v1_re - offset_re;
+            array_out_im[ pos_base + half_width + i ] = v1_im - offset_im;
+        }
+    }
+
+#ifdef HAVE_NEON
+    inline void butterfly_neon(
+            const float * const twiddle_re,
+            const float * const twiddle_im,
+            float * const       array_in_re,
+            float * const       array_in_im,
+            float * const       array_out_re,
+            float * const       array_out_im,
+            const int           pos_base,
+            const int           half_width
+    ) {
+        // The arrays are from the arena and the twiddles from the aligned tables, and pos_base
+        // and half_width are multiples of 4 from the 8-point level up, so all the vectors are aligned.
+        const float * const tw_re_a  = assumeAligned16( twiddle_re   );
+        const float * const tw_im_a  = assumeAligned16( twiddle_im   );
+        const float * const in_re_a  = assumeAligned16( array_in_re  );
+        const float * const in_im_a  = assumeAligned16( array_in_im  );
+        float * const       out_re_a = assumeAligned16( array_out_re );
+        float * const       out_im_a = assumeAligned16( array_out_im );
+
+        for ( size_t i = 0; i < half_width; i+=4 ) {
+
+            const float32x4_t tw_re     = vld1q_f32( &( tw_re_a[i] )                          );
+            const float32x4_t tw_im     = vld1q_f32( &( tw_im_a[i] )                          );
+            const float32x4_t v1_re_pre = vld1q_f32( &( in_re_a[pos_base + i] )              );
+            const float32x4_t v1_im_pre = vld1q_f32( &( in_im_a[pos_base + i] )              );
+            const float32x4_t v2_re_pre = vld1q_f32( &( in_re_a[pos_base + half_width + i] ) );
+            const float32x4_t v2_im_pre = vld1q_f32( &( in_im_a[pos_base + half_width + i] ) );
+
+            // const float offset_re = tw_re * v2_re - tw_im * v2_im;
+            const float32x4_t offset_re_part1 = vmulq_f32( tw_re, v2_re_pre );
+            const float32x4_t offset_re       = vmlsq_f32( offset_re_part1, tw_im, v2_im_pre );
+
+            // const float offset_im = tw_re * v2_im + tw_im * v2_re;
+            const float32x4_t offset_im_part1 = vmulq_f32( tw_re, v2_im_pre );
+            const float32x4_t offset_im       = vmlaq_f32( offset_im_part1, tw_im, v2_re_pre );
+
+            const float32x4_t v1_re = vaddq_f32( v1_re_pre, offset_re );
+            const float32x4_t v1_im = vaddq_f32( v1_im_pre, offset_im );
+            const float32x4_t v2_re = vsubq_f32( v1_re_pre, offset_re );
+            const float32x4_t v2_im = vsubq_f32( v1_im_pre, offset_im );
+
+            vst1q_f32( &( out_re_a[ pos_base + i              ] ), v1_re );
+            vst1q_f32( &( out_re_a[ pos_base + half_width + i ] ), v2_re );
+            vst1q_f32( &( out_im_a[ pos_base + i              ] ), v1_im );
+            vst1q_f32( &( out_im_a[ pos_base + half_width + i ] ), v2_im );
+        }
+    }
+#endif
+
+    inline void deinterleave_cpp( const float * const src, const int src_len, float* const even, float* const odd ) {
+
+        for ( size_t dst_i = 0; dst_i < src_len / 2; dst_i++ ) {
+            even[dst_i] = src[ dst_i * 2     ];
+            odd [dst_i] = src[ dst_i * 2 + 1 ];
+        }
+    }
+
+
+#ifdef HAVE_NEON
+    inline void deinterleave_neon( const float * const src, const int src_len, float* const even, float* const odd ) {
+
+        for ( size_t dst_i = 0; dst_i < src_len/2; dst_i += 4 ) {
+
+            float32x4x2_t interleaved_chunk = vld2q_f32( &(src[dst_i*2]) );
+
+            vst1q_f32( (float32_t *)( &( even[dst_i] ) ), interleaved_chunk.val[0] );
+            vst1q_f32( (float32_t *)( &(  odd[dst_i] ) ), interleaved_chunk.val[1] );
+
+        }
+    }
+#endif
+
+};
+
+
+/** @brief 512-point FFT of a frame of real samples of which only the first numNonZero ones are
+ *         non-zero, pruned to the butterflies that affect the requested output points.
+ *         The real samples are packed into 256 complex ones, z[ n ] = x[ 2n ] + i x[ 2n + 1 ], for an
+ *         iterative radix-2 decimation-in-frequency FFT, whose first stage skips the butterflies
+ *         with a zero upper input (56 of 128 for 400 samples). The points of the 512-point transform
+ *         are then split out of the 256-point one only from the first requested point up to 255.
+ *         The upper 256 points are the mirror image for real input and are never computed.
+ */
+class PrunedFFT512 {
+
+public:
+    static constexpr int cNumComplex = 256;
+    static constexpr int cTableSize  = 4 * cNumComplex;
+
+    /** @brief constructor
+     *
+     *  @param arena      : arena for the scratch arrays, arenaBytes() or more
+     *  @param numNonZero : number of leading samples that can be non-zero (usually 400)
+     */
+    PrunedFFT512( AlignedArena& arena, const int numNonZero )
+        :mNumNonZeroComplex( std::min( ( numNonZero + 1 ) / 2, (int)cNumComplex ) )
+    {
+        mRe  = arena.allocate< float >( cNumComplex );
+        mIm  = arena.allocate< float >( cNumComplex );
+        mZRe = arena.allocate< float >( cNumComplex );
+        mZIm = arena.allocate< float >( cNumComplex );
+
+#ifdef MFCC_RUNTIME_TABLES
+        float* const table      = arena.allocate< float >( cTableSize );
+        int*   const bitReverse = arena.allocate< int   >( cNumComplex );
+        makeTables( table, bitReverse );
+        bindTables( table, bitReverse );
+#else
+        bindTables( cTablePrunedFFT512, cTablePrunedFFT512BitReverse );
+#endif
+    }
+
+    /** @brief arena bytes taken by an instance.
+     */
+    static size_t arenaBytes() {
+
+        size_t bytes = 4 * AlignedArena::bytesFor< float >( cNumComplex );
+#ifdef MFCC_RUNTIME_TABLES
+        bytes += AlignedArena::bytesFor< float >( cTableSize ) + AlignedArena::bytesFor< int >( cNumComplex );
+#endif
+        return bytes;
+    }
+
+    /** @brief fills the tables. The stage twiddles, real and imaginary, then the split
+     *         twiddles, real and imaginary, cNumComplex each, and the bit reversal permutation.
+     *
+     *  @param table      : (out) cTableSize values
+     *  @param bitReverse : (out) cNumComplex indices
+     */
+    static void makeTables( float* table, int* bitReverse ) {
+
+        float* twiddleRe = table;
+        float* twiddleIm = table +     cNumComplex;
+        float* splitRe   = table + 2 * cNumComplex;
+        float* splitIm   = table + 3 * cNumComplex;
+
+        // Twiddles of the stage with half-width h at [ h, 2h ): exp( -2 pi i j / 2h ).
+        for ( int half = 1; half < cNumComplex; half *= 2 ) {
+            for ( int j = 0; j < half; j++ ) {
+                const double theta = -M_PI * (double)j / (double)half;
+                twiddleRe[ half + j ] = (float) cos( theta );
+                twiddleIm[ half + j ] = (float) sin( theta );
+            }
+        }
+        twiddleRe[ 0 ] = 0.0;
+        twiddleIm[ 0 ] = 0.0;
+
+        for ( int k = 0; k < cNumComplex; k++ ) {
+
+            const double theta = -2.0 * M_PI * (double)k / ( 2.0 * cNumComplex );
+            splitRe[ k ] = (float) cos( theta );
+            splitIm[ k ] = (float) sin( theta );
+
+            int r = 0;
+            for ( int b = 1, v = k; b < cNumComplex; b *= 2, v /= 2 ) {
+                r = r * 2 + ( v & 1 );
+            }
+            bitReverse[ k ] = r;
+        }
+    }
+
+    /** @brief main function
+     *
+     *  @param samples    : (in)  512 real samples. [ numNonZero, 512 ) must be zero.
+     *  @param firstPoint : first output point needed
+     *  @param points_re  : (out) points [ 0, 256 ) real. [ 0, firstPoint ) are set to zero.
+     *  @param points_im  : (out) points [ 0, 256 ) imaginary
+     */
+    void transform_cpp( const float* samples, const int firstPoint, float* points_re, float* points_im ) {
+
+        firstStage_cpp( samples );
+
+        for ( int half = cNumComplex / 4; half >= 1; half /= 2 ) {
+
+            for ( int start = 0; start < cNumComplex; start += 2 * half ) {
+
+                for ( int j = 0; j < half; j++ ) {
+                    butterfly( start + j, start + j + half, mTwiddleRe[ half + j ], mTwiddleIm[ half + j ] );
+                }
+            }
+        }
+
+        for ( int k = 0; k < firstPoint; k++ ) {
+            points_re[ k ] = 0.0;
+            points_im[ k ] = 0.0;
+        }
+
+        for ( int k = firstPoint; k < cNumComplex; k++ ) {
+
+            const int   a   = mBitReverse[ k ];
+            const int   b   = mBitReverse[ ( cNumComplex - k ) & ( cNumComplex - 1 ) ];
+            const float er  = 0.5f * ( mRe[ a ] + mRe[ b ] );
+            const float ei  = 0.5f * ( mIm[ a ] - mIm[ b ] );
+            const float or_ = 0.5f * ( mIm[ a ] + mIm[ b ] );
+            const float oi  = 0.5f * ( mRe[ b ] - mRe[ a ] );
+
+            points_re[ k ] = er + mSplitRe[ k ] * or_ - mSplitIm[ k ] * oi;
+            points_im[ k ] = ei + mSplitRe[ k ] * oi  + mSplitIm[ k ] * or_;
+        }
+    }
+
+#ifdef HAVE_NEON
+    void transform_neon( const float* samples, const int firstPoint, float* points_re, float* points_im ) {
+
+        firstStage_neon( samples );
+
+        for ( int half = cNumComplex / 4; half >= 4; half /= 2 ) {
+
+            for ( int start = 0; start < cNumComplex; start += 2 * half ) {
+
+                for ( int j = 0; j < half; j += 4 ) {
+
+                    // Aligned, as start, j and half are multiples of 4 on arrays from the arena.
+                    float* are = assumeAligned16( &mRe[ start + j        ] );
+                    float* aim = assumeAligned16( &mIm[ start + j        ] );
+                    float* bre = assumeAligned16( &mRe[ start + j + half ] );
+                    float* bim = assumeAligned16( &mIm[ start + j + half ] );
+
+                    const float32x4_t ar = vld1q_f32( are );
+                    const float32x4_t ai = vld1q_f32( aim );
+                    const float32x4_t br = vld1q_f32( bre );
+                    const float32x4_t bi = vld1q_f32( bim );
+                    const float32x4_t wr = vld1q_f32( &mTwiddleRe[ half + j ] );
+                    const float32x4_t wi = vld1q_f32( &mTwiddleIm[ half + j ] );
+                    const float32x4_t tr = vsubq_f32( ar, br );
+                    const float32x4_t ti = vsubq_f32( ai, bi );
+
+                    vst1q_f32( are, vaddq_f32( ar, br ) );
+                    vst1q_f32( aim, vaddq_f32( ai, bi ) );
+                    vst1q_f32( bre, vmlsq_f32( vmulq_f32( tr, wr ), ti, wi ) );
+                    vst1q_f32( bim, vmlaq_f32( vmulq_f32( tr, wi ), ti, wr ) );
+                }
+            }
+        }
+
+        // The last two stages, whose twiddles are 1 and -i, as one radix-4 pass.
+        for ( int start = 0; start < cNumComplex; start += 4 ) {
+
+            float* re = &mRe[ start ];
+            float* im = &mIm[ start ];
+
+            const float s0r = re[ 0 ] + re[ 2 ], s0i = im[ 0 ] + im[ 2 ];
+            const float s1r = re[ 1 ] + re[ 3 ], s1i = im[ 1 ] + im[ 3 ];
+            const float d0r = re[ 0 ] - re[ 2 ], d0i = im[ 0 ] - im[ 2 ];
+            const float d1r = im[ 1 ] - im[ 3 ], d1i = re[ 3 ] - re[ 1 ]; // ( x1 - x3 ) * -i
+
+            re[ 0 ] = s0r + s1r;  im[ 0 ] = s0i + s1i;
+            re[ 1 ] = s0r - s1r;  im[ 1 ] = s0i - s1i;
+            re[ 2 ] = d0r + d1r;  im[ 2 ] = d0i + d1i;
+            re[ 3 ] = d0r - d1r;  im[ 3 ] = d0i - d1i;
+        }
+
+        // Natural order, so that the mirrored points are a reversed vector load.
+        for ( int k = 0; k < cNumComplex; k++ ) {
+            mZRe[ k ] = mRe[ mBitReverse[ k ] ];
+            mZIm[ k ] = mIm[ mBitReverse[ k ] ];
+        }
+
+        int k = 0;
+        for ( ; k < firstPoint; k++ ) {
+            points_re[ k ] = 0.0;
+            points_im[ k ] = 0.0;
+        }
+        for ( ; k < std::max( firstPoint, 1 ); k++ ) {
+            splitPoint( k, points_re, points_im );
+        }
+        // Point k pairs with 256 - k, so that the vector at k meets the reversed vector ending at 256 - k.
+        for ( ; k + 4 <= cNumComplex; k += 4 ) {
+
+            const float32x4_t zr  = vld1q_f32( &mZRe[ k ] );
+            const float32x4_t zi  = vld1q_f32( &mZIm[ k ] );
+            const float32x4_t mr  = reverse( vld1q_f32( &mZRe[ cNumComplex - k - 3 ] ) );
+            const float32x4_t mi  = reverse( vld1q_f32( &mZIm[ cNumComplex - k - 3 ] ) );
+            const float32x4_t er  = vmulq_n_f32( vaddq_f32( zr, mr ), 0.5f );
+            const float32x4_t ei  = vmulq_n_f32( vsubq_f32( zi, mi ), 0.5f );
+            const float32x4_t or_ = vmulq_n_f32( vaddq_f32( zi, mi ), 0.5f );
+            const float32x4_t oi  = vmulq_n_f32( vsubq_f32( mr, zr ), 0.5f );
+            const float32x4_t wr  = vld1q_f32( &mSplitRe[ k ] );
+            const float32x4_t wi  = vld1q_f32( &mSplitIm[ k ] );
+
+            vst1q_f32( &points_re[ k ], vmlsq_f32( vmlaq_f32( er, wr, or_ ), wi, oi  ) );
+            vst1q_f32( &points_im[ k ], vmlaq_f32( vmlaq_f32( ei, wr, oi  ), wi, or_ ) );
+        }
+        for ( ; k < cNumComplex; k++ ) {
+            splitPoint( k, points_re, points_im );
+        }
+    }
+#endif
+
+private:
+
+    void bindTables( const float* table, const int* bitReverse ) {
+
+        mTwiddleRe  = table;
+        mTwiddleIm  = table +     cNumComplex;
+        mSplitRe    = table + 2 * cNumComplex;
+        mSplitIm    = table + 3 * cNumComplex;
+        mBitReverse = bitReverse;
+    }
+
+    inline void butterfly( const int a, const int b, const float wr, const float wi ) {
+
+        const float tr = mRe[ a ] - mRe[ b ];
+        const float ti = mIm[ a ] - mIm[ b ];
+
+        mRe[ a ] += mRe[ b ];
+        mIm[ a ] += mIm[ b ];
+        mRe[ b ]  = tr * wr - ti * wi;
+        mIm[ b ]  = tr * wi + ti * wr;
+    }
+
+    /** @brief packs the samples and runs the first stage. z[ n + 128 ] is zero for
+     *         n + 128 >= mNumNonZeroComplex, and the butterfly reduces to a copy and a twiddle.
+     */
+    void firstStage_cpp( const float* samples ) {
+
+        const int half  = cNumComplex / 2;
+        const int full  = std::max( 0, std::min( mNumNonZeroComplex - half, half ) );
+        const int upper = std::min( mNumNonZeroComplex, half );
+
+        for ( int n = 0; n < full; n++ ) {
+
+            const float ar = samples[ 2 * n ],            ai = samples[ 2 * n + 1 ];
+            const float br = samples[ 2 * ( n + half ) ], bi = samples[ 2 * ( n + half ) + 1 ];
+            const float tr = ar - br, ti = ai - bi;
+
+            mRe[ n        ] = ar + br;
+            mIm[ n        ] = ai + bi;
+            mRe[ n + half ] = tr * mTwiddleRe[ half + n ] - ti * mTwiddleIm[ half + n ];
+            mIm[ n + half ] = tr * mTwiddleIm[ half + n ] + ti * mTwiddleRe[ half + n ];
+        }
+        for ( int n = full; n < upper; n++ ) {
+
+            const float ar = samples[ 2 * n ], ai = samples[ 2 * n + 1 ];
+
+            mRe[ n        ] = ar;
+            mIm[ n        ] = ai;
+            mRe[ n + half ] = ar * mTwiddleRe[ half + n ] - ai * mTwiddleIm[ half + n ];
+            mIm[ n + half ] = ar * mTwiddleIm[ half + n ] + ai * mTwiddleRe[ half + n ];
+        }
+        for ( int n = upper; n < half; n++ ) {
+            mRe[ n ] = mIm[ n ] = mRe[ n + half ] = mIm[ n + half ] = 0.0;
+        }
+    }
+
+#ifdef HAVE_NEON
+    void firstStage_neon( const float* samples ) {
+
+        const int half  = cNumComplex / 2;
+        const int full  = std::max( 0, std::min( mNumNonZeroComplex - half, half ) );
+        const int upper = std::min( mNumNonZeroComplex, half );
+
+        int n = 0;
+        for ( ; n + 4 <= full; n += 4 ) {
+
+            const float32x4x2_t a  = vld2q_f32( &samples[ 2 * n ] );
+            const float32x4x2_t b  = vld2q_f32( &samples[ 2 * ( n + half ) ] );
+            const float32x4_t   wr = vld1q_f32( &mTwiddleRe[ half + n ] );
+            const float32x4_t   wi = vld1q_f32( &mTwiddleIm[ half + n ] );
+            const float32x4_t   tr = vsubq_f32( a.val[ 0 ], b.val[ 0 ] );
+            const float32x4_t   ti = vsubq_f32( a.val[ 1 ], b.val[ 1 ] );
+
+            vst1q_f32( &mRe[ n        ], vaddq_f32( a.val[ 0 ], b.val[ 0 ] ) );
+            vst1q_f32( &mIm[ n        ], vaddq_f32( a.val[ 1 ], b.val[ 1 ] ) );
+            vst1q_f32( &mRe[ n + half ], vmlsq_f32( vmulq_f32( tr, wr ), ti, wi ) );
+            vst1q_f32( &mIm[ n + half ], vmlaq_f32( vmulq_f32( tr, wi ), ti, wr ) );
+        }
+        for ( ; n < full; n++ ) {
+
+            const float ar = samples[ 2 * n ],            ai = samples[ 2 * n + 1 ];
+            const float br = samples[ 2 * ( n + half ) ], bi = samples[ 2 * ( n + half ) + 1 ];
+            const float tr = ar - br, ti = ai - bi;
+
+            mRe[ n        ] = ar + br;
+            mIm[ n        ] = ai + bi;
+            mRe[ n + half ] = tr * mTwiddleRe[ half + n ] - ti * mTwiddleIm[ half + n ];
+            mIm[ n + half ] = tr * mTwiddleIm[ half + n ] + ti * mTwiddleRe[ half + n ];
+        }
+        for ( ; n < upper && ( n & 3 ) != 0; n++ ) {
+
+            const float ar = samples[ 2 * n ], ai = samples[ 2 * n + 1 ];
+
+            mRe[ n        ] = ar;
+            mIm[ n        ] = ai;
+            mRe[ n + half ] = ar * mTwiddleRe[ half + n ] - ai * mTwiddleIm[ half + n ];
+            mIm[ n + half ] = ar * mTwiddleIm[ half + n ] + ai * mTwiddleRe[ half + n ];
+        }
+        for ( ; n + 4 <= upper; n += 4 ) {
+
+            const float32x4x2_t a  = vld2q_f32( &samples[ 2 * n ] );
+            const float32x4_t   wr = vld1q_f32( &mTwiddleRe[ half + n ] );
+            const float32x4_t   wi = vld1q_f32( &mTwiddleIm[ half + n ] );
+
+            vst1q_f32( &mRe[ n        ], a.val[ 0 ] );
+            vst1q_f32( &mIm[ n        ], a.val[ 1 ] );
+            vst1q_f32( &mRe[ n + half ], vmlsq_f32( vmulq_f32( a.val[ 0 ], wr ), a.val[ 1 ], wi ) );
+            vst1q_f32( &mIm[ n + half ], vmlaq_f32( vmulq_f32( a.val[ 0 ], wi ), a.val[ 1 ], wr ) );
+        }
+        for ( ; n < upper; n++ ) {
+
+            const float ar = samples[ 2 * n ], ai = samples[ 2 * n + 1 ];
+
+            mRe[ n        ] = ar;
+            mIm[ n        ] = ai;
+            mRe[ n + half ] = ar * mTwiddleRe[ half + n ] - ai * mTwiddleIm[ half + n ];
+            mIm[ n + half ] = ar * mTwiddleIm[ half + n ] + ai * mTwiddleRe[ half + n ];
+        }
+        for ( ; n < half; n++ ) {
+            mRe[ n ] = mIm[ n ] = mRe[ n + half ] = mIm[ n + half ] = 0.0;
+        }
+    }
+
+    static inline float32x4_t reverse( const float32x4_t v ) {
+
+        return vcombine_f32( vrev64_f32( vget_high_f32( v ) ), vrev64_f32( vget_low_f32( v ) ) );
+    }
+
+    inline void splitPoint( const int k, float* points_re, float* points_im ) const {
+
+        const int   m   = ( cNumComplex - k ) & ( cNumComplex - 1 );
+        const float er  = 0.5f * ( mZRe[ k ] + mZRe[ m ] );
+        const float ei  = 0.5f * ( mZIm[ k ] - mZIm[ m ] );
+        const float or_ = 0.5f * ( mZIm[ k ] + mZIm[ m ] );
+        const float oi  = 0.5f * ( mZRe[ m ] - mZRe[ k ] );
+
+        points_re[ k ] = er + mSplitRe[ k ] * or_ - mSplitIm[ k ] * oi;
+        points_im[ k ] = ei + mSplitRe[ k ] * oi  + mSplitIm[ k ] * or_;
+    }
+
+#endif
+
+    const int    mNumNonZeroComplex;
+
+    const float* mTwiddleRe;
+    const float* mTwiddleIm;
+    const float* mSplitRe;           // exp( -2 pi i k / 512 )
+    const float* mSplitIm;
+    const int*   mBitReverse;
+
+    float*       mRe;                // scratch from the arena
+    float*       mIm;
+    float*       mZRe;               // natural order for the NEON split
+    float*       mZIm;
+};
+
+
+class MelFilterBanks {
+
+public:
+    static constexpr int   cNumFilterBanks    =    26;
+    static constexpr int   cNumSamples        =   256;
+    static constexpr float cNumSamplesD       =   256.0;
+    static constexpr float cSampleRate        = 16000.0;
+    static constexpr float cHalfSampleRate    =  8000.0;
+    static constexpr float cFilterBankMaxFreq =  8000.0;
+    static constexpr float cFilterBankMinFreq =   300.0;
+    static constexpr float cMelFloor          =     1.0;
+
+
+    /** @brief constructor.
+     *
+     *  @param arena : arena for the table with MFCC_RUNTIME_TABLES, arenaBytes() or more
+     */
+    MelFilterBanks ( AlignedArena& arena ) {
+
+#ifdef MFCC_RUNTIME_TABLES
+        sampleToBin* const table = arena.allocate< sampleToBin >( cNumSamples );
+        for ( int i = 0; i < cNumSamples; i++ ) {
+            new ( &table[ i ] ) sampleToBin();
+        }
+        constructSampleToBin( table );
+        mSampleToBin = table;
+#else
+        (void)arena;
+        mSampleToBin = cTableMelSampleToBin;
+#endif
+    }
+
+    /** @brief arena bytes taken by an instance.
+     */
+    static size_t arenaBytes() {
+#ifdef MFCC_RUNTIME_TABLES
+        return AlignedArena::bytesFor< sampleToBin >( cNumSamples );
+#else
+        return 0;
+#endif
+    }
+
+    /** @brief first point of the power spectrum that falls in any filter. The points below
+     *         it need not be computed.
+     */
+    int firstPoint() const {
+
+        for ( int i = 0; i < cNumSamples; i++ ) {
+            if ( mSampleToBin[ i ].bin1() != -1 || mSampleToBin[ i ].bin2() != -1 ) {
+                return i;
+            }
+        }
+        return cNumSamples;
+    }
+
+    /** @brief find log Mel filter bank coefficients
+     *
+     *  @param power     : (in)  power spectrum of the first 256 points from complex 512-point FFT
+     *  @param mel_bins  : (out) Log Mel filter bank energy coefficients in real values
+     *  @param melFloor  : floor of the energies before log
+     */
+    void findLogMelCoeffs( const float* power, float* mel_bins, const float melFloor = cMelFloor ) {
+
+        for ( int i = 0; i < cNumFilterBanks; i++ ) {
+            mel_bins[ i ] = 0.0;
+        }
+
+        for ( int i = 0; i < cNumSamples; i++ ) {
+
+            const sampleToBin& stb = mSampleToBin[ i ];
+
+            const float& pwr = power[ i ];
+
+            if ( stb.bin1() != -1 )  {
+                mel_bins[ stb.bin1() ] += ( pwr * stb.coeff1() ) ;
+            }
+            if ( stb.bin2() != -1)  {
+                mel_bins[ stb.bin2() ] += ( pwr * stb.coeff2() );
+            }
+        }
+
+        for ( int i = 0; i < cNumFilterBanks; i++ ) {
+            if ( mel_bins[ i ] < melFloor ) {
+                mel_bins[ i ] = melFloor;
+            }
+            mel_bins[ i ] = log( mel_bins[ i ] ) ;
+        }
+    }
+
+
+    /** @brief fills the table of the filters each power spectrum point falls in.
+     *
+     *  @param table : (out) cNumSamples entries
+     */
+    static void constructSampleToBin( sampleToBin* table ) {
+
+        double filterBankMaxMel = freqToMel( cFilterBankMaxFreq );
+        double filterBankMinMel = freqToMel( cFilterBankMinFreq );
+
+        double intervalMel      =     (  filterBankMaxMel -  filterBankMinMel )
+                                    / ( (float)cNumFilterBanks + 1.0 );
+
+        int   melBoundariesSamplePoint[ cNumFilterBanks + 2 ];
+        float melBoundariesMelFreq    [ cNumFilterBanks + 2 ];
+
+        for ( int i = 0; i <= cNumFilterBanks + 1 ; i++ ) {
+
+            const float& m = filterBankMinMel + (float)i * intervalMel;
+            const float& f = melToFreq( m );
+            const int    s = freqToSampleNum( f ) ;
+
+            melBoundariesSamplePoint[ i ] = s;
+            melBoundariesMelFreq    [ i ] = m;
+        }
+
+        for ( int i = 0; i < cNumSamples ; i++ ) {
+
+            const float f = sampleNumToFreq( i );
+            const float m = freqToMel( f );
+
+            if (   ( m < melBoundariesMelFreq[ 0 ]                )
+                || ( melBoundariesMelFreq[ cNumFilterBanks ]  < m ) ) {
+
+                table[i].setValues( -1, -1, 0.0 );
+            }
+
+            else if (    ( melBoundariesMelFreq[ 0 ] <= m  )
+                      && ( m < melBoundariesMelFreq[ 1 ]   )  ) {
+
+                table[i].setValues( 0, -1, ( m - melBoundariesMelFreq[0] ) / intervalMel );
+            }
+
+            else if (    ( melBoundariesMelFreq[ cNumFilterBanks  - 1 ] <= m  )
+                      && ( m < melBoundariesMelFreq[ cNumFilterBanks  ]       )  ) {
+
+                table[i].setValues( cNumFilterBanks  - 1 , -1, ( melBoundariesMelFreq[cNumFilterBanks ] - m ) / intervalMel );
+            }
+
+            else {
+                for ( int j = 1; j < cNumFilterBanks ; j++ ) {
+                    if (    ( melBoundariesMelFreq[ j ] <= m    )
+                         && ( m < melBoundariesMelFreq[ j + 1 ] ) ) {
+
+                        table[i].setValues( j , j + 1, ( melBoundariesMelFreq[j+1] - m ) / intervalMel );
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    static float sampleNumToFreq( const int& i ) {
+
+        return ( (cHalfSampleRate / cNumSamplesD)  * (float) i );
+    }
+
+    static int freqToSampleNum( const float& f ) {
+
+        return (int)( ( cNumSamplesD / cHalfSampleRate ) * f ) ;
+    }
+
+    // By value, as the in-class constants above have no definitions to bind references to.
+    static float freqToMel ( const float f ) {
+
+        return 1125.0 * log( 1.0 + f / 700.0);
+    }
+
+    static float melToFreq ( const float& m ) {
+
+        return  700.0 * ( exp( m / 1125.0) - 1.0 );
+    }
+
+    const sampleToBin* mSampleToBin;
+
+};
+
+
+/** @brief triangular Mel filter bank with a configurable number of bins for the fbank output.
+ *         The filters overlap by half and are equally spaced on the Mel scale of MelFilterBanks.
+ *         Each filter is stored as a span of power spectrum points and its weights, padded with
+ *         zero weights to a multiple of 4 points, so that it is one short dot product.
+ *         The storage is laid out in the arena for up to maxBins filters, and build() fills it in
+ *         place for the number of bins of the outputs.
+ */
+class FbankFilterBank {
+
+public:
+    static constexpr int cNumPoints = 256; // points of the power spectrum of the 512-point FFT
+
+    /** @brief constructor. No filters until build().
+     *
+     *  @param arena      : arena for the filters, arenaBytes( maxBins ) or more
+     *  @param maxBins    : maximum number of filters
+     *  @param minFreq    : lower edge of the first filter in Hz
+     *  @param maxFreq    : upper edge of the last filter in Hz
+     *  @param sampleRate : sample rate in Hz
+     */
+    FbankFilterBank(
+        AlignedArena& arena,
+        const int     maxBins,
+        const float   minFreq,
+        const float   maxFreq,
+        const float   sampleRate
+    )
+        :mMaxBins   ( maxBins    )
+        ,mNumBins   ( 0          )
+        ,mMinFreq   ( minFreq    )
+        ,mMaxFreq   ( maxFreq    )
+        ,mSampleRate( sampleRate )
+    {
+        mStart   = arena.allocate< int   >( mMaxBins );
+        mLength  = arena.allocate< int   >( mMaxBins );
+        mOffset  = arena.allocate< int   >( mMaxBins );
+        mWeights = arena.allocate< float >( maxNumWeights( mMaxBins ) );
+    }
+
+    static size_t arenaBytes( const int maxBins ) {
+
+        return   3 * AlignedArena::bytesFor< int   >( maxBins )
+               +     AlignedArena::bytesFor< float >( maxNumWeights( maxBins ) );
+    }
+
+    /** @brief lays out numBins filters in place. Allocates nothing.
+     *
+     *  @param numBins : number of filters in [ 1, maxBins ]
+     */
+    void build( const int numBins ) {
+
+        ASSERT( 0 < numBins && numBins <= mMaxBins, "FbankFilterBank: %d bins, up to %d", numBins, mMaxBins );
+        mNumBins = numBins;
+
+        const double minMel      = freqToMel( mMinFreq );
+        const double intervalMel = ( freqToMel( mMaxFreq ) - minMel ) / ( mNumBins + 1.0 );
+        const double hzPerPoint  = mSampleRate / ( 2.0 * cNumPoints );
+
+        int numWeights = 0;
+
+        for ( int k = 0; k < mNumBins; k++ ) {
+
+            const double left  = minMel + k * intervalMel;
+            const double right = left + 2.0 * intervalMel;
+
+            int first = -1;
+            int last  = -1;
+            for ( int i = 0; i < cNumPoints; i++ ) {
+                const double m = freqToMel( i * hzPerPoint );
+                if ( left < m && m < right ) {
+                    first = ( first == -1 ) ? i : first;
+                    last  = i;
+                }
+            }
+
+            const int length = ( first == -1 ) ? 0 : ( ( last - first + 4 ) / 4 ) * 4;
+
+            mStart [ k ] = std::max( 0, std::min( first, cNumPoints - length ) );
+            mLength[ k ] = length;
+            mOffset[ k ] = numWeights;
+            numWeights  += length;
+        }
+
+        for ( int k = 0; k < mNumBins; k++ ) {
+
+            const double left   = minMel + k * intervalMel;
+            const double center = left + intervalMel;
+            const double right  = center + intervalMel;
+
+            for ( int j = 0; j < mLength[ k ]; j++ ) {
+
+                const double m = freqToMel( ( mStart[ k ] + j ) * hzPerPoint );
+                double       w = 0.0;
+
+                if ( left < m && m <= center ) {
+                    w = ( m - left ) / intervalMel;
+                }
+                else if ( center < m && m < right ) {
+                    w = ( right - m ) / intervalMel;
+                }
+                mWeights[ mOffset[ k ] + j ] = w;
+            }
+        }
+    }
+
+    int          numBins()           const { return mNumBins;                 } // 0 before build()
+    int          start  ( int k )    const { return mStart[ k ];              }
+    int          length ( int k )    const { return mLength[ k ];             }
+    const float* weights( int k )    const { return &mWeights[ mOffset[ k ] ]; }
+
+    /** @brief natural log of the filter bank energies.
+     *
+     *  @param power      : (in)  256-point power spectrum
+     *  @param writer     : (out) log energies through FeatureWriter*
+     *  @param melFloor   : floor of the energies before log
+     *  @param firstIndex : index of the writer for the first bin
+     */
+    template< class Writer >
+    void findLogMelCoeffs_cpp( const float* power, Writer& writer, const float melFloor, const int firstIndex ) const {
+
+        for ( int k = 0; k < mNumBins; k++ ) {
+
+            const float* w   = weights( k );
+            const float* pwr = &power[ mStart[ k ] ];
+            float        sum = 0.0;
+
+            for ( int j = 0; j < mLength[ k ]; j++ ) {
+                sum += w[ j ] * pwr[ j ];
+            }
+            writer.write( firstIndex + k, log( std::max( sum, melFloor ) ) );
+        }
+    }
+
+#ifdef HAVE_NEON
+    template< class Writer >
+    void findLogMelCoeffs_neon( const float* power, Writer& writer, const float melFloor, const int firstIndex ) const {
+
+        for ( int k = 0; k < mNumBins; k += 4 ) {
+
+            float sums[ 4 ];
+
+            for ( int l = 0; l < 4; l++ ) {
+
+                float32x4_t acc = vdupq_n_f32( 0.0 );
+
+                if ( k + l < mNumBins ) {
+                    const float* w   = weights( k + l );
+                    const float* pwr = &power[ mStart[ k + l ] ];
+                    for ( int j = 0; j < mLength[ k + l ]; j += 4 ) {
+                        acc = vmlaq_f32( acc, vld1q_f32( &w[ j ] ), vld1q_f32( &pwr[ j ] ) );
+                    }
+                }
+                const float32x2_t acc2 = vadd_f32( vget_low_f32( acc ), vget_high_f32( acc ) );
+                sums[ l ] = log( std::max( vget_lane_f32( vpadd_f32( acc2, acc2 ), 0 ), melFloor ) );
+            }
+
+            if ( k + 4 <= mNumBins ) {
+                writer.write4( firstIndex + k, vld1q_f32( sums ) );
+            }
+            else {
+                for ( int l = 0; k + l < mNumBins; l++ ) {
+                    writer.write( firstIndex + k + l, sums[ l ] );
+                }
+            }
+        }
+    }
+#endif
+
+private:
+
+    static double freqToMel( const double f ) {
+
+        return 1125.0 * log( 1.0 + f / 700.0 );
+    }
+
+    /** @brief upper bound of the weights of maxBins filters. A point is inside at most two of the
+     *         half-overlapping filters, and the padding adds up to 3 points per filter.
+     */
+    static int maxNumWeights( const int maxBins ) {
+
+        return 2 * cNumPoints + 3 * maxBins;
+    }
+
+    const int   mMaxBins;
+    int         mNumBins;
+    const float mMinFreq;
+    const float mMaxFreq;
+    const float mSampleRate;
+    int*        mStart;    // first power spectrum point of each filter
+    int*        mLength;   // number of points of each filter, a multiple of 4
+    int*        mOffset;   // offset of the weights of each filter in mWeights
+    float*      mWeights;
+};
+
+/** @brief constant-Q transform from the points of the 512-point FFT of the frame, after Brown and
+ *         Puckette. Each constant-Q bin is the dot product of the FFT points with the spectrum of its
+ *         temporal kernel, a Hamming-windowed complex sinusoid of Q periods centered in the frame.
+ *         The spectral kernels are sparse, and only the span of points above cKernelThreshold of the
+ *         peak is kept per bin, zero-padded to a multiple of 4 like FbankFilterBank and up to
+ *         cMaxLength points, so that the kernels fit in storage laid out in the arena up front.
+ *
+ *         The kernels are at most one frame long, i.e., bins below Q * sampleRate / frameSize
+ *         (about 670Hz for 400 samples @ 16KHz and 12 bins per octave) would be wider in frequency
+ *         than the constant Q, so the first bin should be above it. The frame arrives windowed and
+ *         pre-emphasized, so the kernels are normalized by the product of the frame window and their
+ *         own window and undo the pre-emphasis gain at their center frequencies. The magnitude of a
+ *         sinusoid at the center of a bin is its amplitude.
+ */
+class ConstantQKernel {
+
+public:
+    static constexpr int   cNumPoints       = 256;  // points of the lower half of the 512-point FFT
+    static constexpr int   cMaxLength       = 64;   // points kept per kernel, 56 for the 34 samples of 7.9KHz
+    static constexpr float cKernelThreshold = 0.01; // relative to the peak of each spectral kernel
+
+    /** @brief constructor. No kernels until build().
+     *
+     *  @param arena         : arena for the kernels, arenaBytes( numBins ) or more
+     *  @param numBins       : number of constant-Q bins
+     *  @param binsPerOctave : bins per octave, 12 for semitones
+     *  @param minFreq       : center frequency of the first bin in Hz
+     *  @param sampleRate    : sample rate in Hz
+     */
+    ConstantQKernel(
+        AlignedArena& arena,
+        const int     numBins,
+        const int     binsPerOctave,
+        const float   minFreq,
+        const float   sampleRate
+    )
+        :mNumBins      ( numBins       )
+        ,mBinsPerOctave( binsPerOctave )
+        ,mMinFreq      ( minFreq       )
+        ,mSampleRate   ( sampleRate    )
+        ,mBuilt        ( false         )
+    {
+        mStart     = arena.allocate< int   >( mNumBins );
+        mLength    = arena.allocate< int   >( mNumBins );
+        mWeightsRe = arena.allocate< float >( mNumBins * cMaxLength );
+        mWeightsIm = arena.allocate< float >( mNumBins * cMaxLength );
+    }
+
+    static size_t arenaBytes( const int numBins ) {
+
+        return   2 * AlignedArena::bytesFor< int   >( numBins )
+               + 2 * AlignedArena::bytesFor< float >( numBins * cMaxLength );
+    }
+
+    /** @brief computes the kernels in place for the window and the pre-emphasis of the frames.
+     *         It runs numBins() FFTs on scratch of its own from the heap, so call it off the
+     *         real-time thread.
+     *
+     *  @param frameWindow  : window applied to the frame before the FFT, frameSize coefficients
+     *  @param frameSize    : number of samples in one frame
+     *  @param preemphCoeff : pre-emphasis coefficient applied to the frame, 0.0 for none
+     */
+    void build( const float* frameWindow, const int frameSize, const float preemphCoeff ) {
+
+        AlignedArena arena( FFT512::arenaBytes() + 4 * AlignedArena::bytesFor< float >( 512 ) );
+        FFT512       fft( arena );
+        float*       kernelRe   = arena.allocate< float >( 512 );
+        float*       kernelIm   = arena.allocate< float >( 512 );
+        float*       spectrumRe = arena.allocate< float >( 512 );
+        float*       spectrumIm = arena.allocate< float >( 512 );
+
+        for ( int k = 0; k < mNumBins; k++ ) {
+
+            makeKernelSpectrum( fft, k, frameWindow, frameSize, preemphCoeff,
+                                kernelRe, kernelIm, spectrumRe, spectrumIm );
+            float peak = 0.0;
+            for ( int i = 0; i < cNumPoints; i++ ) {
+                peak = std::max( peak, spectrumRe[ i ] * spectrumRe[ i ] + spectrumIm[ i ] * spectrumIm[ i ] );
+            }
+
+            const float threshold = cKernelThreshold * cKernelThreshold * peak;
+
+            int first = -1;
+            int last  = -1;
+            for ( int i = 0; i < cNumPoints; i++ ) {
+                if ( spectrumRe[ i ] * spectrumRe[ i ] + spectrumIm[ i ] * spectrumIm[ i ] >= threshold ) {
+                    first = ( first == -1 ) ? i : first;
+                    last  = i;
+                }
+            }
+
+            int length = ( first == -1 ) ? 0 : ( ( last - first + 4 ) / 4 ) * 4;
+
+            // Only the kernels shorter than about 30 samples span more, trimmed evenly on both sides.
+            if ( length > cMaxLength ) {
+                first += ( length - cMaxLength ) / 2;
+                length = cMaxLength;
+            }
+
+            mStart [ k ] = std::max( 0, std::min( first, cNumPoints - length ) );
+            mLength[ k ] = length;
+
+            // Parseval: sum_n x[n] conj( t[n] ) = sum_i X[i] conj( T[i] ) / 512.
+            for ( int j = 0; j < length; j++ ) {
+                mWeightsRe[ k * cMaxLength + j ] = spectrumRe[ mStart[ k ] + j ] / 512.0;
+                mWeightsIm[ k * cMaxLength + j ] = spectrumIm[ mStart[ k ] + j ] / 512.0;
+            }
+        }
+        mBuilt = true;
+    }
+
+    bool         built()               const { return mBuilt;                          }
+    int          numBins()             const { return mNumBins;                        }
+    int          binsPerOctave()       const { return mBinsPerOctave;                  }
+    int          start    ( int k )    const { return mStart[ k ];                     }
+    int          length   ( int k )    const { return mLength[ k ];                    }
+    const float* weightsRe( int k )    const { return &mWeightsRe[ k * cMaxLength ];   }
+    const float* weightsIm( int k )    const { return &mWeightsIm[ k * cMaxLength ];   }
+
+    /** @brief powers of the constant-Q bins.
+     *
+     *  @param re    : (in)  real parts of the lower 256 points of the 512-point FFT
+     *  @param im    : (in)  imaginary parts of them
+     *  @param power : (out) numBins() powers
+     */
+    void findPowers_cpp( const float* re, const float* im, float* power ) const {
+
+        for ( int k = 0; k < mNumBins; k++ ) {
+
+            const float* wr    = weightsRe( k );
+            const float* wi    = weightsIm( k );
+            const float* xr    = &re[ mStart[ k ] ];
+            const float* xi    = &im[ mStart[ k ] ];
+            float        sumRe = 0.0;
+            float        sumIm = 0.0;
+
+            for ( int j = 0; j < mLength[ k ]; j++ ) {
+                sumRe += xr[ j ] * wr[ j ] + xi[ j ] * wi[ j ];
+                sumIm += xi[ j ] * wr[ j ] - xr[ j ] * wi[ j ];
+            }
+            power[ k ] = sumRe * sumRe + sumIm * sumIm;
+        }
+    }
+
+#ifdef HAVE_NEON
+    void findPowers_neon( const float* re, const float* im, float* power ) const {
+
+        for ( int k = 0; k < mNumBins; k += 4 ) {
+
+            float sums[ 4 ];
+
+            for ( int l = 0; l < 4; l++ ) {
+
+                float32x4_t accRe = vdupq_n_f32( 0.0 );
+                float32x4_t accIm = vdupq_n_f32( 0.0 );
+
+                if ( k + l < mNumBins ) {
+                    const float* wr = weightsRe( k + l );
+                    const float* wi = weightsIm( k + l );
+                    const float* xr = &re[ mStart[ k + l ] ];
+                    const float* xi = &im[ mStart[ k + l ] ];
+                    for ( int j = 0; j < mLength[ k + l ]; j += 4 ) {
+
+                        const float32x4_t r  = vld1q_f32( &xr[ j ] );
+                        const float32x4_t i  = vld1q_f32( &xi[ j ] );
+                        const float32x4_t cr = vld1q_f32( &wr[ j ] );
+                        const float32x4_t ci = vld1q_f32( &wi[ j ] );
+                        accRe = vmlaq_f32( vmlaq_f32( accRe, r, cr ), i, ci );
+                        accIm = vmlsq_f32( vmlaq_f32( accIm, i, cr ), r, ci );
+                    }
+                }
+                const float32x2_t re2 = vadd_f32( vget_low_f32( accRe ), vget_high_f32( accRe ) );
+                const float32x2_t im2 = vadd_f32( vget_low_f32( accIm ), vget_high_f32( accIm ) );
+                const float32x2_t sum = vpadd_f32( re2, im2 ); // ( re, im )
+                const float32x2_t sq  = vmul_f32( sum, sum );
+                sums[ l ] = vget_lane_f32( vpadd_f32( sq, sq ), 0 );
+            }
+
+            if ( k + 4 <= mNumBins ) {
+                vst1q_f32( &power[ k ], vld1q_f32( sums ) );
+            }
+            else {
+                for ( int l = 0; k + l < mNumBins; l++ ) {
+                    power[ k + l ] = sums[ l ];
+                }
+            }
+        }
+    }
+#endif
+
+    /** @brief chroma, i.e., the powers summed per pitch class over the octaves and scaled to the
+     *         maximum of 1. Pitch class 0 is the one of the first bin. All zero if no pitch class
+     *         reaches the floor.
+     *
+     *  @param power  : (in)  numBins() powers of findPowers_*()
+     *  @param floor  : floor of the pitch class powers
+     *  @param chroma : (out) binsPerOctave() values
+     */
+    void findChroma( const float* power, const float floor, float* chroma ) const {
+
+        for ( int p = 0; p < mBinsPerOctave; p++ ) {
+            chroma[ p ] = 0.0;
+        }
+        for ( int k = 0; k < mNumBins; k++ ) {
+            chroma[ k % mBinsPerOctave ] += power[ k ];
+        }
+
+        float peak = 0.0;
+        for ( int p = 0; p < mBinsPerOctave; p++ ) {
+            peak = std::max( peak, chroma[ p ] );
+        }
+
+        const float scale = ( peak < floor ) ? 0.0f : 1.0f / peak;
+        for ( int p = 0; p < mBinsPerOctave; p++ ) {
+            chroma[ p ] *= scale;
+        }
+    }
+
+private:
+
+    /** @brief the 512-point spectrum of the temporal kernel of bin k.
+     */
+    void makeKernelSpectrum(
+        FFT512&      fft,
+        const int    k,
+        const float* frameWindow,
+        const int    frameSize,
+        const float  preemphCoeff,
+        float*       kernelRe,
+        float*       kernelIm,
+        float*       spectrumRe,
+        float*       spectrumIm
+    ) const {
+        const double q     = 1.0 / ( pow( 2.0, 1.0 / mBinsPerOctave ) - 1.0 );
+        const double freq  = mMinFreq * pow( 2.0, (double)k / mBinsPerOctave );
+        const double omega = 2.0 * M_PI * freq / mSampleRate;
+        const int    size  = std::max( 2, std::min( (int)lround( q * mSampleRate / freq ), frameSize ) );
+        const int    first = ( frameSize - size ) / 2;
+
+        // Amplitude of the pre-emphasis 1 - a z^-1 at the center frequency.
+        const double preemphGain = sqrt( 1.0 - 2.0 * preemphCoeff * cos( omega ) + preemphCoeff * preemphCoeff );
+
+        double norm = 0.0;
+        for ( int m = 0; m < size; m++ ) {
+            norm += frameWindow[ first + m ] * ( 0.54 - 0.46 * cos( 2.0 * M_PI * m / ( size - 1 ) ) );
+        }
+        const double scale = 2.0 / ( norm * preemphGain );
+
+        memset( kernelRe, 0, sizeof(float) * 512 );
+        memset( kernelIm, 0, sizeof(float) * 512 );
+
+        for ( int m = 0; m < size; m++ ) {
+
+            const double w = scale * ( 0.54 - 0.46 * cos( 2.0 * M_PI * m / ( size - 1 ) ) );
+            kernelRe[ first + m ] = w * cos( omega * ( first + m ) );
+            kernelIm[ first + m ] = w * sin( omega * ( first + m ) );
+        }
+        fft.transform_cpp( kernelRe, kernelIm, spectrumRe, spectrumIm );
+    }
+
+    const int   mNumBins;
+    const int   mBinsPerOctave;
+    const float mMinFreq;
+    const float mSampleRate;
+    bool        mBuilt;
+    int*        mStart;     // first FFT point of each kernel
+    int*        mLength;    // number of points of each kernel, a multiple of 4
+    float*      mWeightsRe; // spectral kernels divided by 512, cMaxLength points per kernel
+    float*      mWeightsIm;
+};
+
+/** @brief F0 estimation by YIN (de Cheveigne and Kawahara) on the raw samples of the frame.
+ *         The difference function d( tau ) = e( 0 ) + e( tau ) - 2 r( tau ) needs the cross correlation
+ *         r( tau ) of the first window of the frame with the whole frame. Both are real, so they go into
+ *         one complex 512-point FFT as the real and imaginary parts, and a second FFT of the conjugated
+ *         cross spectrum gives r( tau ) for all the lags. The lags up to frameSize - window stay clear
+ *         of the circular wrap of the 512 points.
+ */
+class PitchEstimator {
+
+public:
+    static constexpr int cNumPoints = 512;
+
+    /** @brief constructor.
+     *
+     *  @param arena      : arena for the scratch, arenaBytes() or more
+     *  @param frameSize  : number of samples in one frame, up to 512
+     *  @param sampleRate : sample rate in Hz
+     *  @param minFreq    : lowest F0 in Hz. The lag is capped at half the frame.
+     *  @param maxFreq    : highest F0 in Hz
+     *  @param threshold  : absolute threshold of the cumulative mean normalized difference for voicing
+     */
+    PitchEstimator(
+        AlignedArena& arena,
+        const int     frameSize,
+        const float   sampleRate,
+        const float   minFreq,
+        const float   maxFreq,
+        const float   threshold
+    )
+        :mFrameSize ( frameSize  )
+        ,mSampleRate( sampleRate )
+        ,mThreshold ( threshold  )
+    {
+        mMaxLag = std::min( (int)ceil( sampleRate / minFreq ), frameSize / 2 );
+        mMinLag = std::max( 2, std::min( (int)floor( sampleRate / maxFreq ), mMaxLag - 1 ) );
+        mWindow = frameSize - mMaxLag;
+
+        mZRe    = arena.allocate< float >( cNumPoints );
+        mZIm    = arena.allocate< float >( cNumPoints );
+        mSRe    = arena.allocate< float >( cNumPoints );
+        mSIm    = arena.allocate< float >( cNumPoints );
+        mEnergy = arena.allocate< float >( frameSize + 1 );
+        mCMNDF  = arena.allocate< float >( frameSize / 2 + 1 );
+    }
+
+    /** @brief arena bytes taken by an instance.
+     */
+    static size_t arenaBytes( const int frameSize ) {
+
+        return   4 * AlignedArena::bytesFor< float >( cNumPoints )
+               +     AlignedArena::bytesFor< float >( frameSize + 1 )
+               +     AlignedArena::bytesFor< float >( frameSize / 2 + 1 );
+    }
+
+    int minLag() const { return mMinLag; }
+    int maxLag() const { return mMaxLag; }
+
+    /** @brief estimates F0 of one frame.
+     *
+     *  @param fft        : FFT engine of the pipeline, used for the two transforms
+     *  @param samples    : (in)  frameSize raw samples
+     *  @param f0         : (out) F0 in Hz, 0.0 if unvoiced
+     *  @param confidence : (out) 1 - the normalized difference at the chosen lag, in [ 0, 1 ]
+     */
+    void estimate_cpp( FFT512& fft, const float* samples, float& f0, float& confidence ) {
+
+        packFrame( samples );
+        fft.transform_cpp( mZRe, mZIm, mSRe, mSIm );
+
+        // Conjugated cross spectrum conj( X * conj( Y ) ) of x = Re( z ) and y = Im( z ).
+        for ( int k = 0; k < cNumPoints; k++ ) {
+
+            const int   n  = ( cNumPoints - k ) & ( cNumPoints - 1 );
+            const float xr = 0.5 * ( mSRe[ k ] + mSRe[ n ] );
+            const float xi = 0.5 * ( mSIm[ k ] - mSIm[ n ] );
+            const float yr = 0.5 * ( mSIm[ k ] + mSIm[ n ] );
+            const float yi = 0.5 * ( mSRe[ n ] - mSRe[ k ] );
+
+            mZRe[ k ] =   xr * yr + xi * yi;
+            mZIm[ k ] = -( xi * yr - xr * yi );
+        }
+        fft.transform_cpp( mZRe, mZIm, mSRe, mSIm );
+
+        findEnergies( samples );
+
+        const float e0    = mEnergy[ mWindow ];
+        const float scale = 2.0 / cNumPoints;
+
+        for ( int tau = 1; tau <= mMaxLag; tau++ ) {
+            mCMNDF[ tau ] = e0 + ( mEnergy[ tau + mWindow ] - mEnergy[ tau ] ) - scale * mSRe[ tau ];
+        }
+        pickLag( f0, confidence );
+    }
+
+#ifdef HAVE_NEON
+    void estimate_neon( FFT512& fft, const float* samples, float& f0, float& confidence ) {
+
+        packFrame( samples );
+        fft.transform_neon( mZRe, mZIm, mSRe, mSIm );
+
+        // Points 0 to 3 pair with 0, 511, 510 and 509, which do not form one reversed vector.
+        for ( int k = 0; k < 4; k++ ) {
+
+            const int   n  = ( cNumPoints - k ) & ( cNumPoints - 1 );
+            const float xr = 0.5 * ( mSRe[ k ] + mSRe[ n ] );
+            const float xi = 0.5 * ( mSIm[ k ] - mSIm[ n ] );
+            const float yr = 0.5 * ( mSIm[ k ] + mSIm[ n ] );
+            const float yi = 0.5 * ( mSRe[ n ] - mSRe[ k ] );
+
+            mZRe[ k ] =   xr * yr + xi * yi;
+            mZIm[ k ] = -( xi * yr - xr * yi );
+        }
+        for ( int k = 4; k < cNumPoints; k += 4 ) {
+
+            const float32x4_t ar = vld1q_f32( &mSRe[ k ] );
+            const float32x4_t ai = vld1q_f32( &mSIm[ k ] );
+            float32x4_t       br = vrev64q_f32( vld1q_f32( &mSRe[ cNumPoints - k - 3 ] ) );
+            float32x4_t       bi = vrev64q_f32( vld1q_f32( &mSIm[ cNumPoints - k - 3 ] ) );
+            br = vcombine_f32( vget_high_f32( br ), vget_low_f32( br ) );
+            bi = vcombine_f32( vget_high_f32( bi ), vget_low_f32( bi ) );
+
+            const float32x4_t xr = vmulq_n_f32( vaddq_f32( ar, br ), 0.5 );
+            const float32x4_t xi = vmulq_n_f32( vsubq_f32( ai, bi ), 0.5 );
+            const float32x4_t yr = vmulq_n_f32( vaddq_f32( ai, bi ), 0.5 );
+            const float32x4_t yi = vmulq_n_f32( vsubq_f32( br, ar ), 0.5 );
+
+            vst1q_f32( &mZRe[ k ], vmlaq_f32( vmulq_f32( xr, yr ), xi, yi ) );
+            vst1q_f32( &mZIm[ k ], vmlsq_f32( vmulq_f32( xr, yi ), xi, yr ) );
+        }
+        fft.transform_neon( mZRe, mZIm, mSRe, mSIm );
+
+        findEnergies( samples );
+
+        const float32x4_t e0    = vdupq_n_f32( mEnergy[ mWindow ] );
+        const float       scale = 2.0 / cNumPoints;
+
+        int tau = 1;
+        for ( ; tau + 4 <= mMaxLag + 1; tau += 4 ) {
+
+            const float32x4_t eTau = vsubq_f32( vld1q_f32( &mEnergy[ tau + mWindow ] ), vld1q_f32( &mEnergy[ tau ] ) );
+            vst1q_f32( &mCMNDF[ tau ], vmlsq_n_f32( vaddq_f32( e0, eTau ), vld1q_f32( &mSRe[ tau ] ), scale ) );
+        }
+        for ( ; tau <= mMaxLag; tau++ ) {
+            mCMNDF[ tau ] = mEnergy[ mWindow ] + ( mEnergy[ tau + mWindow ] - mEnergy[ tau ] ) - scale * mSRe[ tau ];
+        }
+        pickLag( f0, confidence );
+    }
+#endif
+
+private:
+
+    /** @brief the frame in the real part and its first window in the imaginary part, zero padded.
+     */
+    void packFrame( const float* samples ) {
+
+        memcpy( mZRe, samples, sizeof(float) * mFrameSize );
+        memset( &mZRe[ mFrameSize ], 0, sizeof(float) * ( cNumPoints - mFrameSize ) );
+        memcpy( mZIm, samples, sizeof(float) * mWindow );
+        memset( &mZIm[ mWindow ], 0, sizeof(float) * ( cNumPoints - mWindow ) );
+    }
+
+    /** @brief running sums of the squared samples. mEnergy[ i ] is the sum up to sample i - 1.
+     */
+    void findEnergies( const float* samples ) {
+
+        double sum = 0.0;
+        mEnergy[ 0 ] = 0.0;
+        for ( int i = 0; i < mFrameSize; i++ ) {
+            sum += (double)samples[ i ] * samples[ i ];
+            mEnergy[ i + 1 ] = sum;
+        }
+    }
+
+    /** @brief turns the difference function in mCMNDF into the cumulative mean normalized one,
+     *         and picks the first dip below the threshold, or the deepest one if none.
+     */
+    void pickLag( float& f0, float& confidence ) {
+
+        double sum = 0.0;
+        mCMNDF[ 0 ] = 1.0;
+        for ( int tau = 1; tau <= mMaxLag; tau++ ) {
+
+            const float d = std::max( mCMNDF[ tau ], 0.0f );
+            sum += d;
+            mCMNDF[ tau ] = ( sum > 0.0 ) ? d * tau / sum : 1.0;
+        }
+
+        int  best   = mMinLag;
+        bool voiced = false;
+        for ( int tau = mMinLag; tau <= mMaxLag; tau++ ) {
+
+            if ( mCMNDF[ tau ] < mThreshold ) {
+                while ( tau + 1 <= mMaxLag && mCMNDF[ tau + 1 ] < mCMNDF[ tau ] ) {
+                    tau++;
+                }
+                best   = tau;
+                voiced = true;
+                break;
+            }
+            if ( mCMNDF[ tau ] < mCMNDF[ best ] ) {
+                best = tau;
+            }
+        }
+
+        // Parabolic interpolation around the dip.
+        float lag = best;
+        if ( best > 1 && best < mMaxLag ) {
+
+            const float a     = mCMNDF[ best - 1 ];
+            const float b     = mCMNDF[ best     ];
+            const float c     = mCMNDF[ best + 1 ];
+            const float denom = a - 2.0f * b + c;
+            if ( denom > 0.0f ) {
+                lag += std::max( -1.0f, std::min( 0.5f * ( a - c ) / denom, 1.0f ) );
+            }
+        }
+
+        confidence = std::max( 0.0f, std::min( 1.0f - mCMNDF[ best ], 1.0f ) );
+        f0         = voiced ? mSampleRate / lag : 0.0f;
+    }
+
+    const int   mFrameSize;
+    const float mSampleRate;
+    const float mThreshold;
+    int         mMinLag;
+    int         mMaxLag;
+    int         mWindow;  // samples compared at each lag, frameSize - mMaxLag
+
+    float*      mZRe;     // [ cNumPoints ] packed frame, then the cross spectrum
+    float*      mZIm;     // [ cNumPoints ]
+    float*      mSRe;     // [ cNumPoints ] spectrum, then the cross correlation times cNumPoints
+    float*      mSIm;     // [ cNumPoints ]
+    float*      mEnergy;  // [ frameSize + 1 ]
+    float*      mCMNDF;   // [ frameSize / 2 + 1 ]
+};
+
+/** @brief IEEE 754 binary32 to binary16 with round to nearest even.
+ *         Branch-free formulation so that the NEON version below gives the same bits.
+ */
+static inline uint16_t floatToHalf( const float v ) {
+
+    const uint32_t f32Infinity  = 255u << 23;
+    const uint32_t f16Max       = ( 127u + 16u ) << 23;
+    const uint32_t denormMagic  = ( ( 127u - 15u ) + ( 23u - 10u ) + 1u ) << 23;
+    const uint32_t minNormal    = 113u << 23;
+
+    uint32_t f;
+    memcpy( &f, &v, sizeof(uint32_t) );
+
+    const uint32_t sign = f & 0x80000000u;
+    f ^= sign;
+
+    uint16_t o;
+    if ( f >= f16Max ) {
+        o = ( f > f32Infinity ) ? 0x7e00 : 0x7c00; // NaN or Inf
+    }
+    else if ( f < minNormal ) {
+        float denorm, magic;
+        memcpy( &denorm, &f,           sizeof(float) );
+        memcpy( &magic,  &denormMagic, sizeof(float) );
+        denorm += magic;
+        uint32_t d;
+        memcpy( &d, &denorm, sizeof(uint32_t) );
+        o = (uint16_t)( d - denormMagic );
+    }
+    else {
+        const uint32_t mantOdd = ( f >> 13 ) & 1;
+        f += ( ( 15u - 127u ) << 23 ) + 0xfff;
+        f += mantOdd;
+        o = (uint16_t)( f >> 13 );
+    }
+    return (uint16_t)( o | ( sign >> 16 ) );
+}
+
+/** @brief quantizes to int8 by round half away from zero and saturation. NaN quantizes as 0.0,
+ *         i.e., to zeroPoint. Saturated in float before the conversion to int, which is undefined
+ *         for NaN and out-of-range values, in the same steps as floatToInt8Wide_neon().
+ */
+static inline int8_t floatToInt8( const float v, const float invScale, const int zeroPoint ) {
+
+    const float lo     = (float)( -128 - zeroPoint );
+    const float hi     = (float)(  127 - zeroPoint );
+    float       scaled = v * invScale;
+
+    scaled = ( scaled == scaled ) ? scaled : 0.0f;
+    scaled = std::min( std::max( scaled, lo ), hi );
+    return (int8_t)( (int)( scaled + ( scaled >= 0.0f ? 0.5f : -0.5f ) ) + zeroPoint );
+}
+
+#ifdef HAVE_NEON
+static inline uint16x4_t floatToHalf_neon( const float32x4_t v ) {
+
+    const uint32x4_t f32Infinity = vdupq_n_u32( 255u << 23 );
+    const uint32x4_t f16Max      = vdupq_n_u32( ( 127u + 16u ) << 23 );
+    const uint32x4_t denormMagic = vdupq_n_u32( ( ( 127u - 15u ) + ( 23u - 10u ) + 1u ) << 23 );
+    const uint32x4_t minNormal   = vdupq_n_u32( 113u << 23 );
+
+    uint32x4_t       f    = vreinterpretq_u32_f32( v );
+    const uint32x4_t sign = vandq_u32( f, vdupq_n_u32( 0x80000000u ) );
+    f = veorq_u32( f, sign );
+
+    // NaN or Inf
+    const uint32x4_t isNaN    = vcgtq_u32( f, f32Infinity );
+    const uint32x4_t infOrNaN = vbslq_u32( isNaN, vdupq_n_u32( 0x7e00 ), vdupq_n_u32( 0x7c00 ) );
+
+    // Subnormal
+    const float32x4_t denormF = vaddq_f32( vreinterpretq_f32_u32( f ), vreinterpretq_f32_u32( denormMagic ) );
+    const uint32x4_t  denorm  = vsubq_u32( vreinterpretq_u32_f32( denormF ), denormMagic );
+
+    // Normal
+    const uint32x4_t mantOdd = vandq_u32( vshrq_n_u32( f, 13 ), vdupq_n_u32( 1 ) );
+    uint32x4_t       normal  = vaddq_u32( f, vdupq_n_u32( ( ( 15u - 127u ) << 23 ) + 0xfff ) );
+    normal = vshrq_n_u32( vaddq_u32( normal, mantOdd ), 13 );
+
+    const uint32x4_t isSubnormal = vcgtq_u32( minNormal, f );
+    const uint32x4_t isOverflow  = vcgeq_u32( f, f16Max );
+
+    uint32x4_t o = vbslq_u32( isSubnormal, denorm,   normal );
+    o            = vbslq_u32( isOverflow,  infOrNaN, o      );
+    o            = vorrq_u32( o, vshrq_n_u32( sign, 16 ) );
+
+    return vmovn_u32( o );
+}
+
+static inline int16x4_t floatToInt8Wide_neon( const float32x4_t v, const float invScale, const int zeroPoint ) {
+
+    const float32x4_t lo     = vdupq_n_f32( (float)( -128 - zeroPoint ) );
+    const float32x4_t hi     = vdupq_n_f32( (float)(  127 - zeroPoint ) );
+    float32x4_t       scaled = vmulq_n_f32( v, invScale );
+
+    // NaN fails the comparison with itself and becomes 0.0. Then saturated as in floatToInt8().
+    scaled = vreinterpretq_f32_u32( vandq_u32( vceqq_f32( scaled, scaled ), vreinterpretq_u32_f32( scaled ) ) );
+    scaled = vminq_f32( vmaxq_f32( scaled, lo ), hi );
+
+    const uint32x4_t  isNeg   = vcltq_f32( scaled, vdupq_n_f32( 0.0f ) );
+    const float32x4_t half    = vbslq_f32( isNeg, vdupq_n_f32( -0.5f ), vdupq_n_f32( 0.5f ) );
+    const int32x4_t   rounded = vaddq_s32( vcvtq_s32_f32( vaddq_f32( scaled, half ) ), vdupq_n_s32( zeroPoint ) );
+
+    // Within int8 already. The caller narrows it with vqmovn_s16.
+    return vmovn_s32( rounded );
+}
+#endif
+
+
+/** @brief output stages of the pipeline write the features through one of these,
+ *         so that the conversion to the output format happens in the same SIMD loop.
+ */
+class FeatureWriterFloat {
+
+public:
+    FeatureWriterFloat( float* out ) :mOut( out ) {;}
+
+    void write( const int i, const float v ) { mOut[ i ] = v; }
+
+#ifdef HAVE_NEON
+    void write4( const int i, const float32x4_t v ) { vst1q_f32( &mOut[ i ], v ); }
+#endif
+
+private:
+    float* mOut;
+};
+
+
+class FeatureWriterFP16 {
+
+public:
+    FeatureWriterFP16( uint16_t* out ) :mOut( out ) {;}
+
+    void write( const int i, const float v ) { mOut[ i ] = floatToHalf( v ); }
+
+#ifdef HAVE_NEON
+    void write4( const int i, const float32x4_t v ) { vst1_u16( &mOut[ i ], floatToHalf_neon( v ) ); }
+#endif
+
+private:
+    uint16_t* mOut;
+};
+
+
+class FeatureWriterInt8 {
+
+public:
+    /** @brief q = round( v / scale ) + zeroPoint, saturated to int8.
+     */
+    FeatureWriterInt8( int8_t* out, const float scale, const int zeroPoint )
+        :mOut      ( out         )
+        ,mInvScale ( 1.0f / scale )
+        ,mZeroPoint( zeroPoint   ) {;}
+
+    void write( const int i, const float v ) { mOut[ i ] = floatToInt8( v, mInvScale, mZeroPoint ); }
+
+#ifdef HAVE_NEON
+    void write4( const int i, const float32x4_t v ) {
+
+        const int16x4_t wide   = floatToInt8Wide_neon( v, mInvScale, mZeroPoint );
+        const int8x8_t  narrow = vqmovn_s16( vcombine_s16( wide, wide ) );
+        const uint32_t  packed = vget_lane_u32( vreinterpret_u32_s8( narrow ), 0 );
+        memcpy( &mOut[ i ], &packed, sizeof(uint32_t) );
+    }
+#endif
+
+private:
+    int8_t* mOut;
+    float   mInvScale;
+    int     mZeroPoint;
+};
+
+
+class DCT {
+
+public:
+
+    /** @brief constructor. it pre-calculates a table.
+     *
+     *  @param numPoints : number of points in the input.
+     */
+    DCT ( AlignedArena& arena, const int numPoints )
+        :mArena     ( arena   )
+        ,mOwnedTable( nullptr )
+    {
+        mNumPoints = numPoints;
+        mNumPointsRoundUp4 = ((mNumPoints + 3) / 4) * 4;
+        mNumOutputsRoundUp4 = ((mNumPoints + 4) / 4) * 4;
+        configure( 0.0, false );
+
+    }
+
+    /** @brief arena bytes taken by an instance: a table for a non-default configuration.
+     */
+    static size_t arenaBytes( const int numPoints ) {
+
+        return AlignedArena::bytesFor< float >( tableSize( numPoints ) );
+    }
+
+    /** @brief sets the cepstral lifter and the scaling of output 0. The lifter weights are
+     *         folded into the rows of the table, so liftering costs nothing per frame.
+     *
+     *  @param cepstralLifter : L of the lifter weights 1 + L/2 sin( pi i / L ). 0 for none.
+     *  @param orthonormal    : true  - output 0 scaled by sqrt( 1/N ) as Kaldi
+     *                          false - sqrt( 2/N ) as the other outputs
+     */
+    void configure( const float cepstralLifter, const bool orthonormal ) {
+
+#ifndef MFCC_RUNTIME_TABLES
+        if ( mNumPoints == cTableDCTNumPoints && cepstralLifter == 0.0 && !orthonormal ) {
+            mDCTTable = cTableDCT;
+            return;
+        }
+#endif
+        if ( mOwnedTable == nullptr ) {
+            mOwnedTable = mArena.allocate< float >( mNumOutputsRoundUp4 * mNumPointsRoundUp4 );
+        }
+        makeDCTTable( mOwnedTable, mNumPoints, cepstralLifter, orthonormal );
+        mDCTTable = mOwnedTable;
+    }
+
+    /** @brief fills the table of ( numPoints + 1 ) rows of numPoints coefficients, both rounded
+     *         up to a multiple of 4 with zeros.
+     *
+     *  @param table          : (out) tableSize( numPoints ) coefficients
+     *  @param numPoints      : number of points in the input
+     *  @param cepstralLifter : as configure()
+     *  @param orthonormal    : as configure()
+     */
+    static void makeDCTTable( float* table, const int numPoints, const float cepstralLifter, const bool orthonormal ) {
+
+        const int numPointsRoundUp4 = ((numPoints + 3) / 4) * 4;
+
+        // Redundant memory padded with zero for 4-lane SIMD operations on 4 rows at a time.
+        memset ( table, 0, sizeof(float) * tableSize( numPoints ) );
+
+        const float C  = sqrt( 2.0 / numPoints );
+        const float C0 = orthonormal ? sqrt( 1.0 / numPoints ) : C;
+
+        for ( int i = 0; i <= numPoints; i++ ) {
+
+            const double lifter = ( cepstralLifter != 0.0 ) ? 1.0 + 0.5 * cepstralLifter * sin( M_PI * i / cepstralLifter ) : 1.0;
+            const double rowC   = ( i == 0 ? C0 : C ) * lifter;
+
+            for (int j = 0; j < numPoints; j++ ) {
+
+                const float di = (float)i ;
+                const float dj = (float)j + 0.5 ;
+                table[ numPointsRoundUp4 * i + j ] = rowC * cos( M_PI * di * dj / (float)numPoints );
+            }
+        }
+    }
+
+    static int tableSize( const int numPoints ) {
+
+        return ( ( numPoints + 4 ) / 4 ) * 4 * ( ( numPoints + 3 ) / 4 ) * 4;
+    }
+
+    /** @brief number of output points, i.e., numPoints + 1.
+     */
+    int numOutputs() const { return mNumPoints + 1; }
+
+
+    /** @brief main function for DCT
+     *  @param samples_in  : (in)  time domain samples
+     *  @param samples_out : (out) freq-domain samples
+     */
+    void transform_cpp( const float* const samples_in, float* const samples_out ) const {
+
+        FeatureWriterFloat writer( samples_out );
+        transform_cpp( samples_in, writer, mNumPoints + 1 );
+    }
+
+    /** @brief main function for DCT with output conversion
+     *  @param samples_in  : (in)  time domain samples
+     *  @param writer      : (out) freq-domain samples through FeatureWriter*
+     *  @param numOutputs  : only the first numOutputs points are computed. Up to numOutputs().
+     */
+    template< class Writer >
+    void transform_cpp( const float* const samples_in, Writer& writer, const int numOutputs ) const {
+
+        for ( int i = 0; i < numOutputs ; i++ ) {
+
+            float val = 0.0;
+
+            for ( int j = 0; j < mNumPoints; j++ ) {
+
+                val += mDCTTable[ mNumPointsRoundUp4 * i + j ] * samples_in[ j ];
+            }
+
+            writer.write( i, val );
+        }
+    }
+
+#ifdef HAVE_NEON
+    void transform_neon( const float* const samples_in, float* const samples_out ) const {
+
+        FeatureWriterFloat writer( samples_out );
+        transform_neon( samples_in, writer, mNumPoints + 1 );
+    }
+
+    /** @brief 4 output points at a time so that the writer gets a whole vector.
+     */
+    template< class Writer >
+    void transform_neon( const float* const samples_in, Writer& writer, const int numOutputs ) const {
+
+        for ( int i = 0; i < numOutputs ; i += 4 ) {
+
+            float32x4_t sumQuadF0 = vdupq_n_f32(0.0);
+            float32x4_t sumQuadF1 = vdupq_n_f32(0.0);
+            float32x4_t sumQuadF2 = vdupq_n_f32(0.0);
+            float32x4_t sumQuadF3 = vdupq_n_f32(0.0);
+
+            // The table is from the arena or the aligned generated one, and the rows are multiples of 4 long.
+            const float* const row = assumeAligned16( &( mDCTTable[ mNumPointsRoundUp4 * i ] ) );
+
+            for ( int j = 0; j < mNumPointsRoundUp4; j+=4 ) {
+
+                float32x4_t cur_sample = vld1q_f32( &( samples_in[j] ) );
+                sumQuadF0 = vmlaq_f32( sumQuadF0, vld1q_f32( &( row[                          j ] ) ), cur_sample );
+                sumQuadF1 = vmlaq_f32( sumQuadF1, vld1q_f32( &( row[ mNumPointsRoundUp4     + j ] ) ), cur_sample );
+                sumQuadF2 = vmlaq_f32( sumQuadF2, vld1q_f32( &( row[ mNumPointsRoundUp4 * 2 + j ] ) ), cur_sample );
+                sumQuadF3 = vmlaq_f32( sumQuadF3, vld1q_f32( &( row[ mNumPointsRoundUp4 * 3 + j ] ) ), cur_sample );
+            }
+
+            // Horizontal sums of the 4 rows into one vector.
+            const float32x2_t pair0 = vpadd_f32( vget_low_f32( sumQuadF0 ), vget_high_f32( sumQuadF0 ) );
+            const float32x2_t pair1 = vpadd_f32( vget_low_f32( sumQuadF1 ), vget_high_f32( sumQuadF1 ) );
+            const float32x2_t pair2 = vpadd_f32( vget_low_f32( sumQuadF2 ), vget_high_f32( sumQuadF2 ) );
+            const float32x2_t pair3 = vpadd_f32( vget_low_f32( sumQuadF3 ), vget_high_f32( sumQuadF3 ) );
+            const float32x4_t vals  = vcombine_f32( vpadd_f32( pair0, pair1 ), vpadd_f32( pair2, pair3 ) );
+
+            if ( i + 4 <= numOutputs ) {
+                writer.write4( i, vals );
+            }
+            else {
+                for ( int k = 0; i + k < numOutputs; k++ ) {
+                    writer.write( i + k, vgetq_lane_f32( vals, k ) );
+                }
+            }
+        }
+    }
+#endif
+
+    /** @brief coefficient of output point i for input point j, for the multi-frame kernels.
+     */
+    float coeff( const int i, const int j ) const { return mDCTTable[ mNumPointsRoundUp4 * i + j ]; }
+
+private:
+
+    AlignedArena& mArena;
+    int           mNumPoints;
+    int           mNumPointsRoundUp4;
+    int           mNumOutputsRoundUp4;
+    float*        mOwnedTable;   // non-default configurations
+    const float*  mDCTTable;
+};
+
+
+/** @brief noise suppression by spectral subtraction on the power spectrum, between the FFT and the
+ *         Mel filter banks. The noise power of each point is tracked across frames: the first
+ *         cInitFrames frames are averaged, and then the estimate follows the power down quickly and
+ *         up slowly, so that it settles on the floor between the words rather than on the speech.
+ *         That puts it below the mean noise power, around 0.3 of it for white Gaussian noise with
+ *         the default rates, which the default over-subtraction makes up for. The power is reduced
+ *         by overSubtraction times the estimate and floored at spectralFloor times the original
+ *         power, which keeps the musical noise of plain subtraction down.
+ *         The state is in the arena, and process_*() works in place without allocation.
+ */
+class SpectralSubtractor {
+
+public:
+    static constexpr int   cInitFrames             = 10;    // 100[ms] @ 10[ms] shift
+    static constexpr float cDefaultOverSubtraction = 3.0;
+    static constexpr float cDefaultSpectralFloor   = 0.05;
+    static constexpr float cDefaultRiseRate        = 0.005; // per frame, about 2[s] @ 10[ms] shift
+    static constexpr float cDefaultFallRate        = 0.1;
+
+    /** @brief constructor
+     *
+     *  @param arena     : arena for the noise estimate, arenaBytes() or more
+     *  @param numPoints : points of the power spectrum, a multiple of 4
+     */
+    SpectralSubtractor( AlignedArena& arena, const int numPoints )
+        :mNumPoints( numPoints )
+        ,mNumFrames( 0 )
+    {
+        mNoise = arena.allocate< float >( mNumPoints );
+        setParameters( cDefaultOverSubtraction, cDefaultSpectralFloor, cDefaultRiseRate, cDefaultFallRate );
+    }
+
+    static size_t arenaBytes( const int numPoints ) {
+
+        return AlignedArena::bytesFor< float >( numPoints );
+    }
+
+    /** @brief sets the subtraction and the tracking of the noise.
+     *
+     *  @param overSubtraction : multiple of the noise estimate subtracted from the power (usually 1.0 to 4.0)
+     *  @param spectralFloor   : lower bound of the result relative to the power         (usually 0.01 to 0.1)
+     *  @param riseRate        : per-frame smoothing of the estimate toward a higher power
+     *  @param fallRate        : per-frame smoothing of the estimate toward a lower power
+     */
+    void setParameters(
+        const float overSubtraction,
+        const float spectralFloor,
+        const float riseRate,
+        const float fallRate
+    ) {
+        mOverSubtraction = overSubtraction;
+        mSpectralFloor   = spectralFloor;
+        mRiseRate        = riseRate;
+        mFallRate        = fallRate;
+    }
+
+    /** @brief starts tracking the noise over, e.g., for a new stream.
+     */
+    void reset() { mNumFrames = 0; }
+
+    const float* noise() const { return mNoise; }
+
+    /** @brief updates the noise estimate with the frame and subtracts it.
+     *
+     *  @param power : (in/out) numPoints powers
+     */
+    void process_cpp( float* power ) {
+
+        if ( mNumFrames < cInitFrames ) {
+
+            const float w = 1.0f / ( mNumFrames + 1 );
+            for ( int i = 0; i < mNumPoints; i++ ) {
+                mNoise[ i ] += w * ( power[ i ] - mNoise[ i ] );
+            }
+            mNumFrames++;
+        }
+        else {
+            for ( int i = 0; i < mNumPoints; i++ ) {
+
+                const float rate = ( power[ i ] < mNoise[ i ] ) ? mFallRate : mRiseRate;
+                mNoise[ i ] += rate * ( power[ i ] - mNoise[ i ] );
+            }
+        }
+
+        for ( int i = 0; i < mNumPoints; i++ ) {
+            power[ i ] = std::max( power[ i ] - mOverSubtraction * mNoise[ i ], mSpectralFloor * power[ i ] );
+        }
+    }
+
+#ifdef HAVE_NEON
+    void process_neon( float* power ) {
+
+        const bool        init     = ( mNumFrames < cInitFrames );
+        const float32x4_t initRate = vdupq_n_f32( init ? 1.0f / ( mNumFrames + 1 ) : 0.0f );
+        const float32x4_t fallRate = vdupq_n_f32( mFallRate );
+        const float32x4_t riseRate = vdupq_n_f32( mRiseRate );
+
+        for ( int i = 0; i < mNumPoints; i += 4 ) {
+
+            const float32x4_t pwr   = vld1q_f32( &power [ i ] );
+            float32x4_t       noise = vld1q_f32( &mNoise[ i ] );
+            const float32x4_t r     = init ? initRate : vbslq_f32( vcltq_f32( pwr, noise ), fallRate, riseRate );
+
+            noise = vmlaq_f32( noise, r, vsubq_f32( pwr, noise ) );
+            vst1q_f32( &mNoise[ i ], noise );
+            vst1q_f32( &power [ i ], vmaxq_f32( vmlsq_n_f32( pwr, noise, mOverSubtraction ), vmulq_n_f32( pwr, mSpectralFloor ) ) );
+        }
+        if ( init ) {
+            mNumFrames++;
+        }
+    }
+#endif
+
+private:
+
+    const int mNumPoints;
+    int       mNumFrames;       // frames averaged into the initial estimate, up to cInitFrames
+    float*    mNoise;           // [ mNumPoints ] noise power estimate
+    float     mOverSubtraction;
+    float     mSpectralFloor;
+    float     mRiseRate;
+    float     mFallRate;
+};
+
+class VoiceActivityDetector {
+
+public:
+    static constexpr float cFullScale       = 32768.0;
+    static constexpr float cWeakEnergyRatio = 0.25;  // unvoiced frames may be this much quieter if ZCR is high.
+
+    /** @brief constructor
+     *
+     *  @param frameSizeSamples          : number of samples in one input frame           (usually 400)
+     *  @param energyThresholdDB         : frame energy threshold in dB full scale       (usually around -50.0)
+     *  @param zeroCrossingRateThreshold : zero crossings per sample for unvoiced frames  (usually around 0.25)
+     *  @param hangoverFrames            : frames kept active after the last active one  (usually around 8)
+     */
+    VoiceActivityDetector(
+        const int   frameSizeSamples,
+        const float energyThresholdDB,
+        const float zeroCrossingRateThreshold,
+        const int   hangoverFrames
+    )
+        :mFrameSizeSamples( frameSizeSamples )
+        ,mHangoverCounter ( 0 )
+    {
+        setParameters( energyThresholdDB, zeroCrossingRateThreshold, hangoverFrames );
+    }
+
+    void setParameters(
+        const float energyThresholdDB,
+        const float zeroCrossingRateThreshold,
+        const int   hangoverFrames
+    ) {
+        // Compare mean-square energy in linear scale to avoid log10() per frame.
+        mEnergyThreshold       = cFullScale * cFullScale * pow( 10.0, energyThresholdDB / 10.0 );
+        mZeroCrossingThreshold = (int)( zeroCrossingRateThreshold * (float)( mFrameSizeSamples - 1 ) );
+        mHangoverFrames        = hangoverFrames;
+        mHangoverCounter       = 0;
+    }
+
+    void reset() { mHangoverCounter = 0; }
+
+    /** @brief classifies one frame of raw samples. Updates the hangover state.
+     *
+     *  @param samples : (in) raw time domain samples whose length is frameSizeSamples
+     *  @return true if the frame is considered to contain voice activity.
+     */
+    bool isActive_cpp( const float* const samples ) {
+
+        float sum       = 0.0;
+        float sumSq     = 0.0;
+        int   crossings = 0;
+
+        for ( int i = 0; i < mFrameSizeSamples; i++ ) {
+            sum   += samples[ i ];
+            sumSq += samples[ i ] * samples[ i ];
+        }
+
+        for ( int i = 1; i < mFrameSizeSamples; i++ ) {
+            if ( samples[ i ] * samples[ i - 1 ] < 0.0 ) {
+                crossings++;
+            }
+        }
+
+        return decide( sum, sumSq, crossings );
+    }
+
+#ifdef HAVE_NEON
+    bool isActive_neon( const float* const samples ) {
+
+        float32x4_t sumQuadF   = vdupq_n_f32( 0.0 );
+        float32x4_t sumSqQuadF = vdupq_n_f32( 0.0 );
+        uint32x4_t  crossQuadU = vdupq_n_u32( 0 );
+        const uint32x4_t one   = vdupq_n_u32( 1 );
+        const float32x4_t zero = vdupq_n_f32( 0.0 );
+
+        const int numQuadSamples = ( mFrameSizeSamples / 4 ) * 4;
+
+        for ( int i = 0; i < numQuadSamples; i += 4 ) {
+
+            const float32x4_t cur = vld1q_f32( &samples[ i ] );
+            sumQuadF   = vaddq_f32( sumQuadF, cur );
+            sumSqQuadF = vmlaq_f32( sumSqQuadF, cur, cur );
+        }
+
+        // Sign changes between consecutive samples. The last lane group stops at mFrameSizeSamples - 1.
+        for ( int i = 1; i + 4 <= mFrameSizeSamples; i += 4 ) {
+
+            const float32x4_t cur   = vld1q_f32( &samples[ i     ] );
+            const float32x4_t prev  = vld1q_f32( &samples[ i - 1 ] );
+            const uint32x4_t  isNeg = vcltq_f32( vmulq_f32( cur, prev ), zero );
+            crossQuadU = vaddq_u32( crossQuadU, vandq_u32( isNeg, one ) );
+        }
+
+        float sum   = vgetq_lane_f32( sumQuadF,   0 ) + vgetq_lane_f32( sumQuadF,   1 )
+                    + vgetq_lane_f32( sumQuadF,   2 ) + vgetq_lane_f32( sumQuadF,   3 );
+        float sumSq = vgetq_lane_f32( sumSqQuadF, 0 ) + vgetq_lane_f32( sumSqQuadF, 1 )
+                    + vgetq_lane_f32( sumSqQuadF, 2 ) + vgetq_lane_f32( sumSqQuadF, 3 );
+        int crossings = vgetq_lane_u32( crossQuadU, 0 ) + vgetq_lane_u32( crossQuadU, 1 )
+                      + vgetq_lane_u32( crossQuadU, 2 ) + vgetq_lane_u32( crossQuadU, 3 );
+
+        // Remainder of the sums for frames that are not a multiple of 4 samples.
+        for ( int i = numQuadSamples; i < mFrameSizeSamples; i++ ) {
+            sum   += samples[ i ];
+            sumSq += samples[ i ] * samples[ i ];
+        }
+
+        // Remainder of the crossing count, 3 pairs for a 400-sample frame.
+        for ( int i = ( ( mFrameSizeSamples - 1 ) / 4 ) * 4 + 1; i < mFrameSizeSamples; i++ ) {
+            if ( samples[ i ] * samples[ i - 1 ] < 0.0 ) {
+                crossings++;
+            }
+        }
+
+        return decide( sum, sumSq, crossings );
+    }
+#endif
+
+private:
+
+    bool decide( const float sum, const float sumSq, const int crossings ) {
+
+        // Mean-square energy around the mean, so that DC offset of the mic does not count as activity.
+        const float N      = (float)mFrameSizeSamples;
+        const float mean   = sum / N;
+        const float energy = sumSq / N - mean * mean;
+
+        const bool active =    ( energy > mEnergyThreshold )
+                            || (    ( energy    > mEnergyThreshold * cWeakEnergyRatio )
+                                 && ( crossings > mZeroCrossingThreshold             ) );
+        if ( active ) {
+            mHangoverCounter = mHangoverFrames;
+            return true;
+        }
+        else if ( mHangoverCounter > 0 ) {
+            mHangoverCounter--;
+            return true;
+        }
+        return false;
+    }
+
+    const int mFrameSizeSamples;
+    float     mEnergyThreshold;
+    int       mZeroCrossingThreshold;
+    int       mHangoverFrames;
+    int       mHangoverCounter;
+};
+
+
+class MFCC {
+
+public:
+
+    static constexpr float cSampleRate              = 16000.0;
+    static constexpr int   cFrameSizeSamples        = 400;     // 25[ms] @ 16KHz
+    static constexpr int   cFrameShiftSamples       = 160;     // 10[ms] @ 16KHz
+    static constexpr int   cNumPointsFFT            = 512;
+    static constexpr float cPreemphTap0             = 0.96;
+    static constexpr float cFilterBankMaxFreq       = 8000.0;
+    static constexpr float cFilterBankMinFreq       = 300.0;
+    static constexpr int   cNumFilterBanks          = 26;
+    static constexpr int   cNumFilterBankssRoundUp4 = 28;
+    static constexpr int   cNumMFCCAndPowerSpectrum = 27 + 256;
+
+    // Outputs of generateFeatures_*() as a bit mask.
+    static constexpr unsigned int cOutputMFCC        = 1 << 0; // 27 MFCCs
+    static constexpr unsigned int cOutputLogSpectrum = 1 << 1; // 256-point log10 power spectrum / 10
+    static constexpr unsigned int cOutputLogMel      = 1 << 2; // 26 natural log Mel filter bank energies
+    static constexpr unsigned int cOutputFbank       = 1 << 3; // numFbankBins() natural log Mel energies without DCT
+    static constexpr unsigned int cOutputCQT         = 1 << 4; // cNumCQTBins natural log constant-Q powers
+    static constexpr unsigned int cOutputChroma      = 1 << 5; // cNumChromaBins pitch class profile scaled to max 1
+    static constexpr unsigned int cOutputPitch       = 1 << 6; // F0 in Hz (0 if unvoiced) and voicing confidence
+
+    // Number of MFCCs in bits 8-15 of the outputs, see outputNumCepstra(). 0 for all the 27.
+    static constexpr int          cOutputNumCepstraShift = 8;
+    static constexpr unsigned int cOutputNumCepstraMask  = 0xffu << 8;
+
+    // Number of fbank bins in bits 16-23 of the outputs, see outputNumFbankBins(). 0 for cDefaultFbankBins.
+    static constexpr int          cOutputNumFbankBinsShift = 16;
+    static constexpr unsigned int cOutputNumFbankBinsMask  = 0xffu << 16;
+    static constexpr int          cDefaultFbankBins        = 40;
+    static constexpr int          cMaxFbankBins            = 128;
+    static constexpr float        cFbankMinFreq            = 20.0;
+    static constexpr float        cFbankMaxFreq            = 8000.0;
+
+    // Constant-Q bins in semitones over 3 octaves from C6 for cOutputCQT and cOutputChroma. See ConstantQKernel.
+    // C6 is the first C above the 673Hz whose kernel of Q periods fills the frame. B8 is 7.9KHz.
+    static constexpr int          cCQTBinsPerOctave        = 12;
+    static constexpr int          cNumCQTBins              = 36;
+    static constexpr float        cCQTMinFreq              = 1046.502261;
+    static constexpr int          cNumChromaBins           = cCQTBinsPerOctave;
+
+    // YIN search range and voicing threshold for cOutputPitch. See PitchEstimator.
+    static constexpr int          cNumPitchFeatures        = 2;
+    static constexpr float        cPitchMinFreq            = 80.0;
+    static constexpr float        cPitchMaxFreq            = 500.0;
+    static constexpr float        cPitchThreshold          = 0.15;
+
+    // Upper bound of numFeatures() for any outputs.
+    static constexpr int          cMaxNumFeatures = cNumFilterBanks + 1 + cNumPointsFFT / 2 + cNumFilterBanks + cMaxFbankBins
+                                                  + cNumCQTBins + cNumChromaBins + cNumPitchFeatures;
+    static constexpr float cVADEnergyThresholdDB    = -50.0;
+    static constexpr float cVADZeroCrossingRate     = 0.25;
+    static constexpr int   cVADHangoverFrames       = 8;       // 80[ms] @ 10[ms] shift
+    static constexpr float cInt8MFCCScale           = 1.0;     // MFCC in [-128, 127]
+    static constexpr float cInt8SpectrumScale       = 1.5 / 255.0; // Spectrum in [0, 1.5]
+    static constexpr int   cInt8SpectrumZeroPoint   = -128;
+
+    /** @brief constructor. The tables and scratch buffers of the instance are laid out in one
+     *         arena of arenaBytes().
+     *
+     *  @param pool : arena shared by many instances to carve the arena from, or nullptr
+     *                for an allocation of its own
+     */
+    explicit MFCC( AlignedArena* pool = nullptr )
+        :mArena( pool, arenaBytes() )
+        ,mHammingWindow( mArena, cFrameSizeSamples, cPreemphTap0 )
+        ,mFFT512( mArena )
+        ,mPrunedFFT512( mArena, cFrameSizeSamples )
+        ,mUsePrunedFFT( false )
+        ,mMelFilterBanks( mArena )
+        ,mDCT( mArena, cNumFilterBanks )
+        ,mPitch( mArena, cFrameSizeSamples, cSampleRate, cPitchMinFreq, cPitchMaxFreq, cPitchThreshold )
+        ,mSpectralSubtractor( mArena, cNumPointsFFT / 2 )
+        ,mUseSpectralSubtraction( false )
+        ,mVAD( cFrameSizeSamples, cVADEnergyThresholdDB, cVADZeroCrossingRate, cVADHangoverFrames )
+        ,mVADEmitsSilence( true )
+        ,mInt8MFCCScale         ( cInt8MFCCScale         )
+        ,mInt8MFCCZeroPoint     ( 0                      )
+        ,mInt8SpectrumScale     ( cInt8SpectrumScale     )
+        ,mInt8SpectrumZeroPoint ( cInt8SpectrumZeroPoint )
+        ,mFbank                 ( mArena, cMaxFbankBins, cFbankMinFreq, cFbankMaxFreq, cSampleRate )
+        ,mConstantQ             ( mArena, cNumCQTBins, cCQTBinsPerOctave, cCQTMinFreq, cSampleRate )
+    {
+        // Zero filled by the arena. The tails of the windowed samples and the Mel bins stay zero.
+        mWindowedSamples_re = mArena.allocate< float >( cNumPointsFFT            );
+        mWindowedSamples_im = mArena.allocate< float >( cNumPointsFFT            );
+        mFFT512_re          = mArena.allocate< float >( cNumPointsFFT            );
+        mFFT512_im          = mArena.allocate< float >( cNumPointsFFT            );
+        mPowerSpectrum      = mArena.allocate< float >( cNumPointsFFT / 2        );
+        mMelFilterBankBins  = mArena.allocate< float >( cNumFilterBankssRoundUp4 );
+        mConstantQPower     = mArena.allocate< float >( cNumCQTBins              );
+
+        mFrontEnd = FrontEndParameters::original();
+        mMelFloor = MelFilterBanks::cMelFloor;
+        mFirstMelPoint = mMelFilterBanks.firstPoint();
+        makeSilenceFeatures();
+    }
+
+    /** @brief bytes of the arena of an instance, e.g., to size a pool for many instances.
+     */
+    static size_t arenaBytes() {
+
+        return   HammingWindow::arenaBytes( cFrameSizeSamples )
+               + FFT512::arenaBytes()
+               + PrunedFFT512::arenaBytes()
+               + MelFilterBanks::arenaBytes()
+               + DCT::arenaBytes( cNumFilterBanks )
+               + PitchEstimator::arenaBytes( cFrameSizeSamples )
+               + SpectralSubtractor::arenaBytes( cNumPointsFFT / 2 )
+               + FbankFilterBank::arenaBytes( cMaxFbankBins )
+               + ConstantQKernel::arenaBytes( cNumCQTBins )
+               + 4 * AlignedArena::bytesFor< float >( cNumPointsFFT )
+               +     AlignedArena::bytesFor< float >( cNumPointsFFT / 2 )
+               +     AlignedArena::bytesFor< float >( cNumFilterBankssRoundUp4 )
+               +     AlignedArena::bytesFor< float >( cNumCQTBins );
+    }
+
+    /** @brief number of floats written by generateFeatures_*() for the given outputs.
+     *
+     *  @param outputs : bitwise OR of cOutput*
+     */
+    static int numFeatures( const unsigned int outputs ) {
+
+        return   ( ( outputs & cOutputMFCC        ) ? numCepstra( outputs ) : 0 )
+               + ( ( outputs & cOutputLogSpectrum ) ? cNumPointsFFT / 2   : 0 )
+               + ( ( outputs & cOutputLogMel      ) ? cNumFilterBanks     : 0 )
+               + ( ( outputs & cOutputFbank       ) ? numFbankBins( outputs ) : 0 )
+               + ( ( outputs & cOutputCQT         ) ? cNumCQTBins         : 0 )
+               + ( ( outputs & cOutputChroma      ) ? cNumChromaBins      : 0 )
+               + ( ( outputs & cOutputPitch       ) ? cNumPitchFeatures   : 0 );
+    }
+
+    /** @brief bits to OR into the outputs to get only the first numCepstra MFCCs. The DCT computes
+     *         only those, e.g., cOutputMFCC | outputNumCepstra( 13 ) for 13 MFCCs.
+     */
+    static unsigned int outputNumCepstra( const int numCepstra ) {
+
+        return ( (unsigned int)numCepstra << cOutputNumCepstraShift ) & cOutputNumCepstraMask;
+    }
+
+    /** @brief number of MFCCs generated for the outputs.
+     */
+    static int numCepstra( const unsigned int outputs ) {
+
+        const int n = (int)( ( outputs & cOutputNumCepstraMask ) >> cOutputNumCepstraShift );
+        return ( n == 0 || n > cNumFilterBanks + 1 ) ? cNumFilterBanks + 1 : n;
+    }
+
+    /** @brief bits to OR into the outputs for numBins fbank bins, e.g., cOutputFbank | outputNumFbankBins( 80 ).
+     */
+    static unsigned int outputNumFbankBins( const int numBins ) {
+
+        return ( (unsigned int)numBins << cOutputNumFbankBinsShift ) & cOutputNumFbankBinsMask;
+    }
+
+    /** @brief number of fbank bins generated for the outputs.
+     */
+    static int numFbankBins( const unsigned int outputs ) {
+
+        int n = (int)( ( outputs & cOutputNumFbankBinsMask ) >> cOutputNumFbankBinsShift );
+        if ( n == 0 ) {
+            n = cDefaultFbankBins;
+        }
+        if ( n > cMaxFbankBins ) {
+            n = cMaxFbankBins;
+        }
+        return n;
+    }
+
+    /** @brief 64-bit FNV-1a hash of the pipeline configuration and the outputs. Stored with
+     *         the features so that features from a different configuration are not mixed up.
+     *
+     *  @param outputs : bitwise OR of cOutput*
+     */
+    static uint64_t configHash( const unsigned int outputs ) {
+
+        return hashParams( outputs, nullptr, 0 );
+    }
+
+    /** @brief configHash() including the front end options. Same as configHash( outputs )
+     *         for the original front end.
+     */
+    static uint64_t configHash( const unsigned int outputs, const FrontEndParameters& frontEnd ) {
+
+        if ( !frontEnd.compatible ) {
+            return hashParams( outputs, nullptr, 0 );
+        }
+        const float frontEndParams[] = {
+            (float)frontEnd.windowType,
+            frontEnd.removeDCOffset ? 1.0f : 0.0f,
+            frontEnd.dither,
+            frontEnd.preemphCoeff,
+            frontEnd.useEnergy ? 1.0f : 0.0f,
+            frontEnd.rawEnergy ? 1.0f : 0.0f,
+            frontEnd.cepstralLifter,
+            frontEnd.orthonormalDCT ? 1.0f : 0.0f,
+            frontEnd.melFloor
+        };
+        return hashParams( outputs, frontEndParams, sizeof(frontEndParams) / sizeof(float) );
+    }
+
+    /** @brief sets the front end options. The original front end by default.
+     *         MFCCBatch4 and MFCCFixedPoint always run the original front end.
+     */
+    void setFrontEndParameters( const FrontEndParameters& params ) {
+
+        mFrontEnd = params;
+        mMelFloor = MelFilterBanks::cMelFloor;
+
+        if ( params.compatible ) {
+            mMelFloor = params.melFloor;
+            mHammingWindow.setWindowType( params.windowType );
+            mDCT.configure( params.cepstralLifter, params.orthonormalDCT );
+        }
+        else {
+            mHammingWindow.setWindowType( FrontEndParameters::cWindowHamming );
+            mDCT.configure( 0.0, false );
+        }
+        mDither.reseed( 1 );
+        makeSilenceFeatures();
+
+        // The constant-Q kernels depend on the window and the pre-emphasis.
+        if ( mConstantQ.built() ) {
+            buildConstantQ();
+        }
+    }
+
+    const FrontEndParameters& frontEndParameters() const { return mFrontEnd; }
+
+    /** @brief builds the fbank filter bank and the constant-Q kernels the outputs need, in the
+     *         arena, on the caller's thread. Otherwise the first frame with the outputs builds them,
+     *         and the constant-Q kernels take cNumCQTBins FFTs and heap scratch. Call it where the
+     *         outputs are chosen, before the frames come from a real-time thread.
+     *         setFrontEndParameters() rebuilds the kernels it built.
+     *
+     *  @param outputs : bitwise OR of cOutput*
+     */
+    void prepareOutputs( const unsigned int outputs ) {
+
+        if ( outputs & cOutputFbank ) {
+            fbank( numFbankBins( outputs ) );
+        }
+        if ( outputs & ( cOutputCQT | cOutputChroma ) ) {
+            constantQ();
+        }
+    }
+
+    /** @brief switches generateFeatures_*() to PrunedFFT512, which skips the butterflies on the
+     *         zero padding and, if only MFCC and log Mel are requested, the points below the
+     *         lowest Mel filter. Off by default. The results agree with FFT512 up to rounding.
+     */
+    void setPrunedFFT( const bool pruned ) { mUsePrunedFFT = pruned; }
+
+    bool prunedFFT() const { return mUsePrunedFFT; }
+
+    /** @brief switches on the spectral subtraction of the tracked noise from the power spectrum
+     *         before the Mel filter banks, which also applies to the log spectrum and fbank outputs.
+     *         Off by default. The noise tracking starts over. MFCCBatch4 does not run it, as its
+     *         lanes need not belong to one stream.
+     *
+     *  @param enabled         : true to subtract
+     *  @param overSubtraction : multiple of the noise estimate subtracted
+     *  @param spectralFloor   : lower bound of the result relative to the power
+     */
+    void setSpectralSubtraction(
+        const bool  enabled,
+        const float overSubtraction = SpectralSubtractor::cDefaultOverSubtraction,
+        const float spectralFloor   = SpectralSubtractor::cDefaultSpectralFloor
+    ) {
+        mUseSpectralSubtraction = enabled;
+        mSpectralSubtractor.setParameters( overSubtraction, spectralFloor,
+                                           SpectralSubtractor::cDefaultRiseRate, SpectralSubtractor::cDefaultFallRate );
+        mSpectralSubtractor.reset();
+    }
+
+    bool spectralSubtraction() const { return mUseSpectralSubtraction; }
+
+    /** @brief starts the noise tracking over, e.g., at the start of a new stream.
+     */
+    void resetNoiseEstimate() { mSpectralSubtractor.reset(); }
+
+private:
+
+    /** @brief the log spectrum, fbank and constant-Q outputs use all the points, MFCC and log Mel
+     *         only the Mel filter range.
+     */
+    int firstPointNeeded( const unsigned int outputs ) const {
+
+        return ( outputs & ( cOutputLogSpectrum | cOutputFbank | cOutputCQT | cOutputChroma ) ) ? 0 : mFirstMelPoint;
+    }
+
+    static uint64_t hashParams( const unsigned int outputs, const float* extra, const int numExtra ) {
+
+        const float params[] = {
+            cSampleRate,
+            (float)cFrameSizeSamples,
+            (float)cFrameShiftSamples,
+            (float)cNumPointsFFT,
+            cPreemphTap0,
+            cFilterBankMaxFreq,
+            cFilterBankMinFreq,
+            (float)cNumFilterBanks,
+            (float)outputs
+        };
+        const uint8_t* bytes = reinterpret_cast< const uint8_t* >( params );
+
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for ( size_t i = 0; i < sizeof(params); i++ ) {
+            h = ( h ^ bytes[ i ] ) * 0x100000001b3ULL;
+        }
+
+        const uint8_t* extraBytes = reinterpret_cast< const uint8_t* >( extra );
+        for ( size_t i = 0; i < sizeof(float) * numExtra; i++ ) {
+            h = ( h ^ extraBytes[ i ] ) * 0x100000001b3ULL;
+        }
+
+        if ( outputs & cOutputFbank ) {
+
+            const float fbankParams[] = { cFbankMinFreq, cFbankMaxFreq };
+            const uint8_t* fbankBytes = reinterpret_cast< const uint8_t* >( fbankParams );
+
+            for ( size_t i = 0; i < sizeof(fbankParams); i++ ) {
+                h = ( h ^ fbankBytes[ i ] ) * 0x100000001b3ULL;
+            }
+        }
+
+        if ( outputs & ( cOutputCQT | cOutputChroma ) ) {
+
+            const float cqtParams[] = { cCQTMinFreq, (float)cCQTBinsPerOctave, (float)cNumCQTBins };
+            const uint8_t* cqtBytes = reinterpret_cast< const uint8_t* >( cqtParams );
+
+            for ( size_t i = 0; i < sizeof(cqtParams); i++ ) {
+                h = ( h ^ cqtBytes[ i ] ) * 0x100000001b3ULL;
+            }
+        }
+
+        if ( outputs & cOutputPitch ) {
+
+            const float pitchParams[] = { cPitchMinFreq, cPitchMaxFreq, cPitchThreshold };
+            const uint8_t* pitchBytes = reinterpret_cast< const uint8_t* >( pitchParams );
+
+            for ( size_t i = 0; i < sizeof(pitchParams); i++ ) {
+                h = ( h ^ pitchBytes[ i ] ) * 0x100000001b3ULL;
+            }
+        }
+        return h;
+    }
+
+    /** @brief the filter bank of the fbank output, rebuilt in place when the number of bins changes.
+     */
+    const FbankFilterBank& fbank( const int numBins ) {
+
+        if ( mFbank.numBins() != numBins ) {
+            mFbank.build( numBins );
+        }
+        return mFbank;
+    }
+
+    /** @brief the constant-Q kernels of the current window and pre-emphasis. Built here on the first
+     *         frame only if prepareOutputs() has not built them.
+     */
+    const ConstantQKernel& constantQ() {
+
+        if ( !mConstantQ.built() ) {
+            buildConstantQ();
+        }
+        return mConstantQ;
+    }
+
+    void buildConstantQ() {
+
+        const float preemph = ( mFrontEnd.compatible ) ? mFrontEnd.preemphCoeff : mHammingWindow.preEmphTap0();
+        mConstantQ.build( mHammingWindow.window(), cFrameSizeSamples, preemph );
+    }
+
+    /** @brief constant-Q and chroma outputs after the fbank ones, from the FFT points of the frame.
+     */
+    template< class Writer >
+    void writeConstantQ( const unsigned int outputs, const bool useNeon, Writer& writer ) {
+
+        const ConstantQKernel& cq = constantQ();
+#ifdef HAVE_NEON
+        if ( useNeon ) {
+            cq.findPowers_neon( mFFT512_re, mFFT512_im, mConstantQPower );
+        }
+        else {
+            cq.findPowers_cpp( mFFT512_re, mFFT512_im, mConstantQPower );
+        }
+#else
+        (void)useNeon;
+        cq.findPowers_cpp( mFFT512_re, mFFT512_im, mConstantQPower );
+#endif
+        int index = numFeatures( outputs & ( cOutputLogMel | cOutputFbank | cOutputNumFbankBinsMask ) );
+
+        if ( outputs & cOutputCQT ) {
+            for ( int k = 0; k < cNumCQTBins; k++ ) {
+                writer.write( index + k, log( std::max( mConstantQPower[ k ], mMelFloor ) ) );
+            }
+            index += cNumCQTBins;
+        }
+
+        if ( outputs & cOutputChroma ) {
+            float chroma[ cNumChromaBins ];
+            cq.findChroma( mConstantQPower, mMelFloor, chroma );
+            for ( int p = 0; p < cNumChromaBins; p++ ) {
+                writer.write( index + p, chroma[ p ] );
+            }
+        }
+    }
+
+    /** @brief features of an all-zero frame, emitted for inactive frames instead of running the pipeline.
+     */
+    void makeSilenceFeatures() {
+
+        // Without the spectral subtraction, so that the noise estimate does not see the frame, and
+        // without advancing the dither, so that the frames after it get the same dither either way.
+        const bool            useSpectralSubtraction = mUseSpectralSubtraction;
+        const DitherGenerator dither                 = mDither;
+        mUseSpectralSubtraction = false;
+
+        float silence[ cFrameSizeSamples ];
+        memset( silence, 0, sizeof(float) * cFrameSizeSamples );
+        generateMFCCAndPowerSpectrum_cpp( silence, mSilenceMFCCAndPowerSpectrum );
+
+        mUseSpectralSubtraction = useSpectralSubtraction;
+        mDither                 = dither;
+    }
+
+public:
+
+    /** @brief number of frames in numSamples consecutive samples at cFrameShiftSamples.
+     */
+    static int numFrames( const int numSamples ) {
+
+        return ( numSamples < cFrameSizeSamples ) ? 0 : ( numSamples - cFrameSizeSamples ) / cFrameShiftSamples + 1;
+    }
+
+    /** @brief generates the requested outputs from one frame. Unrequested outputs are not computed.
+     *
+     *  @param samples_real400 : time domain 400 real samples
+     *  @param outputs         : bitwise OR of cOutput*
+     *  @param features        : (out) requested outputs concatenated in the order of the bits,
+     *                                 i.e., 27 MFCCs (or numCepstra( outputs )), 256-point log power spectrum,
+     *                                 26 log Mel energies, numFbankBins( outputs ) fbank energies,
+     *                                 cNumCQTBins log constant-Q powers, cNumChromaBins chroma and then
+     *                                 F0 and voicing confidence.
+     */
+    void generateFeatures_cpp( float* samples_real400, const unsigned int outputs, float* features ) {
+
+        FeatureWriterFloat mfccWriter    ( features );
+        FeatureWriterFloat spectrumWriter( features + numFeatures( outputs & ( cOutputMFCC | cOutputNumCepstraMask ) ) );
+        FeatureWriterFloat logMelWriter  ( features + numFeatures( outputs & ( cOutputMFCC | cOutputNumCepstraMask | cOutputLogSpectrum ) ) );
+        generateFeatures_cpp( samples_real400, outputs, mfccWriter, spectrumWriter, logMelWriter );
+    }
+
+#ifdef HAVE_NEON
+    void generateFeatures_neon( float* samples_real400, const unsigned int outputs, float* features ) {
+
+        FeatureWriterFloat mfccWriter    ( features );
+        FeatureWriterFloat spectrumWriter( features + numFeatures( outputs & ( cOutputMFCC | cOutputNumCepstraMask ) ) );
+        FeatureWriterFloat logMelWriter  ( features + numFeatures( outputs & ( cOutputMFCC | cOutputNumCepstraMask | cOutputLogSpectrum ) ) );
+        generateFeatures_neon( samples_real400, outputs, mfccWriter, spectrumWriter, logMelWriter );
+    }
+#endif
+
+    /** @brief batch version of generateFeatures_*() over consecutive frames.
+     *
+     *  @param samples    : time domain samples. Frame n starts at samples[ n * cFrameShiftSamples ].
+     *  @param numSamples : number of samples. Trailing samples that do not fill a frame are not used.
+     *  @param outputs    : bitwise OR of cOutput*
+     *  @param features   : (out) numFeatures( outputs ) floats per frame, frame after frame
+     *  @return number of frames generated, i.e., numFrames( numSamples )
+     */
+    int generateFeaturesBatch_cpp( float* samples, const int numSamples, const unsigned int outputs, float* features ) {
+
+        const int frames = numFrames( numSamples );
+        const int stride = numFeatures( outputs );
+
+        for ( int i = 0; i < frames; i++ ) {
+            generateFeatures_cpp( &samples[ i * cFrameShiftSamples ], outputs, &features[ i * stride ] );
+        }
+        return frames;
+    }
+
+#ifdef HAVE_NEON
+    int generateFeaturesBatch_neon( float* samples, const int numSamples, const unsigned int outputs, float* features ) {
+
+        const int frames = numFrames( numSamples );
+        const int stride = numFeatures( outputs );
+
+        for ( int i = 0; i < frames; i++ ) {
+            generateFeatures_neon( &samples[ i * cFrameShiftSamples ], outputs, &features[ i * stride ] );
+        }
+        return frames;
+    }
+#endif
+
+    /** @brief generates spectral density in 256 points.
+     *
+     *  @param samples_real400 : time domain 400 real samples.
+     *  @return energy density at 256 points after FFT.
+     */
+    void spectralDensity_cpp( float* samples_real400, float* power_real_256 ) {
+
+        generateFeatures_cpp( samples_real400, cOutputLogSpectrum, power_real_256 );
+    }
+
+#ifdef HAVE_NEON
+    void spectralDensity_neon( float* samples_real400, float* power_real_256 ) {
+
+        generateFeatures_neon( samples_real400, cOutputLogSpectrum, power_real_256 );
+    }
+#endif
+
+    /** @brief
+     *
+     *  @param samples_real400 : time domain 400 real samples
+     *  @return real 27 MFCCs
+     */
+    void generateMFCC_cpp( float* samples_real400, float* mfcc ) {
+
+        generateFeatures_cpp( samples_real400, cOutputMFCC, mfcc );
+    }
+
+#ifdef HAVE_NEON
+    void generateMFCC_neon( float* samples_real400, float* mfcc ) {
+
+        generateFeatures_neon( samples_real400, cOutputMFCC, mfcc );
+    }
+#endif
+
+    /** @brief
+      *
+      * @param samples_real400 : time domain 400 real samples
+      * @return real 27 MFCCs and real 256-point power spectrum.
+      */
+    void generateMFCCAndPowerSpectrum_cpp( float* samples_real400, float* mfcc_fft ) {
+
+        generateFeatures_cpp( samples_real400, cOutputMFCC | cOutputLogSpectrum, mfcc_fft );
+    }
+
+    /** @brief same as above with 27 MFCCs and 256-point power spectrum in IEEE 754 half precision.
+      */
+    void generateMFCCAndPowerSpectrumFP16_cpp( float* samples_real400, uint16_t* mfcc_fft ) {
+
+        FeatureWriterFP16 mfccWriter    ( mfcc_fft      );
+        FeatureWriterFP16 spectrumWriter( mfcc_fft + 27 );
+        generateFeatures_cpp( samples_real400, cOutputMFCC | cOutputLogSpectrum, mfccWriter, spectrumWriter, spectrumWriter );
+    }
+
+    /** @brief same as above with 27 MFCCs and 256-point power spectrum quantized to int8
+      *        with the parameters given to setInt8Quantization().
+      */
+    void generateMFCCAndPowerSpectrumInt8_cpp( float* samples_real400, int8_t* mfcc_fft ) {
+
+        FeatureWriterInt8 mfccWriter    ( mfcc_fft,      mInt8MFCCScale,     mInt8MFCCZeroPoint     );
+        FeatureWriterInt8 spectrumWriter( mfcc_fft + 27, mInt8SpectrumScale, mInt8SpectrumZeroPoint );
+        generateFeatures_cpp( samples_real400, cOutputMFCC | cOutputLogSpectrum, mfccWriter, spectrumWriter, spectrumWriter );
+    }
+
+    /** @brief the pipeline. The power spectrum is computed once and shared by the Mel filter banks
+     *         and the log spectrum output. The DCT runs only if the MFCCs are requested.
+     */
+    template< class Writer >
+    void generateFeatures_cpp(
+        float*             samples_real400,
+        const unsigned int outputs,
+        Writer&            mfccWriter,
+        Writer&            spectrumWriter,
+        Writer&            logMelWriter
+    ) {
+        // 1. Pre-Emphasis & Hamming window oer 400 samples.
+        float logEnergy = 0.0;
+        if ( mFrontEnd.compatible ) {
+            logEnergy = mHammingWindow.compatibleFrontEnd_cpp( samples_real400, mWindowedSamples_re, mFrontEnd, mDither );
+        }
+        else {
+            mHammingWindow.preEmphasisHammingAndMakeComplexForFFT_cpp( samples_real400, mWindowedSamples_re );
+        }
+
+        // 2. 512 point FFT.
+        if ( mUsePrunedFFT ) {
+            mPrunedFFT512.transform_cpp( mWindowedSamples_re, firstPointNeeded( outputs ), mFFT512_re, mFFT512_im );
+        }
+        else {
+            mFFT512.transform_cpp( mWindowedSamples_re, mWindowedSamples_im,  mFFT512_re,  mFFT512_im );
+        }
+
+        // 3. Power spectrum
+        for (int i = 0; i < 256 ; i++) {
+
+            const float re = mFFT512_re[ i ];
+            const float im = mFFT512_im[ i ];
+
+            mPowerSpectrum[ i ] = re * re + im * im;
+        }
+
+        if ( mUseSpectralSubtraction ) {
+            mSpectralSubtractor.process_cpp( mPowerSpectrum );
+        }
+
+        if ( outputs & cOutputLogSpectrum ) {
+
+            for (int i = 0; i < 256 ; i++) {
+
+                spectrumWriter.write( i, std::max( 0.0, log10( mPowerSpectrum[ i ] ) / 10.0 ) );
+            }
+        }
+
+        if ( outputs & ( cOutputMFCC | cOutputLogMel ) ) {
+
+            // 4. Log Mel coefficients
+            mMelFilterBanks.findLogMelCoeffs( mPowerSpectrum, mMelFilterBankBins, mMelFloor );
+        }
+
+        if ( outputs & cOutputLogMel ) {
+
+            for ( int i = 0; i < cNumFilterBanks; i++ ) {
+
+                logMelWriter.write( i, mMelFilterBankBins[ i ] );
+            }
+        }
+
+        if ( outputs & cOutputMFCC ) {
+
+            // 5. DCT
+            mDCT.transform_cpp( mMelFilterBankBins, mfccWriter, numCepstra( outputs ) );
+
+            if ( mFrontEnd.compatible && mFrontEnd.useEnergy ) {
+                mfccWriter.write( 0, logEnergy );
+            }
+        }
+
+        if ( outputs & cOutputFbank ) {
+
+            // 6. Fbank energies right after the log Mel ones. No DCT.
+            fbank( numFbankBins( outputs ) ).findLogMelCoeffs_cpp( mPowerSpectrum, logMelWriter, mMelFloor,
+                                                                  numFeatures( outputs & cOutputLogMel ) );
+        }
+
+        if ( outputs & ( cOutputCQT | cOutputChroma ) ) {
+
+            // 7. Constant-Q and chroma from the same FFT points.
+            writeConstantQ( outputs, false, logMelWriter );
+        }
+
+        if ( outputs & cOutputPitch ) {
+
+            // 8. F0 from the raw frame through the same FFT engine.
+            float f0, confidence;
+            mPitch.estimate_cpp( mFFT512, samples_real400, f0, confidence );
+
+            const int index = numFeatures( outputs & ( cOutputLogMel | cOutputFbank | cOutputNumFbankBinsMask
+                                                     | cOutputCQT | cOutputChroma ) );
+            logMelWriter.write( index,     f0         );
+            logMelWriter.write( index + 1, confidence );
+        }
+    }
+
+#ifdef HAVE_NEON
+    void generateMFCCAndPowerSpectrum_neon( float* samples_real400, float* mfcc_fft ) {
+
+        generateFeatures_neon( samples_real400, cOutputMFCC | cOutputLogSpectrum, mfcc_fft );
+    }
+
+    void generateMFCCAndPowerSpectrumFP16_neon( float* samples_real400, uint16_t* mfcc_fft ) {
+
+        FeatureWriterFP16 mfccWriter    ( mfcc_fft      );
+        FeatureWriterFP16 spectrumWriter( mfcc_fft + 27 );
+        generateFeatures_neon( samples_real400, cOutputMFCC | cOutputLogSpectrum, mfccWriter, spectrumWriter, spectrumWriter );
+    }
+
+    void generateMFCCAndPowerSpectrumInt8_neon( float* samples_real400, int8_t* mfcc_fft ) {
+
+        FeatureWriterInt8 mfccWriter    ( mfcc_fft,      mInt8MFCCScale,     mInt8MFCCZeroPoint     );
+        FeatureWriterInt8 spectrumWriter( mfcc_fft + 27, mInt8SpectrumScale, mInt8SpectrumZeroPoint );
+        generateFeatures_neon( samples_real400, cOutputMFCC | cOutputLogSpectrum, mfccWriter, spectrumWriter, spectrumWriter );
+    }
+
+    template< class Writer >
+    void generateFeatures_neon(
+        float*             samples_real400,
+        const unsigned int outputs,
+        Writer&            mfccWriter,
+        Writer&            spectrumWriter,
+        Writer&            logMelWriter
+    ) {
+        // 1. Pre-Emphasis & Hamming window oer 400 samples.
+        float logEnergy = 0.0;
+        if ( mFrontEnd.compatible ) {
+            logEnergy = mHammingWindow.compatibleFrontEnd_neon( samples_real400, mWindowedSamples_re, mFrontEnd, mDither );
+        }
+        else {
+            mHammingWindow.preEmphasisHammingAndMakeComplexForFFT_neon( samples_real400, mWindowedSamples_re );
+        }
+
+        // 2. 512 point FFT.
+        if ( mUsePrunedFFT ) {
+            mPrunedFFT512.transform_neon( mWindowedSamples_re, firstPointNeeded( outputs ), mFFT512_re, mFFT512_im );
+        }
+        else {
+            mFFT512.transform_neon( mWindowedSamples_re, mWindowedSamples_im,  mFFT512_re,  mFFT512_im );
+        }
+
+        // 3. Power spectrum
+        for (int i = 0; i < 256 ; i += 4) {
+
+            const float32x4_t re = vld1q_f32( &mFFT512_re[ i ] );
+            const float32x4_t im = vld1q_f32( &mFFT512_im[ i ] );
+            vst1q_f32( &mPowerSpectrum[ i ], vmlaq_f32( vmulq_f32( re, re ), im, im ) );
+        }
+
+        if ( mUseSpectralSubtraction ) {
+            mSpectralSubtractor.process_neon( mPowerSpectrum );
+        }
+
+        if ( outputs & cOutputLogSpectrum ) {
+
+            for (int i = 0; i < 256 ; i += 4) {
+
+                float32x4_t logPwr = vdupq_n_f32( 0.0 );
+                logPwr = vsetq_lane_f32( log10( mPowerSpectrum[ i     ] ), logPwr, 0 );
+                logPwr = vsetq_lane_f32( log10( mPowerSpectrum[ i + 1 ] ), logPwr, 1 );
+                logPwr = vsetq_lane_f32( log10( mPowerSpectrum[ i + 2 ] ), logPwr, 2 );
+                logPwr = vsetq_lane_f32( log10( mPowerSpectrum[ i + 3 ] ), logPwr, 3 );
+
+                spectrumWriter.write4( i, vmaxq_f32( vdupq_n_f32( 0.0 ), vmulq_n_f32( logPwr, 0.1 ) ) );
+            }
+        }
+
+        if ( outputs & ( cOutputMFCC | cOutputLogMel ) ) {
+
+            // 4. Log Mel coefficients
+            mMelFilterBanks.findLogMelCoeffs( mPowerSpectrum, mMelFilterBankBins, mMelFloor );
+        }
+
+        if ( outputs & cOutputLogMel ) {
+
+            for ( int i = 0; i < cNumFilterBanks; i++ ) {
+
+                logMelWriter.write( i, mMelFilterBankBins[ i ] );
+            }
+        }
+
+        if ( outputs & cOutputMFCC ) {
+
+            // 5. DCT
+            mDCT.transform_neon( mMelFilterBankBins, mfccWriter, numCepstra( outputs ) );
+
+            if ( mFrontEnd.compatible && mFrontEnd.useEnergy ) {
+                mfccWriter.write( 0, logEnergy );
+            }
+        }
+
+        if ( outputs & cOutputFbank ) {
+
+            // 6. Fbank energies right after the log Mel ones. No DCT.
+            fbank( numFbankBins( outputs ) ).findLogMelCoeffs_neon( mPowerSpectrum, logMelWriter, mMelFloor,
+                                                                  numFeatures( outputs & cOutputLogMel ) );
+        }
+
+        if ( outputs & ( cOutputCQT | cOutputChroma ) ) {
+
+            // 7. Constant-Q and chroma from the same FFT points.
+            writeConstantQ( outputs, true, logMelWriter );
+        }
+
+        if ( outputs & cOutputPitch ) {
+
+            // 8. F0 from the raw frame through the same FFT engine.
+            float f0, confidence;
+            mPitch.estimate_neon( mFFT512, samples_real400, f0, confidence );
+
+            const int index = numFeatures( outputs & ( cOutputLogMel | cOutputFbank | cOutputNumFbankBinsMask
+                                                     | cOutputCQT | cOutputChroma ) );
+            logMelWriter.write( index,     f0         );
+            logMelWriter.write( index + 1, confidence );
+        }
+    }
+#endif
+
+    /** @brief sets the quantization of generateMFCCAndPowerSpectrumInt8_*().
+     *         q = round( v / scale ) + zeroPoint, saturated to [-128, 127].
+     *
+     *  @param mfccScale         : scale for the 27 MFCCs
+     *  @param mfccZeroPoint     : zero point for the 27 MFCCs
+     *  @param spectrumScale     : scale for the 256-point power spectrum
+     *  @param spectrumZeroPoint : zero point for the 256-point power spectrum
+     */
+    void setInt8Quantization(
+        const float mfccScale,
+        const int   mfccZeroPoint,
+        const float spectrumScale,
+        const int   spectrumZeroPoint
+    ) {
+        mInt8MFCCScale          = mfccScale;
+        mInt8MFCCZeroPoint      = mfccZeroPoint;
+        mInt8SpectrumScale      = spectrumScale;
+        mInt8SpectrumZeroPoint  = spectrumZeroPoint;
+    }
+
+    /** @brief configures the voice activity gate used by generateMFCCAndPowerSpectrumWithVAD_*().
+     *
+     *  @param energyThresholdDB         : frame energy threshold in dB full scale
+     *  @param zeroCrossingRateThreshold : zero crossings per sample for low-energy unvoiced frames
+     *  @param hangoverFrames            : number of frames kept active after the last active one
+     *  @param emitSilence               : true  - inactive frames get the cached silence features
+     *                                     false - output is left untouched for inactive frames
+     */
+    void setVADParameters(
+        const float energyThresholdDB,
+        const float zeroCrossingRateThreshold,
+        const int   hangoverFrames,
+        const bool  emitSilence
+    ) {
+        mVAD.setParameters( energyThresholdDB, zeroCrossingRateThreshold, hangoverFrames );
+        mVADEmitsSilence = emitSilence;
+    }
+
+    /** @brief same as generateMFCCAndPowerSpectrum_cpp() but the pipeline runs only on active frames.
+     *
+     *  @param samples_real400 : time domain 400 real samples
+     *  @param mfcc_fft        : (out) real 27 MFCCs and real 256-point power spectrum.
+     *  @return true if the frame is active and the pipeline has run.
+     */
+    bool generateMFCCAndPowerSpectrumWithVAD_cpp( float* samples_real400, float* mfcc_fft ) {
+
+        if ( mVAD.isActive_cpp( samples_real400 ) ) {
+            generateMFCCAndPowerSpectrum_cpp( samples_real400, mfcc_fft );
+            return true;
+        }
+        if ( mVADEmitsSilence ) {
+            memcpy( mfcc_fft, mSilenceMFCCAndPowerSpectrum, sizeof(float) * cNumMFCCAndPowerSpectrum );
+        }
+        return false;
+    }
+
+#ifdef HAVE_NEON
+    bool generateMFCCAndPowerSpectrumWithVAD_neon( float* samples_real400, float* mfcc_fft ) {
+
+        if ( mVAD.isActive_neon( samples_real400 ) ) {
+            generateMFCCAndPowerSpectrum_neon( samples_real400, mfcc_fft );
+            return true;
+        }
+        if ( mVADEmitsSilence ) {
+            memcpy( mfcc_fft, mSilenceMFCCAndPowerSpectrum, sizeof(float) * cNumMFCCAndPowerSpectrum );
+        }
+        return false;
+    }
+#endif
+
+    AlignedArena   mArena;
+    HammingWindow  mHammingWindow;
+    FFT512         mFFT512;
+    PrunedFFT512   mPrunedFFT512;
+    bool           mUsePrunedFFT;
+    MelFilterBanks mMelFilterBanks;
+    int            mFirstMelPoint;
+    DCT            mDCT;
+    PitchEstimator mPitch;
+
+    SpectralSubtractor    mSpectralSubtractor;
+    bool                  mUseSpectralSubtraction;
+
+    VoiceActivityDetector mVAD;
+    bool                  mVADEmitsSilence;
+    float                 mSilenceMFCCAndPowerSpectrum[ cNumMFCCAndPowerSpectrum ];
+
+    FrontEndParameters    mFrontEnd;
+    DitherGenerator       mDither;
+    float                 mMelFloor;
+
+    float                 mInt8MFCCScale;
+    int                   mInt8MFCCZeroPoint;
+    float                 mInt8SpectrumScale;
+    int                   mInt8SpectrumZeroPoint;
+
+    FbankFilterBank       mFbank;
+    ConstantQKernel       mConstantQ;
+
+    float* mWindowedSamples_re;   // [ cNumPointsFFT ]
+    float* mWindowedSamples_im;   // [ cNumPointsFFT ]
+    float* mFFT512_re;            // [ cNumPointsFFT ]
+    float* mFFT512_im;            // [ cNumPointsFFT ]
+    float* mPowerSpectrum;        // [ cNumPointsFFT / 2 ]
+    float* mMelFilterBankBins;    // [ cNumFilterBankssRoundUp4 ]
+    float* mConstantQPower;       // [ cNumCQTBins ]
+
+};
+
+
+/** @brief the pipeline of MFCC::generateFeatures_*() over 4 frames at a time, one frame per SIMD lane.
+ *         The frames need not be consecutive or even from the same stream, so that frames from
+ *         different streams can share one pass of the FFT, Mel and DCT kernels.
+ *         The working arrays are interleaved as [ point ][ lane ], and the twiddles, the Mel weights
+ *         and the DCT coefficients are broadcast to the 4 lanes. The FFT is an iterative radix-2 one
+ *         whose last stage only produces the 256 points used for the power spectrum.
+ *         The results agree with MFCC::generateFeatures_*() up to the rounding order.
+ */
+class MFCCBatch4 {
+
+public:
+
+    static constexpr int cNumLanes = 4;
+
+    /** @brief constructor
+     *
+     *  @param pool : arena shared by many instances to carve the arena of the window, Mel and
+     *                DCT parts from, or nullptr for an allocation of its own
+     */
+    explicit MFCCBatch4( AlignedArena* pool = nullptr )
+        :mArena( pool, arenaBytes() )
+        ,mHammingWindow( mArena, MFCC::cFrameSizeSamples, MFCC::cPreemphTap0 )
+        ,mMelFilterBanks( mArena )
+        ,mDCT( mArena, MFCC::cNumFilterBanks )
+        ,mFbank( mArena, MFCC::cMaxFbankBins, MFCC::cFbankMinFreq, MFCC::cFbankMaxFreq, MFCC::cSampleRate )
+        ,mConstantQ( mArena, MFCC::cNumCQTBins, MFCC::cCQTBinsPerOctave, MFCC::cCQTMinFreq, MFCC::cSampleRate )
+        ,mPitchArena( nullptr )
+        ,mPitchFFT( nullptr )
+        ,mPitch( nullptr )
+    {
+        makeTables();
+        memset( mZeroFrame, 0, sizeof(float) * MFCC::cFrameSizeSamples );
+    }
+
+    ~MFCCBatch4() {
+        delete mPitch;
+        delete mPitchFFT;
+        delete mPitchArena;
+    }
+
+    static size_t arenaBytes() {
+
+        return   HammingWindow::arenaBytes( MFCC::cFrameSizeSamples )
+               + MelFilterBanks::arenaBytes()
+               + DCT::arenaBytes( MFCC::cNumFilterBanks )
+               + FbankFilterBank::arenaBytes( MFCC::cMaxFbankBins )
+               + ConstantQKernel::arenaBytes( MFCC::cNumCQTBins );
+    }
+
+    /** @brief builds the fbank filter bank, the constant-Q kernels and the pitch estimator the
+     *         outputs need on the caller's thread, as MFCC::prepareOutputs() does.
+     *
+     *  @param outputs : bitwise OR of MFCC::cOutput*
+     */
+    void prepareOutputs( const unsigned int outputs ) {
+
+        if ( outputs & MFCC::cOutputFbank ) {
+            fbank( MFCC::numFbankBins( outputs ) );
+        }
+        if ( outputs & ( MFCC::cOutputCQT | MFCC::cOutputChroma ) ) {
+            constantQ();
+        }
+        if ( outputs & MFCC::cOutputPitch ) {
+            pitch();
+        }
+    }
+
+    /** @brief generates the requested outputs of up to 4 frames.
+     *
+     *  @param frames    : frames[ l ] points to the 400 samples of lane l.
+     *  @param numFrames : number of valid lanes in [ 1, 4 ]. The other lanes are not read or written.
+     *  @param outputs   : bitwise OR of MFCC::cOutput*
+     *  @param features  : (out) features[ l ] receives the features of lane l in the layout of
+     *                           MFCC::generateFeatures_*().
+     */
+    void generateFeatures_cpp(
+        const float* const* frames,
+        const int           numFrames,
+        const unsigned int  outputs,
+        float* const*       features
+    ) {
+        const float* lanes[ cNumLanes ];
+        setLanes( frames, numFrames, lanes );
+
+        // 1. Pre-Emphasis & Hamming window, stored in the bit-reversed order for the FFT.
+        const float* window = mHammingWindow.window();
+        const float  tap0   = mHammingWindow.preEmphTap0();
+
+        memset( mRe, 0, sizeof(mRe) );
+        memset( mIm, 0, sizeof(mIm) );
+
+        for ( int i = 1; i < MFCC::cFrameSizeSamples; i++ ) {
+
+            float* re = &mRe[ mBitReverse[ i ] * cNumLanes ];
+
+            for ( int l = 0; l < cNumLanes; l++ ) {
+                re[ l ] = window[ i ] * ( lanes[ l ][ i ] - tap0 * lanes[ l ][ i - 1 ] );
+            }
+        }
+
+        // 2. 512 point FFT but the last stage.
+        for ( int size = 2; size < MFCC::cNumPointsFFT; size *= 2 ) {
+
+            const int half = size / 2;
+            const int step = MFCC::cNumPointsFFT / size;
+
+            for ( int start = 0; start < MFCC::cNumPointsFFT; start += size ) {
+
+                for ( int k = 0; k < half; k++ ) {
+
+                    const float wr = mTwiddleRe[ k * step ];
+                    const float wi = mTwiddleIm[ k * step ];
+
+                    float* are = &mRe[ ( start + k        ) * cNumLanes ];
+                    float* aim = &mIm[ ( start + k        ) * cNumLanes ];
+                    float* bre = &mRe[ ( start + k + half ) * cNumLanes ];
+                    float* bim = &mIm[ ( start + k + half ) * cNumLanes ];
+
+                    for ( int l = 0; l < cNumLanes; l++ ) {
+
+                        const float tr = bre[ l ] * wr - bim[ l ] * wi;
+                        const float ti = bre[ l ] * wi + bim[ l ] * wr;
+                        bre[ l ] = are[ l ] - tr;
+                        bim[ l ] = aim[ l ] - ti;
+                        are[ l ] = are[ l ] + tr;
+                        aim[ l ] = aim[ l ] + ti;
+                    }
+                }
+            }
+        }
+
+        // 3. The last stage fused with the power spectrum of the lower 256 points.
+        for ( int k = 0; k < cNumPoints; k++ ) {
+
+            const float wr = mTwiddleRe[ k ];
+            const float wi = mTwiddleIm[ k ];
+
+            const float* are = &mRe[   k                * cNumLanes ];
+            const float* aim = &mIm[   k                * cNumLanes ];
+            const float* bre = &mRe[ ( k + cNumPoints ) * cNumLanes ];
+            const float* bim = &mIm[ ( k + cNumPoints ) * cNumLanes ];
+
+            for ( int l = 0; l < cNumLanes; l++ ) {
+
+                const float re = are[ l ] + bre[ l ] * wr - bim[ l ] * wi;
+                const float im = aim[ l ] + bre[ l ] * wi + bim[ l ] * wr;
+                mPowerSpectrum[ k * cNumLanes + l ] = re * re + im * im;
+                mSpectrumRe   [ k * cNumLanes + l ] = re;
+                mSpectrumIm   [ k * cNumLanes + l ] = im;
+            }
+        }
+
+        // 4. Log Mel coefficients
+        if ( outputs & ( MFCC::cOutputMFCC | MFCC::cOutputLogMel ) ) {
+
+            memset( mMelBins, 0, sizeof(mMelBins) );
+
+            for ( int i = 0; i < cNumPoints; i++ ) {
+
+                const float* pwr = &mPowerSpectrum[ i * cNumLanes ];
+
+                if ( mMelBin1[ i ] != -1 ) {
+                    float* bin = &mMelBins[ mMelBin1[ i ] * cNumLanes ];
+                    for ( int l = 0; l < cNumLanes; l++ ) {
+                        bin[ l ] += pwr[ l ] * mMelCoeff1[ i ];
+                    }
+                }
+                if ( mMelBin2[ i ] != -1 ) {
+                    float* bin = &mMelBins[ mMelBin2[ i ] * cNumLanes ];
+                    for ( int l = 0; l < cNumLanes; l++ ) {
+                        bin[ l ] += pwr[ l ] * mMelCoeff2[ i ];
+                    }
+                }
+            }
+
+            const float melFloor = MelFilterBanks::cMelFloor;
+
+            for ( int i = 0; i < MFCC::cNumFilterBanks * cNumLanes; i++ ) {
+                mMelBins[ i ] = log( std::max( mMelBins[ i ], melFloor ) );
+            }
+        }
+
+        // 5. DCT
+        if ( outputs & MFCC::cOutputMFCC ) {
+
+            for ( int i = 0; i < MFCC::numCepstra( outputs ); i++ ) {
+
+                float val[ cNumLanes ] = { 0.0, 0.0, 0.0, 0.0 };
+
+                for ( int j = 0; j < MFCC::cNumFilterBanks; j++ ) {
+
+                    const float c = mDCT.coeff( i, j );
+                    for ( int l = 0; l < cNumLanes; l++ ) {
+                        val[ l ] += c * mMelBins[ j * cNumLanes + l ];
+                    }
+                }
+                for ( int l = 0; l < cNumLanes; l++ ) {
+                    mMFCC[ i * cNumLanes + l ] = val[ l ];
+                }
+            }
+        }
+
+        if ( outputs & MFCC::cOutputLogSpectrum ) {
+            for ( int i = 0; i < cNumPoints * cNumLanes; i++ ) {
+                mLogSpectrum[ i ] = std::max( 0.0, log10( mPowerSpectrum[ i ] ) / 10.0 );
+            }
+        }
+
+        // 6. Fbank
+        if ( outputs & MFCC::cOutputFbank ) {
+
+            const FbankFilterBank& fb       = fbank( MFCC::numFbankBins( outputs ) );
+            const float            melFloor = MelFilterBanks::cMelFloor;
+
+            for ( int k = 0; k < fb.numBins(); k++ ) {
+
+                const float* w   = fb.weights( k );
+                const float* pwr = &mPowerSpectrum[ fb.start( k ) * cNumLanes ];
+                float        sum[ cNumLanes ] = { 0.0, 0.0, 0.0, 0.0 };
+
+                for ( int j = 0; j < fb.length( k ); j++ ) {
+                    for ( int l = 0; l < cNumLanes; l++ ) {
+                        sum[ l ] += w[ j ] * pwr[ j * cNumLanes + l ];
+                    }
+                }
+                for ( int l = 0; l < cNumLanes; l++ ) {
+                    mFbankBins[ k * cNumLanes + l ] = log( std::max( sum[ l ], melFloor ) );
+                }
+            }
+        }
+
+        // 7. Constant-Q and chroma. The kernel weights are broadcast to the lanes.
+        if ( outputs & ( MFCC::cOutputCQT | MFCC::cOutputChroma ) ) {
+
+            const ConstantQKernel& cq = constantQ();
+
+            for ( int k = 0; k < cq.numBins(); k++ ) {
+
+                const float* wr = cq.weightsRe( k );
+                const float* wi = cq.weightsIm( k );
+                const float* xr = &mSpectrumRe[ cq.start( k ) * cNumLanes ];
+                const float* xi = &mSpectrumIm[ cq.start( k ) * cNumLanes ];
+                float        sumRe[ cNumLanes ] = { 0.0, 0.0, 0.0, 0.0 };
+                float        sumIm[ cNumLanes ] = { 0.0, 0.0, 0.0, 0.0 };
+
+                for ( int j = 0; j < cq.length( k ); j++ ) {
+                    for ( int l = 0; l < cNumLanes; l++ ) {
+                        sumRe[ l ] += xr[ j * cNumLanes + l ] * wr[ j ] + xi[ j * cNumLanes + l ] * wi[ j ];
+                        sumIm[ l ] += xi[ j * cNumLanes + l ] * wr[ j ] - xr[ j * cNumLanes + l ] * wi[ j ];
+                    }
+                }
+                for ( int l = 0; l < cNumLanes; l++ ) {
+                    mConstantQPower[ k * cNumLanes + l ] = sumRe[ l ] * sumRe[ l ] + sumIm[ l ] * sumIm[ l ];
+                }
+            }
+            finishConstantQ( cq );
+        }
+
+        // 8. F0 of each frame. YIN does not interleave, so the lanes run one after another.
+        if ( outputs & MFCC::cOutputPitch ) {
+
+            PitchEstimator& pe = pitch();
+            for ( int l = 0; l < numFrames; l++ ) {
+                pe.estimate_cpp( *mPitchFFT, lanes[ l ], mPitchFeatures[ l * 2 ], mPitchFeatures[ l * 2 + 1 ] );
+            }
+        }
+
+        writeFeatures( numFrames, outputs, features );
+    }
+
+#ifdef HAVE_NEON
+    void generateFeatures_neon(
+        const float* const* frames,
+        const int           numFrames,
+        const unsigned int  outputs,
+        float* const*       features
+    ) {
+        const float* lanes[ cNumLanes ];
+        setLanes( frames, numFrames, lanes );
+
+        // 1. Pre-Emphasis & Hamming window, stored in the bit-reversed order for the FFT.
+        const float* window = mHammingWindow.window();
+        const float  tap0   = mHammingWindow.preEmphTap0();
+
+        memset( mRe, 0, sizeof(mRe) );
+        memset( mIm, 0, sizeof(mIm) );
+
+        for ( int i = 1; i < MFCC::cFrameSizeSamples; i++ ) {
+
+            float32x4_t cur  = vdupq_n_f32( 0.0 );
+            float32x4_t prev = vdupq_n_f32( 0.0 );
+            cur  = vsetq_lane_f32( lanes[ 0 ][ i     ], cur,  0 );
+            cur  = vsetq_lane_f32( lanes[ 1 ][ i     ], cur,  1 );
+            cur  = vsetq_lane_f32( lanes[ 2 ][ i     ], cur,  2 );
+            cur  = vsetq_lane_f32( lanes[ 3 ][ i     ], cur,  3 );
+            prev = vsetq_lane_f32( lanes[ 0 ][ i - 1 ], prev, 0 );
+            prev = vsetq_lane_f32( lanes[ 1 ][ i - 1 ], prev, 1 );
+            prev = vsetq_lane_f32( lanes[ 2 ][ i - 1 ], prev, 2 );
+            prev = vsetq_lane_f32( lanes[ 3 ][ i - 1 ], prev, 3 );
+
+            vst1q_f32( &mRe[ mBitReverse[ i ] * cNumLanes ], vmulq_n_f32( vmlsq_n_f32( cur, prev, tap0 ), window[ i ] ) );
+        }
+
+        // 2. 512 point FFT but the last stage.
+        for ( int size = 2; size < MFCC::cNumPointsFFT; size *= 2 ) {
+
+            const int half = size / 2;
+            const int step = MFCC::cNumPointsFFT / size;
+
+            for ( int start = 0; start < MFCC::cNumPointsFFT; start += size ) {
+
+                for ( int k = 0; k < half; k++ ) {
+
+                    const float wr = mTwiddleRe[ k * step ];
+                    const float wi = mTwiddleIm[ k * step ];
+
+                    float* are = &mRe[ ( start + k        ) * cNumLanes ];
+                    float* aim = &mIm[ ( start + k        ) * cNumLanes ];
+                    float* bre = &mRe[ ( start + k + half ) * cNumLanes ];
+                    float* bim = &mIm[ ( start + k + half ) * cNumLanes ];
+
+                    const float32x4_t ar = vld1q_f32( are );
+                    const float32x4_t ai = vld1q_f32( aim );
+                    const float32x4_t br = vld1q_f32( bre );
+                    const float32x4_t bi = vld1q_f32( bim );
+
+                    const float32x4_t tr = vmlsq_n_f32( vmulq_n_f32( br, wr ), bi, wi );
+                    const float32x4_t ti = vmlaq_n_f32( vmulq_n_f32( br, wi ), bi, wr );
+
+                    vst1q_f32( bre, vsubq_f32( ar, tr ) );
+                    vst1q_f32( bim, vsubq_f32( ai, ti ) );
+                    vst1q_f32( are, vaddq_f32( ar, tr ) );
+                    vst1q_f32( aim, vaddq_f32( ai, ti ) );
+                }
+            }
+        }
+
+        // 3. The last stage fused with the power spectrum of the lower 256 points.
+        for ( int k = 0; k < cNumPoints; k++ ) {
+
+            const float wr = mTwiddleRe[ k ];
+            const float wi = mTwiddleIm[ k ];
+
+            const float32x4_t br = vld1q_f32( &mRe[ ( k + cNumPoints ) * cNumLanes ] );
+            const float32x4_t bi = vld1q_f32( &mIm[ ( k + cNumPoints ) * cNumLanes ] );
+
+            const float32x4_t re = vaddq_f32( vld1q_f32( &mRe[ k * cNumLanes ] ), vmlsq_n_f32( vmulq_n_f32( br, wr ), bi, wi ) );
+            const float32x4_t im = vaddq_f32( vld1q_f32( &mIm[ k * cNumLanes ] ), vmlaq_n_f32( vmulq_n_f32( br, wi ), bi, wr ) );
+
+            vst1q_f32( &mPowerSpectrum[ k * cNumLanes ], vmlaq_f32( vmulq_f32( re, re ), im, im ) );
+            vst1q_f32( &mSpectrumRe   [ k * cNumLanes ], re );
+            vst1q_f32( &mSpectrumIm   [ k * cNumLanes ], im );
+        }
+
+        // 4. Log Mel coefficients
+        if ( outputs & ( MFCC::cOutputMFCC | MFCC::cOutputLogMel ) ) {
+
+            memset( mMelBins, 0, sizeof(mMelBins) );
+
+            for ( int i = 0; i < cNumPoints; i++ ) {
+
+                const float32x4_t pwr = vld1q_f32( &mPowerSpectrum[ i * cNumLanes ] );
+
+                if ( mMelBin1[ i ] != -1 ) {
+                    float* bin = &mMelBins[ mMelBin1[ i ] * cNumLanes ];
+                    vst1q_f32( bin, vmlaq_n_f32( vld1q_f32( bin ), pwr, mMelCoeff1[ i ] ) );
+                }
+                if ( mMelBin2[ i ] != -1 ) {
+                    float* bin = &mMelBins[ mMelBin2[ i ] * cNumLanes ];
+                    vst1q_f32( bin, vmlaq_n_f32( vld1q_f32( bin ), pwr, mMelCoeff2[ i ] ) );
+                }
+            }
+
+            const float32x4_t melFloor = vdupq_n_f32( MelFilterBanks::cMelFloor );
+
+            for ( int i = 0; i < MFCC::cNumFilterBanks * cNumLanes; i += 4 ) {
+
+                const float32x4_t v = vmaxq_f32( vld1q_f32( &mMelBins[ i ] ), melFloor );
+
+                mMelBins[ i     ] = log( vgetq_lane_f32( v, 0 ) );
+                mMelBins[ i + 1 ] = log( vgetq_lane_f32( v, 1 ) );
+                mMelBins[ i + 2 ] = log( vgetq_lane_f32( v, 2 ) );
+                mMelBins[ i + 3 ] = log( vgetq_lane_f32( v, 3 ) );
+            }
+        }
+
+        // 5. DCT
+        if ( outputs & MFCC::cOutputMFCC ) {
+
+            for ( int i = 0; i < MFCC::numCepstra( outputs ); i++ ) {
+
+                float32x4_t val = vdupq_n_f32( 0.0 );
+
+                for ( int j = 0; j < MFCC::cNumFilterBanks; j++ ) {
+                    val = vmlaq_n_f32( val, vld1q_f32( &mMelBins[ j * cNumLanes ] ), mDCT.coeff( i, j ) );
+                }
+                vst1q_f32( &mMFCC[ i * cNumLanes ], val );
+            }
+        }
+
+        if ( outputs & MFCC::cOutputLogSpectrum ) {
+
+            for ( int i = 0; i < cNumPoints * cNumLanes; i += 4 ) {
+
+                float32x4_t logPwr = vdupq_n_f32( 0.0 );
+                logPwr = vsetq_lane_f32( log10( mPowerSpectrum[ i     ] ), logPwr, 0 );
+                logPwr = vsetq_lane_f32( log10( mPowerSpectrum[ i + 1 ] ), logPwr, 1 );
+                logPwr = vsetq_lane_f32( log10( mPowerSpectrum[ i + 2 ] ), logPwr, 2 );
+                logPwr = vsetq_lane_f32( log10( mPowerSpectrum[ i + 3 ] ), logPwr, 3 );
+
+                vst1q_f32( &mLogSpectrum[ i ], vmaxq_f32( vdupq_n_f32( 0.0 ), vmulq_n_f32( logPwr, 0.1 ) ) );
+            }
+        }
+
+        // 6. Fbank. The weights are broadcast to the lanes.
+        if ( outputs & MFCC::cOutputFbank ) {
+
+            const FbankFilterBank& fb       = fbank( MFCC::numFbankBins( outputs ) );
+            const float32x4_t      melFloor = vdupq_n_f32( MelFilterBanks::cMelFloor );
+
+            for ( int k = 0; k < fb.numBins(); k++ ) {
+
+                const float* w   = fb.weights( k );
+                const float* pwr = &mPowerSpectrum[ fb.start( k ) * cNumLanes ];
+                float32x4_t  sum = vdupq_n_f32( 0.0 );
+
+                for ( int j = 0; j < fb.length( k ); j++ ) {
+                    sum = vmlaq_n_f32( sum, vld1q_f32( &pwr[ j * cNumLanes ] ), w[ j ] );
+                }
+                sum = vmaxq_f32( sum, melFloor );
+
+                float* out = &mFbankBins[ k * cNumLanes ];
+                out[ 0 ] = log( vgetq_lane_f32( sum, 0 ) );
+                out[ 1 ] = log( vgetq_lane_f32( sum, 1 ) );
+                out[ 2 ] = log( vgetq_lane_f32( sum, 2 ) );
+                out[ 3 ] = log( vgetq_lane_f32( sum, 3 ) );
+            }
+        }
+
+        // 7. Constant-Q and chroma. The kernel weights are broadcast to the lanes.
+        if ( outputs & ( MFCC::cOutputCQT | MFCC::cOutputChroma ) ) {
+
+            const ConstantQKernel& cq = constantQ();
+
+            for ( int k = 0; k < cq.numBins(); k++ ) {
+
+                const float* wr    = cq.weightsRe( k );
+                const float* wi    = cq.weightsIm( k );
+                const float* xr    = &mSpectrumRe[ cq.start( k ) * cNumLanes ];
+                const float* xi    = &mSpectrumIm[ cq.start( k ) * cNumLanes ];
+                float32x4_t  sumRe = vdupq_n_f32( 0.0 );
+                float32x4_t  sumIm = vdupq_n_f32( 0.0 );
+
+                for ( int j = 0; j < cq.length( k ); j++ ) {
+
+                    const float32x4_t r = vld1q_f32( &xr[ j * cNumLanes ] );
+                    const float32x4_t i = vld1q_f32( &xi[ j * cNumLanes ] );
+                    sumRe = vmlaq_n_f32( vmlaq_n_f32( sumRe, r, wr[ j ] ), i, wi[ j ] );
+                    sumIm = vmlsq_n_f32( vmlaq_n_f32( sumIm, i, wr[ j ] ), r, wi[ j ] );
+                }
+                vst1q_f32( &mConstantQPower[ k * cNumLanes ], vmlaq_f32( vmulq_f32( sumRe, sumRe ), sumIm, sumIm ) );
+            }
+            finishConstantQ( cq );
+        }
+
+        // 8. F0 of each frame. YIN does not interleave, so the lanes run one after another.
+        if ( outputs & MFCC::cOutputPitch ) {
+
+            PitchEstimator& pe = pitch();
+            for ( int l = 0; l < numFrames; l++ ) {
+                pe.estimate_neon( *mPitchFFT, lanes[ l ], mPitchFeatures[ l * 2 ], mPitchFeatures[ l * 2 + 1 ] );
+            }
+        }
+
+        writeFeatures( numFrames, outputs, features );
+    }
+#endif
+
+private:
+
+    static constexpr int cNumPoints = MFCC::cNumPointsFFT / 2;
+
+    void makeTables() {
+
+        for ( int k = 0; k < cNumPoints; k++ ) {
+
+            const double theta = -2.0 * M_PI * (double)k / (double)MFCC::cNumPointsFFT;
+            mTwiddleRe[ k ] = (float) cos( theta );
+            mTwiddleIm[ k ] = (float) sin( theta );
+        }
+
+        for ( int i = 0; i < MFCC::cNumPointsFFT; i++ ) {
+
+            int r = 0;
+            for ( int b = 1, v = i; b < MFCC::cNumPointsFFT; b *= 2, v /= 2 ) {
+                r = r * 2 + ( v & 1 );
+            }
+            mBitReverse[ i ] = r;
+        }
+
+        for ( int i = 0; i < cNumPoints; i++ ) {
+
+            const sampleToBin& stb = mMelFilterBanks.mSampleToBin[ i ];
+            mMelBin1  [ i ] = stb.bin1();
+            mMelBin2  [ i ] = stb.bin2();
+            mMelCoeff1[ i ] = (float)stb.coeff1();
+            mMelCoeff2[ i ] = (float)stb.coeff2();
+        }
+    }
+
+    const FbankFilterBank& fbank( const int numBins ) {
+
+        if ( mFbank.numBins() != numBins ) {
+            mFbank.build( numBins );
+        }
+        return mFbank;
+    }
+
+    const ConstantQKernel& constantQ() {
+
+        if ( !mConstantQ.built() ) {
+            mConstantQ.build( mHammingWindow.window(), MFCC::cFrameSizeSamples, mHammingWindow.preEmphTap0() );
+        }
+        return mConstantQ;
+    }
+
+    /** @brief the pitch estimator and the FFT engine for it, built on first use.
+     */
+    PitchEstimator& pitch() {
+
+        if ( mPitch == nullptr ) {
+            mPitchArena = new AlignedArena( FFT512::arenaBytes() + PitchEstimator::arenaBytes( MFCC::cFrameSizeSamples ) );
+            mPitchFFT   = new FFT512( *mPitchArena );
+            mPitch      = new PitchEstimator( *mPitchArena, MFCC::cFrameSizeSamples, MFCC::cSampleRate,
+                                              MFCC::cPitchMinFreq, MFCC::cPitchMaxFreq, MFCC::cPitchThreshold );
+        }
+        return *mPitch;
+    }
+
+    /** @brief log constant-Q powers and chroma of each lane from mConstantQPower.
+     */
+    void finishConstantQ( const ConstantQKernel& cq ) {
+
+        const float melFloor = MelFilterBanks::cMelFloor;
+
+        for ( int l = 0; l < cNumLanes; l++ ) {
+
+            float power [ MFCC::cNumCQTBins    ];
+            float chroma[ MFCC::cNumChromaBins ];
+
+            for ( int k = 0; k < MFCC::cNumCQTBins; k++ ) {
+                power[ k ] = mConstantQPower[ k * cNumLanes + l ];
+                mCQT[ k * cNumLanes + l ] = log( std::max( power[ k ], melFloor ) );
+            }
+            cq.findChroma( power, melFloor, chroma );
+            for ( int p = 0; p < MFCC::cNumChromaBins; p++ ) {
+                mChroma[ p * cNumLanes + l ] = chroma[ p ];
+            }
+        }
+    }
+
+    void setLanes( const float* const* frames, const int numFrames, const float** lanes ) const {
+
+        for ( int l = 0; l < cNumLanes; l++ ) {
+            lanes[ l ] = ( l < numFrames ) ? frames[ l ] : mZeroFrame;
+        }
+    }
+
+    void writeFeatures( const int numFrames, const unsigned int outputs, float* const* features ) const {
+
+        for ( int l = 0; l < numFrames; l++ ) {
+
+            float* out = features[ l ];
+
+            if ( outputs & MFCC::cOutputMFCC ) {
+                for ( int i = 0; i < MFCC::numCepstra( outputs ); i++ ) {
+                    *out++ = mMFCC[ i * cNumLanes + l ];
+                }
+            }
+            if ( outputs & MFCC::cOutputLogSpectrum ) {
+                for ( int i = 0; i < cNumPoints; i++ ) {
+                    *out++ = mLogSpectrum[ i * cNumLanes + l ];
+                }
+            }
+            if ( outputs & MFCC::cOutputLogMel ) {
+                for ( int i = 0; i < MFCC::cNumFilterBanks; i++ ) {
+                    *out++ = mMelBins[ i * cNumLanes + l ];
+                }
+            }
+            if ( outputs & MFCC::cOutputFbank ) {
+                for ( int i = 0; i < MFCC::numFbankBins( outputs ); i++ ) {
+                    *out++ = mFbankBins[ i * cNumLanes + l ];
+                }
+            }
+            if ( outputs & MFCC::cOutputCQT ) {
+                for ( int i = 0; i < MFCC::cNumCQTBins; i++ ) {
+                    *out++ = mCQT[ i * cNumLanes + l ];
+                }
+            }
+            if ( outputs & MFCC::cOutputChroma ) {
+                for ( int i = 0; i < MFCC::cNumChromaBins; i++ ) {
+                    *out++ = mChroma[ i * cNumLanes + l ];
+                }
+            }
+            if ( outputs & MFCC::cOutputPitch ) {
+                *out++ = mPitchFeatures[ l * 2     ];
+                *out++ = mPitchFeatures[ l * 2 + 1 ];
+            }
+        }
+    }
+
+    AlignedArena   mArena;
+    HammingWindow  mHammingWindow;
+    MelFilterBanks mMelFilterBanks;
+    DCT            mDCT;
+
+    float          mTwiddleRe    [ cNumPoints ];
+    float          mTwiddleIm    [ cNumPoints ];
+    int            mBitReverse   [ MFCC::cNumPointsFFT ];
+    int            mMelBin1      [ cNumPoints ];
+    int            mMelBin2      [ cNumPoints ];
+    float          mMelCoeff1    [ cNumPoints ];
+    float          mMelCoeff2    [ cNumPoints ];
+    float          mZeroFrame    [ MFCC::cFrameSizeSamples ];
+
+    float          mRe           [ MFCC::cNumPointsFFT * cNumLanes ];
+    float          mIm           [ MFCC::cNumPointsFFT * cNumLanes ];
+    float          mPowerSpectrum[ cNumPoints * cNumLanes ];
+    float          mLogSpectrum  [ cNumPoints * cNumLanes ];
+    float          mMelBins      [ MFCC::cNumFilterBanks * cNumLanes ];
+    float          mMFCC         [ ( MFCC::cNumFilterBanks + 1 ) * cNumLanes ];
+    float          mFbankBins    [ MFCC::cMaxFbankBins * cNumLanes ];
+    float          mSpectrumRe   [ cNumPoints * cNumLanes ];
+    float          mSpectrumIm   [ cNumPoints * cNumLanes ];
+    float          mConstantQPower[ MFCC::cNumCQTBins * cNumLanes ];
+    float          mCQT          [ MFCC::cNumCQTBins * cNumLanes ];
+    float          mChroma       [ MFCC::cNumChromaBins * cNumLanes ];
+    float          mPitchFeatures[ MFCC::cNumPitchFeatures * cNumLanes ]; // [ lane ][ F0, confidence ]
+
+    FbankFilterBank  mFbank;
+    ConstantQKernel  mConstantQ;
+    AlignedArena*    mPitchArena;
+    FFT512*          mPitchFFT;
+    PitchEstimator*  mPitch;
+};
+
+
+/** @brief turns a stream of samples delivered in arbitrary block sizes into overlapping frames.
+ *         The frames are read in place from one linear buffer of fixed capacity. The consumed
+ *         samples are discarded by moving the unconsumed ones to the head when the tail is full,
+ *         so that memory stays constant however long the stream is.
+ */
+class StreamingFrameBuffer {
+
+public:
+
+    /** @brief constructor
+     *
+     *  @param frameSizeSamples  : number of samples in one frame   (usually 400)
+     *  @param frameShiftSamples : number of samples between frames (usually 160)
+     *  @param capacitySamples   : buffer size. At least frameSizeSamples.
+     */
+    StreamingFrameBuffer( const int frameSizeSamples, const int frameShiftSamples, const int capacitySamples )
+        :mFrameSizeSamples  ( frameSizeSamples  )
+        ,mFrameShiftSamples ( frameShiftSamples )
+        ,mCapacitySamples   ( std::max( capacitySamples, frameSizeSamples ) )
+        ,mReadPos           ( 0 )
+        ,mWritePos          ( 0 )
+    {
+        mSamples = new float[ mCapacitySamples ];
+    }
+
+    ~StreamingFrameBuffer() {
+        delete[] mSamples;
+    }
+
+    /** @brief discards all the samples.
+     */
+    void reset() {
+        mReadPos  = 0;
+        mWritePos = 0;
+    }
+
+    /** @brief number of samples putSamples() accepts now.
+     */
+    int space() const {
+        return mCapacitySamples - ( mWritePos - mReadPos );
+    }
+
+    /** @brief appends PCM samples, converted to float without scaling as on the Java side.
+     *
+     *  @param samples    : PCM samples
+     *  @param numSamples : number of samples
+     *  @return number of samples accepted, which is less than numSamples if space() runs out.
+     */
+    int putSamples( const int16_t* samples, const int numSamples ) {
+
+        const int n = makeRoom( numSamples );
+
+        float* const dst = &mSamples[ mWritePos ];
+        for ( int i = 0; i < n; i++ ) {
+            dst[ i ] = (float)samples[ i ];
+        }
+        mWritePos += n;
+        return n;
+    }
+
+    /** @brief same as above for float samples.
+     */
+    int putSamples( const float* samples, const int numSamples ) {
+
+        const int n = makeRoom( numSamples );
+
+        memcpy( &mSamples[ mWritePos ], samples, sizeof(float) * n );
+        mWritePos += n;
+        return n;
+    }
+
+    /** @brief number of complete frames available.
+     */
+    int numFrames() const {
+
+        const int n = mWritePos - mReadPos;
+        return ( n < mFrameSizeSamples ) ? 0 : ( n - mFrameSizeSamples ) / mFrameShiftSamples + 1;
+    }
+
+    /** @brief space to write up to numSamples samples in place, e.g., by a resampler,
+     *         followed by commitSamples() with the number actually written.
+     *
+     *  @return nullptr if space() is less than numSamples.
+     */
+    float* reserveSamples( const int numSamples ) {
+
+        if ( makeRoom( numSamples ) < numSamples ) {
+            return nullptr;
+        }
+        return &mSamples[ mWritePos ];
+    }
+
+    /** @brief appends the samples written to reserveSamples().
+     */
+    void commitSamples( const int numSamples ) {
+        mWritePos += numSamples;
+    }
+
+    /** @brief the available samples. Frame n starts at samples()[ n * frameShiftSamples ].
+     *         Valid until the next putSamples() or reserveSamples().
+     */
+    float* samples() {
+        return &mSamples[ mReadPos ];
+    }
+
+    /** @brief number of samples available from samples().
+     */
+    int numSamples() const {
+        return mWritePos - mReadPos;
+    }
+
+    /** @brief releases the given number of frames.
+     */
+    void consumeFrames( const int numFrames ) {
+        mReadPos = std::min( mReadPos + numFrames * mFrameShiftSamples, mWritePos );
+    }
+
+private:
+
+    int makeRoom( const int numSamples ) {
+
+        const int n = std::min( numSamples, space() );
+
+        if ( mWritePos + n > mCapacitySamples ) {
+            memmove( mSamples, &mSamples[ mReadPos ], sizeof(float) * ( mWritePos - mReadPos ) );
+            mWritePos -= mReadPos;
+            mReadPos   = 0;
+        }
+        return n;
+    }
+
+    const int mFrameSizeSamples;
+    const int mFrameShiftSamples;
+    const int mCapacitySamples;
+    int       mReadPos;
+    int       mWritePos;
+    float*    mSamples;
+};
+
+
+/** @brief streaming polyphase FIR resampler by a rational factor L/M, e.g., 48KHz, 44.1KHz or
+ *         8KHz capture to MFCC::cSampleRate.
+ *
+ *  The prototype is a Kaiser-windowed sinc with the cutoff at 0.46 of the lower of the two rates
+ *  and cNumZeroCrossings zero crossings on each side. It is split into L phases of K taps,
+ *  K rounded up to a multiple of 4 for NEON, and each output sample is one K-tap dot product.
+ *  The group delay of the filter is compensated, so output n is at input time n * M / L.
+ *  All the buffers are allocated at construction.
+ */
+class PolyphaseResampler {
+
+public:
+
+    static constexpr int   cNumZeroCrossings = 16;
+    static constexpr float cCutoffRatio      = 0.92; // of the lower Nyquist frequency
+    static constexpr float cKaiserBeta       = 8.0;
+
+    /** @brief constructor
+     *
+     *  @param inputRate       : input sample rate in Hz
+     *  @param outputRate      : output sample rate in Hz
+     *  @param maxBlockSamples : largest number of input samples processed at once. Larger inputs are split.
+     */
+    PolyphaseResampler( const int inputRate, const int outputRate, const int maxBlockSamples = 4096 )
+        :mInputRate      ( inputRate       )
+        ,mOutputRate     ( outputRate      )
+        ,mMaxBlockSamples( maxBlockSamples )
+    {
+        const int g = gcd( inputRate, outputRate );
+        mL = outputRate / g;
+        mM = inputRate  / g;
+
+        makeFilter();
+
+        mBuffer = new float[ mNumTapsPerPhase - 1 + mMaxBlockSamples ];
+        reset();
+    }
+
+    ~PolyphaseResampler() {
+        delete[] mCoeffs;
+        delete[] mBuffer;
+    }
+
+    /** @brief clears the history. The next input is treated as the start of a stream.
+     */
+    void reset() {
+
+        memset( mBuffer, 0, sizeof(float) * ( mNumTapsPerPhase - 1 ) );
+        mFill = mNumTapsPerPhase - 1;
+        mPos  = (int64_t)( mNumTapsPerPhase - 1 ) * mL + mDelay;
+    }
+
+    /** @brief upper bound of the outputs for numSamples inputs.
+     */
+    int maxOutputSamples( const int numSamples ) const {
+
+        return (int)( ( (int64_t)numSamples * mL + mM - 1 ) / mM ) + 1;
+    }
+
+    /** @brief resamples a block of PCM samples.
+     *
+     *  @param samples    : input samples
+     *  @param numSamples : number of input samples
+     *  @param out        : (out) at least maxOutputSamples( numSamples ) floats, in the scale of int16.
+     *  @return number of output samples
+     */
+    int process_cpp( const int16_t* samples, const int numSamples, float* out ) {
+
+        int numOut = 0;
+        for ( int done = 0; done < numSamples; ) {
+
+            const int n = std::min( numSamples - done, mMaxBlockSamples );
+            load( &samples[ done ], n );
+            numOut += filter_cpp( &out[ numOut ] );
+            done   += n;
+        }
+        return numOut;
+    }
+
+#ifdef HAVE_NEON
+    int process_neon( const int16_t* samples, const int numSamples, float* out ) {
+
+        int numOut = 0;
+        for ( int done = 0; done < numSamples; ) {
+
+            const int n = std::min( numSamples - done, mMaxBlockSamples );
+            load( &samples[ done ], n );
+            numOut += filter_neon( &out[ numOut ] );
+            done   += n;
+        }
+        return numOut;
+    }
+#endif
+
+    /** @brief resamples directly into a frame buffer, as far as it has space.
+     *
+     *  @param samples    : input samples
+     *  @param numSamples : number of input samples
+     *  @param frames     : (out) destination
+     *  @return number of input samples consumed. Less than numSamples if frames is full.
+     */
+    int process_cpp( const int16_t* samples, const int numSamples, StreamingFrameBuffer& frames ) {
+
+        int done = 0;
+        while ( done < numSamples ) {
+
+            const int n   = inputsFittingIn( frames.space(), numSamples - done );
+            float*    out = ( n > 0 ) ? frames.reserveSamples( maxOutputSamples( n ) ) : nullptr;
+            if ( out == nullptr ) {
+                break;
+            }
+            load( &samples[ done ], n );
+            frames.commitSamples( filter_cpp( out ) );
+            done += n;
+        }
+        return done;
+    }
+
+#ifdef HAVE_NEON
+    int process_neon( const int16_t* samples, const int numSamples, StreamingFrameBuffer& frames ) {
+
+        int done = 0;
+        while ( done < numSamples ) {
+
+            const int n   = inputsFittingIn( frames.space(), numSamples - done );
+            float*    out = ( n > 0 ) ? frames.reserveSamples( maxOutputSamples( n ) ) : nullptr;
+            if ( out == nullptr ) {
+                break;
+            }
+            load( &samples[ done ], n );
+            frames.commitSamples( filter_neon( out ) );
+            done += n;
+        }
+        return done;
+    }
+#endif
+
+    int inputRate()       const { return mInputRate;       }
+    int outputRate()      const { return mOutputRate;      }
+    int upFactor()        const { return mL;               }
+    int downFactor()      const { return mM;               }
+    int numTapsPerPhase() const { return mNumTapsPerPhase; }
+
+private:
+
+    static int gcd( int a, int b ) {
+        while ( b != 0 ) {
+            const int t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    /** @brief modified Bessel function of the first kind, order 0.
+     */
+    static double besselI0( const double x ) {
+
+        double sum  = 1.0;
+        double term = 1.0;
+        for ( int k = 1; k < 50; k++ ) {
+            term *= ( x / ( 2.0 * k ) ) * ( x / ( 2.0 * k ) );
+            sum  += term;
+            if ( term < sum * 1.0e-12 ) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    void makeFilter() {
+
+        // Prototype at the rate of inputRate * L.
+        const int    maxLM    = std::max( mL, mM );
+        const int    length   = 2 * cNumZeroCrossings * maxLM + 1;
+        const double center   = ( length - 1 ) / 2.0;
+        const double cutoff   = cCutoffRatio * 0.5 / maxLM; // cycles per sample
+        const double i0Beta   = besselI0( cKaiserBeta );
+
+        mDelay           = ( length - 1 ) / 2;
+        mNumTapsPerPhase = ( ( length + mL - 1 ) / mL + 3 ) / 4 * 4;
+        mCoeffs          = new float[ mL * mNumTapsPerPhase ];
+
+        const int K = mNumTapsPerPhase;
+
+        // Phase p, tap k is h[ p + ( K - 1 - k ) * L ], reversed so that it is applied
+        // to the input in increasing order.
+        for ( int p = 0; p < mL; p++ ) {
+            for ( int k = 0; k < K; k++ ) {
+
+                const int j = p + ( K - 1 - k ) * mL;
+                double    h = 0.0;
+
+                if ( j < length ) {
+                    const double t      = j - center;
+                    const double r      = t / center;
+                    const double sinc   = ( t == 0.0 ) ? 2.0 * cutoff : sin( 2.0 * M_PI * cutoff * t ) / ( M_PI * t );
+                    const double window = besselI0( cKaiserBeta * sqrt( std::max( 0.0, 1.0 - r * r ) ) ) / i0Beta;
+                    h = mL * sinc * window;
+                }
+                mCoeffs[ p * K + k ] = (float)h;
+            }
+        }
+    }
+
+    int inputsFittingIn( const int space, const int numSamples ) const {
+
+        int n = std::min( numSamples, mMaxBlockSamples );
+        while ( n > 0 && maxOutputSamples( n ) > space ) {
+            n = std::min( n / 2, (int)( ( (int64_t)( space - 2 ) * mM ) / mL ) );
+        }
+        return n;
+    }
+
+    void load( const int16_t* samples, const int numSamples ) {
+
+        float* const dst = &mBuffer[ mFill ];
+        for ( int i = 0; i < numSamples; i++ ) {
+            dst[ i ] = (float)samples[ i ];
+        }
+        mFill += numSamples;
+    }
+
+    /** @brief keeps the last K - 1 samples as the history of the next block.
+     */
+    void retire() {
+
+        const int shift = mFill - ( mNumTapsPerPhase - 1 );
+
+        memmove( mBuffer, &mBuffer[ shift ], sizeof(float) * ( mNumTapsPerPhase - 1 ) );
+        mFill -= shift;
+        mPos  -= (int64_t)shift * mL;
+    }
+
+    int filter_cpp( float* out ) {
+
+        const int K      = mNumTapsPerPhase;
+        int       numOut = 0;
+
+        for ( ; mPos / mL < mFill; mPos += mM ) {
+
+            const int    i = (int)( mPos / mL );
+            const int    p = (int)( mPos % mL );
+            const float* x = &mBuffer[ i - K + 1 ];
+            const float* h = &mCoeffs[ p * K ];
+
+            float acc = 0.0;
+            for ( int k = 0; k < K; k++ ) {
+                acc += h[ k ] * x[ k ];
+            }
+            out[ numOut++ ] = acc;
+        }
+        retire();
+        return numOut;
+    }
+
+#ifdef HAVE_NEON
+    int filter_neon( float* out ) {
+
+        const int K      = mNumTapsPerPhase;
+        int       numOut = 0;
+
+        for ( ; mPos / mL < mFill; mPos += mM ) {
+
+            const int    i = (int)( mPos / mL );
+            const int    p = (int)( mPos % mL );
+            const float* x = &mBuffer[ i - K + 1 ];
+            const float* h = &mCoeffs[ p * K ];
+
+            float32x4_t acc = vdupq_n_f32( 0.0 );
+            for ( int k = 0; k < K; k += 4 ) {
+                acc = vmlaq_f32( acc, vld1q_f32( &h[ k ] ), vld1q_f32( &x[ k ] ) );
+            }
+            const float32x2_t sum2 = vadd_f32( vget_low_f32( acc ), vget_high_f32( acc ) );
+            out[ numOut++ ] = vget_lane_f32( vpadd_f32( sum2, sum2 ), 0 );
+        }
+        retire();
+        return numOut;
+    }
+#endif
+
+    const int mInputRate;
+    const int mOutputRate;
+    const int mMaxBlockSamples;
+    int       mL;
+    int       mM;
+    int       mDelay;
+    int       mNumTapsPerPhase;
+    float*    mCoeffs;
+
+    float*    mBuffer;   // K - 1 samples of history followed by the current block
+    int       mFill;
+    int64_t   mPos;      // next output position in units of 1/L input samples from mBuffer[ 0 ]
+};
+
+///////////////////////////////////////
+/////// FIXED-POINT PIPELINE BEGIN ////
+///////////////////////////////////////
+//
+// Integer counterpart of MFCC for low-power cores. It takes int16 PCM directly.
+//
+//  - Pre-emphasis & Hamming in int32 with Q31 coefficients on the frame scaled by a power of 2
+//    into [2^28, 2^29), so that x[i] - a*x[i-1] never overflows and quiet frames keep their precision.
+//  - 512-point iterative radix-2 FFT in int32 with Q31 twiddles and block floating point. Each
+//    stage keeps its input below 2^29 by shifting the whole block right, fused into the loads of
+//    the butterfly, and the shifts are accumulated into a block exponent.
+//  - Power in int64 on the points scaled below 2^28, Mel accumulation in int64 with Q15 weights.
+//  - Natural log by a 256-entry log2 mantissa table, Mel log energies in Q8.
+//  - DCT with a Q14 table, MFCC output in int32 Q16.
+//
+// Accuracy against MFCC::generateMFCC_cpp(), as measured by host/mfcc_bench over tones from
+// 100Hz to 8KHz at peak amplitudes from 100 to 30000 (largest / mean absolute difference of
+// the 27 MFCCs):
+//
+//   - sweep with noise 20dB below, i.e., the frames of mfcc_bench : 0.010 / 0.002
+//   - tones with uniform noise at 5% of the amplitude             : 0.009 / 0.002
+//   - tones clipped at full scale                                 : 0.010 / 0.002
+//   - pure tones                                                  : 0.010 / 0.002
+//
+// which is the resolution of the Q8 log Mel energies and the log2 table.
+//
+// The 32-bit butterflies matter for pure tones. With int16 ones the rounding noise of the FFT
+// sat about 65dB below the strongest bin, the Mel banks below that level read the noise floor
+// instead of their energy, and C0 was off by up to 29. The C++ and the NEON versions are
+// bit-exact to each other.
+//
+
+/** @brief Q31 multiply with rounding and saturation. Same as NEON vqrdmulh.
+ */
+static inline int32_t qrdmulh_q31( const int32_t a, const int32_t b ) {
+
+    const int64_t p = ( (int64_t)a * (int64_t)b + ( 1LL << 30 ) ) >> 31;
+    return (int32_t)( p > INT32_MAX ? INT32_MAX : p );
+}
+
+/** @brief v * 2^-shift rounded to nearest, as NEON vrshl by -shift.
+ */
+static inline int32_t roundingShift( const int32_t v, const int shift ) {
+
+    return ( shift == 0 ) ? v : (int32_t)( ( (int64_t)v + ( 1LL << ( shift - 1 ) ) ) >> shift );
+}
+
+static inline int16_t toQ15( const double v ) {
+
+    const long q = lrint( v * 32768.0 );
+    return (int16_t)( q > INT16_MAX ? INT16_MAX : ( q < INT16_MIN ? INT16_MIN : q ) );
+}
+
+static inline int32_t toQ31( const double v ) {
+
+    const long long q = llrint( v * 2147483648.0 );
+    return (int32_t)( q > INT32_MAX ? INT32_MAX : ( q < INT32_MIN ? INT32_MIN : q ) );
+}
+
+
+class HammingWindowQ31 {
+
+public:
+    /** @brief constructor
+     *
+     *  @param windowSizeSamples : number of samples in one input frame  (usually 400)
+     *  @param preEmphTap0       : pre-emphasis coefficient              (usually around 0.95)
+     */
+    HammingWindowQ31( const int windowSizeSamples, const float preEmphTap0 )
+            :mWindowSizeSamples( windowSizeSamples )
+            ,mPreEmphTap0Q31   ( toQ31( preEmphTap0 ) )
+    {
+        makeHammingWindow();
+    }
+
+    ~HammingWindowQ31() {
+        delete[] mHammingWindowQ31;
+    }
+
+    /** @brief performs conversion on one frame of int16 samples.
+     *         The frame is first scaled by a power of 2 into [2^28, 2^29), exactly, so that
+     *         x[i] - tap0 * x[i-1] fits in int32 with the least rounding for quiet input.
+     *         array_out[i] * 2^exponent = hamming[i] * ( x[i] - tap0 * x[i-1] )
+     *
+     *  @param array_in     : input  samples (frame) whose length is windowSizeSamples
+     *  @param array_out    : output samples (frame) whose length is windowSizeSamples
+     *  @return exponent
+     */
+    int preEmphasisHamming_cpp( const int16_t* array_in, int32_t* array_out ) {
+
+        int maxAbs = 0;
+        for ( int i = 0; i < mWindowSizeSamples; i++ ) {
+            maxAbs = std::max( maxAbs, abs( (int)array_in[ i ] ) );
+        }
+        const int shift = scaleShift( maxAbs );
+
+        array_out[0] = 0;
+
+        for ( int i = 1; i < mWindowSizeSamples; i++ ) {
+            array_out[ i ] = emphasizeAndWindow( array_in, i, shift );
+        }
+        return -shift;
+    }
+
+#ifdef HAVE_NEON
+    int preEmphasisHamming_neon( const int16_t* array_in, int32_t* array_out ) {
+
+        // Max and min rather than vqabsq_s16, which saturates |-32768| to 32767.
+        int16x8_t maxVec = vdupq_n_s16( 0 );
+        int16x8_t minVec = vdupq_n_s16( 0 );
+        int i = 0;
+        for ( ; i + 8 <= mWindowSizeSamples; i += 8 ) {
+            const int16x8_t v = vld1q_s16( &array_in[ i ] );
+            maxVec = vmaxq_s16( maxVec, v );
+            minVec = vminq_s16( minVec, v );
+        }
+        int maxAbs = 0;
+        for ( int lane = 0; lane < 8; lane++ ) {
+            maxAbs = std::max( maxAbs,  (int)vgetq_lane_s16( maxVec, lane ) );
+            maxAbs = std::max( maxAbs, -(int)vgetq_lane_s16( minVec, lane ) );
+        }
+        for ( ; i < mWindowSizeSamples; i++ ) {
+            maxAbs = std::max( maxAbs, abs( (int)array_in[ i ] ) );
+        }
+        const int shift = scaleShift( maxAbs );
+
+        const int32x4_t shiftVec = vdupq_n_s32( shift );
+
+        array_out[0] = 0;
+
+        i = 1;
+        for ( ; i + 4 <= mWindowSizeSamples; i += 4 ) {
+
+            const int32x4_t tap0   = vshlq_s32( vmovl_s16( vld1_s16( &array_in[ i     ] ) ), shiftVec );
+            const int32x4_t tap1   = vshlq_s32( vmovl_s16( vld1_s16( &array_in[ i - 1 ] ) ), shiftVec );
+            const int32x4_t emph   = vsubq_s32( tap0, vqrdmulhq_n_s32( tap1, mPreEmphTap0Q31 ) );
+            const int32x4_t window = vld1q_s32( &mHammingWindowQ31[ i ] );
+
+            vst1q_s32( &array_out[ i ], vqrdmulhq_s32( emph, window ) );
+        }
+
+        for ( ; i < mWindowSizeSamples; i++ ) {
+            array_out[ i ] = emphasizeAndWindow( array_in, i, shift );
+        }
+        return -shift;
+    }
+#endif
+
+private:
+    static constexpr int cScaledMax = 1 << 29;
+
+    /** @brief left shifts that bring maxAbs into [2^28, 2^29). At least 13 for int16 input.
+     */
+    static int scaleShift( const int maxAbs ) {
+
+        if ( maxAbs == 0 ) {
+            return 0;
+        }
+        int shift = 0;
+        while ( ( maxAbs << ( shift + 1 ) ) < cScaledMax ) {
+            shift++;
+        }
+        return shift;
+    }
+
+    int32_t emphasizeAndWindow( const int16_t* array_in, const int i, const int shift ) const {
+
+        const int32_t cur  = (int32_t)array_in[ i     ] * ( 1 << shift );
+        const int32_t prev = (int32_t)array_in[ i - 1 ] * ( 1 << shift );
+        const int32_t emph = cur - qrdmulh_q31( prev, mPreEmphTap0Q31 );
+        return qrdmulh_q31( emph, mHammingWindowQ31[ i ] );
+    }
+
+    void makeHammingWindow() {
+
+        mHammingWindowQ31 = new int32_t[mWindowSizeSamples];
+
+        for ( int i = 0; i < mWindowSizeSamples; i++ ) {
+            mHammingWindowQ31[i] = toQ31( 0.54 - 0.46 * cos( 2.0 * M_PI * (float)i / (float)(mWindowSizeSamples - 1) ) );
+        }
+    }
+
+    const int     mWindowSizeSamples;
+    const int32_t mPreEmphTap0Q31;
+    int32_t*      mHammingWindowQ31;
+};
+
+
+class FFT512Q31 {
+
+public:
+    static constexpr int cNumPoints    = 512;
+    static constexpr int cHeadroomBits = 29; // |v1| + |v2|( |cos| + |sin| ) < 2.5 * 2^29 fits in int32.
+
+    FFT512Q31 () {
+        makeTwiddles();
+        makeBitReverse();
+    }
+
+    /** @brief main function
+     *
+     *  @param samples    : (in)  512 real samples
+     *  @param points_re  : (out) 512 points real
+     *  @param points_im  : (out) 512 points imaginary
+     *
+     *  @return : block exponent. The spectrum is ( points_re, points_im ) * 2^exponent
+     */
+    int transform_cpp( const int32_t* samples, int32_t* points_re, int32_t* points_im ) {
+
+        int     exponent = loadBitReversed( samples, points_re, points_im );
+        int64_t maxAbs   = cHeadroomLimit - 1;
+
+        for ( int half = 1; half < cNumPoints; half *= 2 ) {
+
+            const int shift = blockShift( maxAbs );
+            exponent += shift;
+            maxAbs    = stage_cpp( half, shift, points_re, points_im );
+        }
+        return exponent;
+    }
+
+#ifdef HAVE_NEON
+    int transform_neon( const int32_t* samples, int32_t* points_re, int32_t* points_im ) {
+
+        int     exponent = loadBitReversed( samples, points_re, points_im );
+        int64_t maxAbs   = cHeadroomLimit - 1;
+
+        for ( int half = 1; half < cNumPoints; half *= 2 ) {
+
+            const int shift = blockShift( maxAbs );
+            exponent += shift;
+            maxAbs    = ( half < 4 ) ? stage_cpp ( half, shift, points_re, points_im )
+                                     : stage_neon( half, shift, points_re, points_im );
+        }
+        return exponent;
+    }
+#endif
+
+    /** @brief number of right shifts needed to bring maxAbs below 2^limitBits.
+     */
+    static int blockShift( int64_t maxAbs, const int limitBits = cHeadroomBits ) {
+
+        int shift = 0;
+        while ( maxAbs >= ( 1LL << limitBits ) ) {
+            maxAbs >>= 1;
+            shift++;
+        }
+        return shift;
+    }
+
+private:
+
+    static constexpr int64_t cHeadroomLimit = 1LL << cHeadroomBits;
+
+    /** @brief bit-reversal permutation with normalization of the real input into [2^28, 2^29).
+     *
+     *  @return : negative of the number of left shifts applied.
+     */
+    int loadBitReversed( const int32_t* samples, int32_t* points_re, int32_t* points_im ) {
+
+        int64_t maxAbs = 0;
+        for ( int i = 0; i < cNumPoints; i++ ) {
+            maxAbs = std::max( maxAbs, std::abs( (int64_t)samples[ i ] ) );
+        }
+
+        int leftShift  = 0;
+        int rightShift = blockShift( maxAbs );
+        if ( maxAbs > 0 ) {
+            while ( ( maxAbs << ( leftShift + 1 ) ) < cHeadroomLimit ) {
+                leftShift++;
+            }
+        }
+
+        for ( int i = 0; i < cNumPoints; i++ ) {
+            points_re[ i ] = roundingShift( samples[ mBitReverse[ i ] ] * ( 1 << leftShift ), rightShift );
+            points_im[ i ] = 0;
+        }
+        return rightShift - leftShift;
+    }
+
+    /** @brief one radix-2 stage over the whole block. Inputs are shifted right by shift first, with rounding.
+     *
+     *  @return : max absolute value of the outputs.
+     */
+    int64_t stage_cpp( const int half, const int shift, int32_t* re, int32_t* im ) {
+
+        const int32_t* const twiddle_re = &mTwiddleRe[ half - 1 ];
+        const int32_t* const twiddle_im = &mTwiddleIm[ half - 1 ];
+
+        int64_t maxAbs = 0;
+
+        for ( int base = 0; base < cNumPoints; base += 2 * half ) {
+
+            for ( int k = 0; k < half; k++ ) {
+
+                const int32_t v1_re = roundingShift( re[ base + k        ], shift );
+                const int32_t v1_im = roundingShift( im[ base + k        ], shift );
+                const int32_t v2_re = roundingShift( re[ base + k + half ], shift );
+                const int32_t v2_im = roundingShift( im[ base + k + half ], shift );
+
+                const int32_t offset_re = qrdmulh_q31( twiddle_re[k], v2_re ) - qrdmulh_q31( twiddle_im[k], v2_im );
+                const int32_t offset_im = qrdmulh_q31( twiddle_re[k], v2_im ) + qrdmulh_q31( twiddle_im[k], v2_re );
+
+                re[ base + k        ] = v1_re + offset_re;
+                im[ base + k        ] = v1_im + offset_im;
+                re[ base + k + half ] = v1_re - offset_re;
+                im[ base + k + half ] = v1_im - offset_im;
+
+                maxAbs = std::max( maxAbs, std::abs( (int64_t)re[ base + k        ] ) );
+                maxAbs = std::max( maxAbs, std::abs( (int64_t)im[ base + k        ] ) );
+                maxAbs = std::max( maxAbs, std::abs( (int64_t)re[ base + k + half ] ) );
+                maxAbs = std::max( maxAbs, std::abs( (int64_t)im[ base + k + half ] ) );
+            }
+        }
+        return maxAbs;
+    }
+
+#ifdef HAVE_NEON
+    int64_t stage_neon( const int half, const int shift, int32_t* re, int32_t* im ) {
+
+        const int32_t* const twiddle_re = &mTwiddleRe[ half - 1 ];
+        const int32_t* const twiddle_im = &mTwiddleIm[ half - 1 ];
+
+        const int32x4_t shiftVec = vdupq_n_s32( -shift );
+        int32x4_t       maxVec   = vdupq_n_s32( 0 );
+        int32x4_t       minVec   = vdupq_n_s32( 0 );
+
+        for ( int base = 0; base < cNumPoints; base += 2 * half ) {
+
+            for ( int k = 0; k < half; k += 4 ) {
+
+                const int32x4_t tw_re = vld1q_s32( &twiddle_re[ k ] );
+                const int32x4_t tw_im = vld1q_s32( &twiddle_im[ k ] );
+                const int32x4_t v1_re = vrshlq_s32( vld1q_s32( &re[ base + k        ] ), shiftVec );
+                const int32x4_t v1_im = vrshlq_s32( vld1q_s32( &im[ base + k        ] ), shiftVec );
+                const int32x4_t v2_re = vrshlq_s32( vld1q_s32( &re[ base + k + half ] ), shiftVec );
+                const int32x4_t v2_im = vrshlq_s32( vld1q_s32( &im[ base + k + half ] ), shiftVec );
+
+                const int32x4_t offset_re = vsubq_s32( vqrdmulhq_s32( tw_re, v2_re ), vqrdmulhq_s32( tw_im, v2_im ) );
+                const int32x4_t offset_im = vaddq_s32( vqrdmulhq_s32( tw_re, v2_im ), vqrdmulhq_s32( tw_im, v2_re ) );
+
+                const int32x4_t out1_re = vaddq_s32( v1_re, offset_re );
+                const int32x4_t out1_im = vaddq_s32( v1_im, offset_im );
+                const int32x4_t out2_re = vsubq_s32( v1_re, offset_re );
+                const int32x4_t out2_im = vsubq_s32( v1_im, offset_im );
+
+                vst1q_s32( &re[ base + k        ], out1_re );
+                vst1q_s32( &im[ base + k        ], out1_im );
+                vst1q_s32( &re[ base + k + half ], out2_re );
+                vst1q_s32( &im[ base + k + half ], out2_im );
+
+                maxVec = vmaxq_s32( maxVec, vmaxq_s32( vmaxq_s32( out1_re, out1_im ), vmaxq_s32( out2_re, out2_im ) ) );
+                minVec = vminq_s32( minVec, vminq_s32( vminq_s32( out1_re, out1_im ), vminq_s32( out2_re, out2_im ) ) );
+            }
+        }
+
+        int64_t maxAbs = 0;
+        for ( int lane = 0; lane < 4; lane++ ) {
+            maxAbs = std::max( maxAbs,  (int64_t)vgetq_lane_s32( maxVec, lane ) );
+            maxAbs = std::max( maxAbs, -(int64_t)vgetq_lane_s32( minVec, lane ) );
+        }
+        return maxAbs;
+    }
+#endif
+
+    /** @brief twiddles of all the stages, stage with half width h at offset h - 1, contiguous for SIMD.
+     */
+    void makeTwiddles() {
+
+        for ( int half = 1; half < cNumPoints; half *= 2 ) {
+
+            for ( int k = 0; k < half ; k++ ) {
+
+                const double theta = -1.0 * M_PI * (double)k / (double)half;
+
+                mTwiddleRe[ half - 1 + k ] = toQ31( cos( theta ) );
+                mTwiddleIm[ half - 1 + k ] = toQ31( sin( theta ) );
+            }
+        }
+    }
+
+    void makeBitReverse() {
+
+        for ( int i = 0; i < cNumPoints; i++ ) {
+
+            int r = 0;
+            for ( int b = 1, rb = cNumPoints / 2; b < cNumPoints; b <<= 1, rb >>= 1 ) {
+                if ( i & b ) {
+                    r |= rb;
+                }
+            }
+            mBitReverse[ i ] = (uint16_t)r;
+        }
+    }
+
+    int32_t  mTwiddleRe [ cNumPoints - 1 ];
+    int32_t  mTwiddleIm [ cNumPoints - 1 ];
+    uint16_t mBitReverse[ cNumPoints     ];
+};
+
+
+class MelFilterBanksQ15 {
+
+public:
+    static constexpr int cLog2TableBits = 8;
+    static constexpr int cLogMelFracBits = 8;
+    static constexpr int cPointBits      = 28; // power < 2^57, and 38 bins at most per bank sum below 2^63.
+
+    /** @brief constructor. Converts the bins and weights of the float MelFilterBanks into Q15.
+     */
+    MelFilterBanksQ15 () {
+
+        AlignedArena   arena( MelFilterBanks::arenaBytes() );
+        MelFilterBanks ref( arena );
+
+        for ( int i = 0; i < MelFilterBanks::cNumSamples; i++ ) {
+
+            mBin1    [ i ] = ref.mSampleToBin[ i ].bin1();
+            mBin2    [ i ] = ref.mSampleToBin[ i ].bin2();
+            mCoeff1Q15[ i ] = toQ15( ref.mSampleToBin[ i ].coeff1() );
+            mCoeff2Q15[ i ] = toQ15( ref.mSampleToBin[ i ].coeff2() );
+        }
+
+        for ( int i = 0; i < ( 1 << cLog2TableBits ); i++ ) {
+            // Mid-point of each mantissa interval in Q16.
+            mLog2Table[ i ] = (uint16_t)lrint( log2( 1.0 + ( (double)i + 0.5 ) / (double)( 1 << cLog2TableBits ) ) * 65536.0 );
+        }
+    }
+
+    /** @brief find log Mel filter bank coefficients
+     *
+     *  @param points_re : (in)  first 256 points from FFT512Q31, real parts
+     *  @param points_im : (in)  first 256 points from FFT512Q31, imaginary parts
+     *  @param exponent  : (in)  block exponent of the points including the window normalization
+     *  @param mel_bins  : (out) Log Mel filter bank energy coefficients in Q8
+     */
+    void findLogMelCoeffs_cpp( const int32_t* points_re, const int32_t* points_im, const int exponent, int16_t* mel_bins ) {
+
+        int64_t maxAbs = 0;
+        for ( int i = 0; i < MelFilterBanks::cNumSamples; i++ ) {
+            maxAbs = std::max( maxAbs, std::abs( (int64_t)points_re[ i ] ) );
+            maxAbs = std::max( maxAbs, std::abs( (int64_t)points_im[ i ] ) );
+        }
+        const int shift = FFT512Q31::blockShift( maxAbs, cPointBits );
+
+        for ( int i = 0; i < MelFilterBanks::cNumSamples; i++ ) {
+
+            const int64_t re = roundingShift( points_re[ i ], shift );
+            const int64_t im = roundingShift( points_im[ i ], shift );
+            mPower[ i ] = re * re + im * im;
+        }
+        accumulateAndLog( exponent + shift, mel_bins );
+    }
+
+#ifdef HAVE_NEON
+    void findLogMelCoeffs_neon( const int32_t* points_re, const int32_t* points_im, const int exponent, int16_t* mel_bins ) {
+
+        int32x4_t maxVec = vdupq_n_s32( 0 );
+        int32x4_t minVec = vdupq_n_s32( 0 );
+
+        for ( int i = 0; i < MelFilterBanks::cNumSamples; i += 4 ) {
+
+            const int32x4_t re = vld1q_s32( &points_re[ i ] );
+            const int32x4_t im = vld1q_s32( &points_im[ i ] );
+            maxVec = vmaxq_s32( maxVec, vmaxq_s32( re, im ) );
+            minVec = vminq_s32( minVec, vminq_s32( re, im ) );
+        }
+        int64_t maxAbs = 0;
+        for ( int lane = 0; lane < 4; lane++ ) {
+            maxAbs = std::max( maxAbs,  (int64_t)vgetq_lane_s32( maxVec, lane ) );
+            maxAbs = std::max( maxAbs, -(int64_t)vgetq_lane_s32( minVec, lane ) );
+        }
+        const int shift = FFT512Q31::blockShift( maxAbs, cPointBits );
+
+        const int32x4_t shiftVec = vdupq_n_s32( -shift );
+
+        for ( int i = 0; i < MelFilterBanks::cNumSamples; i += 4 ) {
+
+            const int32x4_t re = vrshlq_s32( vld1q_s32( &points_re[ i ] ), shiftVec );
+            const int32x4_t im = vrshlq_s32( vld1q_s32( &points_im[ i ] ), shiftVec );
+
+            vst1q_s64( &mPower[ i     ], vmlal_s32( vmull_s32( vget_low_s32 ( re ), vget_low_s32 ( re ) ), vget_low_s32 ( im ), vget_low_s32 ( im ) ) );
+            vst1q_s64( &mPower[ i + 2 ], vmlal_s32( vmull_s32( vget_high_s32( re ), vget_high_s32( re ) ), vget_high_s32( im ), vget_high_s32( im ) ) );
+        }
+        accumulateAndLog( exponent + shift, mel_bins );
+    }
+#endif
+
+private:
+
+    /** @brief floor( power * coeff / 2^15 ) without overflowing int64.
+     */
+    static int64_t mulQ15( const int64_t power, const int16_t coeffQ15 ) {
+
+        return ( power >> 15 ) * coeffQ15 + ( ( ( power & 0x7fff ) * coeffQ15 ) >> 15 );
+    }
+
+    void accumulateAndLog( const int exponent, int16_t* mel_bins ) {
+
+        int64_t acc[ MelFilterBanks::cNumFilterBanks ];
+
+        for ( int i = 0; i < MelFilterBanks::cNumFilterBanks; i++ ) {
+            acc[ i ] = 0;
+        }
+
+        for ( int i = 0; i < MelFilterBanks::cNumSamples; i++ ) {
+
+            if ( mBin1[ i ] != -1 ) {
+                acc[ mBin1[ i ] ] += mulQ15( mPower[ i ], mCoeff1Q15[ i ] );
+            }
+            if ( mBin2[ i ] != -1 ) {
+                acc[ mBin2[ i ] ] += mulQ15( mPower[ i ], mCoeff2Q15[ i ] );
+            }
+        }
+
+        // mel = acc * 2^( 2 * exponent ), floored at 1.0 as in MelFilterBanks.
+        const int64_t ln2Q16 = 45426;
+
+        for ( int i = 0; i < MelFilterBanks::cNumFilterBanks; i++ ) {
+
+            const int64_t log2Q16 = log2Q16OfPositive( acc[ i ] ) + (int64_t)( 2 * exponent ) * 65536;
+
+            mel_bins[ i ] = ( log2Q16 <= 0 ) ? 0
+                          : (int16_t)( ( log2Q16 * ln2Q16 + ( 1LL << ( 31 - cLogMelFracBits ) ) ) >> ( 32 - cLogMelFracBits ) );
+        }
+    }
+
+    /** @brief log2( v ) in Q16 by the leading bit position and a mantissa table. Very negative for v <= 0.
+     */
+    int64_t log2Q16OfPositive( const int64_t v ) const {
+
+        if ( v <= 0 ) {
+            return -( 64LL << 16 );
+        }
+
+        int msb = 63;
+        while ( ( ( v >> msb ) & 1 ) == 0 ) {
+            msb--;
+        }
+
+        const int index = ( msb >= cLog2TableBits )
+                        ? (int)( ( v >> ( msb - cLog2TableBits ) ) & ( ( 1 << cLog2TableBits ) - 1 ) )
+                        : (int)( ( v << ( cLog2TableBits - msb ) ) & ( ( 1 << cLog2TableBits ) - 1 ) );
+
+        return ( (int64_t)msb << 16 ) + mLog2Table[ index ];
+    }
+
+    int8_t   mBin1     [ MelFilterBanks::cNumSamples ];
+    int8_t   mBin2     [ MelFilterBanks::cNumSamples ];
+    int16_t  mCoeff1Q15[ MelFilterBanks::cNumSamples ];
+    int16_t  mCoeff2Q15[ MelFilterBanks::cNumSamples ];
+    int64_t  mPower    [ MelFilterBanks::cNumSamples ];
+    uint16_t mLog2Table[ 1 << cLog2TableBits ];
+};
+
+
+
+
+class DCTQ14 {
+
+public:
+    static constexpr int cTableFracBits = 14;
+
+    /** @brief constructor. it pre-calculates a table in Q14.
+     *
+     *  @param numPoints : number of points in the input.
+     */
+    DCTQ14 ( const int numPoints ) {
+
+        mNumPoints = numPoints;
+        mNumPointsRoundUp4 = ((mNumPoints + 3) / 4) * 4;
+        makeDCTTable();
+    }
+
+    ~DCTQ14() { delete[] mDCTTable; }
+
+    /** @brief main function for DCT
+     *  @param samples_in  : (in)  log Mel energies in Q8, zero-padded to a multiple of 4
+     *  @param samples_out : (out) MFCC in Q16
+     */
+    void transform_cpp( const int16_t* const samples_in, int32_t* const samples_out ) const {
+
+        for ( int i = 0; i < mNumPoints + 1 ; i++ ) {
+
+            int32_t val = 0;
+
+            for ( int j = 0; j < mNumPoints; j++ ) {
+                val += (int32_t)mDCTTable[ mNumPointsRoundUp4 * i + j ] * samples_in[ j ];
+            }
+            samples_out[i] = roundToQ16( val );
+        }
+    }
+
+#ifdef HAVE_NEON
+    void transform_neon( const int16_t* const samples_in, int32_t* const samples_out ) const {
+
+        for ( int i = 0; i < mNumPoints + 1 ; i++ ) {
+
+            int32x4_t sumQuad = vdupq_n_s32( 0 );
+
+            for ( int j = 0; j < mNumPointsRoundUp4; j+=4 ) {
+
+                const int16x4_t cur_sample = vld1_s16( &( samples_in[j] ) );
+                const int16x4_t cur_dct    = vld1_s16( &( mDCTTable[ mNumPointsRoundUp4 * i + j ] ) );
+                sumQuad = vmlal_s16( sumQuad, cur_dct, cur_sample );
+            }
+
+            const int32_t val = vgetq_lane_s32( sumQuad, 0 ) + vgetq_lane_s32( sumQuad, 1 )
+                              + vgetq_lane_s32( sumQuad, 2 ) + vgetq_lane_s32( sumQuad, 3 );
+
+            samples_out[i] = roundToQ16( val );
+        }
+    }
+#endif
+
+private:
+
+    static int32_t roundToQ16( const int32_t valQ22 ) {
+
+        const int s = cTableFracBits + MelFilterBanksQ15::cLogMelFracBits - 16;
+        return ( valQ22 + ( 1 << ( s - 1 ) ) ) >> s;
+    }
+
+    void makeDCTTable() {
+
+        // Allocate redundant memory and padd with zero for 4-lane SIMD operations.
+        mDCTTable = new int16_t[ (mNumPoints + 1) * mNumPointsRoundUp4 ];
+        memset ( mDCTTable, 0, sizeof(int16_t) * ( (mNumPoints + 1) * mNumPointsRoundUp4 ) );
+
+        const double C = sqrt( 2.0 / mNumPoints );
+
+        for ( int i = 0; i <= mNumPoints; i++ ) {
+
+            for (int j = 0; j < mNumPoints; j++ ) {
+
+                const double di = (double)i ;
+                const double dj = (double)j + 0.5 ;
+                mDCTTable[ mNumPointsRoundUp4 * i + j ] =
+                    (int16_t)lrint( C * cos( M_PI * di * dj / (double)mNumPoints ) * (double)( 1 << cTableFracBits ) );
+            }
+        }
+    }
+
+    int      mNumPoints;
+    int      mNumPointsRoundUp4;
+    int16_t* mDCTTable;
+};
+
+
+class MFCCFixedPoint {
+
+public:
+    static constexpr int cMFCCFracBits = 16;
+
+    /** @brief constructor
+     */
+    MFCCFixedPoint()
+        :mHammingWindow( MFCC::cFrameSizeSamples, MFCC::cPreemphTap0 )
+        ,mFFT512()
+        ,mMelFilterBanks()
+        ,mDCT( MFCC::cNumFilterBanks )
+    {
+        memset( mWindowedSamples,   0, sizeof(int32_t) * MFCC::cNumPointsFFT            );
+        memset( mMelFilterBankBins, 0, sizeof(int16_t) * MFCC::cNumFilterBankssRoundUp4 );
+    }
+
+    /** @brief
+     *
+     *  @param samples_int16_400 : time domain 400 int16 samples
+     *  @param mfcc_q16          : (out) 27 MFCCs in Q16
+     */
+    void generateMFCC_cpp( const int16_t* samples_int16_400, int32_t* mfcc_q16 ) {
+
+        // 1. Pre-Emphasis & Hamming window oer 400 samples. Normalized.
+        const int windowExponent = mHammingWindow.preEmphasisHamming_cpp( samples_int16_400, mWindowedSamples );
+
+        // 2. 512 point FFT in block floating point.
+        const int exponent = mFFT512.transform_cpp( mWindowedSamples, mFFT512_re, mFFT512_im ) + windowExponent;
+
+        // 3. Log Mel coefficients
+        mMelFilterBanks.findLogMelCoeffs_cpp( mFFT512_re, mFFT512_im, exponent, mMelFilterBankBins );
+
+        // 4. DCT
+        mDCT.transform_cpp( mMelFilterBankBins, mfcc_q16 );
+    }
+
+#ifdef HAVE_NEON
+    void generateMFCC_neon( const int16_t* samples_int16_400, int32_t* mfcc_q16 ) {
+
+        // 1. Pre-Emphasis & Hamming window oer 400 samples. Normalized.
+        const int windowExponent = mHammingWindow.preEmphasisHamming_neon( samples_int16_400, mWindowedSamples );
+
+        // 2. 512 point FFT in block floating point.
+        const int exponent = mFFT512.transform_neon( mWindowedSamples, mFFT512_re, mFFT512_im ) + windowExponent;
+
+        // 3. Log Mel coefficients
+        mMelFilterBanks.findLogMelCoeffs_neon( mFFT512_re, mFFT512_im, exponent, mMelFilterBankBins );
+
+        // 4. DCT
+        mDCT.transform_neon( mMelFilterBankBins, mfcc_q16 );
+    }
+#endif
+
+    HammingWindowQ31  mHammingWindow;
+    FFT512Q31         mFFT512;
+    MelFilterBanksQ15 mMelFilterBanks;
+    DCTQ14            mDCT;
+
+    int32_t mWindowedSamples  [ MFCC::cNumPointsFFT            ];
+    int32_t mFFT512_re        [ MFCC::cNumPointsFFT            ];
+    int32_t mFFT512_im        [ MFCC::cNumPointsFFT            ];
+    int16_t mMelFilterBankBins[ MFCC::cNumFilterBankssRoundUp4 ];
+};
+
+///////////////////////////////////////
+/////// FIXED-POINT PIPELINE END   ////
+///////////////////////////////////////
+
+#endif //ANDROIDMFCC_MFCC_H
@@ -4,94 +4,28 @@
 #include <istream>
 #include <ostream>
 #include <math.h>
+#include <stdint.h>
 #include <sys/time.h>
 
 #include <cpu-features.h>
+#include <android/bitmap.h>
 #include <complex>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "logging_macros.h"
-
-#if defined(HAVE_NEON) && defined(HAVE_NEON_X86)
-/*
- * The latest version and instruction for NEON_2_SSE.h is at:
- *    https://github.com/intel/ARM_NEON_2_x86_SSE
- */
-#include "NEON_2_SSE.h"
-#elif defined(HAVE_NEON)
-#include <arm_neon.h>
-#endif
+#include "mfcc.h"
+#include "feature_cache.h"
+#include "multichannel_extractor.h"
+#include "colormap.h"
+#include "streaming_pipeline.h"
+#include "capture_trace.h"
 
 //#define EXPERIMENT_NEON
 
 #define EXPERIMENT_NEON
 
-///////////////////////////////////////
-/////// DEBUGGING TOOLS BEGIN /////////
-///////////////////////////////////////
-
-static int log_counter = -1;
-
-static char log_samples[ 4096 ];
-
-static void reset_log_samples()
-{
-    log_samples[ 0 ] = '\0';
-}
-
-static void add_log_sample( const float& v )
-{
-    char cur_str[ 256 ];
-
-    sprintf( cur_str, " %.2lf", v );
-    strcat( log_samples, cur_str );
-}
-
-static void print_part(
-    const int          part_num,
-    const float* const arr,
-    const int          len
-) {
-
-    reset_log_samples();
-
-    for ( int i = 0; i < len / 4; i++ ) {
-        add_log_sample( arr[ i ] );
-    }
-
-    LOGI( "Part %d: [%s]", part_num, log_samples );
-}
-
-
-static void print_points( const char* message, const float* arr, int len )
-{
-    if ( len >  64 ) {
-        const int part_len = len / 4;
-        LOGI( "%s", message );
-        print_part( 1,   arr,              part_len );
-        print_part( 2, &(arr[part_len  ]), part_len );
-        print_part( 3, &(arr[part_len*2]), part_len );
-        print_part( 4, &(arr[part_len*3]), part_len );
-    }
-    else {
-
-        reset_log_samples();
-        for (int i = 0; i < len; i++) {
-            add_log_sample(arr[i]);
-        }
-        LOGI("%s [%s]", message, log_samples);
-    }
-}
-
-static double getTimeStampInSeconds() {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (double) tv.tv_sec + ((double) tv.tv_usec / 1000000);
-}
-
-///////////////////////////////////////
-/////// DEBUGGING TOOLS END   /////////
-///////////////////////////////////////
-
 
 static void check_cpu_feature() {
 
@@ -119,1454 +53,664 @@ static void check_cpu_feature() {
     LOGI("CPUINFO:[%s]", buffer);
 }
 
+static MFCC mfccInst;
 
-class HammingWindow {
-
-public:
-    /** @brief constructor
-     *
-     *  @param windowSizeSamples : number of samples in one input frame  (usually 400)
-     *  @param preEmphTap0       : pre-emphasis coefficient              (usually around 0.95)
-     */
-    HammingWindow( const int windowSizeSamples, const float preEmphTap0 )
-            :mWindowSizeSamples( windowSizeSamples )
-            ,mPreEmphTap0      ( preEmphTap0       )
-    {
-        makeHammingWindow();
-    }
+static MFCCFixedPoint mfccFixedPointInst;
 
-    ~HammingWindow() {
-        delete[] mHammingWindow;
-    }
+static constexpr size_t cFeatureCacheDefaultBytes = 4 * 1024 * 1024;
 
+static FeatureCache featureCacheInst( mfccInst, cFeatureCacheDefaultBytes );
 
-    /** @brief performs conversion on one real-valued frame, and generates windowed frame
-     *
-     *  @param array_in     : input  samples (frame) whose length is windowSizeSamples
-     *  @param array_out    : output samples (frame) whose length is windowSizeSamples
-     */
-    void preEmphasisHammingAndMakeComplexForFFT_cpp( float* array_in, float* array_out ) {
+static MultichannelExtractor multichannelExtractorInst;
 
-        array_out[0] = 0.0;
+// Created for the capture rate given to resampleTo16KHz(), and recreated only when the rate changes.
+static PolyphaseResampler* resamplerInst = nullptr;
 
-        for ( int i = 1; i < mWindowSizeSamples; i++ ) {
-            array_out[ i ] = mHammingWindow[ i ] * ( array_in[ i ]  - mPreEmphTap0 * array_in[ i - 1 ] );
-        }
-    }
+static std::vector< float  > resamplerOut;
+static std::vector< jshort > resamplerOutShort;
 
-#ifdef HAVE_NEON
-    void preEmphasisHammingAndMakeComplexForFFT_neon( float* array_in, float* array_out ) {
+static ColormapRenderer colormapRendererInst;
 
-        array_out[0] = 0.0;
+// Pipelined mode. Created by startPipeline() and released by stopPipeline(), possibly on another
+// thread than the audio thread using it. Each call works on its own reference taken with
+// std::atomic_load(), so the pipeline is deleted by whichever call lets go of it last. No mutex,
+// as pushPipelineSamples() may block with PIPELINE_BLOCK until pollPipelineFeatures() makes room.
+static std::shared_ptr< StreamingPipeline > pipelineInst;
 
-        const float coeff1 = -1.0*mPreEmphTap0;
+// Capture trace. Opened by startCaptureTrace() on the UI thread and appended to on the capture thread.
+static CaptureTraceWriter captureTraceInst;
+static std::mutex         captureTraceMutex;
 
-        for ( int i = 1;  i < mWindowSizeSamples; i += 4 ) {
-
-            const float32x4_t tap0 = vld1q_f32( &array_in[i  ] );
-            float32x4_t       tap1 = vld1q_f32( &array_in[i-1] );
-            tap1 = vmulq_n_f32( tap1, coeff1 ); // tap1 = tap1 * coeff1
-            const float32x4_t outvec = vaddq_f32(tap0, tap1); // outvec = tap0 + tap1
+extern "C" JNIEXPORT jfloatArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateMFCC(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jfloatArray samples_real400
+) {
+    jboolean isCopy;
+    jfloat*  samples_real400_jfloat = env->GetFloatArrayElements( samples_real400, &isCopy );
+    jsize    samples_real400_size   = env->GetArrayLength       ( samples_real400 );
 
-            vst1q_f32( &(array_out[ i ]), outvec );
-        }
+    jfloatArray mfcc_27;
+    mfcc_27 = env->NewFloatArray( 27 );
+    if ( mfcc_27 == nullptr ) {
+        return nullptr;
     }
-#endif
-
-private:
-    void makeHammingWindow() {
-
-        mHammingWindow = new float[mWindowSizeSamples];
-
-        for ( int i = 0; i < mWindowSizeSamples; i++ ) {
-            mHammingWindow[i] = 0.54 - 0.46 * cos( 2.0 * M_PI * (float)i / (float)(mWindowSizeSamples - 1) );
-        }
 
+    jfloat mfcc_27_jfloat[ 27 ];
+    if ( execution_type == 0 ) {
+        mfccInst.generateMFCC_neon( samples_real400_jfloat, mfcc_27_jfloat );
     }
-
-    const int   mWindowSizeSamples;
-    const float mPreEmphTap0;
-    float*      mHammingWindow;
-};
-
-
-class FFT512 {
-
-public:
-
-    FFT512 () {
-        makeTwiddles();
+    else {
+        mfccInst.generateMFCC_cpp( samples_real400_jfloat, mfcc_27_jfloat );
     }
 
-    /** @brief main function
-     *
-     *  @param samples_re : (in)  samples real
-     *  @param samples_im : (in)  samples imaginary
-     *  @param points_re  : (out) points real
-     *  @param points_im  : (out) points imaginary
-     *
-     *  @return : frequency domain points in (re,im) pairs
-     */
-    void transform_cpp( float* samples_re, float* samples_im, float* points_re, float* points_im ) {
+    env->SetFloatArrayRegion      ( mfcc_27, 0, 27, mfcc_27_jfloat );
+    env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, 0 );
 
-        memcpy( mArrayIn512re, samples_re, sizeof(float)* 512 );
-        memcpy( mArrayIn512im, samples_im, sizeof(float)* 512 );
+    return mfcc_27;
 
-        cooley_tukey_fft_512_cpp( 0 );
+}
 
-        memcpy( points_re, mArrayOut512re, sizeof(float)* 512 );
-        memcpy( points_im, mArrayOut512im, sizeof(float)* 512 );
+extern "C" JNIEXPORT jfloatArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateMFCCAndPowerSpectrum(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jfloatArray samples_real400
+) {
+    jboolean isCopy;
+    jfloat*  samples_real400_jfloat = env->GetFloatArrayElements( samples_real400, &isCopy );
+    jsize    samples_real400_size   = env->GetArrayLength       ( samples_real400 );
 
+    jfloatArray mfcc_27_fft_256;
+    mfcc_27_fft_256 = env->NewFloatArray( 27 + 256 );
+    if ( mfcc_27_fft_256 == nullptr ) {
+        return nullptr;
     }
 
-#ifdef HAVE_NEON
-    void transform_neon( float* samples_re, float* samples_im, float* points_re, float* points_im ) {
-
-        memcpy( mArrayIn512re, samples_re, sizeof(float)* 512 );
-        memcpy( mArrayIn512im, samples_im, sizeof(float)* 512 );
-
-        cooley_tukey_fft_512_neon( 0 );
-
-        memcpy( points_re, mArrayOut512re, sizeof(float)* 512 );
-        memcpy( points_im, mArrayOut512im, sizeof(float)* 512 );
-
+    jfloat mfcc_27_fft_256_jfloat[ 27 + 256 ];
+    if ( execution_type == 0 ) {
+        mfccInst.generateMFCCAndPowerSpectrum_neon( samples_real400_jfloat, mfcc_27_fft_256_jfloat );
+    }
+    else {
+        mfccInst.generateMFCCAndPowerSpectrum_cpp( samples_real400_jfloat, mfcc_27_fft_256_jfloat );
     }
-#endif
-
-private:
 
-    void makeTwiddles() {
+    env->SetFloatArrayRegion      ( mfcc_27_fft_256, 0, 27 + 256, mfcc_27_fft_256_jfloat );
+    env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, 0 );
 
-        makeTwiddle( mTwiddle512re, mTwiddle512im, 512 );
-        makeTwiddle( mTwiddle256re, mTwiddle256im, 256 );
-        makeTwiddle( mTwiddle128re, mTwiddle128im, 128 );
-        makeTwiddle( mTwiddle64re,  mTwiddle64im,   64 );
-        makeTwiddle( mTwiddle32re,  mTwiddle32im,   32 );
-        makeTwiddle( mTwiddle16re,  mTwiddle16im,   16 );
-        makeTwiddle( mTwiddle8re,   mTwiddle8im,     8 );
-        makeTwiddle( mTwiddle4re,   mTwiddle4im,     4 );
-        makeTwiddle( mTwiddle2re,   mTwiddle2im,     2 );
+    return mfcc_27_fft_256;
 
-    }
+}
 
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_setVADParameters(
+        JNIEnv*     env,
+        jobject     jthis,
+        jfloat      energy_threshold_db,
+        jfloat      zero_crossing_rate_threshold,
+        jint        hangover_frames,
+        jboolean    emit_silence
+) {
+    mfccInst.setVADParameters( energy_threshold_db, zero_crossing_rate_threshold, hangover_frames, emit_silence == JNI_TRUE );
+}
 
-    void makeTwiddle( float re[], float im[], const int N ) {
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_setFrontEndParameters(
+        JNIEnv*     env,
+        jobject     jthis,
+        jboolean    compatible,
+        jint        window_type,
+        jboolean    remove_dc_offset,
+        jfloat      dither,
+        jfloat      preemph_coeff,
+        jboolean    use_energy,
+        jboolean    raw_energy,
+        jfloat      cepstral_lifter,
+        jboolean    orthonormal_dct,
+        jfloat      mel_floor
+) {
+    FrontEndParameters params;
+
+    params.compatible     = ( compatible       == JNI_TRUE );
+    params.windowType     = window_type;
+    params.removeDCOffset = ( remove_dc_offset == JNI_TRUE );
+    params.dither         = dither;
+    params.preemphCoeff   = preemph_coeff;
+    params.useEnergy      = ( use_energy       == JNI_TRUE );
+    params.rawEnergy      = ( raw_energy       == JNI_TRUE );
+    params.cepstralLifter = cepstral_lifter;
+    params.orthonormalDCT = ( orthonormal_dct  == JNI_TRUE );
+    params.melFloor       = mel_floor;
+
+    // The cache keys include the front end, so cached features of the other front end do not hit.
+    mfccInst.setFrontEndParameters( params );
+}
 
-        const double dN  = (double)N;
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_setPrunedFFT(
+        JNIEnv*     env,
+        jobject     jthis,
+        jboolean    pruned
+) {
+    mfccInst.setPrunedFFT( pruned == JNI_TRUE );
+}
 
-        for ( int k = 0; k < N / 2 ; k++ ) {
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_setSpectralSubtraction(
+        JNIEnv*     env,
+        jobject     jthis,
+        jboolean    enabled,
+        jfloat      over_subtraction,
+        jfloat      spectral_floor
+) {
+    // Features with the subtraction depend on the earlier frames, so the cache is bypassed while it is on.
+    mfccInst.setSpectralSubtraction( enabled == JNI_TRUE, over_subtraction, spectral_floor );
+}
 
-            const double theta = -2.0 * M_PI * (double)k / dN;
+extern "C" JNIEXPORT jfloatArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateMFCCAndPowerSpectrumWithVAD(
+        JNIEnv*       env,
+        jobject       jthis,
+        jint          execution_type,
+        jfloatArray   samples_real400,
+        jbooleanArray is_active
+) {
+    jboolean isCopy;
+    jfloat*  samples_real400_jfloat = env->GetFloatArrayElements( samples_real400, &isCopy );
 
-            re[ k ] = (float) cos( theta ); // re
-            im[ k ] = (float) sin( theta ); // im
-        }
+    jfloat   mfcc_27_fft_256_jfloat[ 27 + 256 ];
+    bool     active;
+    if ( execution_type == 0 ) {
+        active = mfccInst.generateMFCCAndPowerSpectrumWithVAD_neon( samples_real400_jfloat, mfcc_27_fft_256_jfloat );
     }
-
-
-    float mTwiddle512re[256];
-    float mTwiddle512im[256];
-    float mTwiddle256re[128];
-    float mTwiddle256im[128];
-    float mTwiddle128re[ 64];
-    float mTwiddle128im[ 64];
-    float mTwiddle64re [ 32];
-    float mTwiddle64im [ 32];
-    float mTwiddle32re [ 16];
-    float mTwiddle32im [ 16];
-    float mTwiddle16re [  8];
-    float mTwiddle16im [  8];
-    float mTwiddle8re  [  4];
-    float mTwiddle8im  [  4];
-    float mTwiddle4re  [  2];
-    float mTwiddle4im  [  2];
-    float mTwiddle2re  [  1];
-    float mTwiddle2im  [  1];
-
-    float mArrayIn512re [512];// Input to 512 FFT
-    float mArrayIn512im [512];
-    float mArrayIn256re [512];
-    float mArrayIn256im [512];
-    float mArrayIn128re [512];
-    float mArrayIn128im [512];
-    float mArrayIn64re  [512];
-    float mArrayIn64im  [512];
-    float mArrayIn32re  [512];
-    float mArrayIn32im  [512];
-    float mArrayIn16re  [512];
-    float mArrayIn16im  [512];
-    float mArrayIn8re   [512];
-    float mArrayIn8im   [512];
-    float mArrayIn4re   [512];
-    float mArrayIn4im   [512];
-    float mArrayIn2re   [512];
-    float mArrayIn2im   [512];
-
-    float mArrayOut512re [512];// Output to 512 FFT
-    float mArrayOut512im [512];
-    float mArrayOut256re [512];
-    float mArrayOut256im [512];
-    float mArrayOut128re [512];
-    float mArrayOut128im [512];
-    float mArrayOut64re  [512];
-    float mArrayOut64im  [512];
-    float mArrayOut32re  [512];
-    float mArrayOut32im  [512];
-    float mArrayOut16re  [512];
-    float mArrayOut16im  [512];
-    float mArrayOut8re   [512];
-    float mArrayOut8im   [512];
-    float mArrayOut4re   [512];
-    float mArrayOut4im   [512];
-    float mArrayOut2re   [512];
-    float mArrayOut2im   [512];
-
-    inline void cooley_tukey_fft_2( const size_t pos_base ) {
-
-        float *const array_in_re       = mArrayIn2re;
-        float *const array_in_im       = mArrayIn2im;
-        float *const array_out_re      = mArrayOut2re;
-        float *const array_out_im      = mArrayOut2im;
-
-        const float * const twiddle_re = mTwiddle2re;
-        const float * const twiddle_im = mTwiddle2im;
-
-        // Butterfly
-        const float tw_re = twiddle_re[ 0 ];
-        const float tw_im = twiddle_im[ 0 ];
-
-        const float v1_re = array_in_re [ pos_base     ];
-        const float v1_im = array_in_im [ pos_base     ];
-        const float v2_re = array_in_re [ pos_base + 1 ];
-        const float v2_im = array_in_im [ pos_base + 1 ];
-
-        array_out_re[ pos_base     ] = v1_re + v2_re;
-        array_out_im[ pos_base     ] = v1_im + v2_im;
-        array_out_re[ pos_base + 1 ] = v1_re - v2_re;
-        array_out_im[ pos_base + 1 ] = v1_im - v2_im;
+    else {
+        active = mfccInst.generateMFCCAndPowerSpectrumWithVAD_cpp( samples_real400_jfloat, mfcc_27_fft_256_jfloat );
     }
+    env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, JNI_ABORT );
 
+    const jboolean active_jboolean = active ? JNI_TRUE : JNI_FALSE;
+    env->SetBooleanArrayRegion( is_active, 0, 1, &active_jboolean );
 
-    inline void cooley_tukey_fft_4( const size_t pos_base ) {
-
-        const size_t half_width = 2;
-
-        float *const array_in_re        = mArrayIn4re;
-        float *const array_in_im        = mArrayIn4im;
-        float *const array_in_child_re  = mArrayIn2re;
-        float *const array_in_child_im  = mArrayIn2im;
-
-        float *const array_out_re       = mArrayOut4re;
-        float *const array_out_im       = mArrayOut4im;
-        float *const array_out_child_re = mArrayOut2re;
-        float *const array_out_child_im = mArrayOut2im;
-
-        const float * const twiddle_re  = mTwiddle4re;
-        const float * const twiddle_im  = mTwiddle4im;
-
-        // Splitting into even and odd.
-
-        array_in_child_re[ pos_base              ] = array_in_re[ pos_base     ]; // even re
-        array_in_child_im[ pos_base              ] = array_in_im[ pos_base     ]; // even re
-        array_in_child_re[ pos_base + half_width ] = array_in_re[ pos_base + 1 ]; // odd re
-        array_in_child_im[ pos_base + half_width ] = array_in_im[ pos_base + 1 ]; // odd re
-
-        array_in_child_re[ pos_base + 1              ] = array_in_re[ pos_base + 2 ]; // even re
-        array_in_child_im[ pos_base + 1              ] = array_in_im[ pos_base + 2 ]; // even re
-        array_in_child_re[ pos_base + half_width + 1 ] = array_in_re[ pos_base + 3 ]; // odd re
-        array_in_child_im[ pos_base + half_width + 1 ] = array_in_im[ pos_base + 3 ]; // odd re
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_2( pos_base              );
-        cooley_tukey_fft_2( pos_base + half_width );
-
-        // Butterfly
-        {
-            const float v1_re = array_out_child_re[ pos_base              ];
-            const float v1_im = array_out_child_im[ pos_base              ];
-            const float v2_re = array_out_child_re[ pos_base + half_width ];
-            const float v2_im = array_out_child_im[ pos_base + half_width ];
-
-            array_out_re[ pos_base              ] = v1_re + v2_re;
-            array_out_im[ pos_base              ] = v1_im + v2_im;
-            array_out_re[ pos_base + half_width ] = v1_re - v2_re;
-            array_out_im[ pos_base + half_width ] = v1_im - v2_im;
-        }
-        {
-            const float v1_re = array_out_child_re[ pos_base + 1              ];
-            const float v1_im = array_out_child_im[ pos_base + 1              ];
-            const float v2_re = array_out_child_re[ pos_base + half_width + 1 ];
-            const float v2_im = array_out_child_im[ pos_base + half_width + 1 ];
-
-            array_out_re[ pos_base + 1              ] = v1_re + v2_im;
-            array_out_im[ pos_base + 1              ] = v1_im - v2_re;
-            array_out_re[ pos_base + half_width + 1 ] = v1_re - v2_im;
-            array_out_im[ pos_base + half_width + 1 ] = v1_im + v2_re;
-
-        }
-
+    if ( !active && !mfccInst.mVADEmitsSilence ) {
+        return nullptr;
     }
 
-
-    inline void cooley_tukey_fft_8_cpp( const size_t pos_base ) {
-
-        const size_t half_width = 4;
-
-        float *const array_in_re = mArrayIn8re;
-        float *const array_in_im = mArrayIn8im;
-        float *const array_in_child_re = mArrayIn4re;
-        float *const array_in_child_im = mArrayIn4im;
-
-        float *const array_out_re = mArrayOut8re;
-        float *const array_out_im = mArrayOut8im;
-        float *const array_out_child_re = mArrayOut4re;
-        float *const array_out_child_im = mArrayOut4im;
-
-        const float *const twiddle_re = mTwiddle8re;
-        const float *const twiddle_im = mTwiddle8im;
-
-        // Splitting into even and odd.
-
-        for (size_t i = 0; i < half_width; i++) {
-
-            array_in_child_re[ pos_base + i              ] = array_in_re[ pos_base + 2 * i     ]; // even re
-            array_in_child_im[ pos_base + i              ] = array_in_im[ pos_base + 2 * i     ]; // even re
-            array_in_child_re[ pos_base + half_width + i ] = array_in_re[ pos_base + 2 * i + 1 ]; // odd re
-            array_in_child_im[ pos_base + half_width + i ] = array_in_im[ pos_base + 2 * i + 1 ]; // odd re
-        }
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_4( pos_base );
-        cooley_tukey_fft_4( pos_base + half_width );
-
-        // Butterfly
-        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    jfloatArray mfcc_27_fft_256 = env->NewFloatArray( 27 + 256 );
+    if ( mfcc_27_fft_256 == nullptr ) {
+        return nullptr;
     }
+    env->SetFloatArrayRegion( mfcc_27_fft_256, 0, 27 + 256, mfcc_27_fft_256_jfloat );
 
-#ifdef HAVE_NEON
-    inline void cooley_tukey_fft_8_neon( const size_t pos_base ) {
-
-        const size_t half_width = 4;
-
-        float *const array_in_re = mArrayIn8re;
-        float *const array_in_im = mArrayIn8im;
-        float *const array_in_child_re = mArrayIn4re;
-        float *const array_in_child_im = mArrayIn4im;
-
-        float *const array_out_re = mArrayOut8re;
-        float *const array_out_im = mArrayOut8im;
-        float *const array_out_child_re = mArrayOut4re;
-        float *const array_out_child_im = mArrayOut4im;
-
-        const float *const twiddle_re = mTwiddle8re;
-        const float *const twiddle_im = mTwiddle8im;
-
-        // Splitting into even and odd.
-        float32x4x2_t interleaved_chunk = vld2q_f32( &(array_in_re[ pos_base ]) );
-        vst1q_f32( (float32_t *)( &(array_in_child_re[pos_base    ]) ), interleaved_chunk.val[0] );
-        vst1q_f32( (float32_t *)( &(array_in_child_re[pos_base + 4]) ), interleaved_chunk.val[1] );
+    return mfcc_27_fft_256;
+}
 
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_4( pos_base );
-        cooley_tukey_fft_4( pos_base + half_width );
+extern "C" JNIEXPORT jintArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateMFCCFixedPoint(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jshortArray samples_int16_400
+) {
+    jboolean isCopy;
+    jshort*  samples_int16_400_jshort = env->GetShortArrayElements( samples_int16_400, &isCopy );
 
-        // Butterfly
-        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    jintArray mfcc_27;
+    mfcc_27 = env->NewIntArray( 27 );
+    if ( mfcc_27 == nullptr ) {
+        env->ReleaseShortArrayElements( samples_int16_400, samples_int16_400_jshort, JNI_ABORT );
+        return nullptr;
     }
-#endif
 
-
-    inline void cooley_tukey_fft_16_cpp( const size_t pos_base ) {
-
-        const size_t half_width = 8;
-
-        float *const array_in_re        = mArrayIn16re;
-        float *const array_in_im        = mArrayIn16im;
-        float *const array_in_child_re  = mArrayIn8re;
-        float *const array_in_child_im  = mArrayIn8im;
-
-        float *const array_out_re       = mArrayOut16re;
-        float *const array_out_im       = mArrayOut16im;
-        float *const array_out_child_re = mArrayOut8re;
-        float *const array_out_child_im = mArrayOut8im;
-
-        const float * const twiddle_re  = mTwiddle16re;
-        const float * const twiddle_im  = mTwiddle16im;
-
-        // Splitting into even and odd.
-
-        deinterleave_cpp(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_cpp(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_8_cpp( pos_base              );
-        cooley_tukey_fft_8_cpp( pos_base + half_width );
-
-        // Butterfly
-        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    jint mfcc_27_jint[ 27 ];
+    if ( execution_type == 0 ) {
+        mfccFixedPointInst.generateMFCC_neon( samples_int16_400_jshort, mfcc_27_jint );
     }
-
-#ifdef HAVE_NEON
-    inline void cooley_tukey_fft_16_neon( const size_t pos_base ) {
-
-        const size_t half_width = 8;
-
-        float *const array_in_re        = mArrayIn16re;
-        float *const array_in_im        = mArrayIn16im;
-        float *const array_in_child_re  = mArrayIn8re;
-        float *const array_in_child_im  = mArrayIn8im;
-
-        float *const array_out_re       = mArrayOut16re;
-        float *const array_out_im       = mArrayOut16im;
-        float *const array_out_child_re = mArrayOut8re;
-        float *const array_out_child_im = mArrayOut8im;
-
-        const float * const twiddle_re  = mTwiddle16re;
-        const float * const twiddle_im  = mTwiddle16im;
-
-        // Splitting into even and odd.
-        deinterleave_neon(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_neon(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_8_neon( pos_base              );
-        cooley_tukey_fft_8_neon( pos_base + half_width );
-
-        // Butterfly
-        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    else {
+        mfccFixedPointInst.generateMFCC_cpp( samples_int16_400_jshort, mfcc_27_jint );
     }
-#endif
-
-
-    inline void cooley_tukey_fft_32_cpp( const size_t pos_base ) {
-
-        const size_t half_width = 16;
 
-        float *const array_in_re        = mArrayIn32re;
-        float *const array_in_im        = mArrayIn32im;
-        float *const array_in_child_re  = mArrayIn16re;
-        float *const array_in_child_im  = mArrayIn16im;
+    env->SetIntArrayRegion        ( mfcc_27, 0, 27, mfcc_27_jint );
+    env->ReleaseShortArrayElements( samples_int16_400, samples_int16_400_jshort, JNI_ABORT );
 
-        float *const array_out_re       = mArrayOut32re;
-        float *const array_out_im       = mArrayOut32im;
-        float *const array_out_child_re = mArrayOut16re;
-        float *const array_out_child_im = mArrayOut16im;
-
-        const float * const twiddle_re  = mTwiddle32re;
-        const float * const twiddle_im  = mTwiddle32im;
-
-        // Splitting into even and odd.
-
-        deinterleave_cpp(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
+    return mfcc_27;
+}
 
-        deinterleave_cpp(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_setInt8Quantization(
+        JNIEnv*     env,
+        jobject     jthis,
+        jfloat      mfcc_scale,
+        jint        mfcc_zero_point,
+        jfloat      spectrum_scale,
+        jint        spectrum_zero_point
+) {
+    mfccInst.setInt8Quantization( mfcc_scale, mfcc_zero_point, spectrum_scale, spectrum_zero_point );
+}
 
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_16_cpp( pos_base              );
-        cooley_tukey_fft_16_cpp( pos_base + half_width );
+extern "C" JNIEXPORT jshortArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateMFCCAndPowerSpectrumFP16(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jfloatArray samples_real400
+) {
+    jboolean isCopy;
+    jfloat*  samples_real400_jfloat = env->GetFloatArrayElements( samples_real400, &isCopy );
 
-        // Butterfly
-        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    jshortArray mfcc_27_fft_256;
+    mfcc_27_fft_256 = env->NewShortArray( 27 + 256 );
+    if ( mfcc_27_fft_256 == nullptr ) {
+        env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, JNI_ABORT );
+        return nullptr;
     }
 
-#ifdef HAVE_NEON
-    inline void cooley_tukey_fft_32_neon( const size_t pos_base ) {
-
-        const size_t half_width = 16;
-
-        float *const array_in_re        = mArrayIn32re;
-        float *const array_in_im        = mArrayIn32im;
-        float *const array_in_child_re  = mArrayIn16re;
-        float *const array_in_child_im  = mArrayIn16im;
-
-        float *const array_out_re       = mArrayOut32re;
-        float *const array_out_im       = mArrayOut32im;
-        float *const array_out_child_re = mArrayOut16re;
-        float *const array_out_child_im = mArrayOut16im;
-
-        const float * const twiddle_re  = mTwiddle32re;
-        const float * const twiddle_im  = mTwiddle32im;
-
-        // Splitting into even and odd.
-        deinterleave_neon(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_neon(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_16_neon( pos_base              );
-        cooley_tukey_fft_16_neon( pos_base + half_width );
-
-        // Butterfly
-        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    uint16_t mfcc_27_fft_256_fp16[ 27 + 256 ];
+    if ( execution_type == 0 ) {
+        mfccInst.generateMFCCAndPowerSpectrumFP16_neon( samples_real400_jfloat, mfcc_27_fft_256_fp16 );
     }
-#endif
-
-
-    inline void cooley_tukey_fft_64_cpp( const size_t pos_base ) {
-
-        const size_t half_width = 32;
-
-        float *const array_in_re        = mArrayIn64re;
-        float *const array_in_im        = mArrayIn64im;
-        float *const array_in_child_re  = mArrayIn32re;
-        float *const array_in_child_im  = mArrayIn32im;
-
-        float *const array_out_re       = mArrayOut64re;
-        float *const array_out_im       = mArrayOut64im;
-        float *const array_out_child_re = mArrayOut32re;
-        float *const array_out_child_im = mArrayOut32im;
-
-        const float * const twiddle_re  = mTwiddle64re;
-        const float * const twiddle_im  = mTwiddle64im;
-
-        // Splitting into even and odd.
-        deinterleave_cpp(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_cpp(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_32_cpp( pos_base              );
-        cooley_tukey_fft_32_cpp( pos_base + half_width );
-
-        // Butterfly
-        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    else {
+        mfccInst.generateMFCCAndPowerSpectrumFP16_cpp( samples_real400_jfloat, mfcc_27_fft_256_fp16 );
     }
 
-#ifdef HAVE_NEON
-    inline void cooley_tukey_fft_64_neon( const size_t pos_base ) {
-
-        const size_t half_width = 32;
+    env->SetShortArrayRegion      ( mfcc_27_fft_256, 0, 27 + 256, (jshort*)mfcc_27_fft_256_fp16 );
+    env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, JNI_ABORT );
 
-        float *const array_in_re        = mArrayIn64re;
-        float *const array_in_im        = mArrayIn64im;
-        float *const array_in_child_re  = mArrayIn32re;
-        float *const array_in_child_im  = mArrayIn32im;
-
-        float *const array_out_re       = mArrayOut64re;
-        float *const array_out_im       = mArrayOut64im;
-        float *const array_out_child_re = mArrayOut32re;
-        float *const array_out_child_im = mArrayOut32im;
-
-        const float * const twiddle_re  = mTwiddle64re;
-        const float * const twiddle_im  = mTwiddle64im;
-
-        // Splitting into even and odd.
-        deinterleave_neon(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_neon(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
+    return mfcc_27_fft_256;
+}
 
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_32_neon( pos_base              );
-        cooley_tukey_fft_32_neon( pos_base + half_width );
+extern "C" JNIEXPORT jbyteArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateMFCCAndPowerSpectrumInt8(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jfloatArray samples_real400
+) {
+    jboolean isCopy;
+    jfloat*  samples_real400_jfloat = env->GetFloatArrayElements( samples_real400, &isCopy );
 
-        // Butterfly
-        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    jbyteArray mfcc_27_fft_256;
+    mfcc_27_fft_256 = env->NewByteArray( 27 + 256 );
+    if ( mfcc_27_fft_256 == nullptr ) {
+        env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, JNI_ABORT );
+        return nullptr;
     }
-#endif
-
-    inline void cooley_tukey_fft_128_cpp( const size_t pos_base ) {
 
-        const size_t half_width = 64;
-
-        float *const array_in_re        = mArrayIn128re;
-        float *const array_in_im        = mArrayIn128im;
-        float *const array_in_child_re  = mArrayIn64re;
-        float *const array_in_child_im  = mArrayIn64im;
-
-        float *const array_out_re       = mArrayOut128re;
-        float *const array_out_im       = mArrayOut128im;
-        float *const array_out_child_re = mArrayOut64re;
-        float *const array_out_child_im = mArrayOut64im;
-
-        const float * const twiddle_re  = mTwiddle128re;
-        const float * const twiddle_im  = mTwiddle128im;
-
-        // Splitting into even and odd.
-        deinterleave_cpp(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_cpp(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_64_cpp( pos_base );
-        cooley_tukey_fft_64_cpp( pos_base + half_width );
-
-        // Butterfly
-        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    int8_t mfcc_27_fft_256_int8[ 27 + 256 ];
+    if ( execution_type == 0 ) {
+        mfccInst.generateMFCCAndPowerSpectrumInt8_neon( samples_real400_jfloat, mfcc_27_fft_256_int8 );
     }
-
-#ifdef HAVE_NEON
-    inline void cooley_tukey_fft_128_neon( const size_t pos_base ) {
-
-        const size_t half_width = 64;
-
-        float *const array_in_re        = mArrayIn128re;
-        float *const array_in_im        = mArrayIn128im;
-        float *const array_in_child_re  = mArrayIn64re;
-        float *const array_in_child_im  = mArrayIn64im;
-
-        float *const array_out_re       = mArrayOut128re;
-        float *const array_out_im       = mArrayOut128im;
-        float *const array_out_child_re = mArrayOut64re;
-        float *const array_out_child_im = mArrayOut64im;
-
-        const float * const twiddle_re  = mTwiddle128re;
-        const float * const twiddle_im  = mTwiddle128im;
-
-        // Splitting into even and odd.
-        deinterleave_neon(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_neon(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_64_neon(pos_base);
-        cooley_tukey_fft_64_neon(pos_base + half_width);
-
-        // Butterfly
-        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    else {
+        mfccInst.generateMFCCAndPowerSpectrumInt8_cpp( samples_real400_jfloat, mfcc_27_fft_256_int8 );
     }
-#endif
-
-    inline void cooley_tukey_fft_256_cpp( const size_t pos_base ) {
-
-        const size_t half_width = 128;
-
-        float *const array_in_re        = mArrayIn256re;
-        float *const array_in_im        = mArrayIn256im;
-        float *const array_in_child_re  = mArrayIn128re;
-        float *const array_in_child_im  = mArrayIn128im;
-
-        float *const array_out_re       = mArrayOut256re;
-        float *const array_out_im       = mArrayOut256im;
-        float *const array_out_child_re = mArrayOut128re;
-        float *const array_out_child_im = mArrayOut128im;
-
-        const float * const twiddle_re  = mTwiddle256re;
-        const float * const twiddle_im  = mTwiddle256im;
 
-        // Splitting into even and odd.
-        deinterleave_cpp(
-            &( array_in_re      [ pos_base ] ),
-            half_width * 2,
-            &( array_in_child_re[ pos_base ] ),
-            &( array_in_child_re[ pos_base + half_width ] ) );
+    env->SetByteArrayRegion       ( mfcc_27_fft_256, 0, 27 + 256, mfcc_27_fft_256_int8 );
+    env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, JNI_ABORT );
 
-        deinterleave_cpp(
-            &( array_in_im      [ pos_base ] ),
-            half_width * 2,
-            &( array_in_child_im[ pos_base ] ),
-            &( array_in_child_im[ pos_base + half_width ] ) );
+    return mfcc_27_fft_256;
+}
 
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_128_cpp( pos_base              );
-        cooley_tukey_fft_128_cpp( pos_base + half_width );
+extern "C" JNIEXPORT jfloatArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateFeatures(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jint        outputs,
+        jfloatArray samples_real400
+) {
+    const int numFeatures = MFCC::numFeatures( (unsigned int)outputs );
 
-        // Butterfly
-        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    jfloatArray features = env->NewFloatArray( numFeatures );
+    if ( features == nullptr ) {
+        return nullptr;
     }
 
-#ifdef HAVE_NEON
-    inline void cooley_tukey_fft_256_neon( const size_t pos_base ) {
-
-        const size_t half_width = 128;
-
-        float *const array_in_re        = mArrayIn256re;
-        float *const array_in_im        = mArrayIn256im;
-        float *const array_in_child_re  = mArrayIn128re;
-        float *const array_in_child_im  = mArrayIn128im;
-
-        float *const array_out_re       = mArrayOut256re;
-        float *const array_out_im       = mArrayOut256im;
-        float *const array_out_child_re = mArrayOut128re;
-        float *const array_out_child_im = mArrayOut128im;
-
-        const float * const twiddle_re  = mTwiddle256re;
-        const float * const twiddle_im  = mTwiddle256im;
-
-        // Splitting into even and odd.
-        deinterleave_neon(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_neon(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_128_neon( pos_base              );
-        cooley_tukey_fft_128_neon( pos_base + half_width );
+    jboolean isCopy;
+    jfloat*  samples_real400_jfloat = env->GetFloatArrayElements( samples_real400, &isCopy );
 
-        // Butterfly
-        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    jfloat features_jfloat[ MFCC::cMaxNumFeatures ];
+    if ( execution_type == 0 ) {
+        mfccInst.generateFeatures_neon( samples_real400_jfloat, (unsigned int)outputs, features_jfloat );
     }
-#endif
-
-    inline void cooley_tukey_fft_512_cpp( const size_t pos_base ) {
-
-        const size_t half_width = 256;
-
-        float * const array_in_re        = mArrayIn512re;
-        float * const array_in_im        = mArrayIn512im;
-        float * const array_in_child_re  = mArrayIn256re;
-        float * const array_in_child_im  = mArrayIn256im;
-
-        float * const array_out_re       = mArrayOut512re;
-        float * const array_out_im       = mArrayOut512im;
-        float * const array_out_child_re = mArrayOut256re;
-        float * const array_out_child_im = mArrayOut256im;
-
-        const float * const twiddle_re   = mTwiddle512re;
-        const float * const twiddle_im   = mTwiddle512im;
-
-        // Splitting into even and odd.
-        deinterleave_cpp(
-            &( array_in_re      [ pos_base ] ),
-            half_width * 2,
-            &( array_in_child_re[ pos_base ] ),
-            &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_cpp(
-            &( array_in_im      [ pos_base ] ),
-            half_width * 2,
-            &( array_in_child_im[ pos_base ] ),
-            &( array_in_child_im[ pos_base + half_width ] ) );
-
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_256_cpp( pos_base              );
-        cooley_tukey_fft_256_cpp( pos_base + half_width );
-
-        // Butterfly
-        butterfly_cpp( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    else {
+        mfccInst.generateFeatures_cpp( samples_real400_jfloat, (unsigned int)outputs, features_jfloat );
     }
 
-#ifdef HAVE_NEON
-    inline void cooley_tukey_fft_512_neon( const size_t pos_base ) {
-
-        const size_t half_width = 256;
-
-        float * const array_in_re        = mArrayIn512re;
-        float * const array_in_im        = mArrayIn512im;
-        float * const array_in_child_re  = mArrayIn256re;
-        float * const array_in_child_im  = mArrayIn256im;
-
-        float * const array_out_re       = mArrayOut512re;
-        float * const array_out_im       = mArrayOut512im;
-        float * const array_out_child_re = mArrayOut256re;
-        float * const array_out_child_im = mArrayOut256im;
+    env->SetFloatArrayRegion      ( features, 0, numFeatures, features_jfloat );
+    env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, JNI_ABORT );
 
-        const float * const twiddle_re   = mTwiddle512re;
-        const float * const twiddle_im   = mTwiddle512im;
-
-        // Splitting into even and odd.
-        deinterleave_neon(
-                &( array_in_re      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_re[ pos_base ] ),
-                &( array_in_child_re[ pos_base + half_width ] ) );
-
-        deinterleave_neon(
-                &( array_in_im      [ pos_base ] ),
-                half_width * 2,
-                &( array_in_child_im[ pos_base ] ),
-                &( array_in_child_im[ pos_base + half_width ] ) );
+    return features;
+}
 
-        // Recursive FFT expected to be expanded here.
-        cooley_tukey_fft_256_neon( pos_base              );
-        cooley_tukey_fft_256_neon( pos_base + half_width );
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_setFeatureCache(
+        JNIEnv*     env,
+        jobject     jthis,
+        jlong       memory_bytes,
+        jstring     disk_directory
+) {
+    featureCacheInst.setMemoryCapacity( (size_t)std::max( memory_bytes, (jlong)0 ) );
 
-        // Butterfly
-        butterfly_neon( twiddle_re, twiddle_im, array_out_child_re, array_out_child_im, array_out_re, array_out_im, pos_base, half_width );
+    if ( disk_directory == nullptr ) {
+        featureCacheInst.setDiskDirectory( nullptr );
     }
-#endif
-
-    inline void butterfly_cpp(
-        const float * const twiddle_re,
-        const float * const twiddle_im,
-        float * const       array_in_re,
-        float * const       array_in_im,
-        float * const       array_out_re,
-        float * const       array_out_im,
-        const int           pos_base,
-        const int           half_width
-    ) {
-
-        for ( size_t i = 0; i < half_width; i++ ) {
-
-            const float tw_re = twiddle_re[ i ];
-            const float tw_im = twiddle_im[ i ];
-
-            const float v1_re = array_in_re[ pos_base + i              ];
-            const float v1_im = array_in_im[ pos_base + i              ];
-            const float v2_re = array_in_re[ pos_base + half_width + i ];
-            const float v2_im = array_in_im[ pos_base + half_width + i ];
-
-            const float offset_re = tw_re * v2_re - tw_im * v2_im;
-            const float offset_im = tw_re * v2_im + tw_im * v2_re;
-
-            array_out_re[ pos_base + i              ] = v1_re + offset_re;
-            array_out_im[ pos_base + i              ] = v1_im + offset_im;
-            array_out_re[ pos_base + half_width + i ] = v1_re - offset_re;
-            array_out_im[ pos_base + half_width + i ] = v1_im - offset_im;
-        }
-    }
-
-#ifdef HAVE_NEON
-    inline void butterfly_neon(
-            const float * const twiddle_re,
-            const float * const twiddle_im,
-            float * const       array_in_re,
-            float * const       array_in_im,
-            float * const       array_out_re,
-            float * const       array_out_im,
-            const int           pos_base,
-            const int           half_width
-    ) {
-        for ( size_t i = 0; i < half_width; i+=4 ) {
-
-            const float32x4_t tw_re     = vld1q_f32( &( twiddle_re[i] )                          );
-            const float32x4_t tw_im     = vld1q_f32( &( twiddle_im[i] )                          );
-            const float32x4_t v1_re_pre = vld1q_f32( &( array_in_re[pos_base + i] )              );
-            const float32x4_t v1_im_pre = vld1q_f32( &( array_in_im[pos_base + i] )              );
-            const float32x4_t v2_re_pre = vld1q_f32( &( array_in_re[pos_base + half_width + i] ) );
-            const float32x4_t v2_im_pre = vld1q_f32( &( array_in_im[pos_base + half_width + i] ) );
-
-            // const float offset_re = tw_re * v2_re - tw_im * v2_im;
-            const float32x4_t offset_re_part1 = vmulq_f32( tw_re, v2_re_pre );
-            const float32x4_t offset_re       = vmlsq_f32( offset_re_part1, tw_im, v2_im_pre );
-
-            // const float offset_im = tw_re * v2_im + tw_im * v2_re;
-            const float32x4_t offset_im_part1 = vmulq_f32( tw_re, v2_im_pre );
-            const float32x4_t offset_im       = vmlaq_f32( offset_im_part1, tw_im, v2_re_pre );
-
-            const float32x4_t v1_re = vaddq_f32( v1_re_pre, offset_re );
-            const float32x4_t v1_im = vaddq_f32( v1_im_pre, offset_im );
-            const float32x4_t v2_re = vsubq_f32( v1_re_pre, offset_re );
-            const float32x4_t v2_im = vsubq_f32( v1_im_pre, offset_im );
-
-            vst1q_f32( &( array_out_re[ pos_base + i              ] ), v1_re );
-            vst1q_f32( &( array_out_re[ pos_base + half_width + i ] ), v2_re );
-            vst1q_f32( &( array_out_im[ pos_base + i              ] ), v1_im );
-            vst1q_f32( &( array_out_im[ pos_base + half_width + i ] ), v2_im );
-        }
+    else {
+        const char* disk_directory_chars = env->GetStringUTFChars( disk_directory, nullptr );
+        featureCacheInst.setDiskDirectory( disk_directory_chars );
+        env->ReleaseStringUTFChars( disk_directory, disk_directory_chars );
     }
-#endif
+}
 
-    inline void deinterleave_cpp( const float * const src, const int src_len, float* const even, float* const odd ) {
+extern "C" JNIEXPORT jfloatArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateFeaturesBatch(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jint        outputs,
+        jfloatArray samples
+) {
+    const jsize numSamples  = env->GetArrayLength( samples );
+    const jsize numFeatures = MFCC::numFrames( numSamples ) * MFCC::numFeatures( (unsigned int)outputs );
 
-        for ( size_t dst_i = 0; dst_i < src_len / 2; dst_i++ ) {
-            even[dst_i] = src[ dst_i * 2     ];
-            odd [dst_i] = src[ dst_i * 2 + 1 ];
-        }
+    jfloatArray features = env->NewFloatArray( numFeatures );
+    if ( features == nullptr ) {
+        return nullptr;
     }
 
+    jboolean isCopy;
+    jfloat*  samples_jfloat  = env->GetFloatArrayElements( samples,  &isCopy );
+    jfloat*  features_jfloat = env->GetFloatArrayElements( features, &isCopy );
 
-#ifdef HAVE_NEON
-    inline void deinterleave_neon( const float * const src, const int src_len, float* const even, float* const odd ) {
-
-        for ( size_t dst_i = 0; dst_i < src_len/2; dst_i += 4 ) {
-
-            float32x4x2_t interleaved_chunk = vld2q_f32( &(src[dst_i*2]) );
-
-            vst1q_f32( (float32_t *)( &( even[dst_i] ) ), interleaved_chunk.val[0] );
-            vst1q_f32( (float32_t *)( &(  odd[dst_i] ) ), interleaved_chunk.val[1] );
-
-        }
+    if ( execution_type == 0 ) {
+        featureCacheInst.generateFeaturesBatch_neon( samples_jfloat, numSamples, (unsigned int)outputs, features_jfloat );
     }
-#endif
-
-};
-
-
-class sampleToBin {
-
-public:
-    sampleToBin()
-            :mBin1   ( -1)
-            ,mBin2   ( -1)
-            ,mCoeff1 (0.0)
-            ,mCoeff2 (0.0) {;}
-
-    void setValues( const int bin1, const int bin2, const double coeff1 ) {
-
-        mBin1   = bin1;
-        mBin2   = bin2;
-        mCoeff1 = coeff1;
-        mCoeff2 = (1.0 - coeff1);
+    else {
+        featureCacheInst.generateFeaturesBatch_cpp( samples_jfloat, numSamples, (unsigned int)outputs, features_jfloat );
     }
 
+    env->ReleaseFloatArrayElements( features, features_jfloat, 0         );
+    env->ReleaseFloatArrayElements( samples,  samples_jfloat,  JNI_ABORT );
 
-    int    bin1()   const { return mBin1;   }
-    int    bin2()   const { return mBin2;   }
-    double coeff1() const { return mCoeff1; }
-    double coeff2() const { return mCoeff2; }
-
-private:
-    int    mBin1;
-    int    mBin2;
-    double mCoeff1;
-    double mCoeff2;
-
-};
-
-
-class MelFilterBanks {
-
-public:
-    static const int   cNumFilterBanks ;
-    static const int   cNumSamples;
-    static const float cNumSamplesD;
-    static const float cSampleRate;
-    static const float cHalfSampleRate;
-    static const float cFilterBankMaxFreq;
-    static const float cFilterBankMinFreq;
-    static const float cMelFloor;
-
-
-    /** @brief constructor.
-     */
-    MelFilterBanks () {
-
-        mSampleToBin = new sampleToBin[ cNumSamples ];
-        constructSampleToBin( cNumSamples );
-
-    }
-
-    ~MelFilterBanks () {
-        delete[] mSampleToBin;
-    }
+    return features;
+}
 
-    /** @brief find log Mel filter bank coefficients
-     *
-     *  @param points_re : (in)  first 256 points from complex 512-point FFT, real parts
-     *  @param points_im : (in)  first 256 points from complex 512-point FFT, imaginary parts
-     *  @param mel_bins  : (out) Log Mel filter bank energy coefficients in real values
-     */
-    void findLogMelCoeffs( float* points_re, float* points_im, float* mel_bins ) {
-
-        for ( int i = 0; i < cNumFilterBanks; i++ ) {
-            mel_bins[ i ] = 0.0;
-        }
-
-        for ( int i = 0; i < cNumSamples; i++ ) {
-
-            sampleToBin& stb = mSampleToBin[ i ];
-
-            const float& re  = points_re[ i ];
-            const float& im  = points_im[ i ];
-            const float& pwr = re*re + im*im;
-
-            if ( stb.bin1() != -1 )  {
-                mel_bins[ stb.bin1() ] += ( pwr * stb.coeff1() ) ;
-            }
-            if ( stb.bin2() != -1)  {
-                mel_bins[ stb.bin2() ] += ( pwr * stb.coeff2() );
-            }
-        }
-
-        for ( int i = 0; i < cNumFilterBanks; i++ ) {
-            if ( mel_bins[ i ] < cMelFloor ) {
-                mel_bins[ i ] = cMelFloor;
-            }
-            mel_bins[ i ] = log( mel_bins[ i ] ) ;
-        }
+extern "C" JNIEXPORT jfloatArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateFeaturesMultichannel(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jint        outputs,
+        jint        num_channels,
+        jshortArray samples
+) {
+    if ( num_channels < 1 || num_channels > MultichannelExtractor::cMaxChannels ) {
+        LOGE( "generateFeaturesMultichannel: %d channels not supported.", num_channels );
+        return nullptr;
     }
 
+    const jsize numSamples  = env->GetArrayLength( samples );
+    const jsize numFeatures = num_channels * MultichannelExtractor::numFrames( numSamples, num_channels )
+                                           * MFCC::numFeatures( (unsigned int)outputs );
 
-    void constructSampleToBin (const int numSamples ) {
-
-        mSampleToBin = new sampleToBin[ cNumSamples ];
-
-        double filterBankMaxMel = freqToMel( cFilterBankMaxFreq );
-        double filterBankMinMel = freqToMel( cFilterBankMinFreq );
-
-        double intervalMel      =     (  filterBankMaxMel -  filterBankMinMel )
-                                    / ( (float)cNumFilterBanks + 1.0 );
-
-        int   melBoundariesSamplePoint[ cNumFilterBanks + 2 ];
-        float melBoundariesMelFreq    [ cNumFilterBanks + 2 ];
-
-        for ( int i = 0; i <= cNumFilterBanks + 1 ; i++ ) {
-
-            const float& m = filterBankMinMel + (float)i * intervalMel;
-            const float& f = melToFreq( m );
-            const int    s = freqToSampleNum( f ) ;
-
-            melBoundariesSamplePoint[ i ] = s;
-            melBoundariesMelFreq    [ i ] = m;
-        }
-
-        for ( int i = 0; i < cNumSamples ; i++ ) {
-
-            const float f = sampleNumToFreq( i );
-            const float m = freqToMel( f );
-
-            if (   ( m < melBoundariesMelFreq[ 0 ]                )
-                || ( melBoundariesMelFreq[ cNumFilterBanks ]  < m ) ) {
-
-                mSampleToBin[i].setValues( -1, -1, 0.0 );
-            }
-
-            else if (    ( melBoundariesMelFreq[ 0 ] <= m  )
-                      && ( m < melBoundariesMelFreq[ 1 ]   )  ) {
-
-                mSampleToBin[i].setValues( 0, -1, ( m - melBoundariesMelFreq[0] ) / intervalMel );
-            }
-
-            else if (    ( melBoundariesMelFreq[ cNumFilterBanks  - 1 ] <= m  )
-                      && ( m < melBoundariesMelFreq[ cNumFilterBanks  ]       )  ) {
-
-                mSampleToBin[i].setValues( cNumFilterBanks  - 1 , -1, ( melBoundariesMelFreq[cNumFilterBanks ] - m ) / intervalMel );
-            }
-
-            else {
-                for ( int j = 1; j < cNumFilterBanks ; j++ ) {
-                    if (    ( melBoundariesMelFreq[ j ] <= m    )
-                         && ( m < melBoundariesMelFreq[ j + 1 ] ) ) {
-
-                        mSampleToBin[i].setValues( j , j + 1, ( melBoundariesMelFreq[j+1] - m ) / intervalMel );
-                        break;
-                    }
-                }
-            }
-        }
+    jfloatArray features = env->NewFloatArray( numFeatures );
+    if ( features == nullptr ) {
+        return nullptr;
     }
 
-    float sampleNumToFreq( const int& i ) {
+    jboolean isCopy;
+    jshort*  samples_jshort  = env->GetShortArrayElements( samples,  &isCopy );
+    jfloat*  features_jfloat = env->GetFloatArrayElements( features, &isCopy );
 
-        return ( (cHalfSampleRate / cNumSamplesD)  * (float) i );
+    if ( execution_type == 0 ) {
+        multichannelExtractorInst.extract_neon( samples_jshort, numSamples, num_channels, (unsigned int)outputs, features_jfloat );
     }
-
-    int freqToSampleNum( const float& f ) {
-
-        return (int)( ( cNumSamplesD / cHalfSampleRate ) * f ) ;
+    else {
+        multichannelExtractorInst.extract_cpp ( samples_jshort, numSamples, num_channels, (unsigned int)outputs, features_jfloat );
     }
 
-    float freqToMel ( const float& f ) {
+    env->ReleaseFloatArrayElements( features, features_jfloat, 0         );
+    env->ReleaseShortArrayElements( samples,  samples_jshort,  JNI_ABORT );
 
-        return 1125.0 * log( 1.0 + f / 700.0);
-    }
-
-    float melToFreq ( const float& m ) {
+    return features;
+}
 
-        return  700.0 * ( exp( m / 1125.0) - 1.0 );
+extern "C" JNIEXPORT jshortArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_resampleTo16KHz(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jint        input_rate,
+        jshortArray samples
+) {
+    if ( resamplerInst == nullptr || resamplerInst->inputRate() != input_rate ) {
+        delete resamplerInst;
+        resamplerInst = new PolyphaseResampler( input_rate, (int)MFCC::cSampleRate );
     }
 
-    sampleToBin* mSampleToBin;
-
-};
+    const jsize numSamples = env->GetArrayLength( samples );
 
-const int   MelFilterBanks::cNumFilterBanks    =    26;
-const int   MelFilterBanks::cNumSamples        =   256;
-const float MelFilterBanks::cNumSamplesD       =   256.0;
-const float MelFilterBanks::cSampleRate        = 16000.0;
-const float MelFilterBanks::cHalfSampleRate    =  8000.0;
-const float MelFilterBanks::cFilterBankMaxFreq =  8000.0;
-const float MelFilterBanks::cFilterBankMinFreq =   300.0;
-const float MelFilterBanks::cMelFloor          =     1.0;
-
-
-class DCT {
-
-public:
-
-    /** @brief constructor. it pre-calculates a table.
-     *
-     *  @param numPoints : number of points in the input.
-     */
-    DCT ( const int numPoints ) {
-
-        mNumPoints = numPoints;
-        mNumPointsRoundUp4 = ((mNumPoints + 3) / 4) * 4;
-        makeDCTTable();
+    jboolean isCopy;
+    jshort*  samples_jshort = env->GetShortArrayElements( samples, &isCopy );
 
+    // The work buffers grow to the largest chunk seen and are reused afterwards.
+    const int maxOut = resamplerInst->maxOutputSamples( numSamples );
+    if ( (int)resamplerOut.size() < maxOut ) {
+        resamplerOut.resize     ( maxOut );
+        resamplerOutShort.resize( maxOut );
     }
 
-    ~DCT() { delete[] mDCTTable; }
-
+    const int numOut = ( execution_type == 0 ) ? resamplerInst->process_neon( samples_jshort, numSamples, resamplerOut.data() )
+                                               : resamplerInst->process_cpp ( samples_jshort, numSamples, resamplerOut.data() );
 
-    /** @brief main function for DCT
-     *  @param samples_in  : (in)  time domain samples
-     *  @param samples_out : (out) freq-domain samples
-     */
-    void transform_cpp( const float* const samples_in, float* const samples_out ) const {
+    env->ReleaseShortArrayElements( samples, samples_jshort, JNI_ABORT );
 
-        for ( int i = 0; i < mNumPoints + 1 ; i++ ) {
-
-            float val = 0.0;
-
-            for ( int j = 0; j < mNumPoints; j++ ) {
-
-                val += mDCTTable[ ( mNumPoints + 1 ) * i + j ] * samples_in[ j ];
-            }
-
-            samples_out[i] = val;
-        }
+    for ( int i = 0; i < numOut; i++ ) {
+        resamplerOutShort[ i ] = (jshort)std::min( 32767.0f, std::max( -32768.0f, roundf( resamplerOut[ i ] ) ) );
     }
 
-#ifdef HAVE_NEON
-    void transform_neon( const float* const samples_in, float* const samples_out ) const {
-
-        for ( int i = 0; i < mNumPoints + 1 ; i++ ) {
-
-            float val = 0.0;
-
-            float32x4_t sumQuadF = vdupq_n_f32(0.0);
-
-            for ( int j = 0; j < mNumPointsRoundUp4; j+=4 ) {
-
-                float32x4_t cur_sample = vld1q_f32( &( samples_in[j] ) );
-                float32x4_t cur_dct    = vld1q_f32( &( mDCTTable[( mNumPoints + 1 ) * i + j ] ) );
-                sumQuadF = vmlaq_f32( sumQuadF, cur_dct, cur_sample );
-
-            }
-
-            val += vgetq_lane_f32( sumQuadF, 0 );
-            val += vgetq_lane_f32( sumQuadF, 1 );
-            val += vgetq_lane_f32( sumQuadF, 2 );
-            val += vgetq_lane_f32( sumQuadF, 3 );
-
-            samples_out[i] = val;
-
-        }
+    jshortArray resampled = env->NewShortArray( numOut );
+    if ( resampled != nullptr ) {
+        env->SetShortArrayRegion( resampled, 0, numOut, resamplerOutShort.data() );
     }
-#endif
-
-private:
-
-    void makeDCTTable() {
-
-        // Allocate redundant memory and padd with zero for 4-lane SIMD operations.
-        mDCTTable = new float[ (mNumPoints + 1) * mNumPointsRoundUp4 ];
-        memset ( mDCTTable, 0, sizeof(float) * ( (mNumPoints + 1) * mNumPointsRoundUp4 ) );
-
-        const float C = sqrt( 2.0 / mNumPoints );
-
-        for ( int i = 0; i <= mNumPoints; i++ ) {
-
-            for (int j = 0; j < mNumPoints; j++ ) {
+    return resampled;
+}
 
-                const float di = (float)i ;
-                const float dj = (float)j + 0.5 ;
-                mDCTTable[ ( mNumPoints + 1 )* i + j ] = C * cos( M_PI * di * dj / (float)mNumPoints );
-            }
-        }
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_renderColumn(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jobject     bitmap,
+        jint        x,
+        jfloatArray values,
+        jint        offset,
+        jint        count,
+        jfloat      scale,
+        jfloat      bias,
+        jint        color_type
+) {
+    AndroidBitmapInfo info;
+    if ( AndroidBitmap_getInfo( env, bitmap, &info ) != ANDROID_BITMAP_RESULT_SUCCESS
+         || info.format != ANDROID_BITMAP_FORMAT_RGBA_8888
+         || x < 0 || x >= (jint)info.width ) {
+        return;
     }
 
-    int    mNumPoints;
-    int    mNumPointsRoundUp4;
-    float* mDCTTable;
-};
-
-
-class MFCC {
-
-public:
-
-    static constexpr float cSampleRate              = 16000.0;
-    static constexpr int   cFrameSizeSamples        = 400;     // 25[ms] @ 16KHz
-    static constexpr int   cFrameShiftSamples       = 160;     // 10[ms] @ 16KHz
-    static constexpr int   cNumPointsFFT            = 512;
-    static constexpr float cPreemphTap0             = 0.96;
-    static constexpr float cFilterBankMaxFreq       = 8000.0;
-    static constexpr float cFilterBankMinFreq       = 300.0;
-    static constexpr int   cNumFilterBanks          = 26;
-    static constexpr int   cNumFilterBankssRoundUp4 = 28;
-
-    /** @brief constructor
-     */
-    MFCC()
-        :mHammingWindow( cFrameSizeSamples, cPreemphTap0 )
-        ,mFFT512()
-        ,mMelFilterBanks()
-        ,mDCT( cNumFilterBanks )
-    {
-        memset( mWindowedSamples_re, 0, sizeof(float) * cNumPointsFFT            );
-        memset( mWindowedSamples_im, 0, sizeof(float) * cNumPointsFFT            );
-        memset( mMelFilterBankBins,  0, sizeof(float) * cNumFilterBankssRoundUp4 );
+    jfloat    values_jfloat[ 1024 ];
+    const int numValues = std::max( 0, std::min( std::min( count, (jint)info.height ), 1024 ) );
+    env->GetFloatArrayRegion( values, offset, numValues, values_jfloat );
+    if ( env->ExceptionCheck() ) {
+        return;
     }
 
-    ~MFCC() {
-        ;
+    void* pixels;
+    if ( AndroidBitmap_lockPixels( env, bitmap, &pixels ) != ANDROID_BITMAP_RESULT_SUCCESS ) {
+        return;
     }
 
-    /** @brief generates spectral density in 256 points.
-     *
-     *  @param samples_real400 : time domain 400 real samples.
-     *  @return energy density at 256 points after FFT.
-     */
-    void spectralDensity_cpp( float* samples_real400, float* power_real_256 ) {
-
-        // 1. Pre-Emphasis & Hamming window oer 400 samples.
-        mHammingWindow.preEmphasisHammingAndMakeComplexForFFT_cpp( samples_real400, mWindowedSamples_re );
-
-        // 2. 512 point FFT.
-        mFFT512.transform_cpp( mWindowedSamples_re, mWindowedSamples_im,  mFFT512_re,  mFFT512_im );
-
-        for (int i = 0; i < 256 ; i++) {
+    // values[ 0 ] at the bottom row, upwards.
+    const ptrdiff_t stride = info.stride / sizeof(uint32_t);
+    uint32_t*       bottom = static_cast< uint32_t* >( pixels ) + ( info.height - 1 ) * stride + x;
 
-            const float re = mFFT512_re[ i ];
-            const float im = mFFT512_im[ i ];
-
-            power_real_256[i] = std::max( 0.0, log10( (re * re + im * im) ) / 10.0 ) ;
-        }
+    if ( execution_type == 0 ) {
+        colormapRendererInst.renderColumn_neon( values_jfloat, numValues, scale, bias, color_type, bottom, -stride );
     }
-
-#ifdef HAVE_NEON
-    void spectralDensity_neon( float* samples_real400, float* power_real_256 ) {
-
-        // 1. Pre-Emphasis & Hamming window oer 400 samples.
-        mHammingWindow.preEmphasisHammingAndMakeComplexForFFT_neon( samples_real400, mWindowedSamples_re );
-
-        // 2. 512 point FFT.
-        mFFT512.transform_neon( mWindowedSamples_re, mWindowedSamples_im,  mFFT512_re,  mFFT512_im );
-
-        for (int i = 0; i < 256 ; i++) {
-
-            const float re = mFFT512_re[ i ];
-            const float im = mFFT512_im[ i ];
-
-            power_real_256[i] = std::max( 0.0, log10( (re * re + im * im) ) / 10.0 ) ;
-        }
+    else {
+        colormapRendererInst.renderColumn_cpp ( values_jfloat, numValues, scale, bias, color_type, bottom, -stride );
     }
-#endif
-
-    /** @brief
-     *
-     *  @param samples_real400 : time domain 400 real samples
-     *  @return real 27 MFCCs
-     */
-    void generateMFCC_cpp( float* samples_real400, float* mfcc ) {
-
-        // 1. Pre-Emphasis & Hamming window oer 400 samples.
-        mHammingWindow.preEmphasisHammingAndMakeComplexForFFT_cpp( samples_real400, mWindowedSamples_re );
-
-        // 2. 512 point FFT.
-        mFFT512.transform_cpp( mWindowedSamples_re, mWindowedSamples_im,  mFFT512_re,  mFFT512_im );
 
-        // 3. Log Mel coefficients
-        mMelFilterBanks.findLogMelCoeffs(  mFFT512_re,  mFFT512_im, mMelFilterBankBins );
+    AndroidBitmap_unlockPixels( env, bitmap );
+}
 
-        // 4. DCT
-        mDCT.transform_cpp( mMelFilterBankBins, mfcc );
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_startPipeline(
+        JNIEnv*     env,
+        jobject     jthis,
+        jint        execution_type,
+        jint        input_rate,
+        jint        queue_frames,
+        jint        drop_policy,
+        jint        post_flags
+) {
+    const std::shared_ptr< StreamingPipeline > previous = std::atomic_exchange( &pipelineInst, std::make_shared< StreamingPipeline >(
+        queue_frames, drop_policy, (unsigned int)post_flags, execution_type == 0, input_rate ) );
 
+    // A push still blocked on the previous pipeline drops its frames and returns.
+    if ( previous != nullptr ) {
+        previous->stop();
     }
+}
 
-#ifdef HAVE_NEON
-    void generateMFCC_neon( float* samples_real400, float* mfcc ) {
-
-        // 1. Pre-Emphasis & Hamming window oer 400 samples.
-        mHammingWindow.preEmphasisHammingAndMakeComplexForFFT_neon( samples_real400, mWindowedSamples_re );
-
-        // 2. 512 point FFT.
-        mFFT512.transform_neon( mWindowedSamples_re, mWindowedSamples_im,  mFFT512_re,  mFFT512_im );
-
-        // 3. Log Mel coefficients
-        mMelFilterBanks.findLogMelCoeffs(  mFFT512_re,  mFFT512_im, mMelFilterBankBins );
-
-        // 4. DCT
-        mDCT.transform_cpp( mMelFilterBankBins, mfcc );
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_stopPipeline(
+        JNIEnv*     env,
+        jobject     jthis
+) {
+    const std::shared_ptr< StreamingPipeline > previous = std::atomic_exchange( &pipelineInst, std::shared_ptr< StreamingPipeline >() );
 
+    if ( previous != nullptr ) {
+        previous->stop();
     }
-#endif
-
-    /** @brief
-      *
-      * @param samples_real400 : time domain 400 real samples
-      * @return real 27 MFCCs and real 256-point power spectrum.
-      */
-    void generateMFCCAndPowerSpectrum_cpp( float* samples_real400, float* mfcc_fft ) {
-        log_counter++;
-        // 1. Pre-Emphasis & Hamming window oer 400 samples.
-        mHammingWindow.preEmphasisHammingAndMakeComplexForFFT_cpp( samples_real400, mWindowedSamples_re );
-
-        // 2. 512 point FFT.
-        mFFT512.transform_cpp( mWindowedSamples_re, mWindowedSamples_im,  mFFT512_re,  mFFT512_im );
-
-        for (int i = 0; i < 256 ; i++) {
-
-            const float re = mFFT512_re[ i ];
-            const float im = mFFT512_im[ i ];
-
-            mfcc_fft[i+27] = std::max( 0.0, log10( (re * re + im * im) ) / 10.0 ) ;
-        }
-
-        // 3. Log Mel coefficients
-        mMelFilterBanks.findLogMelCoeffs(  mFFT512_re,  mFFT512_im, mMelFilterBankBins );
+}
 
-        // 4. DCT
-        mDCT.transform_cpp( mMelFilterBankBins, mfcc_fft );
+extern "C" JNIEXPORT jint
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_pushPipelineSamples(
+        JNIEnv*     env,
+        jobject     jthis,
+        jshortArray samples
+) {
+    const std::shared_ptr< StreamingPipeline > pipeline = std::atomic_load( &pipelineInst );
+    if ( pipeline == nullptr ) {
+        return 0;
     }
 
-#ifdef HAVE_NEON
-    void generateMFCCAndPowerSpectrum_neon( float* samples_real400, float* mfcc_fft ) {
-        log_counter++;
-        // 1. Pre-Emphasis & Hamming window oer 400 samples.
-        mHammingWindow.preEmphasisHammingAndMakeComplexForFFT_neon( samples_real400, mWindowedSamples_re );
+    const jsize numSamples = env->GetArrayLength( samples );
 
-        // 2. 512 point FFT.
-        mFFT512.transform_neon( mWindowedSamples_re, mWindowedSamples_im,  mFFT512_re,  mFFT512_im );
+    jboolean isCopy;
+    jshort*  samples_jshort = env->GetShortArrayElements( samples, &isCopy );
 
-        for (int i = 0; i < 256 ; i++) {
+    const int queued = pipeline->pushSamples( samples_jshort, numSamples );
 
-            const float re = mFFT512_re[ i ];
-            const float im = mFFT512_im[ i ];
+    env->ReleaseShortArrayElements( samples, samples_jshort, JNI_ABORT );
 
-            mfcc_fft[i+27] = std::max( 0.0, log10( (re * re + im * im) ) / 10.0 ) ;
-        }
+    return queued;
+}
 
-        // 3. Log Mel coefficients
-        mMelFilterBanks.findLogMelCoeffs(  mFFT512_re,  mFFT512_im, mMelFilterBankBins );
+extern "C" JNIEXPORT jfloatArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_pollPipelineFeatures(
+        JNIEnv*     env,
+        jobject     jthis
+) {
+    jfloat features_jfloat[ StreamingPipeline::cNumOutputs ];
 
-        // 4. DCT
-        mDCT.transform_neon( mMelFilterBankBins, mfcc_fft );
+    const std::shared_ptr< StreamingPipeline > pipeline = std::atomic_load( &pipelineInst );
+    if ( pipeline == nullptr || !pipeline->popFeatures( features_jfloat ) ) {
+        return nullptr;
     }
-#endif
-
-    HammingWindow  mHammingWindow;
-    FFT512         mFFT512;
-    MelFilterBanks mMelFilterBanks;
-    DCT            mDCT;
-
-    float mWindowedSamples_re [ cNumPointsFFT   ];
-    float mWindowedSamples_im [ cNumPointsFFT   ];
-    float mFFT512_re          [ cNumPointsFFT   ];
-    float mFFT512_im          [ cNumPointsFFT   ];
-    float mMelFilterBankBins  [ cNumFilterBankssRoundUp4 ];
-
-};
 
-static MFCC mfccInst;
+    jfloatArray features = env->NewFloatArray( StreamingPipeline::cNumOutputs );
+    if ( features != nullptr ) {
+        env->SetFloatArrayRegion( features, 0, StreamingPipeline::cNumOutputs, features_jfloat );
+    }
+    return features;
+}
 
-extern "C" JNIEXPORT jfloatArray
-JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateMFCC(
+extern "C" JNIEXPORT jlongArray
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_getPipelineStats(
         JNIEnv*     env,
-        jobject     jthis,
-        jint        execution_type,
-        jfloatArray samples_real400
+        jobject     jthis
 ) {
-    jboolean isCopy;
-    jfloat*  samples_real400_jfloat = env->GetFloatArrayElements( samples_real400, &isCopy );
-    jsize    samples_real400_size   = env->GetArrayLength       ( samples_real400 );
+    jlong stats_jlong[ 5 ] = { 0, 0, 0, 0, 0 };
 
-    jfloatArray mfcc_27;
-    mfcc_27 = env->NewFloatArray( 27 );
-    if ( mfcc_27 == nullptr ) {
-        return nullptr;
+    const std::shared_ptr< StreamingPipeline > pipeline = std::atomic_load( &pipelineInst );
+    if ( pipeline != nullptr ) {
+        stats_jlong[ 0 ] = (jlong)pipeline->numFramesIn();
+        stats_jlong[ 1 ] = (jlong)pipeline->numDropped();
+        stats_jlong[ 2 ] = (jlong)pipeline->numFramesOut();
+        stats_jlong[ 3 ] = (jlong)pipeline->meanLatencyNs() / 1000;
+        stats_jlong[ 4 ] = (jlong)pipeline->maxLatencyNs()  / 1000;
     }
 
-    jfloat mfcc_27_jfloat[ 27 ];
-    if ( execution_type == 0 ) {
-        mfccInst.generateMFCC_neon( samples_real400_jfloat, mfcc_27_jfloat );
-    }
-    else {
-        mfccInst.generateMFCC_cpp( samples_real400_jfloat, mfcc_27_jfloat );
+    jlongArray stats = env->NewLongArray( 5 );
+    if ( stats != nullptr ) {
+        env->SetLongArrayRegion( stats, 0, 5, stats_jlong );
     }
+    return stats;
+}
 
-    env->SetFloatArrayRegion      ( mfcc_27, 0, 27, mfcc_27_jfloat );
-    env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, 0 );
+extern "C" JNIEXPORT jboolean
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_startCaptureTrace(
+        JNIEnv*     env,
+        jobject     jthis,
+        jstring     path,
+        jint        sample_rate,
+        jint        num_channels,
+        jint        requested_samples,
+        jlong       start_time_ns
+) {
+    const char* path_chars = env->GetStringUTFChars( path, nullptr );
 
-    return mfcc_27;
+    std::lock_guard< std::mutex > lock( captureTraceMutex );
+    const bool ok = captureTraceInst.open( path_chars, (uint32_t)sample_rate, (uint32_t)num_channels,
+                                           (uint32_t)std::max( requested_samples, 0 ), (int64_t)start_time_ns );
 
+    env->ReleaseStringUTFChars( path, path_chars );
+    return ok ? JNI_TRUE : JNI_FALSE;
 }
 
-extern "C" JNIEXPORT jfloatArray
-JNICALL Java_com_example_android_1mfcc_MFCCCPP_generateMFCCAndPowerSpectrum(
+extern "C" JNIEXPORT void
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_appendCaptureTrace(
         JNIEnv*     env,
         jobject     jthis,
-        jint        execution_type,
-        jfloatArray samples_real400
+        jlong       timestamp_ns,
+        jshortArray samples,
+        jint        read_result
 ) {
-    jboolean isCopy;
-    jfloat*  samples_real400_jfloat = env->GetFloatArrayElements( samples_real400, &isCopy );
-    jsize    samples_real400_size   = env->GetArrayLength       ( samples_real400 );
-
-    jfloatArray mfcc_27_fft_256;
-    mfcc_27_fft_256 = env->NewFloatArray( 27 + 256 );
-    if ( mfcc_27_fft_256 == nullptr ) {
-        return nullptr;
+    std::lock_guard< std::mutex > lock( captureTraceMutex );
+    if ( !captureTraceInst.isOpen() ) {
+        return;
     }
 
-    jfloat mfcc_27_fft_256_jfloat[ 27 + 256 ];
-    if ( execution_type == 0 ) {
-        mfccInst.generateMFCCAndPowerSpectrum_neon( samples_real400_jfloat, mfcc_27_fft_256_jfloat );
-    }
-    else {
-        mfccInst.generateMFCCAndPowerSpectrum_cpp( samples_real400_jfloat, mfcc_27_fft_256_jfloat );
-    }
+    const jsize numSamples = env->GetArrayLength( samples );
 
-    env->SetFloatArrayRegion      ( mfcc_27_fft_256, 0, 27 + 256, mfcc_27_fft_256_jfloat );
-    env->ReleaseFloatArrayElements( samples_real400, samples_real400_jfloat, 0 );
+    jboolean isCopy;
+    jshort*  samples_jshort = env->GetShortArrayElements( samples, &isCopy );
 
-    return mfcc_27_fft_256;
+    captureTraceInst.append( (int64_t)timestamp_ns, samples_jshort, (uint32_t)numSamples, (int32_t)read_result );
 
+    env->ReleaseShortArrayElements( samples, samples_jshort, JNI_ABORT );
 }
 
+extern "C" JNIEXPORT jlong
+JNICALL Java_com_example_android_1mfcc_MFCCCPP_stopCaptureTrace(
+        JNIEnv*     env,
+        jobject     jthis
+) {
+    std::lock_guard< std::mutex > lock( captureTraceMutex );
+
+    const jlong numChunks = (jlong)captureTraceInst.numChunks();
+    captureTraceInst.close();
+    return numChunks;
+}
@@ -0,0 +1,844 @@
+//
+// Coefficient tables of the default configuration. Generated by host/mfcc_gen_tables.cpp.
+// Do not edit. The host build fails if it is out of date. After changing the construction of
+// the tables in mfcc.h, regenerate it from the host build directory with:
+//   cmake --build . --target mfcc_tables_update
+//
+
+#ifndef ANDROIDMFCC_MFCC_TABLES_H
+#define ANDROIDMFCC_MFCC_TABLES_H
+
+static constexpr int cTableWindowSize   = 400;
+static constexpr int cTableDCTNumPoints = 26;
+
+alignas( 16 ) static constexpr float cTableHammingWindow[ 400 ] = {
+    7.999999821e-02f, 8.005703241e-02f, 8.022812009e-02f, 8.051321656e-02f, 8.091226220e-02f, 8.142513782e-02f,
+    8.205173165e-02f, 8.279188722e-02f, 8.364541829e-02f, 8.461210877e-02f, 8.569172770e-02f, 8.688399941e-02f,
+    8.818863332e-02f, 8.960530907e-02f, 9.113366157e-02f, 9.277332574e-02f, 9.452389181e-02f, 9.638492018e-02f,
+    9.835595638e-02f, 1.004365087e-01f, 1.026260629e-01f, 1.049240679e-01f, 1.073299646e-01f, 1.098431498e-01f,
+    1.124630049e-01f, 1.151888743e-01f, 1.180200875e-01f, 1.209559441e-01f, 1.239957064e-01f, 1.271386296e-01f,
+    1.303839236e-01f, 1.337307990e-01f, 1.371784210e-01f, 1.407259256e-01f, 1.443724483e-01f, 1.481170654e-01f,
+    1.519588679e-01f, 1.558968872e-01f, 1.599301696e-01f, 1.640576869e-01f, 1.682784259e-01f, 1.725913435e-01f,
+    1.769953668e-01f, 1.814894080e-01f, 1.860723495e-01f, 1.907430589e-01f, 1.955003738e-01f, 2.003431022e-01f,
+    2.052700669e-01f, 2.102800459e-01f, 2.153717726e-01f, 2.205440104e-01f, 2.257954478e-01f, 2.311248183e-01f,
+    2.365307659e-01f, 2.420119792e-01f, 2.475670725e-01f, 2.531946898e-01f, 2.588934302e-01f, 2.646618783e-01f,
+    2.704985738e-01f, 2.764021456e-01f, 2.823710442e-01f, 2.884038389e-01f, 2.944990396e-01f, 3.006550968e-01f,
+    3.068705201e-01f, 3.131437302e-01f, 3.194732368e-01f, 3.258574009e-01f, 3.322946429e-01f, 3.387834132e-01f,
+    3.453221023e-01f, 3.519090414e-01f, 3.585426211e-01f, 3.652212024e-01f, 3.719431162e-01f, 3.787067235e-01f,
+    3.855103254e-01f, 3.923522234e-01f, 3.992307186e-01f, 4.061441422e-01f, 4.130907655e-01f, 4.200688601e-01f,
+    4.270766675e-01f, 4.341124892e-01f, 4.411745965e-01f, 4.482611716e-01f, 4.553705156e-01f, 4.625008404e-01f,
+    4.696503878e-01f, 4.768173695e-01f, 4.840000272e-01f, 4.911965430e-01f, 4.984051883e-01f, 5.056241751e-01f,
+    5.128516555e-01f, 5.200858712e-01f, 5.273249745e-01f, 5.345672965e-01f, 5.418109298e-01f, 5.490541458e-01f,
+    5.562950969e-01f, 5.635319948e-01f, 5.707630515e-01f, 5.779864788e-01f, 5.852005482e-01f, 5.924033523e-01f,
+    5.995931625e-01f, 6.067681909e-01f, 6.139267087e-01f, 6.210668683e-01f, 6.281868815e-01f, 6.352850795e-01f,
+    6.423596144e-01f, 6.494088173e-01f, 6.564308405e-01f, 6.634240150e-01f, 6.703865528e-01f, 6.773167849e-01f,
+    6.842129827e-01f, 6.910734177e-01f, 6.978963614e-01f, 7.046802044e-01f, 7.114231586e-01f, 7.181236148e-01f,
+    7.247799039e-01f, 7.313903570e-01f, 7.379533648e-01f, 7.444673181e-01f, 7.509304881e-01f, 7.573414445e-01f,
+    7.636984587e-01f, 7.699999809e-01f, 7.762445211e-01f, 7.824304700e-01f, 7.885562778e-01f, 7.946204543e-01f,
+    8.006215096e-01f, 8.065578938e-01f, 8.124282360e-01f, 8.182309866e-01f, 8.239647150e-01f, 8.296281099e-01f,
+    8.352196217e-01f, 8.407379389e-01f, 8.461816907e-01f, 8.515495062e-01f, 8.568400741e-01f, 8.620520830e-01f,
+    8.671842217e-01f, 8.722352386e-01f, 8.772038817e-01f, 8.820888400e-01f, 8.868890405e-01f, 8.916031718e-01f,
+    8.962301612e-01f, 9.007688165e-01f, 9.052179456e-01f, 9.095765948e-01f, 9.138435125e-01f, 9.180178046e-01f,
+    9.220983386e-01f, 9.260841012e-01f, 9.299741387e-01f, 9.337674379e-01f, 9.374631047e-01f, 9.410602450e-01f,
+    9.445579052e-01f, 9.479552507e-01f, 9.512514472e-01f, 9.544456601e-01f, 9.575371146e-01f, 9.605250359e-01f,
+    9.634086490e-01f, 9.661872983e-01f, 9.688602090e-01f, 9.714268446e-01f, 9.738864303e-01f, 9.762384295e-01f,
+    9.784823060e-01f, 9.806174040e-01f, 9.826433063e-01f, 9.845593572e-01f, 9.863651991e-01f, 9.880604148e-01f,
+    9.896444678e-01f, 9.911170006e-01f, 9.924777150e-01f, 9.937261939e-01f, 9.948621988e-01f, 9.958853722e-01f,
+    9.967955351e-01f, 9.975923896e-01f, 9.982757568e-01f, 9.988455176e-01f, 9.993014932e-01f, 9.996435642e-01f,
+    9.998716712e-01f, 9.999857545e-01f, 9.999857545e-01f, 9.998716712e-01f, 9.996435642e-01f, 9.993014932e-01f,
+    9.988455176e-01f, 9.982757568e-01f, 9.975923896e-01f, 9.967955351e-01f, 9.958853722e-01f, 9.948621988e-01f,
+    9.937261939e-01f, 9.924777150e-01f, 9.911170006e-01f, 9.896444678e-01f, 9.880604148e-01f, 9.863651991e-01f,
+    9.845593572e-01f, 9.826433063e-01f, 9.806174040e-01f, 9.784823060e-01f, 9.762384295e-01f, 9.738864303e-01f,
+    9.714268446e-01f, 9.688602090e-01f, 9.661872983e-01f, 9.634086490e-01f, 9.605250359e-01f, 9.575371146e-01f,
+    9.544456601e-01f, 9.512514472e-01f, 9.479552507e-01f, 9.445579052e-01f, 9.410602450e-01f, 9.374631047e-01f,
+    9.337674379e-01f, 9.299741387e-01f, 9.260841012e-01f, 9.220983386e-01f, 9.180178046e-01f, 9.138435125e-01f,
+    9.095765948e-01f, 9.052179456e-01f, 9.007688165e-01f, 8.962301612e-01f, 8.916031718e-01f, 8.868890405e-01f,
+    8.820888400e-01f, 8.772038817e-01f, 8.722352386e-01f, 8.671842217e-01f, 8.620520830e-01f, 8.568400741e-01f,
+    8.515495062e-01f, 8.461816907e-01f, 8.407379389e-01f, 8.352196217e-01f, 8.296281099e-01f, 8.239647150e-01f,
+    8.182309866e-01f, 8.124282360e-01f, 8.065578938e-01f, 8.006215096e-01f, 7.946204543e-01f, 7.885562778e-01f,
+    7.824304700e-01f, 7.762445211e-01f, 7.699999809e-01f, 7.636984587e-01f, 7.573414445e-01f, 7.509304881e-01f,
+    7.444673181e-01f, 7.379533648e-01f, 7.313903570e-01f, 7.247799039e-01f, 7.181236148e-01f, 7.114231586e-01f,
+    7.046802044e-01f, 6.978963614e-01f, 6.910734177e-01f, 6.842129827e-01f, 6.773167849e-01f, 6.703865528e-01f,
+    6.634240150e-01f, 6.564308405e-01f, 6.494088173e-01f, 6.423596144e-01f, 6.352850795e-01f, 6.281868815e-01f,
+    6.210668683e-01f, 6.139267087e-01f, 6.067681909e-01f, 5.995931625e-01f, 5.924033523e-01f, 5.852005482e-01f,
+    5.779864788e-01f, 5.707630515e-01f, 5.635319948e-01f, 5.562950969e-01f, 5.490541458e-01f, 5.418109298e-01f,
+    5.345672965e-01f, 5.273249745e-01f, 5.200858712e-01f, 5.128516555e-01f, 5.056241751e-01f, 4.984051883e-01f,
+    4.911965430e-01f, 4.840000272e-01f, 4.768173695e-01f, 4.696503878e-01f, 4.625008404e-01f, 4.553705156e-01f,
+    4.482611716e-01f, 4.411745965e-01f, 4.341124892e-01f, 4.270766675e-01f, 4.200688601e-01f, 4.130907655e-01f,
+    4.061441422e-01f, 3.992307186e-01f, 3.923522234e-01f, 3.855103254e-01f, 3.787067235e-01f, 3.719431162e-01f,
+    3.652212024e-01f, 3.585426211e-01f, 3.519090414e-01f, 3.453221023e-01f, 3.387834132e-01f, 3.322946429e-01f,
+    3.258574009e-01f, 3.194732368e-01f, 3.131437302e-01f, 3.068705201e-01f, 3.006550968e-01f, 2.944990396e-01f,
+    2.884038389e-01f, 2.823710442e-01f, 2.764021456e-01f, 2.704985738e-01f, 2.646618783e-01f, 2.588934302e-01f,
+    2.531946898e-01f, 2.475670725e-01f, 2.420119792e-01f, 2.365307659e-01f, 2.311248183e-01f, 2.257954478e-01f,
+    2.205440104e-01f, 2.153717726e-01f, 2.102800459e-01f, 2.052700669e-01f, 2.003431022e-01f, 1.955003738e-01f,
+    1.907430589e-01f, 1.860723495e-01f, 1.814894080e-01f, 1.769953668e-01f, 1.725913435e-01f, 1.682784259e-01f,
+    1.640576869e-01f, 1.599301696e-01f, 1.558968872e-01f, 1.519588679e-01f, 1.481170654e-01f, 1.443724483e-01f,
+    1.407259256e-01f, 1.371784210e-01f, 1.337307990e-01f, 1.303839236e-01f, 1.271386296e-01f, 1.239957064e-01f,
+    1.209559441e-01f, 1.180200875e-01f, 1.151888743e-01f, 1.124630049e-01f, 1.098431498e-01f, 1.073299646e-01f,
+    1.049240679e-01f, 1.026260629e-01f, 1.004365087e-01f, 9.835595638e-02f, 9.638492018e-02f, 9.452389181e-02f,
+    9.277332574e-02f, 9.113366157e-02f, 8.960530907e-02f, 8.818863332e-02f, 8.688399941e-02f, 8.569172770e-02f,
+    8.461210877e-02f, 8.364541829e-02f, 8.279188722e-02f, 8.205173165e-02f, 8.142513782e-02f, 8.091226220e-02f,
+    8.051321656e-02f, 8.022812009e-02f, 8.005703241e-02f, 7.999999821e-02f,
+};
+
+alignas( 16 ) static constexpr float cTableFFT512Twiddles[ 1022 ] = {
+    1.000000000e+00f, 9.999247193e-01f, 9.996988177e-01f, 9.993223548e-01f, 9.987954497e-01f, 9.981181026e-01f,
+    9.972904325e-01f, 9.963126183e-01f, 9.951847196e-01f, 9.939069748e-01f, 9.924795628e-01f, 9.909026623e-01f,
+    9.891765118e-01f, 9.873014092e-01f, 9.852776527e-01f, 9.831054807e-01f, 9.807852507e-01f, 9.783173800e-01f,
+    9.757021070e-01f, 9.729399681e-01f, 9.700312614e-01f, 9.669764638e-01f, 9.637760520e-01f, 9.604305029e-01f,
+    9.569403529e-01f, 9.533060193e-01f, 9.495281577e-01f, 9.456073046e-01f, 9.415440559e-01f, 9.373390079e-01f,
+    9.329928160e-01f, 9.285060763e-01f, 9.238795042e-01f, 9.191138744e-01f, 9.142097831e-01f, 9.091680050e-01f,
+    9.039893150e-01f, 8.986744881e-01f, 8.932242990e-01f, 8.876396418e-01f, 8.819212914e-01f, 8.760700822e-01f,
+    8.700869679e-01f, 8.639728427e-01f, 8.577286005e-01f, 8.513551950e-01f, 8.448535800e-01f, 8.382247090e-01f,
+    8.314695954e-01f, 8.245893121e-01f, 8.175848126e-01f, 8.104571700e-01f, 8.032075167e-01f, 7.958369255e-01f,
+    7.883464098e-01f, 7.807372212e-01f, 7.730104327e-01f, 7.651672363e-01f, 7.572088242e-01f, 7.491363883e-01f,
+    7.409511209e-01f, 7.326542735e-01f, 7.242470980e-01f, 7.157308459e-01f, 7.071067691e-01f, 6.983762383e-01f,
+    6.895405650e-01f, 6.806010008e-01f, 6.715589762e-01f, 6.624158025e-01f, 6.531728506e-01f, 6.438315511e-01f,
+    6.343932748e-01f, 6.248595119e-01f, 6.152315736e-01f, 6.055110693e-01f, 5.956993103e-01f, 5.857978463e-01f,
+    5.758081675e-01f, 5.657318234e-01f, 5.555702448e-01f, 5.453249812e-01f, 5.349976420e-01f, 5.245896578e-01f,
+    5.141027570e-01f, 5.035383701e-01f, 4.928981960e-01f, 4.821837842e-01f, 4.713967443e-01f, 4.605387151e-01f,
+    4.496113360e-01f, 4.386162460e-01f, 4.275550842e-01f, 4.164295495e-01f, 4.052413106e-01f, 3.939920366e-01f,
+    3.826834261e-01f, 3.713172078e-01f, 3.598950505e-01f, 3.484186828e-01f, 3.368898630e-01f, 3.253102899e-01f,
+    3.136817515e-01f, 3.020059466e-01f, 2.902846634e-01f, 2.785196900e-01f, 2.667127550e-01f, 2.548656464e-01f,
+    2.429801822e-01f, 2.310581058e-01f, 2.191012353e-01f, 2.071113735e-01f, 1.950903237e-01f, 1.830398887e-01f,
+    1.709618866e-01f, 1.588581502e-01f, 1.467304677e-01f, 1.345807016e-01f, 1.224106774e-01f, 1.102222055e-01f,
+    9.801714122e-02f, 8.579730988e-02f, 7.356456667e-02f, 6.132073700e-02f, 4.906767607e-02f, 3.680722415e-02f,
+    2.454122901e-02f, 1.227153838e-02f, 6.123234263e-17f, -1.227153838e-02f, -2.454122901e-02f, -3.680722415e-02f,
+    -4.906767607e-02f, -6.132073700e-02f, -7.356456667e-02f, -8.579730988e-02f, -9.801714122e-02f, -1.102222055e-01f,
+    -1.224106774e-01f, -1.345807016e-01f, -1.467304677e-01f, -1.588581502e-01f, -1.709618866e-01f, -1.830398887e-01f,
+    -1.950903237e-01f, -2.071113735e-01f, -2.191012353e-01f, -2.310581058e-01f, -2.429801822e-01f, -2.548656464e-01f,
+    -2.667127550e-01f, -2.785196900e-01f, -2.902846634e-01f, -3.020059466e-01f, -3.136817515e-01f, -3.253102899e-01f,
+    -3.368898630e-01f, -3.484186828e-01f, -3.598950505e-01f, -3.713172078e-01f, -3.826834261e-01f, -3.939920366e-01f,
+    -4.052413106e-01f, -4.164295495e-01f, -4.275550842e-01f, -4.386162460e-01f, -4.496113360e-01f, -4.605387151e-01f,
+    -4.713967443e-01f, -4.821837842e-01f, -4.928981960e-01f, -5.035383701e-01f, -5.141027570e-01f, -5.245896578e-01f,
+    -5.349976420e-01f, -5.453249812e-01f, -5.555702448e-01f, -5.657318234e-01f, -5.758081675e-01f, -5.857978463e-01f,
+    -5.956993103e-01f, -6.055110693e-01f, -6.152315736e-01f, -6.248595119e-01f, -6.343932748e-01f, -6.438315511e-01f,
+    -6.531728506e-01f, -6.624158025e-01f, -6.715589762e-01f, -6.806010008e-01f, -6.895405650e-01f, -6.983762383e-01f,
+    -7.071067691e-01f, -7.157308459e-01f, -7.242470980e-01f, -7.326542735e-01f, -7.409511209e-01f, -7.491363883e-01f,
+    -7.572088242e-01f, -7.651672363e-01f, -7.730104327e-01f, -7.807372212e-01f, -7.883464098e-01f, -7.958369255e-01f,
+    -8.032075167e-01f, -8.104571700e-01f, -8.175848126e-01f, -8.245893121e-01f, -8.314695954e-01f, -8.382247090e-01f,
+    -8.448535800e-01f, -8.513551950e-01f, -8.577286005e-01f, -8.639728427e-01f, -8.700869679e-01f, -8.760700822e-01f,
+    -8.819212914e-01f, -8.876396418e-01f, -8.932242990e-01f, -8.986744881e-01f, -9.039893150e-01f, -9.091680050e-01f,
+    -9.142097831e-01f, -9.191138744e-01f, -9.238795042e-01f, -9.285060763e-01f, -9.329928160e-01f, -9.373390079e-01f,
+    -9.415440559e-01f, -9.456073046e-01f, -9.495281577e-01f, -9.533060193e-01f, -9.569403529e-01f, -9.604305029e-01f,
+    -9.637760520e-01f, -9.669764638e-01f, -9.700312614e-01f, -9.729399681e-01f, -9.757021070e-01f, -9.783173800e-01f,
+    -9.807852507e-01f, -9.831054807e-01f, -9.852776527e-01f, -9.873014092e-01f, -9.891765118e-01f, -9.909026623e-01f,
+    -9.924795628e-01f, -9.939069748e-01f, -9.951847196e-01f, -9.963126183e-01f, -9.972904325e-01f, -9.981181026e-01f,
+    -9.987954497e-01f, -9.993223548e-01f, -9.996988177e-01f, -9.999247193e-01f, -0.000000000e+00f, -1.227153838e-02f,
+    -2.454122901e-02f, -3.680722415e-02f, -4.906767607e-02f, -6.132073700e-02f, -7.356456667e-02f, -8.579730988e-02f,
+    -9.801714122e-02f, -1.102222055e-01f, -1.224106774e-01f, -1.345807016e-01f, -1.467304677e-01f, -1.588581502e-01f,
+    -1.709618866e-01f, -1.830398887e-01f, -1.950903237e-01f, -2.071113735e-01f, -2.191012353e-01f, -2.310581058e-01f,
+    -2.429801822e-01f, -2.548656464e-01f, -2.667127550e-01f, -2.785196900e-01f, -2.902846634e-01f, -3.020059466e-01f,
+    -3.136817515e-01f, -3.253102899e-01f, -3.368898630e-01f, -3.484186828e-01f, -3.598950505e-01f, -3.713172078e-01f,
+    -3.826834261e-01f, -3.939920366e-01f, -4.052413106e-01f, -4.164295495e-01f, -4.275550842e-01f, -4.386162460e-01f,
+    -4.496113360e-01f, -4.605387151e-01f, -4.713967443e-01f, -4.821837842e-01f, -4.928981960e-01f, -5.035383701e-01f,
+    -5.141027570e-01f, -5.245896578e-01f, -5.349976420e-01f, -5.453249812e-01f, -5.555702448e-01f, -5.657318234e-01f,
+    -5.758081675e-01f, -5.857978463e-01f, -5.956993103e-01f, -6.055110693e-01f, -6.152315736e-01f, -6.248595119e-01f,
+    -6.343932748e-01f, -6.438315511e-01f, -6.531728506e-01f, -6.624158025e-01f, -6.715589762e-01f, -6.806010008e-01f,
+    -6.895405650e-01f, -6.983762383e-01f, -7.071067691e-01f, -7.157308459e-01f, -7.242470980e-01f, -7.326542735e-01f,
+    -7.409511209e-01f, -7.491363883e-01f, -7.572088242e-01f, -7.651672363e-01f, -7.730104327e-01f, -7.807372212e-01f,
+    -7.883464098e-01f, -7.958369255e-01f, -8.032075167e-01f, -8.104571700e-01f, -8.175848126e-01f, -8.245893121e-01f,
+    -8.314695954e-01f, -8.382247090e-01f, -8.448535800e-01f, -8.513551950e-01f, -8.577286005e-01f, -8.639728427e-01f,
+    -8.700869679e-01f, -8.760700822e-01f, -8.819212914e-01f, -8.876396418e-01f, -8.932242990e-01f, -8.986744881e-01f,
+    -9.039893150e-01f, -9.091680050e-01f, -9.142097831e-01f, -9.191138744e-01f, -9.238795042e-01f, -9.285060763e-01f,
+    -9.329928160e-01f, -9.373390079e-01f, -9.415440559e-01f, -9.456073046e-01f, -9.495281577e-01f, -9.533060193e-01f,
+    -9.569403529e-01f, -9.604305029e-01f, -9.637760520e-01f, -9.669764638e-01f, -9.700312614e-01f, -9.729399681e-01f,
+    -9.757021070e-01f, -9.783173800e-01f, -9.807852507e-01f, -9.831054807e-01f, -9.852776527e-01f, -9.873014092e-01f,
+    -9.891765118e-01f, -9.909026623e-01f, -9.924795628e-01f, -9.939069748e-01f, -9.951847196e-01f, -9.963126183e-01f,
+    -9.972904325e-01f, -9.981181026e-01f, -9.987954497e-01f, -9.993223548e-01f, -9.996988177e-01f, -9.999247193e-01f,
+    -1.000000000e+00f, -9.999247193e-01f, -9.996988177e-01f, -9.993223548e-01f, -9.987954497e-01f, -9.981181026e-01f,
+    -9.972904325e-01f, -9.963126183e-01f, -9.951847196e-01f, -9.939069748e-01f, -9.924795628e-01f, -9.909026623e-01f,
+    -9.891765118e-01f, -9.873014092e-01f, -9.852776527e-01f, -9.831054807e-01f, -9.807852507e-01f, -9.783173800e-01f,
+    -9.757021070e-01f, -9.729399681e-01f, -9.700312614e-01f, -9.669764638e-01f, -9.637760520e-01f, -9.604305029e-01f,
+    -9.569403529e-01f, -9.533060193e-01f, -9.495281577e-01f, -9.456073046e-01f, -9.415440559e-01f, -9.373390079e-01f,
+    -9.329928160e-01f, -9.285060763e-01f, -9.238795042e-01f, -9.191138744e-01f, -9.142097831e-01f, -9.091680050e-01f,
+    -9.039893150e-01f, -8.986744881e-01f, -8.932242990e-01f, -8.876396418e-01f, -8.819212914e-01f, -8.760700822e-01f,
+    -8.700869679e-01f, -8.639728427e-01f, -8.577286005e-01f, -8.513551950e-01f, -8.448535800e-01f, -8.382247090e-01f,
+    -8.314695954e-01f, -8.245893121e-01f, -8.175848126e-01f, -8.104571700e-01f, -8.032075167e-01f, -7.958369255e-01f,
+    -7.883464098e-01f, -7.807372212e-01f, -7.730104327e-01f, -7.651672363e-01f, -7.572088242e-01f, -7.491363883e-01f,
+    -7.409511209e-01f, -7.326542735e-01f, -7.242470980e-01f, -7.157308459e-01f, -7.071067691e-01f, -6.983762383e-01f,
+    -6.895405650e-01f, -6.806010008e-01f, -6.715589762e-01f, -6.624158025e-01f, -6.531728506e-01f, -6.438315511e-01f,
+    -6.343932748e-01f, -6.248595119e-01f, -6.152315736e-01f, -6.055110693e-01f, -5.956993103e-01f, -5.857978463e-01f,
+    -5.758081675e-01f, -5.657318234e-01f, -5.555702448e-01f, -5.453249812e-01f, -5.349976420e-01f, -5.245896578e-01f,
+    -5.141027570e-01f, -5.035383701e-01f, -4.928981960e-01f, -4.821837842e-01f, -4.713967443e-01f, -4.605387151e-01f,
+    -4.496113360e-01f, -4.386162460e-01f, -4.275550842e-01f, -4.164295495e-01f, -4.052413106e-01f, -3.939920366e-01f,
+    -3.826834261e-01f, -3.713172078e-01f, -3.598950505e-01f, -3.484186828e-01f, -3.368898630e-01f, -3.253102899e-01f,
+    -3.136817515e-01f, -3.020059466e-01f, -2.902846634e-01f, -2.785196900e-01f, -2.667127550e-01f, -2.548656464e-01f,
+    -2.429801822e-01f, -2.310581058e-01f, -2.191012353e-01f, -2.071113735e-01f, -1.950903237e-01f, -1.830398887e-01f,
+    -1.709618866e-01f, -1.588581502e-01f, -1.467304677e-01f, -1.345807016e-01f, -1.224106774e-01f, -1.102222055e-01f,
+    -9.801714122e-02f, -8.579730988e-02f, -7.356456667e-02f, -6.132073700e-02f, -4.906767607e-02f, -3.680722415e-02f,
+    -2.454122901e-02f, -1.227153838e-02f, 1.000000000e+00f, 9.996988177e-01f, 9.987954497e-01f, 9.972904325e-01f,
+    9.951847196e-01f, 9.924795628e-01f, 9.891765118e-01f, 9.852776527e-01f, 9.807852507e-01f, 9.757021070e-01f,
+    9.700312614e-01f, 9.637760520e-01f, 9.569403529e-01f, 9.495281577e-01f, 9.415440559e-01f, 9.329928160e-01f,
+    9.238795042e-01f, 9.142097831e-01f, 9.039893150e-01f, 8.932242990e-01f, 8.819212914e-01f, 8.700869679e-01f,
+    8.577286005e-01f, 8.448535800e-01f, 8.314695954e-01f, 8.175848126e-01f, 8.032075167e-01f, 7.883464098e-01f,
+    7.730104327e-01f, 7.572088242e-01f, 7.409511209e-01f, 7.242470980e-01f, 7.071067691e-01f, 6.895405650e-01f,
+    6.715589762e-01f, 6.531728506e-01f, 6.343932748e-01f, 6.152315736e-01f, 5.956993103e-01f, 5.758081675e-01f,
+    5.555702448e-01f, 5.349976420e-01f, 5.141027570e-01f, 4.928981960e-01f, 4.713967443e-01f, 4.496113360e-01f,
+    4.275550842e-01f, 4.052413106e-01f, 3.826834261e-01f, 3.598950505e-01f, 3.368898630e-01f, 3.136817515e-01f,
+    2.902846634e-01f, 2.667127550e-01f, 2.429801822e-01f, 2.191012353e-01f, 1.950903237e-01f, 1.709618866e-01f,
+    1.467304677e-01f, 1.224106774e-01f, 9.801714122e-02f, 7.356456667e-02f, 4.906767607e-02f, 2.454122901e-02f,
+    6.123234263e-17f, -2.454122901e-02f, -4.906767607e-02f, -7.356456667e-02f, -9.801714122e-02f, -1.224106774e-01f,
+    -1.467304677e-01f, -1.709618866e-01f, -1.950903237e-01f, -2.191012353e-01f, -2.429801822e-01f, -2.667127550e-01f,
+    -2.902846634e-01f, -3.136817515e-01f, -3.368898630e-01f, -3.598950505e-01f, -3.826834261e-01f, -4.052413106e-01f,
+    -4.275550842e-01f, -4.496113360e-01f, -4.713967443e-01f, -4.928981960e-01f, -5.141027570e-01f, -5.349976420e-01f,
+    -5.555702448e-01f, -5.758081675e-01f, -5.956993103e-01f, -6.152315736e-01f, -6.343932748e-01f, -6.531728506e-01f,
+    -6.715589762e-01f, -6.895405650e-01f, -7.071067691e-01f, -7.242470980e-01f, -7.409511209e-01f, -7.572088242e-01f,
+    -7.730104327e-01f, -7.883464098e-01f, -8.032075167e-01f, -8.175848126e-01f, -8.314695954e-01f, -8.448535800e-01f,
+    -8.577286005e-01f, -8.700869679e-01f, -8.819212914e-01f, -8.932242990e-01f, -9.039893150e-01f, -9.142097831e-01f,
+    -9.238795042e-01f, -9.329928160e-01f, -9.415440559e-01f, -9.495281577e-01f, -9.569403529e-01f, -9.637760520e-01f,
+    -9.700312614e-01f, -9.757021070e-01f, -9.807852507e-01f, -9.852776527e-01f, -9.891765118e-01f, -9.924795628e-01f,
+    -9.951847196e-01f, -9.972904325e-01f, -9.987954497e-01f, -9.996988177e-01f, -0.000000000e+00f, -2.454122901e-02f,
+    -4.906767607e-02f, -7.356456667e-02f, -9.801714122e-02f, -1.224106774e-01f, -1.467304677e-01f, -1.709618866e-01f,
+    -1.950903237e-01f, -2.191012353e-01f, -2.429801822e-01f, -2.667127550e-01f, -2.902846634e-01f, -3.136817515e-01f,
+    -3.368898630e-01f, -3.598950505e-01f, -3.826834261e-01f, -4.052413106e-01f, -4.275550842e-01f, -4.496113360e-01f,
+    -4.713967443e-01f, -4.928981960e-01f, -5.141027570e-01f, -5.349976420e-01f, -5.555702448e-01f, -5.758081675e-01f,
+    -5.956993103e-01f, -6.152315736e-01f, -6.343932748e-01f, -6.531728506e-01f, -6.715589762e-01f, -6.895405650e-01f,
+    -7.071067691e-01f, -7.242470980e-01f, -7.409511209e-01f, -7.572088242e-01f, -7.730104327e-01f, -7.883464098e-01f,
+    -8.032075167e-01f, -8.175848126e-01f, -8.314695954e-01f, -8.448535800e-01f, -8.577286005e-01f, -8.700869679e-01f,
+    -8.819212914e-01f, -8.932242990e-01f, -9.039893150e-01f, -9.142097831e-01f, -9.238795042e-01f, -9.329928160e-01f,
+    -9.415440559e-01f, -9.495281577e-01f, -9.569403529e-01f, -9.637760520e-01f, -9.700312614e-01f, -9.757021070e-01f,
+    -9.807852507e-01f, -9.852776527e-01f, -9.891765118e-01f, -9.924795628e-01f, -9.951847196e-01f, -9.972904325e-01f,
+    -9.987954497e-01f, -9.996988177e-01f, -1.000000000e+00f, -9.996988177e-01f, -9.987954497e-01f, -9.972904325e-01f,
+    -9.951847196e-01f, -9.924795628e-01f, -9.891765118e-01f, -9.852776527e-01f, -9.807852507e-01f, -9.757021070e-01f,
+    -9.700312614e-01f, -9.637760520e-01f, -9.569403529e-01f, -9.495281577e-01f, -9.415440559e-01f, -9.329928160e-01f,
+    -9.238795042e-01f, -9.142097831e-01f, -9.039893150e-01f, -8.932242990e-01f, -8.819212914e-01f, -8.700869679e-01f,
+    -8.577286005e-01f, -8.448535800e-01f, -8.314695954e-01f, -8.175848126e-01f, -8.032075167e-01f, -7.883464098e-01f,
+    -7.730104327e-01f, -7.572088242e-01f, -7.409511209e-01f, -7.242470980e-01f, -7.071067691e-01f, -6.895405650e-01f,
+    -6.715589762e-01f, -6.531728506e-01f, -6.343932748e-01f, -6.152315736e-01f, -5.956993103e-01f, -5.758081675e-01f,
+    -5.555702448e-01f, -5.349976420e-01f, -5.141027570e-01f, -4.928981960e-01f, -4.713967443e-01f, -4.496113360e-01f,
+    -4.275550842e-01f, -4.052413106e-01f, -3.826834261e-01f, -3.598950505e-01f, -3.368898630e-01f, -3.136817515e-01f,
+    -2.902846634e-01f, -2.667127550e-01f, -2.429801822e-01f, -2.191012353e-01f, -1.950903237e-01f, -1.709618866e-01f,
+    -1.467304677e-01f, -1.224106774e-01f, -9.801714122e-02f, -7.356456667e-02f, -4.906767607e-02f, -2.454122901e-02f,
+    1.000000000e+00f, 9.987954497e-01f, 9.951847196e-01f, 9.891765118e-01f, 9.807852507e-01f, 9.700312614e-01f,
+    9.569403529e-01f, 9.415440559e-01f, 9.238795042e-01f, 9.039893150e-01f, 8.819212914e-01f, 8.577286005e-01f,
+    8.314695954e-01f, 8.032075167e-01f, 7.730104327e-01f, 7.409511209e-01f, 7.071067691e-01f, 6.715589762e-01f,
+    6.343932748e-01f, 5.956993103e-01f, 5.555702448e-01f, 5.141027570e-01f, 4.713967443e-01f, 4.275550842e-01f,
+    3.826834261e-01f, 3.368898630e-01f, 2.902846634e-01f, 2.429801822e-01f, 1.950903237e-01f, 1.467304677e-01f,
+    9.801714122e-02f, 4.906767607e-02f, 6.123234263e-17f, -4.906767607e-02f, -9.801714122e-02f, -1.467304677e-01f,
+    -1.950903237e-01f, -2.429801822e-01f, -2.902846634e-01f, -3.368898630e-01f, -3.826834261e-01f, -4.275550842e-01f,
+    -4.713967443e-01f, -5.141027570e-01f, -5.555702448e-01f, -5.956993103e-01f, -6.343932748e-01f, -6.715589762e-01f,
+    -7.071067691e-01f, -7.409511209e-01f, -7.730104327e-01f, -8.032075167e-01f, -8.314695954e-01f, -8.577286005e-01f,
+    -8.819212914e-01f, -9.039893150e-01f, -9.238795042e-01f, -9.415440559e-01f, -9.569403529e-01f, -9.700312614e-01f,
+    -9.807852507e-01f, -9.891765118e-01f, -9.951847196e-01f, -9.987954497e-01f, -0.000000000e+00f, -4.906767607e-02f,
+    -9.801714122e-02f, -1.467304677e-01f, -1.950903237e-01f, -2.429801822e-01f, -2.902846634e-01f, -3.368898630e-01f,
+    -3.826834261e-01f, -4.275550842e-01f, -4.713967443e-01f, -5.141027570e-01f, -5.555702448e-01f, -5.956993103e-01f,
+    -6.343932748e-01f, -6.715589762e-01f, -7.071067691e-01f, -7.409511209e-01f, -7.730104327e-01f, -8.032075167e-01f,
+    -8.314695954e-01f, -8.577286005e-01f, -8.819212914e-01f, -9.039893150e-01f, -9.238795042e-01f, -9.415440559e-01f,
+    -9.569403529e-01f, -9.700312614e-01f, -9.807852507e-01f, -9.891765118e-01f, -9.951847196e-01f, -9.987954497e-01f,
+    -1.000000000e+00f, -9.987954497e-01f, -9.951847196e-01f, -9.891765118e-01f, -9.807852507e-01f, -9.700312614e-01f,
+    -9.569403529e-01f, -9.415440559e-01f, -9.238795042e-01f, -9.039893150e-01f, -8.819212914e-01f, -8.577286005e-01f,
+    -8.314695954e-01f, -8.032075167e-01f, -7.730104327e-01f, -7.409511209e-01f, -7.071067691e-01f, -6.715589762e-01f,
+    -6.343932748e-01f, -5.956993103e-01f, -5.555702448e-01f, -5.141027570e-01f, -4.713967443e-01f, -4.275550842e-01f,
+    -3.826834261e-01f, -3.368898630e-01f, -2.902846634e-01f, -2.429801822e-01f, -1.950903237e-01f, -1.467304677e-01f,
+    -9.801714122e-02f, -4.906767607e-02f, 1.000000000e+00f, 9.951847196e-01f, 9.807852507e-01f, 9.569403529e-01f,
+    9.238795042e-01f, 8.819212914e-01f, 8.314695954e-01f, 7.730104327e-01f, 7.071067691e-01f, 6.343932748e-01f,
+    5.555702448e-01f, 4.713967443e-01f, 3.826834261e-01f, 2.902846634e-01f, 1.950903237e-01f, 9.801714122e-02f,
+    6.123234263e-17f, -9.801714122e-02f, -1.950903237e-01f, -2.902846634e-01f, -3.826834261e-01f, -4.713967443e-01f,
+    -5.555702448e-01f, -6.343932748e-01f, -7.071067691e-01f, -7.730104327e-01f, -8.314695954e-01f, -8.819212914e-01f,
+    -9.238795042e-01f, -9.569403529e-01f, -9.807852507e-01f, -9.951847196e-01f, -0.000000000e+00f, -9.801714122e-02f,
+    -1.950903237e-01f, -2.902846634e-01f, -3.826834261e-01f, -4.713967443e-01f, -5.555702448e-01f, -6.343932748e-01f,
+    -7.071067691e-01f, -7.730104327e-01f, -8.314695954e-01f, -8.819212914e-01f, -9.238795042e-01f, -9.569403529e-01f,
+    -9.807852507e-01f, -9.951847196e-01f, -1.000000000e+00f, -9.951847196e-01f, -9.807852507e-01f, -9.569403529e-01f,
+    -9.238795042e-01f, -8.819212914e-01f, -8.314695954e-01f, -7.730104327e-01f, -7.071067691e-01f, -6.343932748e-01f,
+    -5.555702448e-01f, -4.713967443e-01f, -3.826834261e-01f, -2.902846634e-01f, -1.950903237e-01f, -9.801714122e-02f,
+    1.000000000e+00f, 9.807852507e-01f, 9.238795042e-01f, 8.314695954e-01f, 7.071067691e-01f, 5.555702448e-01f,
+    3.826834261e-01f, 1.950903237e-01f, 6.123234263e-17f, -1.950903237e-01f, -3.826834261e-01f, -5.555702448e-01f,
+    -7.071067691e-01f, -8.314695954e-01f, -9.238795042e-01f, -9.807852507e-01f, -0.000000000e+00f, -1.950903237e-01f,
+    -3.826834261e-01f, -5.555702448e-01f, -7.071067691e-01f, -8.314695954e-01f, -9.238795042e-01f, -9.807852507e-01f,
+    -1.000000000e+00f, -9.807852507e-01f, -9.238795042e-01f, -8.314695954e-01f, -7.071067691e-01f, -5.555702448e-01f,
+    -3.826834261e-01f, -1.950903237e-01f, 1.000000000e+00f, 9.238795042e-01f, 7.071067691e-01f, 3.826834261e-01f,
+    6.123234263e-17f, -3.826834261e-01f, -7.071067691e-01f, -9.238795042e-01f, -0.000000000e+00f, -3.826834261e-01f,
+    -7.071067691e-01f, -9.238795042e-01f, -1.000000000e+00f, -9.238795042e-01f, -7.071067691e-01f, -3.826834261e-01f,
+    1.000000000e+00f, 7.071067691e-01f, 6.123234263e-17f, -7.071067691e-01f, -0.000000000e+00f, -7.071067691e-01f,
+    -1.000000000e+00f, -7.071067691e-01f, 1.000000000e+00f, 6.123234263e-17f, -0.000000000e+00f, -1.000000000e+00f,
+    1.000000000e+00f, -0.000000000e+00f,
+};
+
+alignas( 16 ) static constexpr float cTablePrunedFFT512[ 1024 ] = {
+    0.000000000e+00f, 1.000000000e+00f, 1.000000000e+00f, 6.123234263e-17f, 1.000000000e+00f, 7.071067691e-01f,
+    6.123234263e-17f, -7.071067691e-01f, 1.000000000e+00f, 9.238795042e-01f, 7.071067691e-01f, 3.826834261e-01f,
+    6.123234263e-17f, -3.826834261e-01f, -7.071067691e-01f, -9.238795042e-01f, 1.000000000e+00f, 9.807852507e-01f,
+    9.238795042e-01f, 8.314695954e-01f, 7.071067691e-01f, 5.555702448e-01f, 3.826834261e-01f, 1.950903237e-01f,
+    6.123234263e-17f, -1.950903237e-01f, -3.826834261e-01f, -5.555702448e-01f, -7.071067691e-01f, -8.314695954e-01f,
+    -9.238795042e-01f, -9.807852507e-01f, 1.000000000e+00f, 9.951847196e-01f, 9.807852507e-01f, 9.569403529e-01f,
+    9.238795042e-01f, 8.819212914e-01f, 8.314695954e-01f, 7.730104327e-01f, 7.071067691e-01f, 6.343932748e-01f,
+    5.555702448e-01f, 4.713967443e-01f, 3.826834261e-01f, 2.902846634e-01f, 1.950903237e-01f, 9.801714122e-02f,
+    6.123234263e-17f, -9.801714122e-02f, -1.950903237e-01f, -2.902846634e-01f, -3.826834261e-01f, -4.713967443e-01f,
+    -5.555702448e-01f, -6.343932748e-01f, -7.071067691e-01f, -7.730104327e-01f, -8.314695954e-01f, -8.819212914e-01f,
+    -9.238795042e-01f, -9.569403529e-01f, -9.807852507e-01f, -9.951847196e-01f, 1.000000000e+00f, 9.987954497e-01f,
+    9.951847196e-01f, 9.891765118e-01f, 9.807852507e-01f, 9.700312614e-01f, 9.569403529e-01f, 9.415440559e-01f,
+    9.238795042e-01f, 9.039893150e-01f, 8.819212914e-01f, 8.577286005e-01f, 8.314695954e-01f, 8.032075167e-01f,
+    7.730104327e-01f, 7.409511209e-01f, 7.071067691e-01f, 6.715589762e-01f, 6.343932748e-01f, 5.956993103e-01f,
+    5.555702448e-01f, 5.141027570e-01f, 4.713967443e-01f, 4.275550842e-01f, 3.826834261e-01f, 3.368898630e-01f,
+    2.902846634e-01f, 2.429801822e-01f, 1.950903237e-01f, 1.467304677e-01f, 9.801714122e-02f, 4.906767607e-02f,
+    6.123234263e-17f, -4.906767607e-02f, -9.801714122e-02f, -1.467304677e-01f, -1.950903237e-01f, -2.429801822e-01f,
+    -2.902846634e-01f, -3.368898630e-01f, -3.826834261e-01f, -4.275550842e-01f, -4.713967443e-01f, -5.141027570e-01f,
+    -5.555702448e-01f, -5.956993103e-01f, -6.343932748e-01f, -6.715589762e-01f, -7.071067691e-01f, -7.409511209e-01f,
+    -7.730104327e-01f, -8.032075167e-01f, -8.314695954e-01f, -8.577286005e-01f, -8.819212914e-01f, -9.039893150e-01f,
+    -9.238795042e-01f, -9.415440559e-01f, -9.569403529e-01f, -9.700312614e-01f, -9.807852507e-01f, -9.891765118e-01f,
+    -9.951847196e-01f, -9.987954497e-01f, 1.000000000e+00f, 9.996988177e-01f, 9.987954497e-01f, 9.972904325e-01f,
+    9.951847196e-01f, 9.924795628e-01f, 9.891765118e-01f, 9.852776527e-01f, 9.807852507e-01f, 9.757021070e-01f,
+    9.700312614e-01f, 9.637760520e-01f, 9.569403529e-01f, 9.495281577e-01f, 9.415440559e-01f, 9.329928160e-01f,
+    9.238795042e-01f, 9.142097831e-01f, 9.039893150e-01f, 8.932242990e-01f, 8.819212914e-01f, 8.700869679e-01f,
+    8.577286005e-01f, 8.448535800e-01f, 8.314695954e-01f, 8.175848126e-01f, 8.032075167e-01f, 7.883464098e-01f,
+    7.730104327e-01f, 7.572088242e-01f, 7.409511209e-01f, 7.242470980e-01f, 7.071067691e-01f, 6.895405650e-01f,
+    6.715589762e-01f, 6.531728506e-01f, 6.343932748e-01f, 6.152315736e-01f, 5.956993103e-01f, 5.758081675e-01f,
+    5.555702448e-01f, 5.349976420e-01f, 5.141027570e-01f, 4.928981960e-01f, 4.713967443e-01f, 4.496113360e-01f,
+    4.275550842e-01f, 4.052413106e-01f, 3.826834261e-01f, 3.598950505e-01f, 3.368898630e-01f, 3.136817515e-01f,
+    2.902846634e-01f, 2.667127550e-01f, 2.429801822e-01f, 2.191012353e-01f, 1.950903237e-01f, 1.709618866e-01f,
+    1.467304677e-01f, 1.224106774e-01f, 9.801714122e-02f, 7.356456667e-02f, 4.906767607e-02f, 2.454122901e-02f,
+    6.123234263e-17f, -2.454122901e-02f, -4.906767607e-02f, -7.356456667e-02f, -9.801714122e-02f, -1.224106774e-01f,
+    -1.467304677e-01f, -1.709618866e-01f, -1.950903237e-01f, -2.191012353e-01f, -2.429801822e-01f, -2.667127550e-01f,
+    -2.902846634e-01f, -3.136817515e-01f, -3.368898630e-01f, -3.598950505e-01f, -3.826834261e-01f, -4.052413106e-01f,
+    -4.275550842e-01f, -4.496113360e-01f, -4.713967443e-01f, -4.928981960e-01f, -5.141027570e-01f, -5.349976420e-01f,
+    -5.555702448e-01f, -5.758081675e-01f, -5.956993103e-01f, -6.152315736e-01f, -6.343932748e-01f, -6.531728506e-01f,
+    -6.715589762e-01f, -6.895405650e-01f, -7.071067691e-01f, -7.242470980e-01f, -7.409511209e-01f, -7.572088242e-01f,
+    -7.730104327e-01f, -7.883464098e-01f, -8.032075167e-01f, -8.175848126e-01f, -8.314695954e-01f, -8.448535800e-01f,
+    -8.577286005e-01f, -8.700869679e-01f, -8.819212914e-01f, -8.932242990e-01f, -9.039893150e-01f, -9.142097831e-01f,
+    -9.238795042e-01f, -9.329928160e-01f, -9.415440559e-01f, -9.495281577e-01f, -9.569403529e-01f, -9.637760520e-01f,
+    -9.700312614e-01f, -9.757021070e-01f, -9.807852507e-01f, -9.852776527e-01f, -9.891765118e-01f, -9.924795628e-01f,
+    -9.951847196e-01f, -9.972904325e-01f, -9.987954497e-01f, -9.996988177e-01f, 0.000000000e+00f, -0.000000000e+00f,
+    -0.000000000e+00f, -1.000000000e+00f, -0.000000000e+00f, -7.071067691e-01f, -1.000000000e+00f, -7.071067691e-01f,
+    -0.000000000e+00f, -3.826834261e-01f, -7.071067691e-01f, -9.238795042e-01f, -1.000000000e+00f, -9.238795042e-01f,
+    -7.071067691e-01f, -3.826834261e-01f, -0.000000000e+00f, -1.950903237e-01f, -3.826834261e-01f, -5.555702448e-01f,
+    -7.071067691e-01f, -8.314695954e-01f, -9.238795042e-01f, -9.807852507e-01f, -1.000000000e+00f, -9.807852507e-01f,
+    -9.238795042e-01f, -8.314695954e-01f, -7.071067691e-01f, -5.555702448e-01f, -3.826834261e-01f, -1.950903237e-01f,
+    -0.000000000e+00f, -9.801714122e-02f, -1.950903237e-01f, -2.902846634e-01f, -3.826834261e-01f, -4.713967443e-01f,
+    -5.555702448e-01f, -6.343932748e-01f, -7.071067691e-01f, -7.730104327e-01f, -8.314695954e-01f, -8.819212914e-01f,
+    -9.238795042e-01f, -9.569403529e-01f, -9.807852507e-01f, -9.951847196e-01f, -1.000000000e+00f, -9.951847196e-01f,
+    -9.807852507e-01f, -9.569403529e-01f, -9.238795042e-01f, -8.819212914e-01f, -8.314695954e-01f, -7.730104327e-01f,
+    -7.071067691e-01f, -6.343932748e-01f, -5.555702448e-01f, -4.713967443e-01f, -3.826834261e-01f, -2.902846634e-01f,
+    -1.950903237e-01f, -9.801714122e-02f, -0.000000000e+00f, -4.906767607e-02f, -9.801714122e-02f, -1.467304677e-01f,
+    -1.950903237e-01f, -2.429801822e-01f, -2.902846634e-01f, -3.368898630e-01f, -3.826834261e-01f, -4.275550842e-01f,
+    -4.713967443e-01f, -5.141027570e-01f, -5.555702448e-01f, -5.956993103e-01f, -6.343932748e-01f, -6.715589762e-01f,
+    -7.071067691e-01f, -7.409511209e-01f, -7.730104327e-01f, -8.032075167e-01f, -8.314695954e-01f, -8.577286005e-01f,
+    -8.819212914e-01f, -9.039893150e-01f, -9.238795042e-01f, -9.415440559e-01f, -9.569403529e-01f, -9.700312614e-01f,
+    -9.807852507e-01f, -9.891765118e-01f, -9.951847196e-01f, -9.987954497e-01f, -1.000000000e+00f, -9.987954497e-01f,
+    -9.951847196e-01f, -9.891765118e-01f, -9.807852507e-01f, -9.700312614e-01f, -9.569403529e-01f, -9.415440559e-01f,
+    -9.238795042e-01f, -9.039893150e-01f, -8.819212914e-01f, -8.577286005e-01f, -8.314695954e-01f, -8.032075167e-01f,
+    -7.730104327e-01f, -7.409511209e-01f, -7.071067691e-01f, -6.715589762e-01f, -6.343932748e-01f, -5.956993103e-01f,
+    -5.555702448e-01f, -5.141027570e-01f, -4.713967443e-01f, -4.275550842e-01f, -3.826834261e-01f, -3.368898630e-01f,
+    -2.902846634e-01f, -2.429801822e-01f, -1.950903237e-01f, -1.467304677e-01f, -9.801714122e-02f, -4.906767607e-02f,
+    -0.000000000e+00f, -2.454122901e-02f, -4.906767607e-02f, -7.356456667e-02f, -9.801714122e-02f, -1.224106774e-01f,
+    -1.467304677e-01f, -1.709618866e-01f, -1.950903237e-01f, -2.191012353e-01f, -2.429801822e-01f, -2.667127550e-01f,
+    -2.902846634e-01f, -3.136817515e-01f, -3.368898630e-01f, -3.598950505e-01f, -3.826834261e-01f, -4.052413106e-01f,
+    -4.275550842e-01f, -4.496113360e-01f, -4.713967443e-01f, -4.928981960e-01f, -5.141027570e-01f, -5.349976420e-01f,
+    -5.555702448e-01f, -5.758081675e-01f, -5.956993103e-01f, -6.152315736e-01f, -6.343932748e-01f, -6.531728506e-01f,
+    -6.715589762e-01f, -6.895405650e-01f, -7.071067691e-01f, -7.242470980e-01f, -7.409511209e-01f, -7.572088242e-01f,
+    -7.730104327e-01f, -7.883464098e-01f, -8.032075167e-01f, -8.175848126e-01f, -8.314695954e-01f, -8.448535800e-01f,
+    -8.577286005e-01f, -8.700869679e-01f, -8.819212914e-01f, -8.932242990e-01f, -9.039893150e-01f, -9.142097831e-01f,
+    -9.238795042e-01f, -9.329928160e-01f, -9.415440559e-01f, -9.495281577e-01f, -9.569403529e-01f, -9.637760520e-01f,
+    -9.700312614e-01f, -9.757021070e-01f, -9.807852507e-01f, -9.852776527e-01f, -9.891765118e-01f, -9.924795628e-01f,
+    -9.951847196e-01f, -9.972904325e-01f, -9.987954497e-01f, -9.996988177e-01f, -1.000000000e+00f, -9.996988177e-01f,
+    -9.987954497e-01f, -9.972904325e-01f, -9.951847196e-01f, -9.924795628e-01f, -9.891765118e-01f, -9.852776527e-01f,
+    -9.807852507e-01f, -9.757021070e-01f, -9.700312614e-01f, -9.637760520e-01f, -9.569403529e-01f, -9.495281577e-01f,
+    -9.415440559e-01f, -9.329928160e-01f, -9.238795042e-01f, -9.142097831e-01f, -9.039893150e-01f, -8.932242990e-01f,
+    -8.819212914e-01f, -8.700869679e-01f, -8.577286005e-01f, -8.448535800e-01f, -8.314695954e-01f, -8.175848126e-01f,
+    -8.032075167e-01f, -7.883464098e-01f, -7.730104327e-01f, -7.572088242e-01f, -7.409511209e-01f, -7.242470980e-01f,
+    -7.071067691e-01f, -6.895405650e-01f, -6.715589762e-01f, -6.531728506e-01f, -6.343932748e-01f, -6.152315736e-01f,
+    -5.956993103e-01f, -5.758081675e-01f, -5.555702448e-01f, -5.349976420e-01f, -5.141027570e-01f, -4.928981960e-01f,
+    -4.713967443e-01f, -4.496113360e-01f, -4.275550842e-01f, -4.052413106e-01f, -3.826834261e-01f, -3.598950505e-01f,
+    -3.368898630e-01f, -3.136817515e-01f, -2.902846634e-01f, -2.667127550e-01f, -2.429801822e-01f, -2.191012353e-01f,
+    -1.950903237e-01f, -1.709618866e-01f, -1.467304677e-01f, -1.224106774e-01f, -9.801714122e-02f, -7.356456667e-02f,
+    -4.906767607e-02f, -2.454122901e-02f, 1.000000000e+00f, 9.999247193e-01f, 9.996988177e-01f, 9.993223548e-01f,
+    9.987954497e-01f, 9.981181026e-01f, 9.972904325e-01f, 9.963126183e-01f, 9.951847196e-01f, 9.939069748e-01f,
+    9.924795628e-01f, 9.909026623e-01f, 9.891765118e-01f, 9.873014092e-01f, 9.852776527e-01f, 9.831054807e-01f,
+    9.807852507e-01f, 9.783173800e-01f, 9.757021070e-01f, 9.729399681e-01f, 9.700312614e-01f, 9.669764638e-01f,
+    9.637760520e-01f, 9.604305029e-01f, 9.569403529e-01f, 9.533060193e-01f, 9.495281577e-01f, 9.456073046e-01f,
+    9.415440559e-01f, 9.373390079e-01f, 9.329928160e-01f, 9.285060763e-01f, 9.238795042e-01f, 9.191138744e-01f,
+    9.142097831e-01f, 9.091680050e-01f, 9.039893150e-01f, 8.986744881e-01f, 8.932242990e-01f, 8.876396418e-01f,
+    8.819212914e-01f, 8.760700822e-01f, 8.700869679e-01f, 8.639728427e-01f, 8.577286005e-01f, 8.513551950e-01f,
+    8.448535800e-01f, 8.382247090e-01f, 8.314695954e-01f, 8.245893121e-01f, 8.175848126e-01f, 8.104571700e-01f,
+    8.032075167e-01f, 7.958369255e-01f, 7.883464098e-01f, 7.807372212e-01f, 7.730104327e-01f, 7.651672363e-01f,
+    7.572088242e-01f, 7.491363883e-01f, 7.409511209e-01f, 7.326542735e-01f, 7.242470980e-01f, 7.157308459e-01f,
+    7.071067691e-01f, 6.983762383e-01f, 6.895405650e-01f, 6.806010008e-01f, 6.715589762e-01f, 6.624158025e-01f,
+    6.531728506e-01f, 6.438315511e-01f, 6.343932748e-01f, 6.248595119e-01f, 6.152315736e-01f, 6.055110693e-01f,
+    5.956993103e-01f, 5.857978463e-01f, 5.758081675e-01f, 5.657318234e-01f, 5.555702448e-01f, 5.453249812e-01f,
+    5.349976420e-01f, 5.245896578e-01f, 5.141027570e-01f, 5.035383701e-01f, 4.928981960e-01f, 4.821837842e-01f,
+    4.713967443e-01f, 4.605387151e-01f, 4.496113360e-01f, 4.386162460e-01f, 4.275550842e-01f, 4.164295495e-01f,
+    4.052413106e-01f, 3.939920366e-01f, 3.826834261e-01f, 3.713172078e-01f, 3.598950505e-01f, 3.484186828e-01f,
+    3.368898630e-01f, 3.253102899e-01f, 3.136817515e-01f, 3.020059466e-01f, 2.902846634e-01f, 2.785196900e-01f,
+    2.667127550e-01f, 2.548656464e-01f, 2.429801822e-01f, 2.310581058e-01f, 2.191012353e-01f, 2.071113735e-01f,
+    1.950903237e-01f, 1.830398887e-01f, 1.709618866e-01f, 1.588581502e-01f, 1.467304677e-01f, 1.345807016e-01f,
+    1.224106774e-01f, 1.102222055e-01f, 9.801714122e-02f, 8.579730988e-02f, 7.356456667e-02f, 6.132073700e-02f,
+    4.906767607e-02f, 3.680722415e-02f, 2.454122901e-02f, 1.227153838e-02f, 6.123234263e-17f, -1.227153838e-02f,
+    -2.454122901e-02f, -3.680722415e-02f, -4.906767607e-02f, -6.132073700e-02f, -7.356456667e-02f, -8.579730988e-02f,
+    -9.801714122e-02f, -1.102222055e-01f, -1.224106774e-01f, -1.345807016e-01f, -1.467304677e-01f, -1.588581502e-01f,
+    -1.709618866e-01f, -1.830398887e-01f, -1.950903237e-01f, -2.071113735e-01f, -2.191012353e-01f, -2.310581058e-01f,
+    -2.429801822e-01f, -2.548656464e-01f, -2.667127550e-01f, -2.785196900e-01f, -2.902846634e-01f, -3.020059466e-01f,
+    -3.136817515e-01f, -3.253102899e-01f, -3.368898630e-01f, -3.484186828e-01f, -3.598950505e-01f, -3.713172078e-01f,
+    -3.826834261e-01f, -3.939920366e-01f, -4.052413106e-01f, -4.164295495e-01f, -4.275550842e-01f, -4.386162460e-01f,
+    -4.496113360e-01f, -4.605387151e-01f, -4.713967443e-01f, -4.821837842e-01f, -4.928981960e-01f, -5.035383701e-01f,
+    -5.141027570e-01f, -5.245896578e-01f, -5.349976420e-01f, -5.453249812e-01f, -5.555702448e-01f, -5.657318234e-01f,
+    -5.758081675e-01f, -5.857978463e-01f, -5.956993103e-01f, -6.055110693e-01f, -6.152315736e-01f, -6.248595119e-01f,
+    -6.343932748e-01f, -6.438315511e-01f, -6.531728506e-01f, -6.624158025e-01f, -6.715589762e-01f, -6.806010008e-01f,
+    -6.895405650e-01f, -6.983762383e-01f, -7.071067691e-01f, -7.157308459e-01f, -7.242470980e-01f, -7.326542735e-01f,
+    -7.409511209e-01f, -7.491363883e-01f, -7.572088242e-01f, -7.651672363e-01f, -7.730104327e-01f, -7.807372212e-01f,
+    -7.883464098e-01f, -7.958369255e-01f, -8.032075167e-01f, -8.104571700e-01f, -8.175848126e-01f, -8.245893121e-01f,
+    -8.314695954e-01f, -8.382247090e-01f, -8.448535800e-01f, -8.513551950e-01f, -8.577286005e-01f, -8.639728427e-01f,
+    -8.700869679e-01f, -8.760700822e-01f, -8.819212914e-01f, -8.876396418e-01f, -8.932242990e-01f, -8.986744881e-01f,
+    -9.039893150e-01f, -9.091680050e-01f, -9.142097831e-01f, -9.191138744e-01f, -9.238795042e-01f, -9.285060763e-01f,
+    -9.329928160e-01f, -9.373390079e-01f, -9.415440559e-01f, -9.456073046e-01f, -9.495281577e-01f, -9.533060193e-01f,
+    -9.569403529e-01f, -9.604305029e-01f, -9.637760520e-01f, -9.669764638e-01f, -9.700312614e-01f, -9.729399681e-01f,
+    -9.757021070e-01f, -9.783173800e-01f, -9.807852507e-01f, -9.831054807e-01f, -9.852776527e-01f, -9.873014092e-01f,
+    -9.891765118e-01f, -9.909026623e-01f, -9.924795628e-01f, -9.939069748e-01f, -9.951847196e-01f, -9.963126183e-01f,
+    -9.972904325e-01f, -9.981181026e-01f, -9.987954497e-01f, -9.993223548e-01f, -9.996988177e-01f, -9.999247193e-01f,
+    -0.000000000e+00f, -1.227153838e-02f, -2.454122901e-02f, -3.680722415e-02f, -4.906767607e-02f, -6.132073700e-02f,
+    -7.356456667e-02f, -8.579730988e-02f, -9.801714122e-02f, -1.102222055e-01f, -1.224106774e-01f, -1.345807016e-01f,
+    -1.467304677e-01f, -1.588581502e-01f, -1.709618866e-01f, -1.830398887e-01f, -1.950903237e-01f, -2.071113735e-01f,
+    -2.191012353e-01f, -2.310581058e-01f, -2.429801822e-01f, -2.548656464e-01f, -2.667127550e-01f, -2.785196900e-01f,
+    -2.902846634e-01f, -3.020059466e-01f, -3.136817515e-01f, -3.253102899e-01f, -3.368898630e-01f, -3.484186828e-01f,
+    -3.598950505e-01f, -3.713172078e-01f, -3.826834261e-01f, -3.939920366e-01f, -4.052413106e-01f, -4.164295495e-01f,
+    -4.275550842e-01f, -4.386162460e-01f, -4.496113360e-01f, -4.605387151e-01f, -4.713967443e-01f, -4.821837842e-01f,
+    -4.928981960e-01f, -5.035383701e-01f, -5.141027570e-01f, -5.245896578e-01f, -5.349976420e-01f, -5.453249812e-01f,
+    -5.555702448e-01f, -5.657318234e-01f, -5.758081675e-01f, -5.857978463e-01f, -5.956993103e-01f, -6.055110693e-01f,
+    -6.152315736e-01f, -6.248595119e-01f, -6.343932748e-01f, -6.438315511e-01f, -6.531728506e-01f, -6.624158025e-01f,
+    -6.715589762e-01f, -6.806010008e-01f, -6.895405650e-01f, -6.983762383e-01f, -7.071067691e-01f, -7.157308459e-01f,
+    -7.242470980e-01f, -7.326542735e-01f, -7.409511209e-01f, -7.491363883e-01f, -7.572088242e-01f, -7.651672363e-01f,
+    -7.730104327e-01f, -7.807372212e-01f, -7.883464098e-01f, -7.958369255e-01f, -8.032075167e-01f, -8.104571700e-01f,
+    -8.175848126e-01f, -8.245893121e-01f, -8.314695954e-01f, -8.382247090e-01f, -8.448535800e-01f, -8.513551950e-01f,
+    -8.577286005e-01f, -8.639728427e-01f, -8.700869679e-01f, -8.760700822e-01f, -8.819212914e-01f, -8.876396418e-01f,
+    -8.932242990e-01f, -8.986744881e-01f, -9.039893150e-01f, -9.091680050e-01f, -9.142097831e-01f, -9.191138744e-01f,
+    -9.238795042e-01f, -9.285060763e-01f, -9.329928160e-01f, -9.373390079e-01f, -9.415440559e-01f, -9.456073046e-01f,
+    -9.495281577e-01f, -9.533060193e-01f, -9.569403529e-01f, -9.604305029e-01f, -9.637760520e-01f, -9.669764638e-01f,
+    -9.700312614e-01f, -9.729399681e-01f, -9.757021070e-01f, -9.783173800e-01f, -9.807852507e-01f, -9.831054807e-01f,
+    -9.852776527e-01f, -9.873014092e-01f, -9.891765118e-01f, -9.909026623e-01f, -9.924795628e-01f, -9.939069748e-01f,
+    -9.951847196e-01f, -9.963126183e-01f, -9.972904325e-01f, -9.981181026e-01f, -9.987954497e-01f, -9.993223548e-01f,
+    -9.996988177e-01f, -9.999247193e-01f, -1.000000000e+00f, -9.999247193e-01f, -9.996988177e-01f, -9.993223548e-01f,
+    -9.987954497e-01f, -9.981181026e-01f, -9.972904325e-01f, -9.963126183e-01f, -9.951847196e-01f, -9.939069748e-01f,
+    -9.924795628e-01f, -9.909026623e-01f, -9.891765118e-01f, -9.873014092e-01f, -9.852776527e-01f, -9.831054807e-01f,
+    -9.807852507e-01f, -9.783173800e-01f, -9.757021070e-01f, -9.729399681e-01f, -9.700312614e-01f, -9.669764638e-01f,
+    -9.637760520e-01f, -9.604305029e-01f, -9.569403529e-01f, -9.533060193e-01f, -9.495281577e-01f, -9.456073046e-01f,
+    -9.415440559e-01f, -9.373390079e-01f, -9.329928160e-01f, -9.285060763e-01f, -9.238795042e-01f, -9.191138744e-01f,
+    -9.142097831e-01f, -9.091680050e-01f, -9.039893150e-01f, -8.986744881e-01f, -8.932242990e-01f, -8.876396418e-01f,
+    -8.819212914e-01f, -8.760700822e-01f, -8.700869679e-01f, -8.639728427e-01f, -8.577286005e-01f, -8.513551950e-01f,
+    -8.448535800e-01f, -8.382247090e-01f, -8.314695954e-01f, -8.245893121e-01f, -8.175848126e-01f, -8.104571700e-01f,
+    -8.032075167e-01f, -7.958369255e-01f, -7.883464098e-01f, -7.807372212e-01f, -7.730104327e-01f, -7.651672363e-01f,
+    -7.572088242e-01f, -7.491363883e-01f, -7.409511209e-01f, -7.326542735e-01f, -7.242470980e-01f, -7.157308459e-01f,
+    -7.071067691e-01f, -6.983762383e-01f, -6.895405650e-01f, -6.806010008e-01f, -6.715589762e-01f, -6.624158025e-01f,
+    -6.531728506e-01f, -6.438315511e-01f, -6.343932748e-01f, -6.248595119e-01f, -6.152315736e-01f, -6.055110693e-01f,
+    -5.956993103e-01f, -5.857978463e-01f, -5.758081675e-01f, -5.657318234e-01f, -5.555702448e-01f, -5.453249812e-01f,
+    -5.349976420e-01f, -5.245896578e-01f, -5.141027570e-01f, -5.035383701e-01f, -4.928981960e-01f, -4.821837842e-01f,
+    -4.713967443e-01f, -4.605387151e-01f, -4.496113360e-01f, -4.386162460e-01f, -4.275550842e-01f, -4.164295495e-01f,
+    -4.052413106e-01f, -3.939920366e-01f, -3.826834261e-01f, -3.713172078e-01f, -3.598950505e-01f, -3.484186828e-01f,
+    -3.368898630e-01f, -3.253102899e-01f, -3.136817515e-01f, -3.020059466e-01f, -2.902846634e-01f, -2.785196900e-01f,
+    -2.667127550e-01f, -2.548656464e-01f, -2.429801822e-01f, -2.310581058e-01f, -2.191012353e-01f, -2.071113735e-01f,
+    -1.950903237e-01f, -1.830398887e-01f, -1.709618866e-01f, -1.588581502e-01f, -1.467304677e-01f, -1.345807016e-01f,
+    -1.224106774e-01f, -1.102222055e-01f, -9.801714122e-02f, -8.579730988e-02f, -7.356456667e-02f, -6.132073700e-02f,
+    -4.906767607e-02f, -3.680722415e-02f, -2.454122901e-02f, -1.227153838e-02f,
+};
+
+static constexpr int cTablePrunedFFT512BitReverse[ 256 ] = {
+      0, 128,  64, 192,  32, 160,  96, 224,  16, 144,  80, 208,  48, 176, 112, 240,
+      8, 136,  72, 200,  40, 168, 104, 232,  24, 152,  88, 216,  56, 184, 120, 248,
+      4, 132,  68, 196,  36, 164, 100, 228,  20, 148,  84, 212,  52, 180, 116, 244,
+     12, 140,  76, 204,  44, 172, 108, 236,  28, 156,  92, 220,  60, 188, 124, 252,
+      2, 130,  66, 194,  34, 162,  98, 226,  18, 146,  82, 210,  50, 178, 114, 242,
+     10, 138,  74, 202,  42, 170, 106, 234,  26, 154,  90, 218,  58, 186, 122, 250,
+      6, 134,  70, 198,  38, 166, 102, 230,  22, 150,  86, 214,  54, 182, 118, 246,
+     14, 142,  78, 206,  46, 174, 110, 238,  30, 158,  94, 222,  62, 190, 126, 254,
+      1, 129,  65, 193,  33, 161,  97, 225,  17, 145,  81, 209,  49, 177, 113, 241,
+      9, 137,  73, 201,  41, 169, 105, 233,  25, 153,  89, 217,  57, 185, 121, 249,
+      5, 133,  69, 197,  37, 165, 101, 229,  21, 149,  85, 213,  53, 181, 117, 245,
+     13, 141,  77, 205,  45, 173, 109, 237,  29, 157,  93, 221,  61, 189, 125, 253,
+      3, 131,  67, 195,  35, 163,  99, 227,  19, 147,  83, 211,  51, 179, 115, 243,
+     11, 139,  75, 203,  43, 171, 107, 235,  27, 155,  91, 219,  59, 187, 123, 251,
+      7, 135,  71, 199,  39, 167, 103, 231,  23, 151,  87, 215,  55, 183, 119, 247,
+     15, 143,  79, 207,  47, 175, 111, 239,  31, 159,  95, 223,  63, 191, 127, 255,
+};
+
+static constexpr sampleToBin cTableMelSampleToBin[ 256 ] = {
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(   0,  -1, 1.55043045631452769e-01 ),
+    sampleToBin(   0,  -1, 5.34427972112362926e-01 ),
+    sampleToBin(   0,  -1, 9.02619656337404486e-01 ),
+    sampleToBin(   1,   2, 7.39739885304524392e-01 ),
+    sampleToBin(   1,   2, 3.92063107502521990e-01 ),
+    sampleToBin(   1,   2, 5.38092243033849449e-02 ),
+    sampleToBin(   2,   3, 7.24480836017691199e-01 ),
+    sampleToBin(   2,   3, 4.03620305338229568e-01 ),
+    sampleToBin(   2,   3, 9.08020080015555786e-02 ),
+    sampleToBin(   3,   4, 7.85632821823912586e-01 ),
+    sampleToBin(   3,   4, 4.87747875850532198e-01 ),
+    sampleToBin(   3,   4, 1.96806863777150676e-01 ),
+    sampleToBin(   4,   5, 9.12493855859270342e-01 ),
+    sampleToBin(   4,   5, 6.34513048061459695e-01 ),
+    sampleToBin(   4,   5, 3.62589815365491064e-01 ),
+    sampleToBin(   4,   5, 9.64648182605210430e-02 ),
+    sampleToBin(   5,   6, 8.35895933808009972e-01 ),
+    sampleToBin(   5,   6, 5.80655747765203012e-01 ),
+    sampleToBin(   5,   6, 3.30531253639947620e-01 ),
+    sampleToBin(   5,   6, 8.53213448141746794e-02 ),
+    sampleToBin(   6,   7, 8.44835359975517064e-01 ),
+    sampleToBin(   6,   7, 6.08896669380732392e-01 ),
+    sampleToBin(   6,   7, 3.77335602643918744e-01 ),
+    sampleToBin(   6,   7, 1.49992357873277055e-01 ),
+    sampleToBin(   7,   8, 9.26716901356050116e-01 ),
+    sampleToBin(   7,   8, 7.07364428302023507e-01 ),
+    sampleToBin(   7,   8, 4.91802510291604211e-01 ),
+    sampleToBin(   7,   8, 2.79898430499399831e-01 ),
+    sampleToBin(   7,   8, 7.15330146332212313e-02 ),
+    sampleToBin(   8,   9, 8.66589408186659416e-01 ),
+    sampleToBin(   8,   9, 6.64955985575847897e-01 ),
+    sampleToBin(   8,   9, 4.66529434827580913e-01 ),
+    sampleToBin(   8,   9, 2.71208186942833662e-01 ),
+    sampleToBin(   8,   9, 7.88960899358626816e-02 ),
+    sampleToBin(   9,  10, 8.89502020113345226e-01 ),
+    sampleToBin(   9,  10, 7.02938728451180661e-01 ),
+    sampleToBin(   9,  10, 5.19124571029288773e-01 ),
+    sampleToBin(   9,  10, 3.37976938395129267e-01 ),
+    sampleToBin(   9,  10, 1.59422700869404299e-01 ),
+    sampleToBin(  10,  11, 9.83385631545314665e-01 ),
+    sampleToBin(  10,  11, 8.09797440945244640e-01 ),
+    sampleToBin(  10,  11, 6.38590027682317207e-01 ),
+    sampleToBin(  10,  11, 4.69699741850476526e-01 ),
+    sampleToBin(  10,  11, 3.03064287796987575e-01 ),
+    sampleToBin(  10,  11, 1.38624078375755716e-01 ),
+    sampleToBin(  11,  12, 9.76324554733107197e-01 ),
+    sampleToBin(  11,  12, 8.16105552911348009e-01 ),
+    sampleToBin(  11,  12, 6.57919285323406267e-01 ),
+    sampleToBin(  11,  12, 5.01711581836468579e-01 ),
+    sampleToBin(  11,  12, 3.47435043584323311e-01 ),
+    sampleToBin(  11,  12, 1.95042271700758968e-01 ),
+    sampleToBin(  11,  12, 4.44885758262045586e-02 ),
+    sampleToBin(  12,  13, 8.95728876880228619e-01 ),
+    sampleToBin(  12,  13, 7.48720616198301658e-01 ),
+    sampleToBin(  12,  13, 6.03424131713273471e-01 ),
+    sampleToBin(  12,  13, 4.59800150078854497e-01 ),
+    sampleToBin(  12,  13, 3.17810752202075442e-01 ),
+    sampleToBin(  12,  13, 1.77418018989967008e-01 ),
+    sampleToBin(  12,  13, 3.85867398562006123e-02 ),
+    sampleToBin(  13,  14, 9.01281315493587143e-01 ),
+    sampleToBin(  13,  14, 7.65472729770800275e-01 ),
+    sampleToBin(  13,  14, 6.31124029127330566e-01 ),
+    sampleToBin(  13,  14, 4.98206774243451056e-01 ),
+    sampleToBin(  13,  14, 3.66691171546114525e-01 ),
+    sampleToBin(  13,  14, 2.36546073208953267e-01 ),
+    sampleToBin(  13,  14, 1.07743039912240365e-01 ),
+    sampleToBin(  14,  15, 9.80258660628669620e-01 ),
+    sampleToBin(  14,  15, 8.54061210720274300e-01 ),
+    sampleToBin(  14,  15, 7.29127279159747954e-01 ),
+    sampleToBin(  14,  15, 6.05431135134004483e-01 ),
+    sampleToBin(  14,  15, 4.82949756336598257e-01 ),
+    sampleToBin(  14,  15, 3.61657411954442953e-01 ),
+    sampleToBin(  14,  15, 2.41533788187733550e-01 ),
+    sampleToBin(  14,  15, 1.22554508476704127e-01 ),
+    sampleToBin(  14,  15, 4.69925902154971851e-03 ),
+    sampleToBin(  15,  16, 8.87945983048284537e-01 ),
+    sampleToBin(  15,  16, 7.72275144198824481e-01 ),
+    sampleToBin(  15,  16, 6.57666039952504278e-01 ),
+    sampleToBin(  15,  16, 5.44101065016159513e-01 ),
+    sampleToBin(  15,  16, 4.31558551336664931e-01 ),
+    sampleToBin(  15,  16, 3.20023602127496865e-01 ),
+    sampleToBin(  15,  16, 2.09474549335529947e-01 ),
+    sampleToBin(  15,  16, 9.98978504275609691e-02 ),
+    sampleToBin(  16,  17, 9.91272802882924409e-01 ),
+    sampleToBin(  16,  17, 8.83586641610137891e-01 ),
+    sampleToBin(  16,  17, 7.76821372595176807e-01 ),
+    sampleToBin(  16,  17, 6.70960744798197006e-01 ),
+    sampleToBin(  16,  17, 5.65991215685995197e-01 ),
+    sampleToBin(  16,  17, 4.61897888472047713e-01 ),
+    sampleToBin(  16,  17, 3.58664512116510681e-01 ),
+    sampleToBin(  16,  17, 2.56278898339501071e-01 ),
+    sampleToBin(  16,  17, 1.54726150354495245e-01 ),
+    sampleToBin(  16,  17, 5.39927256282898352e-02 ),
+    sampleToBin(  17,  18, 9.54064692906821055e-01 ),
+    sampleToBin(  17,  18, 8.54931995605247241e-01 ),
+    sampleToBin(  17,  18, 7.56579348216184333e-01 ),
+    sampleToBin(  17,  18, 6.58997270966389936e-01 ),
+    sampleToBin(  17,  18, 5.62170867069340496e-01 ),
+    sampleToBin(  17,  18, 4.66090656751793564e-01 ),
+    sampleToBin(  17,  18, 3.70744451733866165e-01 ),
+    sampleToBin(  17,  18, 2.76120063735675436e-01 ),
+    sampleToBin(  17,  18, 1.82209367237299275e-01 ),
+    sampleToBin(  17,  18, 8.89988197055344155e-02 ),
+    sampleToBin(  18,  19, 9.96479906899598311e-01 ),
+    sampleToBin(  18,  19, 9.04641217981329127e-01 ),
+    sampleToBin(  18,  19, 8.13474238709944286e-01 ),
+    sampleToBin(  18,  19, 7.22968135058881023e-01 ),
+    sampleToBin(  18,  19, 6.33113427254897276e-01 ),
+    sampleToBin(  18,  19, 5.43900635524750542e-01 ),
+    sampleToBin(  18,  19, 4.55318925841878108e-01 ),
+    sampleToBin(  18,  19, 3.67365589699639505e-01 ),
+    sampleToBin(  18,  19, 2.80024376058190638e-01 ),
+    sampleToBin(  18,  19, 1.93292576410890871e-01 ),
+    sampleToBin(  18,  19, 1.07159356731177560e-01 ),
+    sampleToBin(  18,  19, 2.16138829924880441e-02 ),
+    sampleToBin(  19,  20, 9.36653057967321123e-01 ),
+    sampleToBin(  19,  20, 8.52264116564194540e-01 ),
+    sampleToBin(  19,  20, 7.68443961555607125e-01 ),
+    sampleToBin(  19,  20, 6.85184467421636967e-01 ),
+    sampleToBin(  19,  20, 6.02474800135721189e-01 ),
+    sampleToBin(  19,  20, 5.20309542684578741e-01 ),
+    sampleToBin(  19,  20, 4.38683278054928072e-01 ),
+    sampleToBin(  19,  20, 3.57585172220206637e-01 ),
+    sampleToBin(  19,  20, 2.77012516673773745e-01 ),
+    sampleToBin(  19,  20, 1.96954477389066795e-01 ),
+    sampleToBin(  19,  20, 1.17408345859445082e-01 ),
+    sampleToBin(  19,  20, 3.83659965649866055e-02 ),
+    sampleToBin(  20,  21, 9.59818915264908923e-01 ),
+    sampleToBin(  20,  21, 8.81765170894292294e-01 ),
+    sampleToBin(  20,  21, 8.04196249212354330e-01 ),
+    sampleToBin(  20,  21, 7.27106733205813649e-01 ),
+    sampleToBin(  20,  21, 6.50491205861388866e-01 ),
+    sampleToBin(  20,  21, 5.74341541659158183e-01 ),
+    sampleToBin(  20,  21, 4.98655032092480743e-01 ),
+    sampleToBin(  20,  21, 4.23423551641434637e-01 ),
+    sampleToBin(  20,  21, 3.48641683292738536e-01 ),
+    sampleToBin(  20,  21, 2.74306718539751748e-01 ),
+    sampleToBin(  20,  21, 2.00413240369193030e-01 ),
+    sampleToBin(  20,  21, 1.26953123261140305e-01 ),
+    sampleToBin(  20,  21, 5.39236587089529373e-02 ),
+    sampleToBin(  21,  22, 9.81319040978489099e-01 ),
+    sampleToBin(  21,  22, 9.09131921991547798e-01 ),
+    sampleToBin(  21,  22, 8.37361913027268590e-01 ),
+    sampleToBin(  21,  22, 7.66003597072370090e-01 ),
+    sampleToBin(  21,  22, 6.95048848606930392e-01 ),
+    sampleToBin(  21,  22, 6.24494959124308635e-01 ),
+    sampleToBin(  21,  22, 5.54339220117864406e-01 ),
+    sampleToBin(  21,  22, 4.84573506067675519e-01 ),
+    sampleToBin(  21,  22, 4.15197816973742140e-01 ),
+    sampleToBin(  21,  22, 3.46204027316142138e-01 ),
+    sampleToBin(  21,  22, 2.77592137094875568e-01 ),
+    sampleToBin(  21,  22, 2.09354020790020467e-01 ),
+    sampleToBin(  21,  22, 1.41484261388295479e-01 ),
+    sampleToBin(  21,  22, 7.39855673963412813e-02 ),
+    sampleToBin(  21,  22, 6.84710478759521009e-03 ),
+    sampleToBin(  22,  23, 9.40068484841196761e-01 ),
+    sampleToBin(  22,  23, 8.73645067985585611e-01 ),
+    sampleToBin(  22,  23, 8.07576465499901364e-01 ),
+    sampleToBin(  22,  23, 7.41851843357581142e-01 ),
+    sampleToBin(  22,  23, 6.76473910065265804e-01 ),
+    sampleToBin(  22,  23, 6.11434540103033330e-01 ),
+    sampleToBin(  22,  23, 5.46733733470883609e-01 ),
+    sampleToBin(  22,  23, 4.82366073155535480e-01 ),
+    sampleToBin(  22,  23, 4.18328850650348139e-01 ),
+    sampleToBin(  22,  23, 3.54619357448681005e-01 ),
+    sampleToBin(  22,  23, 2.91232176537252752e-01 ),
+    sampleToBin(  22,  23, 2.28167307916063322e-01 ),
+    sampleToBin(  22,  23, 1.65416626065190753e-01 ),
+    sampleToBin(  22,  23, 1.02982839491275735e-01 ),
+    sampleToBin(  22,  23, 4.08578226743962561e-02 ),
+    sampleToBin(  23,  24, 9.79043895400332431e-01 ),
+    sampleToBin(  23,  24, 9.17531001084242792e-01 ),
+    sampleToBin(  23,  24, 8.56321459511907190e-01 ),
+    sampleToBin(  23,  24, 7.95407145163403939e-01 ),
+    sampleToBin(  23,  24, 7.34793475052014311e-01 ),
+    sampleToBin(  23,  24, 6.74469615151175428e-01 ),
+    sampleToBin(  23,  24, 6.14435565460887512e-01 ),
+    sampleToBin(  23,  24, 5.54691325981150563e-01 ),
+    sampleToBin(  23,  24, 4.95231479698683141e-01 ),
+    sampleToBin(  23,  24, 4.36050609600203976e-01 ),
+    sampleToBin(  23,  24, 3.77151424192353701e-01 ),
+    sampleToBin(  23,  24, 3.18528506461851046e-01 ),
+    sampleToBin(  23,  24, 2.60179147902055319e-01 ),
+    sampleToBin(  23,  24, 2.02103348512966519e-01 ),
+    sampleToBin(  23,  24, 1.44295691281303318e-01 ),
+    sampleToBin(  23,  24, 8.67534677004250659e-02 ),
+    sampleToBin(  23,  24, 2.94739692636910890e-02 ),
+    sampleToBin(  24,  25, 9.72459515756881498e-01 ),
+    sampleToBin(  24,  25, 9.15702759101795438e-01 ),
+    sampleToBin(  24,  25, 8.59200602070931629e-01 ),
+    sampleToBin(  24,  25, 8.02955753170930819e-01 ),
+    sampleToBin(  24,  25, 7.46962795388511624e-01 ),
+    sampleToBin(  24,  25, 6.91221728723674045e-01 ),
+    sampleToBin(  24,  25, 6.35727136163136697e-01 ),
+    sampleToBin(  24,  25, 5.80476309200259055e-01 ),
+    sampleToBin(  24,  25, 5.25471956341681756e-01 ),
+    sampleToBin(  24,  25, 4.70705952067482725e-01 ),
+    sampleToBin(  24,  25, 4.16181004884302652e-01 ),
+    sampleToBin(  24,  25, 3.61891697778860266e-01 ),
+    sampleToBin(  24,  25, 3.07840739257796203e-01 ),
+    sampleToBin(  24,  25, 2.54020003801188443e-01 ),
+    sampleToBin(  24,  25, 2.00432199915677650e-01 ),
+    sampleToBin(  24,  25, 1.47071910587982552e-01 ),
+    sampleToBin(  24,  25, 9.39391358181031061e-02 ),
+    sampleToBin(  24,  25, 4.10311670993986702e-02 ),
+    sampleToBin(  25,  -1, 9.88347615711008709e-01 ),
+    sampleToBin(  25,  -1, 9.35886550588013622e-01 ),
+    sampleToBin(  25,  -1, 8.83642165996271545e-01 ),
+    sampleToBin(  25,  -1, 8.31617170442423115e-01 ),
+    sampleToBin(  25,  -1, 7.79808855419827696e-01 ),
+    sampleToBin(  25,  -1, 7.28214512421844651e-01 ),
+    sampleToBin(  25,  -1, 6.76831432941833233e-01 ),
+    sampleToBin(  25,  -1, 6.25659616979793665e-01 ),
+    sampleToBin(  25,  -1, 5.74696356029084976e-01 ),
+    sampleToBin(  25,  -1, 5.23941650089707389e-01 ),
+    sampleToBin(  25,  -1, 4.73390082148379410e-01 ),
+    sampleToBin(  25,  -1, 4.23044360711741840e-01 ),
+    sampleToBin(  25,  -1, 3.72899068766513353e-01 ),
+    sampleToBin(  25,  -1, 3.22956914819334473e-01 ),
+    sampleToBin(  25,  -1, 2.73212481856924039e-01 ),
+    sampleToBin(  25,  -1, 2.23665769879281967e-01 ),
+    sampleToBin(  25,  -1, 1.74316778886408258e-01 ),
+    sampleToBin(  25,  -1, 1.25160091865021611e-01 ),
+    sampleToBin(  25,  -1, 7.61957088151220124e-02 ),
+    sampleToBin(  25,  -1, 2.74236297367094518e-02 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+    sampleToBin(  -1,  -1, 0.00000000000000000e+00 ),
+};
+
+alignas( 16 ) static constexpr float cTableDCT[ 784 ] = {
+    2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f,
+    2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f,
+    2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f,
+    2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f, 2.773500979e-01f,
+    2.773500979e-01f, 2.773500979e-01f, 0.000000000e+00f, 0.000000000e+00f, 2.768440843e-01f, 2.728070915e-01f,
+    2.647919357e-01f, 2.529155016e-01f, 2.373510152e-01f, 2.183254212e-01f, 1.961161345e-01f, 1.710470468e-01f,
+    1.434836984e-01f, 1.138280332e-01f, 8.251249790e-02f, 4.999375343e-02f, 1.674598269e-02f, -1.674598269e-02f,
+    -4.999375343e-02f, -8.251249790e-02f, -1.138280332e-01f, -1.434836984e-01f, -1.710470468e-01f, -1.961161345e-01f,
+    -2.183254212e-01f, -2.373510152e-01f, -2.529155016e-01f, -2.647919357e-01f, -2.728070915e-01f, -2.768440843e-01f,
+    0.000000000e+00f, 0.000000000e+00f, 2.753278911e-01f, 2.593268454e-01f, 2.282546610e-01f, 1.839171350e-01f,
+    1.288910210e-01f, 6.637421995e-02f, -4.460129739e-17f, -6.637421995e-02f, -1.288910210e-01f, -1.839171350e-01f,
+    -2.282546610e-01f, -2.593268454e-01f, -2.753278911e-01f, -2.753278911e-01f, -2.593268454e-01f, -2.282546610e-01f,
+    -1.839171350e-01f, -1.288910210e-01f, -6.637421995e-02f, -5.094838658e-17f, 6.637421995e-02f, 1.288910210e-01f,
+    1.839171350e-01f, 2.282546610e-01f, 2.593268454e-01f, 2.753278911e-01f, 0.000000000e+00f, 0.000000000e+00f,
+    2.728070915e-01f, 2.373510152e-01f, 1.710470468e-01f, 8.251249790e-02f, -1.674598269e-02f, -1.138280332e-01f,
+    -1.961161345e-01f, -2.529155016e-01f, -2.768440843e-01f, -2.647919357e-01f, -2.183254212e-01f, -1.434836984e-01f,
+    -4.999375343e-02f, 4.999375343e-02f, 1.434836984e-01f, 2.183254212e-01f, 2.647919357e-01f, 2.768440843e-01f,
+    2.529155016e-01f, 1.961161345e-01f, 1.138280332e-01f, 1.674598269e-02f, -8.251249790e-02f, -1.710470468e-01f,
+    -2.373510152e-01f, -2.728070915e-01f, 0.000000000e+00f, 0.000000000e+00f, 2.692908049e-01f, 2.075995356e-01f,
+    9.834969789e-02f, -3.343085945e-02f, -1.575528085e-01f, -2.455813140e-01f, -2.773500979e-01f, -2.455813140e-01f,
+    -1.575528085e-01f, -3.343085945e-02f, 9.834969789e-02f, 2.075995356e-01f, 2.692908049e-01f, 2.692908049e-01f,
+    2.075995356e-01f, 9.834969789e-02f, -3.343085945e-02f, -1.575528085e-01f, -2.455813140e-01f, -2.773500979e-01f,
+    -2.455813140e-01f, -1.575528085e-01f, -3.343085945e-02f, 9.834969789e-02f, 2.075995356e-01f, 2.692908049e-01f,
+    0.000000000e+00f, 0.000000000e+00f, 2.647919357e-01f, 1.710470468e-01f, 1.674598269e-02f, -1.434836984e-01f,
+    -2.529155016e-01f, -2.728070915e-01f, -1.961161345e-01f, -4.999375343e-02f, 1.138280332e-01f, 2.373510152e-01f,
+    2.768440843e-01f, 2.183254212e-01f, 8.251249790e-02f, -8.251249790e-02f, -2.183254212e-01f, -2.768440843e-01f,
+    -2.373510152e-01f, -1.138280332e-01f, 4.999375343e-02f, 1.961161345e-01f, 2.728070915e-01f, 2.529155016e-01f,
+    1.434836984e-01f, -1.674598269e-02f, -1.710470468e-01f, -2.647919357e-01f, 0.000000000e+00f, 0.000000000e+00f,
+    2.593268454e-01f, 1.288910210e-01f, -6.637421995e-02f, -2.282546610e-01f, -2.753278911e-01f, -1.839171350e-01f,
+    -5.094838658e-17f, 1.839171350e-01f, 2.753278911e-01f, 2.282546610e-01f, 6.637421995e-02f, -1.288910210e-01f,
+    -2.593268454e-01f, -2.593268454e-01f, -1.288910210e-01f, 6.637421995e-02f, 2.282546610e-01f, 2.753278911e-01f,
+    1.839171350e-01f, 1.528451630e-16f, -1.839171350e-01f, -2.753278911e-01f, -2.282546610e-01f, -6.637421995e-02f,
+    1.288910210e-01f, 2.593268454e-01f, 0.000000000e+00f, 0.000000000e+00f, 2.529155016e-01f, 8.251249790e-02f,
+    -1.434836984e-01f, -2.728070915e-01f, -2.183254212e-01f, -1.674598269e-02f, 1.961161345e-01f, 2.768440843e-01f,
+    1.710470468e-01f, -4.999375343e-02f, -2.373510152e-01f, -2.647919357e-01f, -1.138280332e-01f, 1.138280332e-01f,
+    2.647919357e-01f, 2.373510152e-01f, 4.999375343e-02f, -1.710470468e-01f, -2.768440843e-01f, -1.961161345e-01f,
+    1.674598269e-02f, 2.183254212e-01f, 2.728070915e-01f, 1.434836984e-01f, -8.251249790e-02f, -2.529155016e-01f,
+    0.000000000e+00f, 0.000000000e+00f, 2.455813140e-01f, 3.343085945e-02f, -2.075995356e-01f, -2.692908049e-01f,
+    -9.834969789e-02f, 1.575528085e-01f, 2.773500979e-01f, 1.575528085e-01f, -9.834969789e-02f, -2.692908049e-01f,
+    -2.075995356e-01f, 3.343085945e-02f, 2.455813140e-01f, 2.455813140e-01f, 3.343085945e-02f, -2.075995356e-01f,
+    -2.692908049e-01f, -9.834969789e-02f, 1.575528085e-01f, 2.773500979e-01f, 1.575528085e-01f, -9.834969789e-02f,
+    -2.692908049e-01f, -2.075995356e-01f, 3.343085945e-02f, 2.455813140e-01f, 0.000000000e+00f, 0.000000000e+00f,
+    2.373510152e-01f, -1.674598269e-02f, -2.529155016e-01f, -2.183254212e-01f, 4.999375343e-02f, 2.647919357e-01f,
+    1.961161345e-01f, -8.251249790e-02f, -2.728070915e-01f, -1.710470468e-01f, 1.138280332e-01f, 2.768440843e-01f,
+    1.434836984e-01f, -1.434836984e-01f, -2.768440843e-01f, -1.138280332e-01f, 1.710470468e-01f, 2.728070915e-01f,
+    8.251249790e-02f, -1.961161345e-01f, -2.647919357e-01f, -4.999375343e-02f, 2.183254212e-01f, 2.529155016e-01f,
+    1.674598269e-02f, -2.373510152e-01f, 0.000000000e+00f, 0.000000000e+00f, 2.282546610e-01f, -6.637421995e-02f,
+    -2.753278911e-01f, -1.288910210e-01f, 1.839171350e-01f, 2.593268454e-01f, 8.491397432e-17f, -2.593268454e-01f,
+    -1.839171350e-01f, 1.288910210e-01f, 2.753278911e-01f, 6.637421995e-02f, -2.282546610e-01f, -2.282546610e-01f,
+    6.637421995e-02f, 2.753278911e-01f, 1.288910210e-01f, -1.839171350e-01f, -2.593268454e-01f, -7.474146729e-16f,
+    2.593268454e-01f, 1.839171350e-01f, -1.288910210e-01f, -2.753278911e-01f, -6.637421995e-02f, 2.282546610e-01f,
+    0.000000000e+00f, 0.000000000e+00f, 2.183254212e-01f, -1.138280332e-01f, -2.728070915e-01f, -1.674598269e-02f,
+    2.647919357e-01f, 1.434836984e-01f, -1.961161345e-01f, -2.373510152e-01f, 8.251249790e-02f, 2.768440843e-01f,
+    4.999375343e-02f, -2.529155016e-01f, -1.710470468e-01f, 1.710470468e-01f, 2.529155016e-01f, -4.999375343e-02f,
+    -2.768440843e-01f, -8.251249790e-02f, 2.373510152e-01f, 1.961161345e-01f, -1.434836984e-01f, -2.647919357e-01f,
+    1.674598269e-02f, 2.728070915e-01f, 1.138280332e-01f, -2.183254212e-01f, 0.000000000e+00f, 0.000000000e+00f,
+    2.075995356e-01f, -1.575528085e-01f, -2.455813140e-01f, 9.834969789e-02f, 2.692908049e-01f, -3.343085945e-02f,
+    -2.773500979e-01f, -3.343085945e-02f, 2.692908049e-01f, 9.834969789e-02f, -2.455813140e-01f, -1.575528085e-01f,
+    2.075995356e-01f, 2.075995356e-01f, -1.575528085e-01f, -2.455813140e-01f, 9.834969789e-02f, 2.692908049e-01f,
+    -3.343085945e-02f, -2.773500979e-01f, -3.343085945e-02f, 2.692908049e-01f, 9.834969789e-02f, -2.455813140e-01f,
+    -1.575528085e-01f, 2.075995356e-01f, 0.000000000e+00f, 0.000000000e+00f, 1.961161345e-01f, -1.961161345e-01f,
+    -1.961161345e-01f, 1.961161345e-01f, 1.961161345e-01f, -1.961161345e-01f, -1.961161345e-01f, 1.961161345e-01f,
+    1.961161345e-01f, -1.961161345e-01f, -1.961161345e-01f, 1.961161345e-01f, 1.961161345e-01f, -1.961161345e-01f,
+    -1.961161345e-01f, 1.961161345e-01f, 1.961161345e-01f, -1.961161345e-01f, -1.961161345e-01f, 1.961161345e-01f,
+    1.961161345e-01f, -1.961161345e-01f, -1.961161345e-01f, 1.961161345e-01f, 1.961161345e-01f, -1.961161345e-01f,
+    0.000000000e+00f, 0.000000000e+00f, 1.839171350e-01f, -2.282546610e-01f, -1.288910210e-01f, 2.593268454e-01f,
+    6.637421995e-02f, -2.753278911e-01f, -1.188795654e-16f, 2.753278911e-01f, -6.637421995e-02f, -2.593268454e-01f,
+    1.288910210e-01f, 2.282546610e-01f, -1.839171350e-01f, -1.839171350e-01f, 2.282546610e-01f, 1.288910210e-01f,
+    -2.593268454e-01f, -6.637421995e-02f, 2.753278911e-01f, -1.360340340e-16f, -2.753278911e-01f, 6.637421995e-02f,
+    2.593268454e-01f, -1.288910210e-01f, -2.282546610e-01f, 1.839171350e-01f, 0.000000000e+00f, 0.000000000e+00f,
+    1.710470468e-01f, -2.529155016e-01f, -4.999375343e-02f, 2.768440843e-01f, -8.251249790e-02f, -2.373510152e-01f,
+    1.961161345e-01f, 1.434836984e-01f, -2.647919357e-01f, -1.674598269e-02f, 2.728070915e-01f, -1.138280332e-01f,
+    -2.183254212e-01f, 2.183254212e-01f, 1.138280332e-01f, -2.728070915e-01f, 1.674598269e-02f, 2.647919357e-01f,
+    -1.434836984e-01f, -1.961161345e-01f, 2.373510152e-01f, 8.251249790e-02f, -2.768440843e-01f, 4.999375343e-02f,
+    2.529155016e-01f, -1.710470468e-01f, 0.000000000e+00f, 0.000000000e+00f, 1.575528085e-01f, -2.692908049e-01f,
+    3.343085945e-02f, 2.455813140e-01f, -2.075995356e-01f, -9.834969789e-02f, 2.773500979e-01f, -9.834969789e-02f,
+    -2.075995356e-01f, 2.455813140e-01f, 3.343085945e-02f, -2.692908049e-01f, 1.575528085e-01f, 1.575528085e-01f,
+    -2.692908049e-01f, 3.343085945e-02f, 2.455813140e-01f, -2.075995356e-01f, -9.834969789e-02f, 2.773500979e-01f,
+    -9.834969789e-02f, -2.075995356e-01f, 2.455813140e-01f, 3.343085945e-02f, -2.692908049e-01f, 1.575528085e-01f,
+    0.000000000e+00f, 0.000000000e+00f, 1.434836984e-01f, -2.768440843e-01f, 1.138280332e-01f, 1.710470468e-01f,
+    -2.728070915e-01f, 8.251249790e-02f, 1.961161345e-01f, -2.647919357e-01f, 4.999375343e-02f, 2.183254212e-01f,
+    -2.529155016e-01f, 1.674598269e-02f, 2.373510152e-01f, -2.373510152e-01f, -1.674598269e-02f, 2.529155016e-01f,
+    -2.183254212e-01f, -4.999375343e-02f, 2.647919357e-01f, -1.961161345e-01f, -8.251249790e-02f, 2.728070915e-01f,
+    -1.710470468e-01f, -1.138280332e-01f, 2.768440843e-01f, -1.434836984e-01f, 0.000000000e+00f, 0.000000000e+00f,
+    1.288910210e-01f, -2.753278911e-01f, 1.839171350e-01f, 6.637421995e-02f, -2.593268454e-01f, 2.282546610e-01f,
+    1.528451630e-16f, -2.282546610e-01f, 2.593268454e-01f, -6.637421995e-02f, -1.839171350e-01f, 2.753278911e-01f,
+    -1.288910210e-01f, -1.288910210e-01f, 2.753278911e-01f, -1.839171350e-01f, -6.637421995e-02f, 2.593268454e-01f,
+    -2.282546610e-01f, -9.512082589e-16f, 2.282546610e-01f, -2.593268454e-01f, 6.637421995e-02f, 1.839171350e-01f,
+    -2.753278911e-01f, 1.288910210e-01f, 0.000000000e+00f, 0.000000000e+00f, 1.138280332e-01f, -2.647919357e-01f,
+    2.373510152e-01f, -4.999375343e-02f, -1.710470468e-01f, 2.768440843e-01f, -1.961161345e-01f, -1.674598269e-02f,
+    2.183254212e-01f, -2.728070915e-01f, 1.434836984e-01f, 8.251249790e-02f, -2.529155016e-01f, 2.529155016e-01f,
+    -8.251249790e-02f, -1.434836984e-01f, 2.728070915e-01f, -2.183254212e-01f, 1.674598269e-02f, 1.961161345e-01f,
+    -2.768440843e-01f, 1.710470468e-01f, 4.999375343e-02f, -2.373510152e-01f, 2.647919357e-01f, -1.138280332e-01f,
+    0.000000000e+00f, 0.000000000e+00f, 9.834969789e-02f, -2.455813140e-01f, 2.692908049e-01f, -1.575528085e-01f,
+    -3.343085945e-02f, 2.075995356e-01f, -2.773500979e-01f, 2.075995356e-01f, -3.343085945e-02f, -1.575528085e-01f,
+    2.692908049e-01f, -2.455813140e-01f, 9.834969789e-02f, 9.834969789e-02f, -2.455813140e-01f, 2.692908049e-01f,
+    -1.575528085e-01f, -3.343085945e-02f, 2.075995356e-01f, -2.773500979e-01f, 2.075995356e-01f, -3.343085945e-02f,
+    -1.575528085e-01f, 2.692908049e-01f, -2.455813140e-01f, 9.834969789e-02f, 0.000000000e+00f, 0.000000000e+00f,
+    8.251249790e-02f, -2.183254212e-01f, 2.768440843e-01f, -2.373510152e-01f, 1.138280332e-01f, 4.999375343e-02f,
+    -1.961161345e-01f, 2.728070915e-01f, -2.529155016e-01f, 1.434836984e-01f, 1.674598269e-02f, -1.710470468e-01f,
+    2.647919357e-01f, -2.647919357e-01f, 1.710470468e-01f, -1.674598269e-02f, -1.434836984e-01f, 2.529155016e-01f,
+    -2.728070915e-01f, 1.961161345e-01f, -4.999375343e-02f, -1.138280332e-01f, 2.373510152e-01f, -2.768440843e-01f,
+    2.183254212e-01f, -8.251249790e-02f, 0.000000000e+00f, 0.000000000e+00f, 6.637421995e-02f, -1.839171350e-01f,
+    2.593268454e-01f, -2.753278911e-01f, 2.282546610e-01f, -1.288910210e-01f, -6.794834775e-16f, 1.288910210e-01f,
+    -2.282546610e-01f, 2.753278911e-01f, -2.593268454e-01f, 1.839171350e-01f, -6.637421995e-02f, -6.637421995e-02f,
+    1.839171350e-01f, -2.593268454e-01f, 2.753278911e-01f, -2.282546610e-01f, 1.288910210e-01f, 2.038450433e-15f,
+    -1.288910210e-01f, 2.282546610e-01f, -2.753278911e-01f, 2.593268454e-01f, -1.839171350e-01f, 6.637421995e-02f,
+    0.000000000e+00f, 0.000000000e+00f, 4.999375343e-02f, -1.434836984e-01f, 2.183254212e-01f, -2.647919357e-01f,
+    2.768440843e-01f, -2.529155016e-01f, 1.961161345e-01f, -1.138280332e-01f, 1.674598269e-02f, 8.251249790e-02f,
+    -1.710470468e-01f, 2.373510152e-01f, -2.728070915e-01f, 2.728070915e-01f, -2.373510152e-01f, 1.710470468e-01f,
+    -8.251249790e-02f, -1.674598269e-02f, 1.138280332e-01f, -1.961161345e-01f, 2.529155016e-01f, -2.768440843e-01f,
+    2.647919357e-01f, -2.183254212e-01f, 1.434836984e-01f, -4.999375343e-02f, 0.000000000e+00f, 0.000000000e+00f,
+    3.343085945e-02f, -9.834969789e-02f, 1.575528085e-01f, -2.075995356e-01f, 2.455813140e-01f, -2.692908049e-01f,
+    2.773500979e-01f, -2.692908049e-01f, 2.455813140e-01f, -2.075995356e-01f, 1.575528085e-01f, -9.834969789e-02f,
+    3.343085945e-02f, 3.343085945e-02f, -9.834969789e-02f, 1.575528085e-01f, -2.075995356e-01f, 2.455813140e-01f,
+    -2.692908049e-01f, 2.773500979e-01f, -2.692908049e-01f, 2.455813140e-01f, -2.075995356e-01f, 1.575528085e-01f,
+    -9.834969789e-02f, 3.343085945e-02f, 0.000000000e+00f, 0.000000000e+00f, 1.674598269e-02f, -4.999375343e-02f,
+    8.251249790e-02f, -1.138280332e-01f, 1.434836984e-01f, -1.710470468e-01f, 1.961161345e-01f, -2.183254212e-01f,
+    2.373510152e-01f, -2.529155016e-01f, 2.647919357e-01f, -2.728070915e-01f, 2.768440843e-01f, -2.768440843e-01f,
+    2.728070915e-01f, -2.647919357e-01f, 2.529155016e-01f, -2.373510152e-01f, 2.183254212e-01f, -1.961161345e-01f,
+    1.710470468e-01f, -1.434836984e-01f, 1.138280332e-01f, -8.251249790e-02f, 4.999375343e-02f, -1.674598269e-02f,
+    0.000000000e+00f, 0.000000000e+00f, -4.460129739e-17f, -5.094838658e-17f, -1.614223907e-16f, 3.737931779e-16f,
+    1.528451630e-16f, 3.058619826e-16f, -2.718964114e-16f, 2.379308137e-16f, -2.039652161e-16f, 1.155345105e-15f,
+    -1.360340340e-16f, 1.087413910e-15f, -6.810285848e-17f, -9.512082589e-16f, -1.970862709e-15f, 9.515515190e-16f,
+    6.775950573e-17f, -1.087070544e-15f, -1.835000318e-15f, 8.156891813e-16f, -1.767069123e-15f, -1.222932934e-15f,
+    -3.669828689e-15f, 6.798268435e-16f, -1.631206732e-15f, 2.582586727e-15f, 0.000000000e+00f, 0.000000000e+00f,
+    0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f,
+    0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f,
+    0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f,
+    0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f,
+    0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f,
+};
+
+#endif //ANDROIDMFCC_MFCC_TABLES_H
@@ -0,0 +1,464 @@
+//
+// Feature extraction of many concurrent streams on a fixed pool of worker threads.
+//
+// Each stream has its own StreamingFrameBuffer and a bounded queue of frames. A worker takes
+// up to MFCCBatch4::cNumLanes frames from the queues, round robin over the streams, and runs
+// them through one pass of the 4-lane kernels, so that frames of different streams share the
+// SIMD lanes of the FFT, Mel and DCT.
+//
+// - Ordering : a stream is owned by at most one worker at a time. Its frames are delivered
+//              to the callback in order, on the thread of that worker.
+// - Latency  : a worker that finds fewer frames than lanes waits at most maxBatchWaitUs for
+//              more before it runs a partial batch.
+// - Backpressure : pushSamples() accepts only as many samples as the stream buffer holds,
+//              and frames move from the buffer to the queue only while the queue has room.
+//
+
+#ifndef ANDROIDMFCC_MULTI_STREAM_SCHEDULER_H
+#define ANDROIDMFCC_MULTI_STREAM_SCHEDULER_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "mfcc.h"
+
+class MultiStreamScheduler {
+
+public:
+
+    /** @brief receives the features of one frame.
+     *
+     *  @param streamId   : stream returned by addStream()
+     *  @param frameIndex : 0 for the first frame of the stream
+     *  @param features   : MFCC::numFeatures( outputs ) floats, valid only during the call
+     */
+    typedef std::function< void( const int streamId, const uint64_t frameIndex, const float* features ) > Callback;
+
+    /** @brief constructor. Starts the workers.
+     *
+     *  @param numWorkers      : number of worker threads
+     *  @param outputs         : bitwise OR of MFCC::cOutput*, common to all streams
+     *  @param maxQueuedFrames : bound of the frame queue of each stream
+     *  @param maxBatchWaitUs  : longest wait for a full batch in micro seconds
+     *  @param useNeon         : runs the _neon kernels if available
+     */
+    MultiStreamScheduler(
+        const int          numWorkers,
+        const unsigned int outputs,
+        const int          maxQueuedFrames = 32,
+        const int          maxBatchWaitUs  = 2000,
+        const bool         useNeon         = true
+    )
+        :mOutputs        ( outputs )
+        ,mNumFeatures    ( MFCC::numFeatures( outputs ) )
+        ,mMaxQueuedFrames( std::max( maxQueuedFrames, 1 ) )
+        ,mMaxBatchWait   ( std::max( maxBatchWaitUs, 0 ) )
+        ,mUseNeon        ( useNeon )
+        ,mNextStream     ( 0 )
+        ,mNumQueuedFrames( 0 )
+        ,mStop           ( false )
+        ,mNumBatches     ( 0 )
+        ,mNumBatchedFrames( 0 )
+    {
+        for ( int i = 0; i < std::max( numWorkers, 1 ); i++ ) {
+            mWorkers.emplace_back( &MultiStreamScheduler::workerLoop, this );
+        }
+    }
+
+    /** @brief destructor. Frames still in the queues are discarded, and pushSamplesBlocking()
+     *         and drain() return without waiting further.
+     */
+    ~MultiStreamScheduler() {
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mStop = true;
+        }
+        mWorkAvailable.notify_all();
+        mStreamIdle.notify_all();
+
+        for ( auto& w : mWorkers ) {
+            w.join();
+        }
+    }
+
+    /** @brief adds a stream.
+     *
+     *  @param callback : receives the features of the frames of this stream
+     *  @return stream id
+     */
+    int addStream( const Callback& callback ) {
+
+        std::lock_guard< std::mutex > lock( mMutex );
+
+        std::unique_ptr< Stream > s( new Stream( mMaxQueuedFrames, callback ) );
+
+        for ( size_t i = 0; i < mStreams.size(); i++ ) {
+            if ( !mStreams[ i ] ) {
+                mStreams[ i ] = std::move( s );
+                return (int)i;
+            }
+        }
+        mStreams.push_back( std::move( s ) );
+        return (int)mStreams.size() - 1;
+    }
+
+    /** @brief removes a stream after the batch in flight, if any, has been delivered.
+     *         Queued frames are discarded and no more callbacks are made for the stream.
+     *         From a callback, i.e., on a worker, it does not wait for the batch, which could be
+     *         the one of the caller. The rest of the batch is then not delivered, and the worker
+     *         removes the stream after it.
+     */
+    void removeStream( const int streamId ) {
+
+        std::unique_lock< std::mutex > lock( mMutex );
+
+        Stream* s = findStream( streamId );
+        if ( s == nullptr ) {
+            return;
+        }
+        if ( s->inFlight && isWorkerThread() ) {
+            mNumQueuedFrames -= s->numQueued;
+            s->numQueued = 0;
+            s->removed.store( true );
+            return;
+        }
+        mStreamIdle.wait( lock, [ s ] { return !s->inFlight; } );
+
+        mNumQueuedFrames -= s->numQueued;
+        mStreams[ streamId ].reset();
+    }
+
+    /** @brief feeds samples of one stream.
+     *
+     *  @return number of samples accepted. Fewer than numSamples if the queue of the stream is full.
+     */
+    int pushSamples( const int streamId, const int16_t* samples, const int numSamples ) {
+
+        std::lock_guard< std::mutex > lock( mMutex );
+
+        Stream* s = findStream( streamId );
+        if ( s == nullptr ) {
+            return 0;
+        }
+        const int accepted = s->buffer.putSamples( samples, numSamples );
+        enqueueFrames( *s );
+        return accepted;
+    }
+
+    int pushSamples( const int streamId, const float* samples, const int numSamples ) {
+
+        std::lock_guard< std::mutex > lock( mMutex );
+
+        Stream* s = findStream( streamId );
+        if ( s == nullptr ) {
+            return 0;
+        }
+        const int accepted = s->buffer.putSamples( samples, numSamples );
+        enqueueFrames( *s );
+        return accepted;
+    }
+
+    /** @brief feeds all the samples, waiting for room in the queue as needed.
+     */
+    void pushSamplesBlocking( const int streamId, const int16_t* samples, const int numSamples ) {
+
+        std::unique_lock< std::mutex > lock( mMutex );
+
+        int done = 0;
+        while ( done < numSamples && !mStop ) {
+
+            Stream* s = findStream( streamId );
+            if ( s == nullptr ) {
+                return;
+            }
+            done += s->buffer.putSamples( &samples[ done ], numSamples - done );
+            enqueueFrames( *s );
+
+            if ( done < numSamples ) {
+                mStreamIdle.wait( lock );
+            }
+        }
+    }
+
+    /** @brief waits until all the frames queued so far have been delivered.
+     */
+    void drain() {
+
+        std::unique_lock< std::mutex > lock( mMutex );
+        mStreamIdle.wait( lock, [ this ] { return mStop || ( mNumQueuedFrames == 0 && !anyInFlight() ); } );
+    }
+
+    int      numWorkers()       const { return (int)mWorkers.size(); }
+    int      numFeatures()      const { return mNumFeatures; }
+    uint64_t numBatches()       const { std::lock_guard< std::mutex > lock( mMutex ); return mNumBatches; }
+    uint64_t numBatchedFrames() const { std::lock_guard< std::mutex > lock( mMutex ); return mNumBatchedFrames; }
+
+private:
+
+    static constexpr int cNumLanes = MFCCBatch4::cNumLanes;
+
+    struct Stream {
+
+        Stream( const int maxQueuedFrames, const Callback& cb )
+            :buffer     ( MFCC::cFrameSizeSamples, MFCC::cFrameShiftSamples,
+                          MFCC::cFrameSizeSamples + MFCC::cFrameShiftSamples * maxQueuedFrames )
+            ,frames     ( (size_t)maxQueuedFrames * MFCC::cFrameSizeSamples )
+            ,capacity   ( maxQueuedFrames )
+            ,head       ( 0 )
+            ,numQueued  ( 0 )
+            ,nextFrame  ( 0 )
+            ,inFlight   ( false )
+            ,removed    ( false )
+            ,callback   ( cb )
+        {
+            ;
+        }
+
+        StreamingFrameBuffer  buffer;
+        std::vector< float >  frames;     // ring of capacity frames
+        int                   capacity;
+        int                   head;       // oldest queued frame
+        int                   numQueued;
+        uint64_t              nextFrame;  // index of the frame at head
+        bool                  inFlight;
+        std::atomic< bool >   removed;    // by removeStream() from a callback, until the batch is done
+        Callback              callback;
+    };
+
+    /** @brief one frame taken by a worker. The stream is not removed while it is in flight.
+     */
+    struct Job {
+        Stream*  stream;
+        int      streamId;
+        uint64_t frameIndex;
+    };
+
+    Stream* findStream( const int streamId ) const {
+
+        if ( streamId < 0 || streamId >= (int)mStreams.size() ) {
+            return nullptr;
+        }
+        Stream* s = mStreams[ streamId ].get();
+        return ( s != nullptr && !s->removed.load() ) ? s : nullptr;
+    }
+
+    bool isWorkerThread() const {
+
+        for ( const auto& w : mWorkers ) {
+            if ( w.get_id() == std::this_thread::get_id() ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool anyInFlight() const {
+
+        for ( const auto& s : mStreams ) {
+            if ( s && s->inFlight ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief moves complete frames from the stream buffer to the queue while there is room.
+     */
+    void enqueueFrames( Stream& s ) {
+
+        int moved = 0;
+
+        while ( s.buffer.numFrames() > 0 && s.numQueued < s.capacity ) {
+
+            const int tail = ( s.head + s.numQueued ) % s.capacity;
+            memcpy( &s.frames[ (size_t)tail * MFCC::cFrameSizeSamples ], s.buffer.samples(),
+                    sizeof(float) * MFCC::cFrameSizeSamples );
+            s.buffer.consumeFrames( 1 );
+            s.numQueued++;
+            moved++;
+        }
+
+        if ( moved > 0 ) {
+            mNumQueuedFrames += moved;
+            mWorkAvailable.notify_one();
+        }
+    }
+
+    /** @brief number of frames that a worker could take now.
+     */
+    int numRunnableFrames() const {
+
+        int n = 0;
+        for ( const auto& s : mStreams ) {
+            if ( s && !s->inFlight ) {
+                n += s->numQueued;
+            }
+        }
+        return n;
+    }
+
+    /** @brief takes up to cNumLanes frames, one from each idle stream in turn, round robin
+     *         from mNextStream, and then more from the same streams if lanes are left.
+     *         The streams taken are marked in flight. The later frames of a stream always
+     *         go to the later lanes, so delivering the lanes in order keeps each stream in order.
+     */
+    int takeBatch( Job* jobs, float* frames ) {
+
+        const int numStreams = (int)mStreams.size();
+        int       numJobs    = 0;
+        int       taken[ cNumLanes ];
+        int       numTaken   = 0;
+
+        for ( int i = 0; i < numStreams && numJobs < cNumLanes; i++ ) {
+
+            const int id = ( mNextStream + i ) % numStreams;
+            Stream*   s  = mStreams[ id ].get();
+
+            if ( s != nullptr && !s->inFlight && s->numQueued > 0 ) {
+                s->inFlight         = true;
+                taken[ numTaken++ ] = id;
+                takeFrame( id, *s, jobs[ numJobs ], &frames[ numJobs * MFCC::cFrameSizeSamples ] );
+                numJobs++;
+                mNextStream = ( id + 1 ) % numStreams;
+            }
+        }
+
+        for ( int i = 0; i < numTaken && numJobs < cNumLanes; i++ ) {
+
+            Stream* s = mStreams[ taken[ i ] ].get();
+
+            while ( s->numQueued > 0 && numJobs < cNumLanes ) {
+                takeFrame( taken[ i ], *s, jobs[ numJobs ], &frames[ numJobs * MFCC::cFrameSizeSamples ] );
+                numJobs++;
+            }
+        }
+
+        mNumQueuedFrames -= numJobs;
+        return numJobs;
+    }
+
+    void takeFrame( const int id, Stream& s, Job& job, float* frame ) {
+
+        memcpy( frame, &s.frames[ (size_t)s.head * MFCC::cFrameSizeSamples ], sizeof(float) * MFCC::cFrameSizeSamples );
+        job.stream     = &s;
+        job.streamId   = id;
+        job.frameIndex = s.nextFrame;
+
+        s.head = ( s.head + 1 ) % s.capacity;
+        s.numQueued--;
+        s.nextFrame++;
+
+        // Room in the queue for the frames waiting in the stream buffer.
+        enqueueFrames( s );
+    }
+
+    void workerLoop() {
+
+        std::unique_ptr< MFCCBatch4 > kernel( new MFCCBatch4() );
+        kernel->prepareOutputs( mOutputs );
+        std::vector< float >          frames  ( (size_t)cNumLanes * MFCC::cFrameSizeSamples );
+        std::vector< float >          features( (size_t)cNumLanes * std::max( mNumFeatures, 1 ) );
+        Job                           jobs[ cNumLanes ];
+
+        while ( true ) {
+
+            int numJobs = 0;
+            {
+                std::unique_lock< std::mutex > lock( mMutex );
+
+                mWorkAvailable.wait( lock, [ this ] { return mStop || numRunnableFrames() > 0; } );
+                if ( mStop ) {
+                    return;
+                }
+
+                // Bounded wait for a full batch.
+                if ( numRunnableFrames() < cNumLanes && mMaxBatchWait.count() > 0 ) {
+                    const auto deadline = std::chrono::steady_clock::now() + mMaxBatchWait;
+                    mWorkAvailable.wait_until( lock, deadline,
+                        [ this ] { return mStop || numRunnableFrames() >= cNumLanes; } );
+                    if ( mStop ) {
+                        return;
+                    }
+                }
+
+                numJobs = takeBatch( jobs, frames.data() );
+                if ( numJobs == 0 ) {
+                    continue;
+                }
+                mNumBatches++;
+                mNumBatchedFrames += numJobs;
+            }
+
+            const float* in [ cNumLanes ];
+            float*       out[ cNumLanes ];
+
+            for ( int l = 0; l < numJobs; l++ ) {
+                in [ l ] = &frames  [ (size_t)l * MFCC::cFrameSizeSamples ];
+                out[ l ] = &features[ (size_t)l * mNumFeatures ];
+            }
+
+#ifdef HAVE_NEON
+            if ( mUseNeon ) {
+                kernel->generateFeatures_neon( in, numJobs, mOutputs, out );
+            }
+            else {
+                kernel->generateFeatures_cpp( in, numJobs, mOutputs, out );
+            }
+#else
+            kernel->generateFeatures_cpp( in, numJobs, mOutputs, out );
+#endif
+            // The stream stays in flight during the callbacks, so that the next batch of the
+            // same stream can not overtake this one.
+            for ( int l = 0; l < numJobs; l++ ) {
+                if ( !jobs[ l ].stream->removed.load() ) {
+                    jobs[ l ].stream->callback( jobs[ l ].streamId, jobs[ l ].frameIndex, out[ l ] );
+                }
+            }
+
+            {
+                std::lock_guard< std::mutex > lock( mMutex );
+                for ( int l = 0; l < numJobs; l++ ) {
+                    jobs[ l ].stream->inFlight = false;
+                }
+                // Removed from a callback. A stream is in at most one batch, so no other job refers to it.
+                for ( int l = 0; l < numJobs; l++ ) {
+                    const int id = jobs[ l ].streamId;
+                    if ( mStreams[ id ] && mStreams[ id ]->removed.load() ) {
+                        mStreams[ id ].reset();
+                    }
+                }
+            }
+            mStreamIdle.notify_all();
+            mWorkAvailable.notify_one();
+        }
+    }
+
+    const unsigned int                       mOutputs;
+    const int                                mNumFeatures;
+    const int                                mMaxQueuedFrames;
+    const std::chrono::microseconds          mMaxBatchWait;
+    const bool                               mUseNeon;
+
+    mutable std::mutex                       mMutex;
+    std::condition_variable                  mWorkAvailable;
+    std::condition_variable                  mStreamIdle;
+
+    std::vector< std::unique_ptr< Stream > > mStreams;   // nullptr for removed streams
+    int                                      mNextStream;
+    int                                      mNumQueuedFrames;
+    bool                                     mStop;
+    uint64_t                                 mNumBatches;
+    uint64_t                                 mNumBatchedFrames;
+
+    std::vector< std::thread >               mWorkers;
+};
+
+#endif //ANDROIDMFCC_MULTI_STREAM_SCHEDULER_H
@@ -0,0 +1,247 @@
+//
+// Feature extraction of multichannel captures, e.g., of a microphone array.
+//
+// The input is a block of interleaved 16-bit PCM at 16KHz, one sample of every channel per
+// time step. It is deinterleaved into one float buffer per channel, with vld2/vld3/vld4 for
+// 2, 3 and 4 channels and vld3/vld4 followed by vuzp for 6 and 8, and the frames of all the
+// channels then go through the 4-lane kernels of MFCCBatch4 four at a time, regardless of the
+// channel they belong to. The features come out channel-major:
+//
+//     features[ ( channel * numFrames + frame ) * MFCC::numFeatures( outputs ) + i ]
+//
+// The buffers grow to the largest block seen and are reused afterwards.
+//
+
+#ifndef ANDROIDMFCC_MULTICHANNEL_EXTRACTOR_H
+#define ANDROIDMFCC_MULTICHANNEL_EXTRACTOR_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "logging_macros.h"
+#include "mfcc.h"
+
+class MultichannelExtractor {
+
+public:
+
+    static constexpr int cMaxChannels = 8;
+    static constexpr int cNumLanes    = MFCCBatch4::cNumLanes;
+
+    MultichannelExtractor()
+        :mNumChannels( 0 )
+    {
+        ;
+    }
+
+    /** @brief number of frames per channel in a block.
+     *
+     *  @param numSamples  : samples in the block over all the channels
+     *  @param numChannels : number of channels
+     */
+    static int numFrames( const int numSamples, const int numChannels ) {
+
+        return ( numChannels <= 0 ) ? 0 : MFCC::numFrames( numSamples / numChannels );
+    }
+
+    /** @brief generates the requested outputs of all the frames of all the channels.
+     *
+     *  @param samples     : numSamples interleaved samples, numSamples / numChannels per channel.
+     *                       A trailing partial time step is ignored.
+     *  @param numSamples  : samples in the block over all the channels
+     *  @param numChannels : number of channels in [ 1, cMaxChannels ]
+     *  @param outputs     : bitwise OR of MFCC::cOutput*
+     *  @param features    : (out) numChannels * numFrames() rows of MFCC::numFeatures( outputs ), channel-major
+     *  @return number of frames per channel, or -1 for an unsupported number of channels.
+     */
+    int extract_cpp(
+        const int16_t*     samples,
+        const int          numSamples,
+        const int          numChannels,
+        const unsigned int outputs,
+        float*             features
+    ) {
+        if ( !prepare( numSamples, numChannels ) ) {
+            return -1;
+        }
+        deinterleave_cpp( samples, numChannels, numSamples / numChannels, mChannels );
+        return extractFrames( numSamples / numChannels, outputs, features, false );
+    }
+
+#ifdef HAVE_NEON
+    int extract_neon(
+        const int16_t*     samples,
+        const int          numSamples,
+        const int          numChannels,
+        const unsigned int outputs,
+        float*             features
+    ) {
+        if ( !prepare( numSamples, numChannels ) ) {
+            return -1;
+        }
+        deinterleave_neon( samples, numChannels, numSamples / numChannels, mChannels );
+        return extractFrames( numSamples / numChannels, outputs, features, true );
+    }
+#endif
+
+    /** @brief splits interleaved samples into one buffer per channel.
+     *
+     *  @param in            : numChannels * numPerChannel interleaved samples
+     *  @param numChannels   : number of channels
+     *  @param numPerChannel : samples per channel
+     *  @param out           : (out) out[ c ] receives numPerChannel samples of channel c
+     */
+    static void deinterleave_cpp( const int16_t* in, const int numChannels, const int numPerChannel, float* const* out ) {
+
+        for ( int i = 0; i < numPerChannel; i++ ) {
+            for ( int c = 0; c < numChannels; c++ ) {
+                out[ c ][ i ] = in[ i * numChannels + c ];
+            }
+        }
+    }
+
+#ifdef HAVE_NEON
+    static void deinterleave_neon( const int16_t* in, const int numChannels, const int numPerChannel, float* const* out ) {
+
+        int i = 0;
+
+        switch ( numChannels ) {
+
+          case 2:
+            for ( ; i + 8 <= numPerChannel; i += 8 ) {
+                const int16x8x2_t v = vld2q_s16( &in[ i * 2 ] );
+                store8( v.val[ 0 ], &out[ 0 ][ i ] );
+                store8( v.val[ 1 ], &out[ 1 ][ i ] );
+            }
+            break;
+
+          case 3:
+            for ( ; i + 8 <= numPerChannel; i += 8 ) {
+                const int16x8x3_t v = vld3q_s16( &in[ i * 3 ] );
+                for ( int c = 0; c < 3; c++ ) {
+                    store8( v.val[ c ], &out[ c ][ i ] );
+                }
+            }
+            break;
+
+          case 4:
+            for ( ; i + 8 <= numPerChannel; i += 8 ) {
+                const int16x8x4_t v = vld4q_s16( &in[ i * 4 ] );
+                for ( int c = 0; c < 4; c++ ) {
+                    store8( v.val[ c ], &out[ c ][ i ] );
+                }
+            }
+            break;
+
+          case 6:
+            // vld3q_s16 leaves channels c and c + 3 alternating in val[ c ], and vuzpq_s16 splits them.
+            for ( ; i + 4 <= numPerChannel; i += 4 ) {
+                const int16x8x3_t v = vld3q_s16( &in[ i * 6 ] );
+                for ( int c = 0; c < 3; c++ ) {
+                    const int16x8x2_t u = vuzpq_s16( v.val[ c ], v.val[ c ] );
+                    store4( vget_low_s16( u.val[ 0 ] ), &out[ c     ][ i ] );
+                    store4( vget_low_s16( u.val[ 1 ] ), &out[ c + 3 ][ i ] );
+                }
+            }
+            break;
+
+          case 8:
+            for ( ; i + 4 <= numPerChannel; i += 4 ) {
+                const int16x8x4_t v = vld4q_s16( &in[ i * 8 ] );
+                for ( int c = 0; c < 4; c++ ) {
+                    const int16x8x2_t u = vuzpq_s16( v.val[ c ], v.val[ c ] );
+                    store4( vget_low_s16( u.val[ 0 ] ), &out[ c     ][ i ] );
+                    store4( vget_low_s16( u.val[ 1 ] ), &out[ c + 4 ][ i ] );
+                }
+            }
+            break;
+
+          default:
+            break;
+        }
+
+        // The tail, and the channel counts without a structured load.
+        for ( ; i < numPerChannel; i++ ) {
+            for ( int c = 0; c < numChannels; c++ ) {
+                out[ c ][ i ] = in[ i * numChannels + c ];
+            }
+        }
+    }
+#endif
+
+private:
+
+#ifdef HAVE_NEON
+    static inline void store4( const int16x4_t v, float* out ) {
+
+        vst1q_f32( out, vcvtq_f32_s32( vmovl_s16( v ) ) );
+    }
+
+    static inline void store8( const int16x8_t v, float* out ) {
+
+        store4( vget_low_s16 ( v ), out     );
+        store4( vget_high_s16( v ), out + 4 );
+    }
+#endif
+
+    /** @brief sizes the per-channel buffers for the block.
+     */
+    bool prepare( const int numSamples, const int numChannels ) {
+
+        if ( numChannels < 1 || numChannels > cMaxChannels ) {
+            LOGE( "MultichannelExtractor: %d channels not supported.", numChannels );
+            return false;
+        }
+
+        const size_t stride = ( (size_t)std::max( numSamples / numChannels, 0 ) + 3 ) & ~(size_t)3;
+
+        if ( mSamples.size() < stride * numChannels ) {
+            mSamples.resize( stride * numChannels );
+        }
+        for ( int c = 0; c < numChannels; c++ ) {
+            mChannels[ c ] = mSamples.data() + stride * c;
+        }
+        mNumChannels = numChannels;
+        return true;
+    }
+
+    /** @brief runs the frames of all the channels through the kernels, cNumLanes at a time.
+     */
+    int extractFrames( const int numPerChannel, const unsigned int outputs, float* features, const bool useNeon ) {
+
+        const int frames      = MFCC::numFrames( numPerChannel );
+        const int numFeatures = MFCC::numFeatures( outputs );
+        const int total       = frames * mNumChannels;
+
+        const float* in [ cNumLanes ];
+        float*       out[ cNumLanes ];
+
+        for ( int first = 0; first < total; first += cNumLanes ) {
+
+            const int n = std::min( (int)cNumLanes, total - first );
+
+            for ( int l = 0; l < n; l++ ) {
+
+                const int c = ( first + l ) / frames;
+                const int f = ( first + l ) % frames;
+                in [ l ] = &mChannels[ c ][ (size_t)f * MFCC::cFrameShiftSamples ];
+                out[ l ] = &features[ (size_t)( first + l ) * numFeatures ];
+            }
+#ifdef HAVE_NEON
+            if ( useNeon ) {
+                mBatch.generateFeatures_neon( in, n, outputs, out );
+                continue;
+            }
+#endif
+            mBatch.generateFeatures_cpp( in, n, outputs, out );
+        }
+        return frames;
+    }
+
+    MFCCBatch4           mBatch;
+    std::vector< float > mSamples;                  // [ numChannels ][ numPerChannel rounded up to 4 ] planar samples
+    float*               mChannels[ cMaxChannels ]; // start of each channel in mSamples
+    int                  mNumChannels;
+};
+
+#endif //ANDROIDMFCC_MULTICHANNEL_EXTRACTOR_H
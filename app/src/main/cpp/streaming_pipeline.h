@@ -0,0 +1,558 @@
+//
+// Pipelined streaming extraction on 3 threads connected by lock-free single-producer
+// single-consumer queues.
+//
+//   capture thread : pushSamples()  [PolyphaseResampler] -> StreamingFrameBuffer
+//                                   -> 400-sample frames                          -> queue 1
+//   spectral stage : own thread     pre-emphasis, window, FFT, power, log spectrum
+//                                   and log Mel (MFCC::generateFeatures_*())      -> queue 2
+//   post stage     : own thread     DCT, mean normalization, deltas               -> queue 3
+//   consumer       : popFeatures()
+//
+// A slow frame then delays only the stage it is in, and the capture thread never runs the
+// FFT. Input at another rate than 16KHz, e.g., 48KHz capture, is resampled by the capture
+// thread straight into the frame buffer, without going back to int16. Each queue holds
+// queueFrames frames, which bounds the latency added by the pipeline.
+// When a queue is full, the drop policy decides:
+//
+//   cDropPolicyBlock      : the producer waits for room. Backpressure reaches the capture thread.
+//                           popFeatures() must then run on another thread than pushSamples().
+//   cDropPolicyDropNewest : the new frame is dropped.
+//   cDropPolicyDropOldest : the consumer of the queue discards the oldest frames so that at most
+//                           half the queue is waiting, and the new frame is dropped if still full.
+//
+// A stage that finds its input queue empty, or its output queue full with cDropPolicyBlock,
+// yields for cIdleSpins tries and then sleeps on a condition variable. Pushes and pops notify
+// it only while a stage sleeps, so the lock-free path takes no lock, and an idle pipeline, e.g.,
+// while the capture is paused, does not wake up at all.
+//
+
+#ifndef ANDROIDMFCC_STREAMING_PIPELINE_H
+#define ANDROIDMFCC_STREAMING_PIPELINE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "mfcc.h"
+
+/** @brief lock-free bounded queue for exactly one producer thread and one consumer thread.
+ *         The slots are filled and read in place.
+ */
+template< class T >
+class SPSCQueue {
+
+public:
+
+    /** @brief constructor
+     *
+     *  @param capacity : number of slots, rounded up to a power of 2
+     */
+    explicit SPSCQueue( const int capacity )
+        :mHead( 0 )
+        ,mTail( 0 )
+    {
+        mCapacity = 1;
+        while ( mCapacity < (uint32_t)std::max( capacity, 1 ) ) {
+            mCapacity *= 2;
+        }
+        mSlots = new T[ mCapacity ];
+    }
+
+    ~SPSCQueue() {
+        delete[] mSlots;
+    }
+
+    /** @brief producer: the slot to fill, or nullptr if full. Published by push().
+     */
+    T* back() {
+
+        const uint32_t tail = mTail.load( std::memory_order_relaxed );
+        if ( tail - mHead.load( std::memory_order_acquire ) == mCapacity ) {
+            return nullptr;
+        }
+        return &mSlots[ tail & ( mCapacity - 1 ) ];
+    }
+
+    void push() {
+        mTail.store( mTail.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+    }
+
+    /** @brief consumer: the oldest slot, or nullptr if empty. Released by pop().
+     */
+    T* front() {
+
+        const uint32_t head = mHead.load( std::memory_order_relaxed );
+        if ( mTail.load( std::memory_order_acquire ) == head ) {
+            return nullptr;
+        }
+        return &mSlots[ head & ( mCapacity - 1 ) ];
+    }
+
+    void pop() {
+        mHead.store( mHead.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+    }
+
+    int size() const {
+        return (int)( mTail.load( std::memory_order_acquire ) - mHead.load( std::memory_order_acquire ) );
+    }
+
+    int capacity() const { return (int)mCapacity; }
+
+private:
+
+    // Padded apart, as they are written by different threads. Padding rather than alignas(),
+    // since C++14 new does not honor extended alignments.
+    std::atomic< uint32_t > mHead;
+    char                    mPadHead[ 64 ];
+    std::atomic< uint32_t > mTail;
+    char                    mPadTail[ 64 ];
+    uint32_t                mCapacity;
+    T*                      mSlots;
+};
+
+
+class StreamingPipeline {
+
+public:
+
+    static constexpr int cDropPolicyBlock      = 0;
+    static constexpr int cDropPolicyDropNewest = 1;
+    static constexpr int cDropPolicyDropOldest = 2;
+
+    // Post-processing on the MFCCs as a bit mask.
+    static constexpr unsigned int cPostMeanNormalization = 1 << 0; // subtract a running mean
+    static constexpr unsigned int cPostDeltas            = 1 << 1; // regression over +-cDeltaWindow frames
+
+    static constexpr int   cNumMFCC                 = MFCC::cNumFilterBanks + 1;
+    static constexpr int   cNumSpectrum             = MFCC::cNumPointsFFT / 2;
+    static constexpr int   cNumOutputs              = cNumMFCC + cNumSpectrum + cNumMFCC; // MFCC, log spectrum, deltas
+    static constexpr int   cDeltaWindow             = 2;       // deltas delay the output by 2 frames
+    static constexpr float cMeanNormalizationDecay  = 0.995;   // about 2[s] time constant at 10[ms] shift
+    static constexpr int   cIdleSpins               = 64;
+
+    /** @brief constructor. Starts the spectral and the post stages.
+     *
+     *  @param queueFrames : frames per queue
+     *  @param dropPolicy  : cDropPolicy*
+     *  @param postFlags   : bitwise OR of cPost*
+     *  @param useNeon     : runs the _neon kernels if available
+     *  @param inputRate   : sample rate of the PCM given to pushSamples()
+     */
+    StreamingPipeline(
+        const int          queueFrames,
+        const int          dropPolicy,
+        const unsigned int postFlags,
+        const bool         useNeon,
+        const int          inputRate = (int)MFCC::cSampleRate
+    )
+        :mDropPolicy    ( dropPolicy )
+        ,mPostFlags     ( postFlags  )
+        ,mUseNeon       ( useNeon    )
+        ,mResampler     ( ( inputRate != (int)MFCC::cSampleRate ) ? new PolyphaseResampler( inputRate, (int)MFCC::cSampleRate ) : nullptr )
+        ,mFrameBuffer   ( MFCC::cFrameSizeSamples, MFCC::cFrameShiftSamples, 4 * MFCC::cFrameSizeSamples )
+        ,mFrames        ( queueFrames )
+        ,mSpectra       ( queueFrames )
+        ,mOutputs       ( queueFrames )
+        ,mNextFrameIndex( 0 )
+        ,mNumHistory    ( 0 )
+        ,mStop          ( false )
+        ,mNumSleeping   ( 0 )
+        ,mNumFramesIn   ( 0 )
+        ,mNumDropped    ( 0 )
+        ,mNumFramesOut  ( 0 )
+        ,mMaxLatencyNs  ( 0 )
+        ,mSumLatencyNs  ( 0 )
+    {
+        memset( mMean, 0, sizeof(mMean) );
+
+        mSpectralThread = std::thread( &StreamingPipeline::spectralLoop, this );
+        mPostThread     = std::thread( &StreamingPipeline::postLoop,     this );
+    }
+
+    /** @brief destructor. Frames in the queues are discarded.
+     */
+    ~StreamingPipeline() {
+
+        stop();
+        mSpectralThread.join();
+        mPostThread.join();
+
+        delete mResampler;
+    }
+
+    /** @brief capture thread: feeds samples at the input rate and queues the frames completed by them.
+     *         The latency of these frames counts from now.
+     *
+     *  @return number of frames queued
+     */
+    int pushSamples( const int16_t* samples, const int numSamples ) {
+
+        const int64_t arrivalNs = nowNs();
+        int           queued    = 0;
+
+        for ( int done = 0; done < numSamples; ) {
+
+            done += putSamples( &samples[ done ], numSamples - done );
+
+            while ( mFrameBuffer.numFrames() > 0 ) {
+
+                mNumFramesIn++;
+
+                FrameSlot* slot = acquire( mFrames );
+                if ( slot != nullptr ) {
+                    slot->index       = mNextFrameIndex;
+                    slot->captureTime = arrivalNs;
+                    memcpy( slot->samples, mFrameBuffer.samples(), sizeof(float) * MFCC::cFrameSizeSamples );
+                    mFrames.push();
+                    wake();
+                    queued++;
+                }
+                mNextFrameIndex++;
+                mFrameBuffer.consumeFrames( 1 );
+            }
+        }
+        return queued;
+    }
+
+    /** @brief consumer: takes the features of the oldest frame done.
+     *
+     *  @param features   : (out) cNumOutputs floats: 27 MFCCs, 256-point log spectrum and 27 deltas.
+     *                            The deltas are 0 without cPostDeltas.
+     *  @param frameIndex : (out) index of the frame in the stream, or nullptr. Dropped frames leave gaps.
+     *  @param arrivalNs  : (out) steady clock in ns when the samples completing the frame were pushed, or nullptr
+     *  @return false if no frame is done
+     */
+    bool popFeatures( float* features, uint64_t* frameIndex = nullptr, int64_t* arrivalNs = nullptr ) {
+
+        skipBacklog( mOutputs );
+
+        OutputSlot* slot = mOutputs.front();
+        if ( slot == nullptr ) {
+            return false;
+        }
+        memcpy( features, slot->features, sizeof(float) * cNumOutputs );
+        if ( frameIndex != nullptr ) {
+            *frameIndex = slot->index;
+        }
+        if ( arrivalNs != nullptr ) {
+            *arrivalNs = slot->captureTime;
+        }
+
+        const int64_t latency = nowNs() - slot->captureTime;
+        mOutputs.pop();
+        wake();
+
+        mNumFramesOut++;
+        mSumLatencyNs += latency;
+        if ( latency > mMaxLatencyNs.load() ) {
+            mMaxLatencyNs.store( latency );
+        }
+        return true;
+    }
+
+    /** @brief any thread: stops the stages. pushSamples() then drops the frames instead of
+     *         waiting for room, and the destructor only joins the threads.
+     */
+    void stop() {
+
+        mStop.store( true );
+
+        std::lock_guard< std::mutex > lock( mWakeMutex );
+        mWake.notify_all();
+    }
+
+    int      inputRate()      const { return mResampler != nullptr ? mResampler->inputRate() : (int)MFCC::cSampleRate; }
+    uint64_t numFramesIn()    const { return mNumFramesIn.load();  }
+    uint64_t numDropped()     const { return mNumDropped.load();   }
+    uint64_t numFramesOut()   const { return mNumFramesOut.load(); }
+    int64_t  maxLatencyNs()   const { return mMaxLatencyNs.load(); }
+    int64_t  meanLatencyNs()  const { return mNumFramesOut.load() > 0 ? mSumLatencyNs.load() / (int64_t)mNumFramesOut.load() : 0; }
+
+private:
+
+    struct FrameSlot {
+        uint64_t index;
+        int64_t  captureTime;
+        float    samples[ MFCC::cFrameSizeSamples ];
+    };
+
+    struct SpectrumSlot {
+        uint64_t index;
+        int64_t  captureTime;
+        float    logSpectrum[ cNumSpectrum ];
+        float    logMel     [ MFCC::cNumFilterBankssRoundUp4 ]; // zero padded for DCT::transform_neon()
+    };
+
+    struct OutputSlot {
+        uint64_t index;
+        int64_t  captureTime;
+        float    features[ cNumOutputs ];
+    };
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast< std::chrono::nanoseconds >(
+                   std::chrono::steady_clock::now().time_since_epoch() ).count();
+    }
+
+    /** @brief as many samples as the frame buffer takes now, resampled to 16KHz if needed.
+     *
+     *  @return number of input samples consumed
+     */
+    int putSamples( const int16_t* samples, const int numSamples ) {
+
+        if ( mResampler == nullptr ) {
+            return mFrameBuffer.putSamples( samples, numSamples );
+        }
+#ifdef HAVE_NEON
+        if ( mUseNeon ) {
+            return mResampler->process_neon( samples, numSamples, mFrameBuffer );
+        }
+#endif
+        return mResampler->process_cpp( samples, numSamples, mFrameBuffer );
+    }
+
+    /** @brief waits a little for ready() to become true. Yields for the first cIdleSpins calls in a
+     *         row, and then sleeps until a queue changes or the pipeline stops.
+     */
+    template< class Ready >
+    void idle( int& spins, Ready ready ) {
+
+        if ( spins++ < cIdleSpins ) {
+            std::this_thread::yield();
+            return;
+        }
+
+        std::unique_lock< std::mutex > lock( mWakeMutex );
+
+        // Counted before ready() is checked. See wake().
+        mNumSleeping.fetch_add( 1 );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+
+        mWake.wait( lock, [ & ] { return ready() || mStop.load(); } );
+        mNumSleeping.fetch_sub( 1 );
+    }
+
+    /** @brief after a push() or a pop(): wakes the sleeping stages, if any. The fence orders the
+     *         queue update before the check of mNumSleeping, as idle() orders its count before its
+     *         check of the queue, so either the stage sees the update or wake() sees the stage.
+     */
+    void wake() {
+
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+
+        if ( mNumSleeping.load( std::memory_order_relaxed ) > 0 ) {
+            std::lock_guard< std::mutex > lock( mWakeMutex );
+            mWake.notify_all();
+        }
+    }
+
+    /** @brief producer side of the drop policy. nullptr if the frame is to be dropped.
+     */
+    template< class T >
+    T* acquire( SPSCQueue< T >& queue ) {
+
+        int spins = 0;
+        T*  slot;
+
+        while ( ( slot = queue.back() ) == nullptr ) {
+
+            if ( mDropPolicy != cDropPolicyBlock || mStop.load() ) {
+                mNumDropped++;
+                return nullptr;
+            }
+            idle( spins, [ & ] { return queue.back() != nullptr; } );
+        }
+        return slot;
+    }
+
+    /** @brief consumer side of the drop policy.
+     */
+    template< class T >
+    void skipBacklog( SPSCQueue< T >& queue ) {
+
+        if ( mDropPolicy != cDropPolicyDropOldest ) {
+            return;
+        }
+        if ( queue.size() <= queue.capacity() / 2 ) {
+            return;
+        }
+        while ( queue.size() > queue.capacity() / 2 ) {
+            queue.pop();
+            mNumDropped++;
+        }
+        wake();
+    }
+
+    void spectralLoop() {
+
+        MFCC  mfcc;
+        float features[ cNumSpectrum + MFCC::cNumFilterBanks ];
+        int   spins = 0;
+
+        while ( !mStop.load() ) {
+
+            skipBacklog( mFrames );
+
+            FrameSlot* in = mFrames.front();
+            if ( in == nullptr ) {
+                idle( spins, [ this ] { return mFrames.front() != nullptr; } );
+                continue;
+            }
+            spins = 0;
+
+            const unsigned int outputs = MFCC::cOutputLogSpectrum | MFCC::cOutputLogMel;
+#ifdef HAVE_NEON
+            if ( mUseNeon ) {
+                mfcc.generateFeatures_neon( in->samples, outputs, features );
+            }
+            else {
+                mfcc.generateFeatures_cpp( in->samples, outputs, features );
+            }
+#else
+            mfcc.generateFeatures_cpp( in->samples, outputs, features );
+#endif
+            SpectrumSlot* out = acquire( mSpectra );
+            if ( out != nullptr ) {
+                out->index       = in->index;
+                out->captureTime = in->captureTime;
+                memcpy( out->logSpectrum, features, sizeof(float) * cNumSpectrum );
+                memset( out->logMel, 0, sizeof(out->logMel) );
+                memcpy( out->logMel, &features[ cNumSpectrum ], sizeof(float) * MFCC::cNumFilterBanks );
+                mSpectra.push();
+            }
+            mFrames.pop();
+            wake();
+        }
+    }
+
+    void postLoop() {
+
+        AlignedArena arena( DCT::arenaBytes( MFCC::cNumFilterBanks ) );
+        DCT          dct( arena, MFCC::cNumFilterBanks );
+        int spins = 0;
+
+        while ( !mStop.load() ) {
+
+            skipBacklog( mSpectra );
+
+            SpectrumSlot* in = mSpectra.front();
+            if ( in == nullptr ) {
+                idle( spins, [ this ] { return mSpectra.front() != nullptr; } );
+                continue;
+            }
+            spins = 0;
+
+            // The newest entry of the history gets this frame.
+            OutputSlot& cur = mHistory[ mNumHistory % cHistorySize ];
+            cur.index       = in->index;
+            cur.captureTime = in->captureTime;
+#ifdef HAVE_NEON
+            if ( mUseNeon ) {
+                dct.transform_neon( in->logMel, cur.features );
+            }
+            else {
+                dct.transform_cpp( in->logMel, cur.features );
+            }
+#else
+            dct.transform_cpp( in->logMel, cur.features );
+#endif
+            memcpy( &cur.features[ cNumMFCC ], in->logSpectrum, sizeof(float) * cNumSpectrum );
+            memset( &cur.features[ cNumMFCC + cNumSpectrum ], 0, sizeof(float) * cNumMFCC );
+            mSpectra.pop();
+            wake();
+
+            if ( mPostFlags & cPostMeanNormalization ) {
+                for ( int i = 0; i < cNumMFCC; i++ ) {
+                    mMean[ i ]          = cMeanNormalizationDecay * mMean[ i ] + ( 1.0f - cMeanNormalizationDecay ) * cur.features[ i ];
+                    cur.features[ i ] -= mMean[ i ];
+                }
+            }
+            mNumHistory++;
+
+            if ( mPostFlags & cPostDeltas ) {
+                // Frame t - cDeltaWindow has its right context now.
+                if ( mNumHistory > cDeltaWindow ) {
+                    emit( deltas( mNumHistory - 1 - cDeltaWindow ) );
+                }
+            }
+            else {
+                emit( cur );
+            }
+        }
+    }
+
+    /** @brief history entry t with the deltas filled in. Frames before the first one repeat it.
+     */
+    OutputSlot& deltas( const uint64_t t ) {
+
+        OutputSlot& center = mHistory[ t % cHistorySize ];
+        float*      delta  = &center.features[ cNumMFCC + cNumSpectrum ];
+
+        float denominator = 0.0;
+        for ( int n = 1; n <= cDeltaWindow; n++ ) {
+            denominator += 2.0f * n * n;
+        }
+
+        for ( int n = 1; n <= cDeltaWindow; n++ ) {
+
+            const float* next = mHistory[ ( t + n ) % cHistorySize ].features;
+            const float* prev = mHistory[ ( t >= (uint64_t)n ? t - n : 0 ) % cHistorySize ].features;
+
+            for ( int i = 0; i < cNumMFCC; i++ ) {
+                delta[ i ] += n * ( next[ i ] - prev[ i ] ) / denominator;
+            }
+        }
+        return center;
+    }
+
+    void emit( const OutputSlot& slot ) {
+
+        OutputSlot* out = acquire( mOutputs );
+        if ( out != nullptr ) {
+            *out = slot;
+            mOutputs.push();
+            wake();
+        }
+    }
+
+    static constexpr int cHistorySize = 2 * cDeltaWindow + 1;
+
+    const int                   mDropPolicy;
+    const unsigned int          mPostFlags;
+    const bool                  mUseNeon;
+
+    // Capture thread
+    PolyphaseResampler*         mResampler;   // nullptr at 16KHz input
+    StreamingFrameBuffer        mFrameBuffer;
+
+    SPSCQueue< FrameSlot >      mFrames;
+    SPSCQueue< SpectrumSlot >   mSpectra;
+    SPSCQueue< OutputSlot >     mOutputs;
+
+    uint64_t                    mNextFrameIndex;
+
+    // Post stage
+    OutputSlot                  mHistory[ cHistorySize ];
+    uint64_t                    mNumHistory;
+    float                       mMean[ cNumMFCC ];
+
+    std::atomic< bool >         mStop;
+    std::atomic< int >          mNumSleeping;   // stages waiting on mWake
+    std::mutex                  mWakeMutex;
+    std::condition_variable     mWake;
+    std::atomic< uint64_t >     mNumFramesIn;
+    std::atomic< uint64_t >     mNumDropped;
+    std::atomic< uint64_t >     mNumFramesOut;
+    std::atomic< int64_t >      mMaxLatencyNs;
+    std::atomic< int64_t >      mSumLatencyNs;
+
+    std::thread                 mSpectralThread;
+    std::thread                 mPostThread;
+};
+
+#endif //ANDROIDMFCC_STREAMING_PIPELINE_H
@@ -0,0 +1,315 @@
+//
+// Work-stealing thread pool for batch feature extraction.
+//
+// Each worker owns an MFCC instance as its scratch state and a deque of tasks. The instances
+// are carved out of one aligned arena, so that the pool makes a single allocation for all of
+// their tables and scratch buffers. A worker runs the tasks of its own deque from the back
+// and, when it runs dry, steals from the front of the other deques, so that workers that got
+// short inputs help out with the long ones instead of idling. Tasks are typically chunks of a
+// few hundred frames of one input (submitExtraction()).
+//
+// Workers can be pinned to CPUs, e.g., to the big cores of a big.LITTLE SoC, and each of them
+// counts the tasks, steals, frames and busy time for throughput figures.
+//
+
+#ifndef ANDROIDMFCC_WORK_STEALING_POOL_H
+#define ANDROIDMFCC_WORK_STEALING_POOL_H
+
+#include <stdint.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "logging_macros.h"
+#include "mfcc.h"
+
+class WorkStealingPool {
+
+public:
+
+    /** @brief a task runs on the MFCC instance of the worker and returns the number of frames it generated.
+     */
+    typedef std::function< int( MFCC& mfcc ) > Task;
+
+    struct WorkerStats {
+        uint64_t numTasks;
+        uint64_t numSteals;    // tasks taken from other workers
+        uint64_t numFrames;
+        double   busySeconds;
+
+        double framesPerSecond() const { return busySeconds > 0.0 ? (double)numFrames / busySeconds : 0.0; }
+    };
+
+    /** @brief constructor. Starts the workers.
+     *
+     *  @param numWorkers : number of worker threads
+     *  @param cpus       : worker i is pinned to cpus[ i % cpus.size() ]. Empty for no pinning.
+     */
+    WorkStealingPool( const int numWorkers, const std::vector< int >& cpus = std::vector< int >() )
+        :mArena      ( nullptr, (size_t)std::max( numWorkers, 1 ) * MFCC::arenaBytes() )
+        ,mNumQueued  ( 0 )
+        ,mNumPending ( 0 )
+        ,mNextQueue  ( 0 )
+        ,mStop       ( false )
+    {
+        const int n = std::max( numWorkers, 1 );
+
+        for ( int i = 0; i < n; i++ ) {
+            mWorkers.emplace_back( new Worker( &mArena ) );
+        }
+        for ( int i = 0; i < n; i++ ) {
+            const int cpu = cpus.empty() ? -1 : cpus[ i % cpus.size() ];
+            mWorkers[ i ]->thread = std::thread( &WorkStealingPool::workerLoop, this, i, cpu );
+        }
+    }
+
+    /** @brief destructor. Runs the remaining tasks and stops the workers.
+     */
+    ~WorkStealingPool() {
+
+        wait();
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mStop = true;
+        }
+        mWorkAvailable.notify_all();
+
+        for ( auto& w : mWorkers ) {
+            w->thread.join();
+        }
+    }
+
+    /** @brief queues a task. From a worker it goes to the deque of that worker, otherwise
+     *         to the deques in turn.
+     */
+    void submit( const Task& task ) {
+
+        const int self  = currentWorker();
+        const int queue = ( self >= 0 ) ? self : (int)( mNextQueue++ % mWorkers.size() );
+
+        mNumPending++;
+        {
+            std::lock_guard< std::mutex > lock( mWorkers[ queue ]->mutex );
+            mWorkers[ queue ]->tasks.push_back( task );
+        }
+        {
+            // Under mMutex so that a worker about to sleep does not miss it.
+            std::lock_guard< std::mutex > lock( mMutex );
+            mNumQueued++;
+        }
+        mWorkAvailable.notify_one();
+    }
+
+    /** @brief queues the extraction of one input in chunks of framesPerChunk frames.
+     *         Same output as MFCC::generateFeaturesBatch_*() on the whole input.
+     *
+     *  @param samples        : time domain samples, alive until wait() returns
+     *  @param numSamples     : number of samples
+     *  @param outputs        : bitwise OR of MFCC::cOutput*
+     *  @param features       : (out) MFCC::numFrames( numSamples ) rows of MFCC::numFeatures( outputs )
+     *  @param framesPerChunk : frames per task
+     *  @param useNeon        : runs generateFeaturesBatch_neon() if available
+     *  @return number of frames that will be generated
+     */
+    int submitExtraction(
+        float*             samples,
+        const int          numSamples,
+        const unsigned int outputs,
+        float*             features,
+        const int          framesPerChunk,
+        const bool         useNeon
+    ) {
+        const int frames      = MFCC::numFrames( numSamples );
+        const int numFeatures = MFCC::numFeatures( outputs );
+        const int chunk       = std::max( framesPerChunk, 1 );
+#ifndef HAVE_NEON
+        (void)useNeon;
+#endif
+
+        for ( int first = 0; first < frames; first += chunk ) {
+
+            const int n            = std::min( chunk, frames - first );
+            float*    in           = &samples [ (size_t)first * MFCC::cFrameShiftSamples ];
+            float*    out          = &features[ (size_t)first * numFeatures ];
+            const int chunkSamples = ( n - 1 ) * MFCC::cFrameShiftSamples + MFCC::cFrameSizeSamples;
+
+            submit( [ = ]( MFCC& mfcc ) {
+#ifdef HAVE_NEON
+                if ( useNeon ) {
+                    return mfcc.generateFeaturesBatch_neon( in, chunkSamples, outputs, out );
+                }
+#endif
+                return mfcc.generateFeaturesBatch_cpp( in, chunkSamples, outputs, out );
+            } );
+        }
+        return frames;
+    }
+
+    /** @brief waits until all the tasks submitted so far, and the tasks they submitted, have run.
+     */
+    void wait() {
+
+        std::unique_lock< std::mutex > lock( mMutex );
+        mAllDone.wait( lock, [ this ] { return mNumPending.load() == 0; } );
+    }
+
+    int numWorkers() const { return (int)mWorkers.size(); }
+
+    WorkerStats stats( const int worker ) const {
+
+        std::lock_guard< std::mutex > lock( mWorkers[ worker ]->mutex );
+        return mWorkers[ worker ]->stats;
+    }
+
+    void resetStats() {
+
+        for ( auto& w : mWorkers ) {
+            std::lock_guard< std::mutex > lock( w->mutex );
+            w->stats = WorkerStats{ 0, 0, 0, 0.0 };
+        }
+    }
+
+    /** @brief pins the calling thread to the cpu. Linux and Android only.
+     *
+     *  @return true if pinned
+     */
+    static bool pinCurrentThread( const int cpu ) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO( &set );
+        CPU_SET( cpu, &set );
+        return sched_setaffinity( 0, sizeof(set), &set ) == 0;
+#else
+        return false;
+#endif
+    }
+
+private:
+
+    struct Worker {
+
+        Worker( AlignedArena* arena )
+            :mfcc  ( new MFCC( arena ) )
+            ,stats { 0, 0, 0, 0.0 }
+        {
+            ;
+        }
+
+        std::unique_ptr< MFCC > mfcc;
+        mutable std::mutex      mutex;     // guards tasks and stats
+        std::deque< Task >      tasks;
+        WorkerStats             stats;
+        std::thread             thread;
+    };
+
+    struct CurrentWorker {
+        const WorkStealingPool* pool;
+        int                     index;
+    };
+
+    static CurrentWorker& currentWorkerSlot() {
+        static thread_local CurrentWorker slot = { nullptr, -1 };
+        return slot;
+    }
+
+    /** @brief index of the worker of this pool running on the calling thread, or -1.
+     */
+    int currentWorker() const {
+        const CurrentWorker& c = currentWorkerSlot();
+        return ( c.pool == this ) ? c.index : -1;
+    }
+
+    /** @brief the newest task of the own deque, or the oldest one of another deque.
+     */
+    bool takeTask( const int self, Task& task, bool& stolen ) {
+        {
+            Worker& w = *mWorkers[ self ];
+            std::lock_guard< std::mutex > lock( w.mutex );
+            if ( !w.tasks.empty() ) {
+                task = std::move( w.tasks.back() );
+                w.tasks.pop_back();
+                mNumQueued--;
+                stolen = false;
+                return true;
+            }
+        }
+
+        const int n = (int)mWorkers.size();
+        for ( int i = 1; i < n; i++ ) {
+
+            Worker& victim = *mWorkers[ ( self + i ) % n ];
+            std::lock_guard< std::mutex > lock( victim.mutex );
+            if ( !victim.tasks.empty() ) {
+                task = std::move( victim.tasks.front() );
+                victim.tasks.pop_front();
+                mNumQueued--;
+                stolen = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop( const int self, const int cpu ) {
+
+        currentWorkerSlot() = CurrentWorker{ this, self };
+
+        if ( cpu >= 0 && !pinCurrentThread( cpu ) ) {
+            LOGW( "WorkStealingPool: worker %d could not be pinned to cpu %d", self, cpu );
+        }
+
+        Worker& w = *mWorkers[ self ];
+
+        while ( true ) {
+
+            Task task;
+            bool stolen = false;
+
+            if ( takeTask( self, task, stolen ) ) {
+
+                const auto t0     = std::chrono::steady_clock::now();
+                const int  frames = task( *w.mfcc );
+                const auto t1     = std::chrono::steady_clock::now();
+                {
+                    std::lock_guard< std::mutex > lock( w.mutex );
+                    w.stats.numTasks++;
+                    w.stats.numSteals  += stolen ? 1 : 0;
+                    w.stats.numFrames  += (uint64_t)std::max( frames, 0 );
+                    w.stats.busySeconds += std::chrono::duration< double >( t1 - t0 ).count();
+                }
+
+                if ( --mNumPending == 0 ) {
+                    std::lock_guard< std::mutex > lock( mMutex );
+                    mAllDone.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock< std::mutex > lock( mMutex );
+            mWorkAvailable.wait( lock, [ this ] { return mStop || mNumQueued > 0; } );
+            if ( mStop && mNumQueued == 0 ) {
+                return;
+            }
+        }
+    }
+
+    AlignedArena                             mArena;        // before mWorkers, which carve from it
+    std::vector< std::unique_ptr< Worker > > mWorkers;
+
+    std::mutex                               mMutex;        // for the waits on the conditions below
+    std::condition_variable                  mWorkAvailable;
+    std::condition_variable                  mAllDone;
+    std::atomic< int >                       mNumQueued;    // tasks in the deques
+    std::atomic< int >                       mNumPending;   // tasks submitted and not finished
+    std::atomic< unsigned int >              mNextQueue;
+    bool                                     mStop;
+};
+
+#endif //ANDROIDMFCC_WORK_STEALING_POOL_H
@@ -14,6 +14,7 @@ public class AudioReceiver {
     private static final String TAG = AudioReceiver.class.getSimpleName();
 
     private static final int RECORDING_RATE =16000;
+
     private static final int CHANNEL = AudioFormat.CHANNEL_IN_MONO;
     private static final int FORMAT = AudioFormat.ENCODING_PCM_16BIT;
 
@@ -30,16 +31,51 @@ public class AudioReceiver {
 
     AudioReceiverListener mListener;
 
+    int mCaptureRate;
+
+    MFCCCPP          mTracer = new MFCCCPP();
+    volatile boolean mTracing;
+
 
     AudioReceiver(AudioReceiverListener listener) {
+        this( listener, RECORDING_RATE );
+    }
+
+    /** @param captureRate : rate to record at, e.g., 48000, the native rate of most devices, to
+     *                       bypass the system resampler. The chunks are forwarded at this rate,
+     *                       and RECORDING_RATE is used if the device does not support it.
+     */
+    AudioReceiver(AudioReceiverListener listener, int captureRate) {
         mListener = listener;
-        receiveAndForward();
+        receiveAndForward( captureRate );
     }
 
-    void receiveAndForward() {
-        BUFFER_SIZE = AudioRecord.getMinBufferSize( RECORDING_RATE, CHANNEL, FORMAT );
+    /** @brief records the chunks as they are read into a capture trace until stopCaptureTrace().
+     *
+     * @param path : trace file to create
+     * @return true if the trace was created
+     */
+    boolean startCaptureTrace( String path ) {
+        mTracing = mTracer.startCaptureTrace( path, mCaptureRate, 1, buffer.length, System.nanoTime() );
+        return mTracing;
+    }
+
+    long stopCaptureTrace() {
+        mTracing = false;
+        return mTracer.stopCaptureTrace();
+    }
+
+    void receiveAndForward( int captureRate ) {
+        mCaptureRate = captureRate;
+        BUFFER_SIZE = AudioRecord.getMinBufferSize( mCaptureRate, CHANNEL, FORMAT );
+        if ( BUFFER_SIZE <= 0 ) {
+            mCaptureRate = RECORDING_RATE;
+            BUFFER_SIZE = AudioRecord.getMinBufferSize( mCaptureRate, CHANNEL, FORMAT );
+        }
+        mListener.onCaptureStarted( mCaptureRate );
+
         recorder = new AudioRecord(MediaRecorder.AudioSource.MIC,
-                RECORDING_RATE, CHANNEL, FORMAT, BUFFER_SIZE * 10);
+                mCaptureRate, CHANNEL, FORMAT, BUFFER_SIZE * 10);
         buffer = new short[BUFFER_SIZE];
         recorder.startRecording();
 
@@ -51,10 +87,20 @@ public class AudioReceiver {
                     Handler uiHandler = new Handler(Looper.getMainLooper());
                     while (true) {
 
-                        int lengthRead = recorder.read(buffer, 0, buffer.length);
+                        int readResult = recorder.read(buffer, 0, buffer.length);
+                        long arrivalNs = System.nanoTime();
+                        // Negative for an error. Traced as it is before giving up.
+                        int lengthRead = Math.max( readResult, 0 );
                         //Log.i(TAG, "length read: " + String.valueOf(lengthRead) );
                         short[] arrayToForward = new short[lengthRead];
                         System.arraycopy( buffer, 0, arrayToForward, 0,  lengthRead );
+                        if ( mTracing ) {
+                            mTracer.appendCaptureTrace( arrivalNs, arrayToForward, readResult );
+                        }
+                        if ( readResult < 0 ) {
+                            Log.e(TAG, "AudioRecord.read failed: " + readResult );
+                            break;
+                        }
                         mListener.onAudioArrivalMonauralPCM(arrayToForward);
 
                     }
@@ -2,6 +2,10 @@ package com.example.android_mfcc;
 
 public interface AudioReceiverListener {
 
+    /** @brief called once before the first chunk with the rate the chunks are recorded at.
+     */
+    void onCaptureStarted( int sampleRate );
+
     void onAudioArrivalMonauralPCM( short[] chunk );
 
 }
@@ -1,9 +1,48 @@
 package com.example.android_mfcc;
 
+import android.graphics.Bitmap;
+
 public class MFCCCPP implements MFCCInterface {
 
     private static final String TAG = MFCCCPP.class.getSimpleName();
 
+    // Outputs of generateFeatures as a bit mask. Must match MFCC::cOutput* in mfcc.h.
+    public static final int OUTPUT_MFCC         = 1 << 0; // 27 MFCCs
+    public static final int OUTPUT_LOG_SPECTRUM = 1 << 1; // 256-point log power spectrum
+    public static final int OUTPUT_LOG_MEL      = 1 << 2; // 26 log Mel filter bank energies
+    public static final int OUTPUT_FBANK        = 1 << 3; // 40 log Mel energies, or outputNumFbankBins(), without DCT
+    public static final int OUTPUT_CQT          = 1 << 4; // 36 log constant-Q powers, semitones from C6
+    public static final int OUTPUT_CHROMA       = 1 << 5; // 12 pitch classes from C, scaled to max 1
+    public static final int OUTPUT_PITCH        = 1 << 6; // F0 in Hz (0 if unvoiced) and voicing confidence
+
+    /** @brief bits to OR into the outputs to get only the first num_cepstra MFCCs, e.g.,
+     *         OUTPUT_MFCC | outputNumCepstra( 13 ). Must match MFCC::outputNumCepstra() in mfcc.h.
+     */
+    public static int outputNumCepstra( int num_cepstra ) {
+        return ( num_cepstra << 8 ) & 0xff00;
+    }
+
+    /** @brief bits to OR into the outputs for num_bins fbank bins (up to 128), e.g.,
+     *         OUTPUT_FBANK | outputNumFbankBins( 80 ). Must match MFCC::outputNumFbankBins() in mfcc.h.
+     */
+    public static int outputNumFbankBins( int num_bins ) {
+        return ( num_bins << 16 ) & 0xff0000;
+    }
+
+    // Pipelined mode. Must match StreamingPipeline in streaming_pipeline.h.
+    public static final int PIPELINE_BLOCK              = 0; // a full queue stalls the stage feeding it. Poll from another thread.
+    public static final int PIPELINE_DROP_NEWEST        = 1; // a full queue drops the new frame
+    public static final int PIPELINE_DROP_OLDEST        = 2; // a queue over half full drops its oldest frames
+    public static final int PIPELINE_MEAN_NORMALIZATION = 1 << 0;
+    public static final int PIPELINE_DELTAS             = 1 << 1;
+    public static final int PIPELINE_NUM_OUTPUTS        = 27 + 256 + 27; // MFCC, log spectrum, deltas
+
+    // Window types of setFrontEndParameters. Must match FrontEndParameters::cWindow* in mfcc.h.
+    public static final int WINDOW_HAMMING     = 0;
+    public static final int WINDOW_HANN        = 1;
+    public static final int WINDOW_POVEY       = 2;
+    public static final int WINDOW_RECTANGULAR = 3;
+
     static {
         System.loadLibrary( "mfcc_impl01" );
     }
@@ -27,4 +66,244 @@ public class MFCCCPP implements MFCCInterface {
      */
     public native float[] generateMFCCAndPowerSpectrum( int exec_type, float[] samples_real400 );
 
+    /** @brief generates only the requested outputs. The power spectrum is computed once
+     *         and shared by the MFCC and the log spectrum.
+     *
+     * @param exec_type       : 0         - Use NEON/SSE intrinsics.
+     *                          Otherwise - NOEN/SSE not used
+     * @param outputs         : bitwise OR of OUTPUT_*
+     * @param samples_real400 : time domain 400 real samples
+     * @return requested outputs concatenated in the order of the bits.
+     */
+    public native float[] generateFeatures( int exec_type, int outputs, float[] samples_real400 );
+
+    /** @brief configures the voice activity gate used by generateMFCCAndPowerSpectrumWithVAD
+     *
+     * @param energy_threshold_db          : frame energy threshold in dB full scale (default -50.0)
+     * @param zero_crossing_rate_threshold : zero crossings per sample for low-energy unvoiced frames (default 0.25)
+     * @param hangover_frames              : frames kept active after the last active one (default 8)
+     * @param emit_silence                 : true  - inactive frames return the cached silence features
+     *                                       false - inactive frames return null
+     */
+    public native void setVADParameters(
+        float energy_threshold_db, float zero_crossing_rate_threshold, int hangover_frames, boolean emit_silence );
+
+    /** @brief sets the framing, window and energy of the front end in the style of Kaldi or HTK.
+     *         The Mel filter banks stay at 26 bands between 300Hz and 8KHz, so the features are
+     *         not those of Kaldi or HTK.
+     *         Applies to generateMFCC* and generateFeatures*, not to the fixed-point and pipelined modes.
+     *
+     * @param compatible       : false - the original front end. The other parameters are ignored.
+     * @param window_type      : WINDOW_*
+     * @param remove_dc_offset : subtracts the mean of each frame
+     * @param dither           : standard deviation of the dither in sample units. 0 for none.
+     * @param preemph_coeff    : pre-emphasis coefficient
+     * @param use_energy       : C0 is replaced by the log energy of the frame
+     * @param raw_energy       : the energy is taken before pre-emphasis and window
+     * @param cepstral_lifter  : L of the lifter 1 + L/2 sin(pi i / L). 0 for none.
+     * @param orthonormal_dct  : C0 scaled by sqrt(1/N) instead of sqrt(2/N)
+     * @param mel_floor        : floor of the Mel energies before log
+     */
+    public native void setFrontEndParameters(
+        boolean compatible, int window_type, boolean remove_dc_offset, float dither, float preemph_coeff,
+        boolean use_energy, boolean raw_energy, float cepstral_lifter, boolean orthonormal_dct, float mel_floor );
+
+    /** @brief Kaldi-style framing and energy: the window, DC removal, dither, pre-emphasis,
+     *         energy and lifter defaults of compute-mfcc-feats, not its Mel filter banks.
+     */
+    public void setKaldiFrontEnd() {
+        setFrontEndParameters( true, WINDOW_POVEY, true, 1.0f, 0.97f, true, true, 22.0f, true, Math.ulp( 1.0f ) );
+    }
+
+    /** @brief switches to the FFT that skips the zero padding of the 400-sample frames and, for MFCC
+     *         and log Mel only, the points below the lowest Mel filter. Off by default.
+     *         The results agree with the full FFT up to rounding.
+     */
+    public native void setPrunedFFT( boolean pruned );
+
+    /** @brief switches on the spectral subtraction of the noise tracked across frames from the power
+     *         spectrum before the Mel filter banks. Off by default. Restarts the noise tracking.
+     *
+     * @param enabled          : true to subtract
+     * @param over_subtraction : multiple of the noise estimate subtracted, e.g., 2.0
+     * @param spectral_floor   : lower bound of the result relative to the power, e.g., 0.05
+     */
+    public native void setSpectralSubtraction( boolean enabled, float over_subtraction, float spectral_floor );
+
+    /** @brief same as generateMFCCAndPowerSpectrum but FFT, Mel and DCT are skipped for silent frames
+     *
+     * @param exec_type       : 0         - Use NEON/SSE intrinsics.
+     *                          Otherwise - NOEN/SSE not used
+     * @param samples_real400 : time domain 400 real samples
+     * @param is_active       : (out) is_active[0] is set to the activity flag of this frame
+     * @return real 27 MFCCs and 256-point real power spectrum, or null for an inactive frame
+     *         if emit_silence is false.
+     */
+    public native float[] generateMFCCAndPowerSpectrumWithVAD(
+        int exec_type, float[] samples_real400, boolean[] is_active );
+
+    /** @brief generates 27 MFCC in the integer pipeline
+     *
+     * @param exec_type         : 0         - Use NEON/SSE intrinsics.
+     *                            Otherwise - NOEN/SSE not used
+     * @param samples_int16_400 : time domain 400 PCM samples
+     * @return 27 MFCC in Q16, i.e., the float value multiplied by 65536.
+     */
+    public native int[] generateMFCCFixedPoint( int exec_type, short[] samples_int16_400 );
+
+    /** @brief same as generateMFCCAndPowerSpectrum but in IEEE 754 half precision
+     *
+     * @param exec_type       : 0         - Use NEON/SSE intrinsics.
+     *                          Otherwise - NOEN/SSE not used
+     * @param samples_real400 : time domain 400 real samples
+     * @return 27 MFCCs and 256-point power spectrum, each short holds the bits of a half float.
+     */
+    public native short[] generateMFCCAndPowerSpectrumFP16( int exec_type, float[] samples_real400 );
+
+    /** @brief sets the quantization of generateMFCCAndPowerSpectrumInt8.
+     *         q = round( v / scale ) + zero_point, saturated to [-128, 127].
+     *         The defaults are scale 1.0, zero point 0 for MFCC and
+     *         scale 1.5/255, zero point -128 for the power spectrum.
+     */
+    public native void setInt8Quantization(
+        float mfcc_scale, int mfcc_zero_point, float spectrum_scale, int spectrum_zero_point );
+
+    /** @brief same as generateMFCCAndPowerSpectrum but quantized to int8
+     *
+     * @param exec_type       : 0         - Use NEON/SSE intrinsics.
+     *                          Otherwise - NOEN/SSE not used
+     * @param samples_real400 : time domain 400 real samples
+     * @return 27 MFCCs and 256-point power spectrum in int8.
+     */
+    public native byte[] generateMFCCAndPowerSpectrumInt8( int exec_type, float[] samples_real400 );
+
+    /** @brief generates the requested outputs of all the frames in a clip at 10[ms] shift.
+     *         Results are cached by the content of the samples, so a clip seen before
+     *         is not processed again, except with the spectral subtraction or the dither of
+     *         the compatible front end on. Call it and setFeatureCache from one thread at a time.
+     *
+     * @param exec_type : 0         - Use NEON/SSE intrinsics.
+     *                    Otherwise - NOEN/SSE not used
+     * @param outputs   : bitwise OR of OUTPUT_*
+     * @param samples   : time domain real samples of the clip
+     * @return requested outputs of each frame concatenated frame after frame.
+     */
+    public native float[] generateFeaturesBatch( int exec_type, int outputs, float[] samples );
+
+    /** @brief generates the requested outputs of all the frames of a multichannel block,
+     *         e.g., of a microphone array, at 10[ms] shift.
+     *
+     * @param exec_type    : 0         - Use NEON/SSE intrinsics.
+     *                       Otherwise - NOEN/SSE not used
+     * @param outputs      : bitwise OR of OUTPUT_*
+     * @param num_channels : number of channels, 1 to 8
+     * @param samples      : interleaved 16-bit PCM at 16KHz, one sample of every channel per time step
+     * @return requested outputs of each frame concatenated frame after frame and channel after channel,
+     *         or null for an unsupported number of channels.
+     */
+    public native float[] generateFeaturesMultichannel( int exec_type, int outputs, int num_channels, short[] samples );
+
+    /** @brief configures the cache used by generateFeaturesBatch.
+     *
+     * @param memory_bytes   : bound of the in-memory tier in bytes (default 4MB). 0 disables it.
+     * @param disk_directory : existing directory for the on-disk tier, e.g., getCacheDir(),
+     *                         or null to disable it (default).
+     */
+    public native void setFeatureCache( long memory_bytes, String disk_directory );
+
+    /** @brief converts a chunk of captured PCM to 16KHz with a polyphase filter.
+     *         The filter state carries over from the previous chunk of the same rate.
+     *
+     * @param exec_type  : 0         - Use NEON/SSE intrinsics.
+     *                     Otherwise - NOEN/SSE not used
+     * @param input_rate : sample rate of the chunk, e.g., 48000, 44100 or 8000
+     * @param samples    : PCM chunk
+     * @return PCM chunk at 16KHz.
+     */
+    public native short[] resampleTo16KHz( int exec_type, int input_rate, short[] samples );
+
+    /** @brief renders values[offset] ... values[offset+count-1] into column x of an ARGB_8888 bitmap
+     *         from the bottom row upwards through a colormap lookup table.
+     *
+     * @param exec_type  : 0         - Use NEON/SSE intrinsics.
+     *                     Otherwise - NOEN/SSE not used
+     * @param bitmap     : ARGB_8888 bitmap
+     * @param x          : column
+     * @param values     : feature vector
+     * @param offset     : first value
+     * @param count      : number of values, clipped to the bitmap height
+     * @param scale      : values are mapped by v * scale + bias, and [0, 1] covers the colormap.
+     * @param bias       : see above
+     * @param color_type : 0 - heat map, 1 - lime green, as ScrollingHeatMapView.setColorType()
+     */
+    public native void renderColumn(
+        int exec_type, Bitmap bitmap, int x, float[] values, int offset, int count,
+        float scale, float bias, int color_type );
+
+    /** @brief starts the pipelined mode. The spectral stage (FFT, Mel) and the post stage
+     *         (DCT, mean normalization, deltas) run on their own native threads, connected to
+     *         pushPipelineSamples and pollPipelineFeatures by lock-free queues.
+     *
+     * @param exec_type    : 0         - Use NEON/SSE intrinsics.
+     *                       Otherwise - NOEN/SSE not used
+     * @param input_rate   : sample rate of the PCM given to pushPipelineSamples, e.g., 16000 or 48000.
+     *                       Other rates than 16KHz are resampled natively into the frames.
+     * @param queue_frames : frames per queue. Bounds the latency added by the pipeline.
+     * @param drop_policy  : PIPELINE_BLOCK, PIPELINE_DROP_NEWEST or PIPELINE_DROP_OLDEST
+     * @param post_flags   : bitwise OR of PIPELINE_MEAN_NORMALIZATION and PIPELINE_DELTAS
+     */
+    public native void startPipeline( int exec_type, int input_rate, int queue_frames, int drop_policy, int post_flags );
+
+    /** @brief stops the pipelined mode. Safe to call from any thread, also while
+     *         pushPipelineSamples or pollPipelineFeatures is running.
+     */
+    public native void stopPipeline();
+
+    /** @brief feeds PCM at the input_rate of startPipeline to the pipeline. Returns without waiting for the FFT
+     *         unless the drop policy is PIPELINE_BLOCK and the pipeline is behind.
+     *
+     * @param samples : PCM chunk of any size
+     * @return number of frames queued by this chunk
+     */
+    public native int pushPipelineSamples( short[] samples );
+
+    /** @brief takes the features of the oldest frame done by the pipeline.
+     *
+     * @return PIPELINE_NUM_OUTPUTS values, 27 MFCCs, 256-point log spectrum and 27 deltas
+     *         (0 without PIPELINE_DELTAS), or null if no frame is done.
+     */
+    public native float[] pollPipelineFeatures();
+
+    /** @brief statistics of the pipeline since startPipeline.
+     *
+     * @return frames captured, frames dropped, frames polled, mean and max latency in micro seconds.
+     */
+    public native long[] getPipelineStats();
+
+    /** @brief starts recording the captured chunks, with their sizes and arrival times, into a
+     *         capture trace for replaying on the host (host/trace_replay).
+     *
+     * @param path              : trace file to create
+     * @param sample_rate       : capture rate
+     * @param num_channels      : number of interleaved channels
+     * @param requested_samples : samples asked of each AudioRecord.read
+     * @param start_time_ns     : System.nanoTime() now
+     * @return true if the trace was created
+     */
+    public native boolean startCaptureTrace( String path, int sample_rate, int num_channels, int requested_samples, long start_time_ns );
+
+    /** @brief appends a chunk to the capture trace. Ignored if no trace is open.
+     *
+     * @param timestamp_ns : System.nanoTime() right after AudioRecord.read returned
+     * @param samples      : the samples read
+     * @param read_result  : value returned by AudioRecord.read
+     */
+    public native void appendCaptureTrace( long timestamp_ns, short[] samples, int read_result );
+
+    /** @brief closes the capture trace.
+     *
+     * @return number of chunks recorded
+     */
+    public native long stopCaptureTrace();
+
 };
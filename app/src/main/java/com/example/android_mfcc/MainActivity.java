@@ -3,14 +3,30 @@ package com.example.android_mfcc;
 import androidx.appcompat.app.AppCompatActivity;
 
 import android.os.Bundle;
+import android.util.Log;
 import android.widget.TextView;
 
+import java.io.File;
 import java.util.Random;
 import java.util.TimerTask;
 import java.util.Timer;
 
 public class MainActivity extends AppCompatActivity {
 
+    private static final String TAG = MainActivity.class.getSimpleName();
+
+    // true to run the native pipeline on its own threads instead of on the audio thread.
+    private static final boolean PIPELINED_MODE = false;
+
+    // Rate to record at. 48000, the native rate of most devices, bypasses the system resampler,
+    // and the chunks are then converted to 16KHz natively.
+    private static final int CAPTURE_RATE = 16000;
+
+    // true to record the chunks as AudioRecord returns them into CAPTURE_TRACE_FILE in the app's
+    // external files directory, for host/trace_replay. For debugging only.
+    private static final boolean CAPTURE_TRACE      = false;
+    private static final String  CAPTURE_TRACE_FILE = "capture.trace";
+
     @Override
     protected void onCreate(Bundle savedInstanceState) {
         super.onCreate(savedInstanceState);
@@ -22,8 +38,24 @@ public class MainActivity extends AppCompatActivity {
         mfccView.setColorType(1);
         fftView.setResolution  ( 200, 256 );
 
-        mMFCCProcessor = new TopLevelMFCCProcessor( mfccView, fftView );
-        mAudioReceiver = new AudioReceiver( mMFCCProcessor );
+        mMFCCProcessor = new TopLevelMFCCProcessor( mfccView, fftView, PIPELINED_MODE );
+        mAudioReceiver = new AudioReceiver( mMFCCProcessor, CAPTURE_RATE );
+
+        if ( CAPTURE_TRACE ) {
+            final File trace = new File( getExternalFilesDir( null ), CAPTURE_TRACE_FILE );
+            if ( !mAudioReceiver.startCaptureTrace( trace.getAbsolutePath() ) ) {
+                Log.e( TAG, "cannot create " + trace.getAbsolutePath() );
+            }
+        }
+    }
+
+    @Override
+    protected void onDestroy() {
+        if ( CAPTURE_TRACE ) {
+            Log.i( TAG, "capture trace: " + mAudioReceiver.stopCaptureTrace() + " chunks" );
+        }
+        mMFCCProcessor.release();
+        super.onDestroy();
     }
 
     TopLevelMFCCProcessor mMFCCProcessor;
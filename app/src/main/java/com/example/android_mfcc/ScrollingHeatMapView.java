@@ -36,7 +36,7 @@ public class ScrollingHeatMapView extends AppCompatImageView {
     }
 
     @Override
-    protected void onDraw(Canvas canvas) {
+    protected synchronized void onDraw(Canvas canvas) {
         canvas.save();
         super.onDraw(canvas);
 
@@ -113,7 +113,7 @@ public class ScrollingHeatMapView extends AppCompatImageView {
         canvas.restore();
     }
 
-    public void setResolution( int w, int h ) {
+    public synchronized void setResolution( int w, int h ) {
 
         mResW = w;
         mResH = h;
@@ -134,7 +134,36 @@ public class ScrollingHeatMapView extends AppCompatImageView {
 
     public void setColorType(int t) { mColorType = t; }
 
-    public void setNewColumn(float[] vec) {
+    /** @brief same as setNewColumn but the column is rendered natively through a colormap table
+     *         on the calling thread, so that it can be called from the audio thread without
+     *         copying the feature vector. The view is redrawn on the UI thread.
+     *
+     * @param renderer : native renderer
+     * @param vec      : feature vector
+     * @param offset   : first value in vec
+     * @param count    : number of values
+     * @param scale    : values are mapped by v * scale + bias into [0, 1]
+     * @param bias     : see above
+     */
+    public synchronized void renderNewColumn( MFCCCPP renderer, float[] vec, int offset, int count, float scale, float bias ) {
+
+        if ( mBitmapRender1 == null ) {
+            return;
+        }
+
+        renderer.renderColumn(
+            0, mRender1to2 ? mBitmapRender2 : mBitmapRender1, mRenderOffset, vec, offset, count, scale, bias, mColorType );
+
+        mRenderOffset++;
+        if (mRenderOffset == mResW) {
+            mRender1to2 = !mRender1to2;
+            mRenderOffset = 0;
+        }
+
+        postInvalidate();
+    }
+
+    public synchronized void setNewColumn(float[] vec) {
 
         if ( mRender1to2 ) {
 
@@ -1,30 +1,70 @@
 package com.example.android_mfcc;
 
-import android.os.Handler;
-import android.os.Looper;
 import android.util.Log;
 
 import java.time.Instant;
-import java.util.Arrays;
 
 public class TopLevelMFCCProcessor implements AudioReceiverListener {
 
     private static final String TAG = TopLevelMFCCProcessor.class.getSimpleName();
 
+    // Pipelined mode settings. See MFCCCPP.startPipeline().
+    private static final int PIPELINE_QUEUE_FRAMES = 32;   // 320[ms]
+    private static final int PIPELINE_DROP_POLICY  = MFCCCPP.PIPELINE_DROP_OLDEST;
+    private static final int PIPELINE_POST_FLAGS   = 0;
+
+    private static final int RECORDING_RATE = 16000;
+
     TopLevelMFCCProcessor ( ScrollingHeatMapView mfccView, ScrollingHeatMapView fftView ) {
+        this( mfccView, fftView, false );
+    }
+
+    /** @param pipelined : true  - the native pipeline runs FFT, Mel and DCT on its own threads,
+     *                             and the audio thread only feeds it and renders the results.
+     *                     false - all the implementations run on the audio thread for comparison.
+     */
+    TopLevelMFCCProcessor ( ScrollingHeatMapView mfccView, ScrollingHeatMapView fftView, boolean pipelined ) {
         mMfccView        = mfccView;
         mFftView         = fftView;
         mAudioAggregator = new AudioChunkAggregator();
         mMFCCJava        = new MFCCJava();
-        mMFCCCPP         = new MFCCCPP();
-        mUiHandler       = new Handler(Looper.getMainLooper());
+        mRenderer        = new MFCCCPP();
+        mMFCCCPP         = mRenderer;
+        mPipelined       = pipelined;
+        mCaptureRate     = RECORDING_RATE;
+    }
+
+    public void onCaptureStarted( int sampleRate ) {
+
+        mCaptureRate = sampleRate;
 
+        if ( mPipelined ) {
+            // The pipeline resamples to 16KHz on its own, straight into its frame buffer.
+            mRenderer.startPipeline( 0, mCaptureRate, PIPELINE_QUEUE_FRAMES, PIPELINE_DROP_POLICY, PIPELINE_POST_FLAGS );
+        }
+    }
+
+    /** @brief joins the pipeline threads. Chunks arriving afterwards are ignored.
+     */
+    public void release() {
+
+        if ( mPipelined ) {
+            mRenderer.stopPipeline();
+        }
     }
 
     public void onAudioArrivalMonauralPCM( short[] chunk ) {
 
+        if ( mPipelined ) {
+            onAudioArrivalPipelined( chunk );
+            return;
+        }
+
+        // The Java implementation for comparison takes 16KHz PCM.
+        if ( mCaptureRate != RECORDING_RATE ) {
+            chunk = mRenderer.resampleTo16KHz( 0, mCaptureRate, chunk );
+        }
         mAudioAggregator.putChunk( chunk );
-        Handler uiHandler = new Handler( Looper.getMainLooper() );
 
         while ( mAudioAggregator.totalNumSamples() >= 400 ) {
 
@@ -61,24 +101,31 @@ public class TopLevelMFCCProcessor implements AudioReceiverListener {
                 ) );
             }
 
-            for ( int i = 0; i < 27 ; i++ ) {
-                mfcc_fft_neon[i] =mfcc_fft_neon[i] / 5.0f + 0.5f;
-            }
+            // MFCC rescaled by v / 5 + 0.5 into the colormap, the spectrum as it is.
+            mMfccView.renderNewColumn( mRenderer, mfcc_fft_neon,  0,  27, 0.2f, 0.5f );
+            mFftView. renderNewColumn( mRenderer, mfcc_fft_neon, 27, 256, 1.0f, 0.0f );
+        }
+    }
+
+    private void onAudioArrivalPipelined( short[] chunk ) {
+
+        mRenderer.pushPipelineSamples( chunk );
+
+        float[] features;
+        while ( ( features = mRenderer.pollPipelineFeatures() ) != null ) {
 
-            final float[] mfccArray = Arrays.copyOfRange( mfcc_fft_neon,  0, 27       );
-            final float[] fftArray  = Arrays.copyOfRange( mfcc_fft_neon, 27, 27 + 256 );
-
-            uiHandler.post( new Runnable() {
-                @Override
-                public void run() {
-                try {
-                    mMfccView.setNewColumn( mfccArray );
-                    mFftView. setNewColumn( fftArray  );
-                    } catch ( Exception e ) {
-                        Log.e(TAG, "Exception: " + e);
-                    }
-                }
-            } );
+            mMfccView.renderNewColumn( mRenderer, features,  0,  27, 0.2f, 0.5f );
+            mFftView. renderNewColumn( mRenderer, features, 27, 256, 1.0f, 0.0f );
+
+            mAccumCount++;
+
+            if ( mAccumCount % 1000 == 0 ) {
+                long[] stats = mRenderer.getPipelineStats();
+                Log.i( TAG, String.format(
+                    "Pipeline frames in: %d dropped: %d out: %d  latency mean: %d[us] max: %d[us]",
+                    stats[0], stats[1], stats[2], stats[3], stats[4]
+                ) );
+            }
         }
     }
 
@@ -101,7 +148,9 @@ public class TopLevelMFCCProcessor implements AudioReceiverListener {
     AudioChunkAggregator mAudioAggregator;
     MFCCInterface        mMFCCJava;
     MFCCInterface        mMFCCCPP;
+    MFCCCPP              mRenderer;
     ScrollingHeatMapView mMfccView;
     ScrollingHeatMapView mFftView;
-    Handler              mUiHandler;
+    boolean              mPipelined;
+    int                  mCaptureRate;
 }
@@ -0,0 +1,335 @@
+//
+// Comparison of FFT512 with reference FFTs on the same 512-point transforms. FFTW is the only
+// third-party one. The radix-2 baseline is written here and stands for no particular library.
+//
+// Workloads
+//   complex : 512 complex samples of noise. All the 512 points are compared.
+//   real    : 400 real samples of noise zero-padded to 512 as in MFCC. Points 0 to 255 are compared.
+//
+// Engines
+//   fft512       : FFT512::transform_cpp() and _neon()
+//   pruned       : PrunedFFT512::transform_cpp() and _neon() from point 0, real workload only
+//   radix2       : textbook iterative radix-2 FFT in float with a twiddle table, defined below
+//   fftw         : FFTW3 single precision with FFTW_MEASURE plans, if CMake found it. Fed through
+//                  the split re/im arrays of the FFT512 interface, so the conversion is included.
+//   dft          : direct DFT in double. The reference of the agreement, timed over fewer runs.
+//
+// Reports the time per transform and the largest error of each engine relative to the peak
+// magnitude of the reference spectrum.
+//
+// Usage: fft_compare [-n <transforms>]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#ifdef HAVE_FFTW3
+#include <fftw3.h>
+#endif
+
+#include "mfcc.h"
+
+static constexpr int cNumPoints = 512;
+static constexpr int cNumInputs = 32;   // distinct inputs the timing loops cycle through
+
+/** @brief textbook iterative radix-2 decimation-in-time FFT on split arrays.
+ */
+class Radix2FFT {
+
+public:
+
+    Radix2FFT()
+        :mCos( cNumPoints / 2 )
+        ,mSin( cNumPoints / 2 )
+        ,mBitReverse( cNumPoints )
+    {
+        for ( int k = 0; k < cNumPoints / 2; k++ ) {
+            mCos[ k ] = cos( 2.0 * M_PI * k / cNumPoints );
+            mSin[ k ] = sin( 2.0 * M_PI * k / cNumPoints );
+        }
+        for ( int i = 0; i < cNumPoints; i++ ) {
+            int r = 0;
+            for ( int b = 1, j = i; b < cNumPoints; b <<= 1, j >>= 1 ) {
+                r = ( r << 1 ) | ( j & 1 );
+            }
+            mBitReverse[ i ] = r;
+        }
+    }
+
+    void transform( const float* samples_re, const float* samples_im, float* points_re, float* points_im ) const {
+
+        for ( int i = 0; i < cNumPoints; i++ ) {
+            points_re[ mBitReverse[ i ] ] = samples_re[ i ];
+            points_im[ mBitReverse[ i ] ] = samples_im[ i ];
+        }
+
+        for ( int size = 2; size <= cNumPoints; size *= 2 ) {
+
+            const int half = size / 2;
+            const int step = cNumPoints / size;
+
+            for ( int start = 0; start < cNumPoints; start += size ) {
+                for ( int j = 0; j < half; j++ ) {
+
+                    const float wr = mCos[ j * step ];
+                    const float wi = mSin[ j * step ];
+                    const int   a  = start + j;
+                    const int   b  = a + half;
+
+                    // ( br + i bi ) * ( wr - i wi )
+                    const float tr = points_re[ b ] * wr + points_im[ b ] * wi;
+                    const float ti = points_im[ b ] * wr - points_re[ b ] * wi;
+
+                    points_re[ b ] = points_re[ a ] - tr;
+                    points_im[ b ] = points_im[ a ] - ti;
+                    points_re[ a ] += tr;
+                    points_im[ a ] += ti;
+                }
+            }
+        }
+    }
+
+private:
+
+    std::vector< float > mCos;
+    std::vector< float > mSin;
+    std::vector< int >   mBitReverse;
+};
+
+/** @brief direct DFT in double precision.
+ */
+static void directDFT( const float* samples_re, const float* samples_im, double* points_re, double* points_im ) {
+
+    static std::vector< double > cosTable;
+    static std::vector< double > sinTable;
+
+    if ( cosTable.empty() ) {
+        for ( int i = 0; i < cNumPoints; i++ ) {
+            cosTable.push_back( cos( 2.0 * M_PI * i / cNumPoints ) );
+            sinTable.push_back( sin( 2.0 * M_PI * i / cNumPoints ) );
+        }
+    }
+
+    for ( int k = 0; k < cNumPoints; k++ ) {
+
+        double sumRe = 0.0;
+        double sumIm = 0.0;
+
+        for ( int n = 0; n < cNumPoints; n++ ) {
+
+            const int i = ( k * n ) & ( cNumPoints - 1 );
+            sumRe += samples_re[ n ] * cosTable[ i ] + samples_im[ n ] * sinTable[ i ];
+            sumIm += samples_im[ n ] * cosTable[ i ] - samples_re[ n ] * sinTable[ i ];
+        }
+        points_re[ k ] = sumRe;
+        points_im[ k ] = sumIm;
+    }
+}
+
+/** @brief inputs of a workload and their reference spectra.
+ */
+struct Workload {
+
+    const char*           name;
+    int                   numCompared;  // points compared from point 0
+    std::vector< float >  re;           // [ cNumInputs ][ cNumPoints ]
+    std::vector< float >  im;
+    std::vector< double > refRe;
+    std::vector< double > refIm;
+};
+
+static void makeWorkload( Workload& w, const char* name, const bool real ) {
+
+    w.name        = name;
+    w.numCompared = real ? cNumPoints / 2 : cNumPoints;
+    w.re.assign   ( (size_t)cNumInputs * cNumPoints, 0.0 );
+    w.im.assign   ( (size_t)cNumInputs * cNumPoints, 0.0 );
+    w.refRe.resize( (size_t)cNumInputs * cNumPoints );
+    w.refIm.resize( (size_t)cNumInputs * cNumPoints );
+
+    uint32_t seed = real ? 54321u : 12345u;
+
+    for ( int n = 0; n < cNumInputs; n++ ) {
+
+        const size_t o = (size_t)n * cNumPoints;
+
+        for ( int i = 0; i < ( real ? MFCC::cFrameSizeSamples : cNumPoints ); i++ ) {
+
+            seed = seed * 1664525u + 1013904223u;
+            w.re[ o + i ] = (float)( (int32_t)( seed >> 16 ) - 32768 ) / 4.0f;
+            if ( !real ) {
+                seed = seed * 1664525u + 1013904223u;
+                w.im[ o + i ] = (float)( (int32_t)( seed >> 16 ) - 32768 ) / 4.0f;
+            }
+        }
+        directDFT( &w.re[ o ], &w.im[ o ], &w.refRe[ o ], &w.refIm[ o ] );
+    }
+}
+
+/** @brief checks the engine against the reference on all the inputs, times it over
+ *         numTransforms transforms, and prints both.
+ *
+ *  @param engine : engine( samples_re, samples_im, points_re, points_im ) for one transform
+ */
+template< class Engine >
+static void compare( const char* name, Workload& w, const int numTransforms, Engine engine ) {
+
+    std::vector< float > outRe( cNumPoints );
+    std::vector< float > outIm( cNumPoints );
+
+    double maxError = 0.0;
+
+    for ( int n = 0; n < cNumInputs; n++ ) {
+
+        const size_t o = (size_t)n * cNumPoints;
+        engine( &w.re[ o ], &w.im[ o ], outRe.data(), outIm.data() );
+
+        double peak  = 0.0;
+        double error = 0.0;
+        for ( int k = 0; k < w.numCompared; k++ ) {
+
+            const double dr = outRe[ k ] - w.refRe[ o + k ];
+            const double di = outIm[ k ] - w.refIm[ o + k ];
+            peak  = std::max( peak,  sqrt( w.refRe[ o + k ] * w.refRe[ o + k ] + w.refIm[ o + k ] * w.refIm[ o + k ] ) );
+            error = std::max( error, sqrt( dr * dr + di * di ) );
+        }
+        maxError = std::max( maxError, ( peak > 0.0 ) ? error / peak : error );
+    }
+
+    // Keeps the transforms from being optimized away.
+    volatile float sink = 0.0;
+
+    const double t0 = getTimeStampInSeconds();
+    for ( int i = 0; i < numTransforms; i++ ) {
+
+        const size_t o = (size_t)( i % cNumInputs ) * cNumPoints;
+        engine( &w.re[ o ], &w.im[ o ], outRe.data(), outIm.data() );
+        sink = sink + outRe[ i & ( w.numCompared - 1 ) ];
+    }
+    const double elapsed = getTimeStampInSeconds() - t0;
+
+    printf( "  %-12s : %10.1f[ns] per transform, max error %.2e of the peak\n", name,
+            1.0e9 * elapsed / numTransforms, maxError );
+}
+
+int main( int argc, char* argv[] ) {
+
+    int numTransforms = 20000;
+
+    for ( int argi = 1; argi < argc; argi++ ) {
+
+        if ( strcmp( argv[ argi ], "-n" ) == 0 && argi + 1 < argc ) {
+            numTransforms = atoi( argv[ ++argi ] );
+        }
+        else {
+            fprintf( stderr, "Usage: %s [-n <transforms>]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+    if ( numTransforms <= 0 ) {
+        fprintf( stderr, "Usage: %s [-n <transforms>]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    // The direct DFT is about 100 times slower than the FFTs.
+    const int numDFTs = std::max( numTransforms / 100, 10 );
+
+    AlignedArena arena( FFT512::arenaBytes() + PrunedFFT512::arenaBytes() );
+    FFT512       fft( arena );
+    PrunedFFT512 pruned( arena, MFCC::cFrameSizeSamples );
+    Radix2FFT    radix2;
+
+    Workload workloads[ 2 ];
+    makeWorkload( workloads[ 0 ], "complex", false );
+    makeWorkload( workloads[ 1 ], "real",    true  );
+
+    for ( int wi = 0; wi < 2; wi++ ) {
+
+        Workload&  w    = workloads[ wi ];
+        const bool real = ( w.numCompared < cNumPoints );
+
+        printf( "%s, %d points, %d transforms\n", w.name, cNumPoints, numTransforms );
+
+        compare( "fft512 cpp", w, numTransforms, [ & ]( float* re, float* im, float* outRe, float* outIm ) {
+            fft.transform_cpp( re, im, outRe, outIm );
+        } );
+#ifdef HAVE_NEON
+        compare( "fft512 neon", w, numTransforms, [ & ]( float* re, float* im, float* outRe, float* outIm ) {
+            fft.transform_neon( re, im, outRe, outIm );
+        } );
+#endif
+        if ( real ) {
+            compare( "pruned cpp", w, numTransforms, [ & ]( float* re, float*, float* outRe, float* outIm ) {
+                pruned.transform_cpp( re, 0, outRe, outIm );
+            } );
+#ifdef HAVE_NEON
+            compare( "pruned neon", w, numTransforms, [ & ]( float* re, float*, float* outRe, float* outIm ) {
+                pruned.transform_neon( re, 0, outRe, outIm );
+            } );
+#endif
+        }
+
+        compare( "radix2", w, numTransforms, [ & ]( float* re, float* im, float* outRe, float* outIm ) {
+            radix2.transform( re, im, outRe, outIm );
+        } );
+
+#ifdef HAVE_FFTW3
+        if ( real ) {
+            float*         in   = fftwf_alloc_real   ( cNumPoints );
+            fftwf_complex* out  = fftwf_alloc_complex( cNumPoints / 2 + 1 );
+            fftwf_plan     plan = fftwf_plan_dft_r2c_1d( cNumPoints, in, out, FFTW_MEASURE );
+
+            compare( "fftw r2c", w, numTransforms, [ & ]( float* re, float*, float* outRe, float* outIm ) {
+                memcpy( in, re, sizeof(float) * cNumPoints );
+                fftwf_execute( plan );
+                for ( int k = 0; k < cNumPoints / 2; k++ ) {
+                    outRe[ k ] = out[ k ][ 0 ];
+                    outIm[ k ] = out[ k ][ 1 ];
+                }
+            } );
+            fftwf_destroy_plan( plan );
+            fftwf_free( out );
+            fftwf_free( in );
+        }
+        {
+            fftwf_complex* in   = fftwf_alloc_complex( cNumPoints );
+            fftwf_complex* out  = fftwf_alloc_complex( cNumPoints );
+            fftwf_plan     plan = fftwf_plan_dft_1d( cNumPoints, in, out, FFTW_FORWARD, FFTW_MEASURE );
+
+            compare( "fftw c2c", w, numTransforms, [ & ]( float* re, float* im, float* outRe, float* outIm ) {
+                for ( int i = 0; i < cNumPoints; i++ ) {
+                    in[ i ][ 0 ] = re[ i ];
+                    in[ i ][ 1 ] = im[ i ];
+                }
+                fftwf_execute( plan );
+                for ( int k = 0; k < cNumPoints; k++ ) {
+                    outRe[ k ] = out[ k ][ 0 ];
+                    outIm[ k ] = out[ k ][ 1 ];
+                }
+            } );
+            fftwf_destroy_plan( plan );
+            fftwf_free( out );
+            fftwf_free( in );
+        }
+#endif
+
+        std::vector< double > dftRe( cNumPoints );
+        std::vector< double > dftIm( cNumPoints );
+
+        compare( "dft double", w, numDFTs, [ & ]( float* re, float* im, float* outRe, float* outIm ) {
+            directDFT( re, im, dftRe.data(), dftIm.data() );
+            for ( int k = 0; k < cNumPoints; k++ ) {
+                outRe[ k ] = dftRe[ k ];
+                outIm[ k ] = dftIm[ k ];
+            }
+        } );
+    }
+
+#ifndef HAVE_FFTW3
+    printf( "fftw not found at build time\n" );
+#endif
+    return 0;
+}
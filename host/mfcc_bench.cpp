@@ -0,0 +1,716 @@
+//
+// Throughput benchmark of the native pipeline on synthetic audio.
+//
+// Runs N streams of the same length
+//   1. one after another on one MFCC instance (generateFeaturesBatch_*()), and
+//   2. concurrently through MultiStreamScheduler, fed in 10[ms] blocks round robin,
+// and reports the frames per second of both, the mean number of frames per 4-lane batch,
+// and the largest difference of the scheduler output from the serial one.
+// Then
+//   3. extracts N inputs of different lengths in chunks on WorkStealingPool with 1 to the
+//      given number of workers, and reports the scaling and the per-worker stats, and
+//   4. runs the first stream through StreamingPipeline as fast as it goes, with a consumer
+//      thread, and reports the throughput, the drops and the latency, and
+//   5. times FFT512 against PrunedFFT512 on the frames of the first stream, and reruns 1. with
+//      MFCC::setPrunedFFT(), and reports the savings and the largest difference from 1.
+//   6. runs MFCCFixedPoint and the float MFCC::generateMFCC_cpp() on pure tones, tones with
+//      noise, clipped tones and the frames of the first stream, and reports the largest and the
+//      mean difference of the 27 MFCCs, and the frames where the C++ and NEON versions differ.
+// With -P,
+//   7. runs each stage of MFCC in a loop of its own over the frames of the first stream, for
+//      each backend, with the hardware counters around the loop, and reports the IPC and the
+//      cycles, instructions, L1D misses and branch misses per frame.
+//
+// Usage: mfcc_bench [options]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <thread>
+#include <vector>
+
+#include "mfcc.h"
+#include "multi_stream_scheduler.h"
+#include "work_stealing_pool.h"
+#include "streaming_pipeline.h"
+#include "perf_counters.h"
+
+static void usage( const char* prog ) {
+
+    fprintf( stderr,
+        "Usage: %s [options]\n"
+        "  -n <streams>   : number of streams (default: 8)\n"
+        "  -w <workers>   : number of scheduler workers (default: number of cores)\n"
+        "  -t <seconds>   : length of each stream (default: 30)\n"
+        "  -Q <frames>    : frame queue bound per stream (default: 32)\n"
+        "  -W <us>        : longest wait for a full batch in micro seconds (default: 2000)\n"
+        "  -c <frames>    : frames per task of the work-stealing pool (default: 256)\n"
+        "  -p             : pin the pool workers to cpus 0, 1, ...\n"
+        "  -d <policy>    : drop policy of the pipeline, 0 block, 1 drop newest, 2 drop oldest (default: 0)\n"
+        "  -P             : read hardware counters per stage (Linux perf_event_open)\n"
+        "  -i cpp|neon    : implementation (default: neon if available)\n",
+        prog );
+}
+
+/** @brief a sweep plus noise, different for each stream.
+ */
+static void makeStream( const int index, const int numSamples, std::vector< int16_t >& samples ) {
+
+    samples.resize( numSamples );
+
+    uint32_t     seed  = 12345u + 7919u * (uint32_t)index;
+    const double f0    = 200.0  + 50.0 * index;
+    const double f1    = 4000.0 + 10.0 * index;
+    double       phase = 0.0;
+
+    for ( int i = 0; i < numSamples; i++ ) {
+
+        seed = seed * 1664525u + 1013904223u;
+        const double noise = (double)( (int32_t)( seed >> 16 ) - 32768 ) / 32768.0;
+        const double f     = f0 + ( f1 - f0 ) * (double)i / (double)numSamples;
+
+        phase += 2.0 * M_PI * f / MFCC::cSampleRate;
+        samples[ i ] = (int16_t)( 8000.0 * sin( phase ) + 1000.0 * noise );
+    }
+}
+
+/** @brief runs stage( f ) on all the frames with the counters around the loop, and prints the
+ *         counts per frame.
+ */
+template< class Stage >
+static void countStage(
+    PerfCounters& counters,
+    const char*   backend,
+    const char*   name,
+    const int     numFrames,
+    Stage         stage
+) {
+    static const char* labels[ PerfCounters::cNumCounters ] = { "cycles", "instructions", "L1D misses", "branch misses" };
+
+    PerfCounters::Counts counts;
+
+    counters.start();
+    for ( int f = 0; f < numFrames; f++ ) {
+        stage( f );
+    }
+    counters.stop( counts );
+
+    printf( "  %-4s %-8s : IPC %5.2f", backend, name, counts.ipc() );
+    for ( int i = 0; i < PerfCounters::cNumCounters; i++ ) {
+        if ( counts.counted[ i ] ) {
+            printf( ", %9.1f %s", counts.value[ i ] / numFrames, labels[ i ] );
+        }
+        else {
+            printf( ", %9s %s", "-", labels[ i ] );
+        }
+    }
+    printf( " per frame\n" );
+}
+
+/** @brief differences of MFCCFixedPoint from the float MFCC over a set of frames.
+ */
+struct FixedPointStats {
+
+    double maxDiff;
+    int    maxCoeff;
+    double sumDiff;
+    long   numValues;
+    long   numNeonMismatches;
+
+    FixedPointStats() : maxDiff( 0.0 ), maxCoeff( 0 ), sumDiff( 0.0 ), numValues( 0 ), numNeonMismatches( 0 ) {;}
+
+    void add( MFCC& mfcc, MFCCFixedPoint& fixed, const int16_t* frame ) {
+
+        float   samples[ MFCC::cFrameSizeSamples ];
+        float   reference[ MFCC::cNumFilterBanks + 1 ];
+        int32_t cepstra[ MFCC::cNumFilterBanks + 1 ];
+
+        for ( int i = 0; i < MFCC::cFrameSizeSamples; i++ ) {
+            samples[ i ] = (float)frame[ i ];
+        }
+        mfcc.generateMFCC_cpp( samples, reference );
+        fixed.generateMFCC_cpp( frame, cepstra );
+
+        for ( int i = 0; i < MFCC::cNumFilterBanks + 1; i++ ) {
+
+            const double diff = fabs( (double)reference[ i ] - (double)cepstra[ i ] / ( 1 << MFCCFixedPoint::cMFCCFracBits ) );
+            if ( diff > maxDiff ) {
+                maxDiff  = diff;
+                maxCoeff = i;
+            }
+            sumDiff += diff;
+            numValues++;
+        }
+#ifdef HAVE_NEON
+        int32_t cepstraNeon[ MFCC::cNumFilterBanks + 1 ];
+        fixed.generateMFCC_neon( frame, cepstraNeon );
+        if ( memcmp( cepstra, cepstraNeon, sizeof(cepstra) ) != 0 ) {
+            numNeonMismatches++;
+        }
+#endif
+    }
+
+    void print( const char* name ) const {
+
+        printf( "fixed point     : %-12s max difference %7.3f (c%d), mean %6.3f", name, maxDiff, maxCoeff,
+                numValues > 0 ? sumDiff / numValues : 0.0 );
+#ifdef HAVE_NEON
+        printf( ", %ld neon mismatches", numNeonMismatches );
+#endif
+        printf( "\n" );
+    }
+};
+
+/** @brief a tone of 400 samples with uniform noise at noiseRatio of the amplitude, clipped to int16.
+ */
+static void makeTone( const double freq, const double amplitude, const double noiseRatio, uint32_t& seed, int16_t* frame ) {
+
+    for ( int i = 0; i < MFCC::cFrameSizeSamples; i++ ) {
+
+        seed = seed * 1664525u + 1013904223u;
+        const double noise = (double)( (int32_t)( seed >> 16 ) - 32768 ) / 32768.0;
+        const double v     = amplitude * ( sin( 2.0 * M_PI * freq * i / MFCC::cSampleRate ) + noiseRatio * noise );
+
+        frame[ i ] = (int16_t)lrint( std::max( -32768.0, std::min( 32767.0, v ) ) );
+    }
+}
+
+int main( int argc, char* argv[] ) {
+
+    int          numStreams  = 8;
+    int          numWorkers  = std::max( 1u, std::thread::hardware_concurrency() );
+    double       seconds     = 30.0;
+    int          queueFrames = 32;
+    int          batchWaitUs = 2000;
+    int          chunkFrames = 256;
+    bool         pin         = false;
+    bool         useCounters = false;
+    int          dropPolicy  = StreamingPipeline::cDropPolicyBlock;
+    unsigned int outputs     = MFCC::cOutputMFCC;
+#ifdef HAVE_NEON
+    bool         useNeon     = true;
+#else
+    bool         useNeon     = false;
+#endif
+
+    for ( int argi = 1; argi < argc; argi++ ) {
+
+        const char* opt = argv[ argi ];
+
+        if ( strcmp( opt, "-n" ) == 0 && argi + 1 < argc ) {
+            numStreams = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-w" ) == 0 && argi + 1 < argc ) {
+            numWorkers = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-t" ) == 0 && argi + 1 < argc ) {
+            seconds = atof( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-Q" ) == 0 && argi + 1 < argc ) {
+            queueFrames = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-W" ) == 0 && argi + 1 < argc ) {
+            batchWaitUs = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-c" ) == 0 && argi + 1 < argc ) {
+            chunkFrames = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-d" ) == 0 && argi + 1 < argc ) {
+            dropPolicy = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-p" ) == 0 ) {
+            pin = true;
+        }
+        else if ( strcmp( opt, "-P" ) == 0 ) {
+            useCounters = true;
+        }
+        else if ( strcmp( opt, "-i" ) == 0 && argi + 1 < argc ) {
+            const char* impl = argv[ ++argi ];
+            if ( strcmp( impl, "cpp" ) == 0 ) {
+                useNeon = false;
+            }
+            else if ( strcmp( impl, "neon" ) == 0 ) {
+#ifdef HAVE_NEON
+                useNeon = true;
+#else
+                fprintf( stderr, "NEON is not available in this build\n" );
+                return 1;
+#endif
+            }
+            else {
+                usage( argv[ 0 ] );
+                return 1;
+            }
+        }
+        else {
+            usage( argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    if ( numStreams <= 0 || numWorkers <= 0 || seconds <= 0.0 || chunkFrames <= 0 ) {
+        usage( argv[ 0 ] );
+        return 1;
+    }
+
+    const int numSamples  = (int)( seconds * MFCC::cSampleRate );
+    const int framesEach  = MFCC::numFrames( numSamples );
+    const int numFeatures = MFCC::numFeatures( outputs );
+
+    std::vector< std::vector< int16_t > > streams( numStreams );
+    for ( int s = 0; s < numStreams; s++ ) {
+        makeStream( s, numSamples, streams[ s ] );
+    }
+
+    printf( "streams %d x %.1f[s], %d frames each, %s\n", numStreams, seconds, framesEach, useNeon ? "neon" : "cpp" );
+
+    int status = 0;
+
+    // 1. Serial
+    std::vector< std::vector< float > > reference( numStreams );
+    double                              serialFramesPerSecond = 0.0;
+    {
+        MFCC                 mfcc;
+        std::vector< float > samples( numSamples );
+
+        double elapsed = 0.0;
+
+        for ( int s = 0; s < numStreams; s++ ) {
+
+            for ( int i = 0; i < numSamples; i++ ) {
+                samples[ i ] = (float)streams[ s ][ i ];
+            }
+            reference[ s ].resize( (size_t)framesEach * numFeatures );
+
+            const double t0 = getTimeStampInSeconds();
+#ifdef HAVE_NEON
+            if ( useNeon ) {
+                mfcc.generateFeaturesBatch_neon( samples.data(), numSamples, outputs, reference[ s ].data() );
+            }
+            else {
+                mfcc.generateFeaturesBatch_cpp( samples.data(), numSamples, outputs, reference[ s ].data() );
+            }
+#else
+            mfcc.generateFeaturesBatch_cpp( samples.data(), numSamples, outputs, reference[ s ].data() );
+#endif
+            elapsed += getTimeStampInSeconds() - t0;
+        }
+        serialFramesPerSecond = (double)numStreams * framesEach / elapsed;
+        printf( "serial          : %10.0f frames/s\n", serialFramesPerSecond );
+    }
+
+    // 2. Scheduler
+    {
+        std::vector< std::vector< float > > results( numStreams );
+        std::vector< uint64_t >             expected( numStreams, 0 );
+        std::vector< int >                  outOfOrder( numStreams, 0 );
+
+        MultiStreamScheduler scheduler( numWorkers, outputs, queueFrames, batchWaitUs, useNeon );
+
+        std::vector< int > ids( numStreams );
+        for ( int s = 0; s < numStreams; s++ ) {
+
+            results[ s ].resize( (size_t)framesEach * numFeatures );
+
+            // Each stream is delivered by one worker at a time, so the per-stream state needs no lock.
+            ids[ s ] = scheduler.addStream( [ &, s ]( const int, const uint64_t frameIndex, const float* features ) {
+
+                if ( frameIndex != expected[ s ] ) {
+                    outOfOrder[ s ]++;
+                }
+                expected[ s ] = frameIndex + 1;
+                memcpy( &results[ s ][ (size_t)frameIndex * numFeatures ], features, sizeof(float) * numFeatures );
+            } );
+        }
+
+        // A copy, as std::min() binds references and the in-class constant has no definition.
+        const int shift = MFCC::cFrameShiftSamples;
+        const double t0 = getTimeStampInSeconds();
+
+        for ( int pos = 0; pos < numSamples; pos += shift ) {
+
+            const int n = std::min( shift, numSamples - pos );
+            for ( int s = 0; s < numStreams; s++ ) {
+                scheduler.pushSamplesBlocking( ids[ s ], &streams[ s ][ pos ], n );
+            }
+        }
+        scheduler.drain();
+
+        const double elapsed = getTimeStampInSeconds() - t0;
+
+        float maxDiff       = 0.0;
+        int   numOutOfOrder = 0;
+        for ( int s = 0; s < numStreams; s++ ) {
+            for ( size_t i = 0; i < results[ s ].size(); i++ ) {
+                maxDiff = std::max( maxDiff, fabsf( results[ s ][ i ] - reference[ s ][ i ] ) );
+            }
+            numOutOfOrder += outOfOrder[ s ] + ( expected[ s ] != (uint64_t)framesEach ? 1 : 0 );
+        }
+
+        printf( "scheduler (%2d) : %10.0f frames/s, %.2f frames per batch\n", numWorkers,
+                (double)numStreams * framesEach / elapsed,
+                (double)scheduler.numBatchedFrames() / (double)std::max( scheduler.numBatches(), (uint64_t)1 ) );
+        printf( "max difference  : %g, %d streams out of order or incomplete\n", maxDiff, numOutOfOrder );
+
+        status |= ( numOutOfOrder == 0 ) ? 0 : 1;
+    }
+
+    // 3. Work-stealing pool over inputs from 1/4 to 2 times as long as the streams above.
+    {
+        std::vector< std::vector< float > > inputs  ( numStreams );
+        std::vector< std::vector< float > > expected( numStreams );
+        std::vector< std::vector< float > > results ( numStreams );
+        uint64_t                            totalFrames = 0;
+
+        MFCC mfcc;
+
+        for ( int s = 0; s < numStreams; s++ ) {
+
+            const double ratio = 0.25 + 1.75 * (double)( ( s * 5 ) % numStreams ) / (double)numStreams;
+            const int    n     = (int)( ratio * numSamples );
+
+            std::vector< int16_t > pcm;
+            makeStream( numStreams + s, n, pcm );
+            inputs[ s ].assign( pcm.begin(), pcm.end() );
+
+            expected[ s ].resize( (size_t)MFCC::numFrames( n ) * numFeatures );
+            results [ s ].resize( expected[ s ].size() );
+            mfcc.generateFeaturesBatch_cpp( inputs[ s ].data(), n, outputs, expected[ s ].data() );
+            totalFrames += MFCC::numFrames( n );
+        }
+
+        printf( "pool            : %d inputs, %llu frames, %d frames per task%s\n", numStreams,
+                (unsigned long long)totalFrames, chunkFrames, pin ? ", pinned" : "" );
+
+        double baseline = 0.0;
+
+        for ( int workers = 1; workers <= numWorkers; workers++ ) {
+
+            std::vector< int > cpus;
+            for ( int i = 0; pin && i < workers; i++ ) {
+                cpus.push_back( i );
+            }
+
+            WorkStealingPool pool( workers, cpus );
+
+            const double t0 = getTimeStampInSeconds();
+            for ( int s = 0; s < numStreams; s++ ) {
+                pool.submitExtraction( inputs[ s ].data(), (int)inputs[ s ].size(), outputs,
+                                       results[ s ].data(), chunkFrames, useNeon );
+            }
+            pool.wait();
+            const double fps = (double)totalFrames / ( getTimeStampInSeconds() - t0 );
+
+            if ( workers == 1 ) {
+                baseline = fps;
+            }
+
+            float maxDiff = 0.0;
+            for ( int s = 0; s < numStreams; s++ ) {
+                for ( size_t i = 0; i < results[ s ].size(); i++ ) {
+                    maxDiff = std::max( maxDiff, fabsf( results[ s ][ i ] - expected[ s ][ i ] ) );
+                }
+            }
+
+            printf( "pool (%2d)       : %10.0f frames/s, x%.2f, max difference %g\n", workers, fps, fps / baseline, maxDiff );
+
+            for ( int w = 0; w < workers; w++ ) {
+
+                const WorkStealingPool::WorkerStats st = pool.stats( w );
+                printf( "  worker %2d     : %5llu tasks, %5llu stolen, %8llu frames, %10.0f frames/s busy\n", w,
+                        (unsigned long long)st.numTasks, (unsigned long long)st.numSteals,
+                        (unsigned long long)st.numFrames, st.framesPerSecond() );
+            }
+        }
+    }
+
+    // 4. Pipeline
+    {
+        StreamingPipeline pipeline( queueFrames, dropPolicy, 0, useNeon );
+
+        float maxDiff = 0.0;
+
+        std::thread consumer( [ & ] {
+
+            float    features[ StreamingPipeline::cNumOutputs ];
+            uint64_t index;
+
+            while ( pipeline.numFramesOut() + pipeline.numDropped() < (uint64_t)framesEach ) {
+
+                if ( !pipeline.popFeatures( features, &index ) ) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for ( int i = 0; i < StreamingPipeline::cNumMFCC; i++ ) {
+                    maxDiff = std::max( maxDiff, fabsf( features[ i ] - reference[ 0 ][ index * numFeatures + i ] ) );
+                }
+            }
+        } );
+
+        const int    shift = MFCC::cFrameShiftSamples;
+        const double t0    = getTimeStampInSeconds();
+        for ( int pos = 0; pos < numSamples; pos += shift ) {
+            pipeline.pushSamples( &streams[ 0 ][ pos ], std::min( shift, numSamples - pos ) );
+        }
+        consumer.join();
+        const double elapsed = getTimeStampInSeconds() - t0;
+
+        printf( "pipeline        : %10.0f frames/s, %llu dropped, latency mean %.0f[us] max %.0f[us], max difference %g\n",
+                (double)framesEach / elapsed, (unsigned long long)pipeline.numDropped(),
+                pipeline.meanLatencyNs() / 1000.0, pipeline.maxLatencyNs() / 1000.0, maxDiff );
+    }
+
+    // 5. Pruned FFT
+    {
+        AlignedArena   arena( FFT512::arenaBytes() + PrunedFFT512::arenaBytes() + MelFilterBanks::arenaBytes() );
+        FFT512         fft( arena );
+        PrunedFFT512   pruned( arena, MFCC::cFrameSizeSamples );
+        MelFilterBanks melFilterBanks( arena );
+
+        const int firstPoint = melFilterBanks.firstPoint();
+
+        std::vector< float > frame( MFCC::cNumPointsFFT, 0.0 );
+        std::vector< float > zero ( MFCC::cNumPointsFFT, 0.0 );
+        std::vector< float > re   ( MFCC::cNumPointsFFT );
+        std::vector< float > im   ( MFCC::cNumPointsFFT );
+
+        double fullSeconds   = 0.0;
+        double prunedSeconds = 0.0;
+
+        for ( int f = 0; f < framesEach; f++ ) {
+
+            for ( int i = 0; i < MFCC::cFrameSizeSamples; i++ ) {
+                frame[ i ] = (float)streams[ 0 ][ f * MFCC::cFrameShiftSamples + i ];
+            }
+
+            const double t0 = getTimeStampInSeconds();
+#ifdef HAVE_NEON
+            if ( useNeon ) {
+                fft.transform_neon( frame.data(), zero.data(), re.data(), im.data() );
+            }
+            else {
+                fft.transform_cpp( frame.data(), zero.data(), re.data(), im.data() );
+            }
+#else
+            fft.transform_cpp( frame.data(), zero.data(), re.data(), im.data() );
+#endif
+            const double t1 = getTimeStampInSeconds();
+#ifdef HAVE_NEON
+            if ( useNeon ) {
+                pruned.transform_neon( frame.data(), firstPoint, re.data(), im.data() );
+            }
+            else {
+                pruned.transform_cpp( frame.data(), firstPoint, re.data(), im.data() );
+            }
+#else
+            pruned.transform_cpp( frame.data(), firstPoint, re.data(), im.data() );
+#endif
+            const double t2 = getTimeStampInSeconds();
+
+            fullSeconds   += t1 - t0;
+            prunedSeconds += t2 - t1;
+        }
+
+        printf( "fft             : %8.2f[us] full, %8.2f[us] pruned from point %d, %.1f%% saved\n",
+                1.0e6 * fullSeconds / framesEach, 1.0e6 * prunedSeconds / framesEach, firstPoint,
+                100.0 * ( 1.0 - prunedSeconds / fullSeconds ) );
+
+        MFCC mfcc;
+        mfcc.setPrunedFFT( true );
+
+        std::vector< float > samples ( numSamples );
+        std::vector< float > features( (size_t)framesEach * numFeatures );
+
+        double elapsed = 0.0;
+        float  maxDiff = 0.0;
+
+        for ( int s = 0; s < numStreams; s++ ) {
+
+            for ( int i = 0; i < numSamples; i++ ) {
+                samples[ i ] = (float)streams[ s ][ i ];
+            }
+
+            const double t0 = getTimeStampInSeconds();
+#ifdef HAVE_NEON
+            if ( useNeon ) {
+                mfcc.generateFeaturesBatch_neon( samples.data(), numSamples, outputs, features.data() );
+            }
+            else {
+                mfcc.generateFeaturesBatch_cpp( samples.data(), numSamples, outputs, features.data() );
+            }
+#else
+            mfcc.generateFeaturesBatch_cpp( samples.data(), numSamples, outputs, features.data() );
+#endif
+            elapsed += getTimeStampInSeconds() - t0;
+
+            for ( size_t i = 0; i < features.size(); i++ ) {
+                maxDiff = std::max( maxDiff, fabsf( features[ i ] - reference[ s ][ i ] ) );
+            }
+        }
+
+        const double fps = (double)numStreams * framesEach / elapsed;
+        printf( "serial pruned   : %10.0f frames/s, x%.2f, max difference %g\n",
+                fps, fps / serialFramesPerSecond, maxDiff );
+    }
+
+    // 6. Fixed point against float
+    {
+        static const double amplitudes[] = { 100.0, 300.0, 1000.0, 3000.0, 10000.0, 30000.0 };
+
+        MFCC           mfcc;
+        MFCCFixedPoint fixed;
+        int16_t        frame[ MFCC::cFrameSizeSamples ];
+        uint32_t       seed = 1;
+
+        FixedPointStats tones, noisy, clipped, stream;
+
+        for ( const double amplitude : amplitudes ) {
+            for ( double freq = 100.0; freq < MFCC::cSampleRate / 2; freq += 50.0 ) {
+
+                makeTone( freq, amplitude, 0.0, seed, frame );
+                tones.add( mfcc, fixed, frame );
+
+                makeTone( freq, amplitude, 0.05, seed, frame );
+                noisy.add( mfcc, fixed, frame );
+            }
+        }
+        for ( double freq = 100.0; freq < MFCC::cSampleRate / 2; freq += 50.0 ) {
+
+            makeTone( freq, 60000.0, 0.0, seed, frame );
+            clipped.add( mfcc, fixed, frame );
+        }
+        for ( int f = 0; f < framesEach; f++ ) {
+            stream.add( mfcc, fixed, &streams[ 0 ][ (size_t)f * MFCC::cFrameShiftSamples ] );
+        }
+
+        tones  .print( "tones" );
+        noisy  .print( "tones+noise" );
+        clipped.print( "clipped" );
+        stream .print( "stream" );
+    }
+
+    // 7. Hardware counters per stage
+    if ( useCounters ) {
+
+        PerfCounters counters;
+
+        if ( !counters.available() ) {
+            printf( "counters        : not available (%s)\n", counters.error() );
+            return status;
+        }
+        printf( "counters        : %d frames, each stage in a loop of its own\n", framesEach );
+
+        AlignedArena   arena(   HammingWindow::arenaBytes( MFCC::cFrameSizeSamples ) + FFT512::arenaBytes()
+                              + MelFilterBanks::arenaBytes() + DCT::arenaBytes( MelFilterBanks::cNumFilterBanks ) );
+        HammingWindow  window( arena, MFCC::cFrameSizeSamples, MFCC::cPreemphTap0 );
+        FFT512         fft( arena );
+        MelFilterBanks melFilterBanks( arena );
+        DCT            dct( arena, MelFilterBanks::cNumFilterBanks );
+        MFCC           mfcc;
+
+        // The inputs and outputs of every stage for all the frames, so that each stage reads
+        // what the previous one wrote, as in the pipeline.
+        const int cNumPoints = MFCC::cNumPointsFFT;
+        const int cMelStride = ( MelFilterBanks::cNumFilterBanks + 4 ) / 4 * 4;
+
+        std::vector< float > samples ( numSamples );
+        std::vector< float > windowed( (size_t)framesEach * cNumPoints, 0.0 );
+        std::vector< float > zero    ( cNumPoints, 0.0 );
+        std::vector< float > re      ( (size_t)framesEach * cNumPoints );
+        std::vector< float > im      ( (size_t)framesEach * cNumPoints );
+        std::vector< float > power   ( (size_t)framesEach * cNumPoints / 2 );
+        std::vector< float > melBins ( (size_t)framesEach * cMelStride, 0.0 );
+        std::vector< float > cepstra ( (size_t)framesEach * cMelStride );
+        std::vector< float > features( (size_t)framesEach * numFeatures );
+
+        for ( int i = 0; i < numSamples; i++ ) {
+            samples[ i ] = (float)streams[ 0 ][ i ];
+        }
+
+        std::vector< const char* > backends( 1, "cpp" );
+#ifdef HAVE_NEON
+        backends.push_back( "neon" );
+#endif
+        for ( const char* backend : backends ) {
+
+#ifdef HAVE_NEON
+            const bool neon = ( strcmp( backend, "neon" ) == 0 );
+#endif
+
+            countStage( counters, backend, "window", framesEach, [ & ]( const int f ) {
+                float* in  = &samples [ (size_t)f * MFCC::cFrameShiftSamples ];
+                float* out = &windowed[ (size_t)f * cNumPoints ];
+#ifdef HAVE_NEON
+                if ( neon ) {
+                    window.preEmphasisHammingAndMakeComplexForFFT_neon( in, out );
+                    return;
+                }
+#endif
+                window.preEmphasisHammingAndMakeComplexForFFT_cpp( in, out );
+            } );
+
+            countStage( counters, backend, "fft", framesEach, [ & ]( const int f ) {
+                const size_t o = (size_t)f * cNumPoints;
+#ifdef HAVE_NEON
+                if ( neon ) {
+                    fft.transform_neon( &windowed[ o ], zero.data(), &re[ o ], &im[ o ] );
+                    return;
+                }
+#endif
+                fft.transform_cpp( &windowed[ o ], zero.data(), &re[ o ], &im[ o ] );
+            } );
+
+            countStage( counters, backend, "power", framesEach, [ & ]( const int f ) {
+                const float* r = &re   [ (size_t)f * cNumPoints ];
+                const float* i = &im   [ (size_t)f * cNumPoints ];
+                float*       p = &power[ (size_t)f * cNumPoints / 2 ];
+#ifdef HAVE_NEON
+                if ( neon ) {
+                    for ( int k = 0; k < cNumPoints / 2; k += 4 ) {
+                        const float32x4_t vr = vld1q_f32( &r[ k ] );
+                        const float32x4_t vi = vld1q_f32( &i[ k ] );
+                        vst1q_f32( &p[ k ], vmlaq_f32( vmulq_f32( vr, vr ), vi, vi ) );
+                    }
+                    return;
+                }
+#endif
+                for ( int k = 0; k < cNumPoints / 2; k++ ) {
+                    p[ k ] = r[ k ] * r[ k ] + i[ k ] * i[ k ];
+                }
+            } );
+
+            // No NEON version. Counted for both for the totals.
+            countStage( counters, backend, "mel", framesEach, [ & ]( const int f ) {
+                melFilterBanks.findLogMelCoeffs( &power[ (size_t)f * cNumPoints / 2 ], &melBins[ (size_t)f * cMelStride ] );
+            } );
+
+            countStage( counters, backend, "dct", framesEach, [ & ]( const int f ) {
+                const size_t o = (size_t)f * cMelStride;
+#ifdef HAVE_NEON
+                if ( neon ) {
+                    dct.transform_neon( &melBins[ o ], &cepstra[ o ] );
+                    return;
+                }
+#endif
+                dct.transform_cpp( &melBins[ o ], &cepstra[ o ] );
+            } );
+
+            countStage( counters, backend, "frame", framesEach, [ & ]( const int f ) {
+                float* in  = &samples [ (size_t)f * MFCC::cFrameShiftSamples ];
+                float* out = &features[ (size_t)f * numFeatures ];
+#ifdef HAVE_NEON
+                if ( neon ) {
+                    mfcc.generateFeatures_neon( in, outputs, out );
+                    return;
+                }
+#endif
+                mfcc.generateFeatures_cpp( in, outputs, out );
+            } );
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,72 @@
+//
+// Prints the header, the chunk index and a range of frames of a feature store.
+//
+// Usage: mfcc_dump <store> [first frame [number of frames]]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mfcc.h"
+#include "feature_store.h"
+
+int main( int argc, char* argv[] ) {
+
+    if ( argc < 2 || argc > 4 ) {
+        fprintf( stderr, "Usage: %s <store> [first frame [number of frames]]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    FeatureStoreReader store;
+    if ( !store.open( argv[ 1 ] ) ) {
+        return 1;
+    }
+
+    const FeatureStoreHeader& h = store.header();
+
+    const char* config = "differs from this build";
+    if ( h.configHash == MFCC::configHash( h.outputs ) ) {
+        config = "matches this build";
+    }
+    else if ( h.configHash == MFCC::configHash( h.outputs, FrontEndParameters::kaldi() ) ) {
+        config = "matches this build, Kaldi front end";
+    }
+    printf( "config hash   : %016llx (%s)\n", (unsigned long long)h.configHash, config );
+    printf( "outputs       : 0x%x\n", h.outputs );
+    printf( "frames        : %llu x %u (dtype %u, row stride %u bytes)\n",
+            (unsigned long long)h.numFrames, h.numFeatures, h.dtype, h.rowStrideBytes );
+    printf( "frame         : %u samples, shift %u samples @ %u[Hz]\n", h.frameSizeSamples, h.frameShiftSamples, h.sampleRate );
+
+    for ( uint64_t i = 0; i < store.numChunks(); i++ ) {
+        const FeatureStoreChunk& c = store.chunk( i );
+        printf( "chunk %llu      : tag %llu frames [%llu, %llu)\n", (unsigned long long)i, (unsigned long long)c.tag,
+                (unsigned long long)c.firstFrame, (unsigned long long)( c.firstFrame + c.numFrames ) );
+    }
+
+    if ( argc < 3 ) {
+        return 0;
+    }
+
+    const uint64_t first = strtoull( argv[ 2 ], nullptr, 10 );
+    const uint64_t count = ( argc > 3 ) ? strtoull( argv[ 3 ], nullptr, 10 ) : 1;
+    const uint64_t last  = std::min( first + count, store.numFrames() );
+
+    if ( store.dtype() != FEATURE_DTYPE_FLOAT32 ) {
+        fprintf( stderr, "only float32 stores can be printed\n" );
+        return 1;
+    }
+
+    store.adviseAccess( false );
+
+    for ( uint64_t f = first; f < last; f++ ) {
+
+        const float* row = store.frameFloat( f );
+
+        printf( "%llu:", (unsigned long long)f );
+        for ( uint32_t i = 0; i < store.numFeatures(); i++ ) {
+            printf( " %.4f", row[ i ] );
+        }
+        printf( "\n" );
+    }
+    return 0;
+}
@@ -0,0 +1,451 @@
+//
+// Offline feature extraction from WAV or raw PCM files.
+// Inputs at other rates than 16KHz, e.g., 48KHz or 44.1KHz archives, go through PolyphaseResampler.
+//
+// The input is streamed in fixed-size blocks through a StreamingFrameBuffer, and the features
+// of each block are written out before the next block is read. The memory footprint does not
+// depend on the length of the input.
+//
+// Usage: mfcc_extract [options] <input.wav | input.raw | -> [more inputs...] <output>
+//
+// The output is a feature store (feature_store.h) with one chunk per input, tagged with the
+// position of the input on the command line. With -R it is a bare row-major float32 matrix
+// in host byte order instead, which can also go to stdout.
+// Each row is one frame (10[ms] shift) with the requested outputs concatenated in the order
+// MFCC, log spectrum, log Mel, fbank, constant-Q, chroma, pitch.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <memory>
+
+#include "mfcc.h"
+#include "feature_store.h"
+
+static void usage( const char* prog ) {
+
+    fprintf( stderr,
+        "Usage: %s [options] <input.wav | input.raw | -> [more inputs...] <output>\n"
+        "  -o <outputs>           : mfcc, logspec, logmel, fbank, cqt, chroma or pitch, comma separated (default: mfcc)\n"
+        "  -r                     : inputs are headerless 16-bit little-endian mono PCM\n"
+        "  -s <rate>              : sample rate of the raw inputs (default: 16000)\n"
+        "  -R                     : write a bare float32 matrix instead of a feature store (output may be -)\n"
+        "  -i cpp|neon            : implementation (default: neon if available)\n"
+        "  -k                     : Kaldi-style framing and energy (not Kaldi's Mel banks)\n"
+        "  -d <stddev>            : dither of the compatible front end (default: 1.0)\n"
+        "  -c <n>                 : number of MFCCs, 1 to 27 (default: 27)\n"
+        "  -m <n>                 : number of fbank bins, e.g., 40, 64 or 80 (default: 40)\n"
+        "  -b <samples>           : read block size in samples (default: 65536)\n"
+        "  -q                     : do not print the report\n",
+        prog );
+}
+
+
+/** @brief sequential reader of 16-bit mono PCM from a WAV or a raw file. Works on pipes.
+ */
+class PCMReader {
+
+public:
+
+    PCMReader() : mFp( nullptr ), mRemainingBytes( 0 ), mSampleRate( 0 ), mNumChannels( 0 ) {;}
+
+    ~PCMReader() {
+        if ( mFp != nullptr && mFp != stdin ) {
+            fclose( mFp );
+        }
+    }
+
+    /** @brief opens the input and parses the WAV header unless raw.
+     *
+     *  @param path    : file name or "-" for stdin
+     *  @param raw     : true if the input has no header
+     *  @param rawRate : sample rate of the raw input
+     *  @return error message, or nullptr on success.
+     */
+    const char* open( const char* path, const bool raw, const int rawRate ) {
+
+        mFp = ( strcmp( path, "-" ) == 0 ) ? stdin : fopen( path, "rb" );
+        if ( mFp == nullptr ) {
+            return "cannot open the input";
+        }
+
+        if ( raw ) {
+            mSampleRate     = rawRate;
+            mNumChannels    = 1;
+            mRemainingBytes = UINT64_MAX;
+            return nullptr;
+        }
+        return parseWaveHeader();
+    }
+
+    /** @brief reads up to maxSamples samples.
+     *
+     *  @return number of samples read. 0 at the end of the input.
+     */
+    int read( int16_t* samples, const int maxSamples ) {
+
+        const uint64_t maxBytes = std::min( (uint64_t)maxSamples * sizeof(int16_t), mRemainingBytes );
+        const size_t   n        = fread( samples, sizeof(int16_t), maxBytes / sizeof(int16_t), mFp );
+
+        mRemainingBytes -= n * sizeof(int16_t);
+        return (int)n;
+    }
+
+    int sampleRate()  const { return mSampleRate;  }
+    int numChannels() const { return mNumChannels; }
+
+private:
+
+    static uint32_t le32( const uint8_t* p ) {
+        return (uint32_t)p[0] | ( (uint32_t)p[1] << 8 ) | ( (uint32_t)p[2] << 16 ) | ( (uint32_t)p[3] << 24 );
+    }
+
+    static uint16_t le16( const uint8_t* p ) {
+        return (uint16_t)( p[0] | ( p[1] << 8 ) );
+    }
+
+    bool skip( uint32_t bytes ) {
+
+        uint8_t buf[ 256 ];
+        while ( bytes > 0 ) {
+            const size_t n = std::min( bytes, (uint32_t)sizeof(buf) );
+            if ( fread( buf, 1, n, mFp ) != n ) {
+                return false;
+            }
+            bytes -= n;
+        }
+        return true;
+    }
+
+    const char* parseWaveHeader() {
+
+        uint8_t header[ 12 ];
+        if ( fread( header, 1, 12, mFp ) != 12 || memcmp( header, "RIFF", 4 ) != 0 || memcmp( &header[ 8 ], "WAVE", 4 ) != 0 ) {
+            return "not a RIFF/WAVE file (use -r for raw PCM)";
+        }
+
+        bool fmtFound = false;
+
+        while ( true ) {
+
+            uint8_t chunk[ 8 ];
+            if ( fread( chunk, 1, 8, mFp ) != 8 ) {
+                return "no data chunk";
+            }
+            const uint32_t chunkSize = le32( &chunk[ 4 ] );
+
+            if ( memcmp( chunk, "fmt ", 4 ) == 0 ) {
+
+                uint8_t fmt[ 16 ];
+                if ( chunkSize < 16 || fread( fmt, 1, 16, mFp ) != 16 || !skip( chunkSize - 16 + ( chunkSize & 1 ) ) ) {
+                    return "broken fmt chunk";
+                }
+                const uint16_t format = le16( &fmt[ 0 ] );
+                mNumChannels          = le16( &fmt[ 2 ] );
+                mSampleRate           = le32( &fmt[ 4 ] );
+                const uint16_t bits   = le16( &fmt[ 14 ] );
+
+                if ( ( format != 1 && format != 0xFFFE ) || bits != 16 ) {
+                    return "only 16-bit linear PCM is supported";
+                }
+                fmtFound = true;
+            }
+            else if ( memcmp( chunk, "data", 4 ) == 0 ) {
+
+                if ( !fmtFound ) {
+                    return "data chunk before fmt chunk";
+                }
+                // Streams written by a pipe often carry 0 or 0xFFFFFFFF. Read to the end then.
+                mRemainingBytes = ( chunkSize == 0 || chunkSize == 0xFFFFFFFF ) ? UINT64_MAX : chunkSize;
+                return nullptr;
+            }
+            else if ( !skip( chunkSize + ( chunkSize & 1 ) ) ) {
+                return "truncated chunk";
+            }
+        }
+    }
+
+    FILE*    mFp;
+    uint64_t mRemainingBytes;
+    int      mSampleRate;
+    int      mNumChannels;
+};
+
+
+static bool parseOutputs( const char* arg, unsigned int& outputs ) {
+
+    outputs = 0;
+
+    char buf[ 256 ];
+    strncpy( buf, arg, sizeof(buf) - 1 );
+    buf[ sizeof(buf) - 1 ] = '\0';
+
+    for ( char* tok = strtok( buf, "," ); tok != nullptr; tok = strtok( nullptr, "," ) ) {
+
+        if      ( strcmp( tok, "mfcc"    ) == 0 ) { outputs |= MFCC::cOutputMFCC;        }
+        else if ( strcmp( tok, "logspec" ) == 0 ) { outputs |= MFCC::cOutputLogSpectrum; }
+        else if ( strcmp( tok, "logmel"  ) == 0 ) { outputs |= MFCC::cOutputLogMel;      }
+        else if ( strcmp( tok, "fbank"   ) == 0 ) { outputs |= MFCC::cOutputFbank;       }
+        else if ( strcmp( tok, "cqt"     ) == 0 ) { outputs |= MFCC::cOutputCQT;         }
+        else if ( strcmp( tok, "chroma"  ) == 0 ) { outputs |= MFCC::cOutputChroma;      }
+        else if ( strcmp( tok, "pitch"   ) == 0 ) { outputs |= MFCC::cOutputPitch;       }
+        else {
+            return false;
+        }
+    }
+    return outputs != 0;
+}
+
+
+int main( int argc, char* argv[] ) {
+
+    unsigned int outputs     = MFCC::cOutputMFCC;
+    bool         raw         = false;
+    bool         rawOutput   = false;
+    int          rawRate     = (int)MFCC::cSampleRate;
+    bool         quiet       = false;
+    int          blockSize   = 65536;
+    bool         compatible  = false;
+    float        dither      = 1.0;
+    int          numCepstra  = 0;
+    int          numFbank    = 0;
+#ifdef HAVE_NEON
+    bool         useNeon     = true;
+#else
+    bool         useNeon     = false;
+#endif
+
+    int argi = 1;
+    for ( ; argi < argc && argv[ argi ][ 0 ] == '-' && argv[ argi ][ 1 ] != '\0'; argi++ ) {
+
+        const char* opt = argv[ argi ];
+
+        if ( strcmp( opt, "-r" ) == 0 ) {
+            raw = true;
+        }
+        else if ( strcmp( opt, "-s" ) == 0 && argi + 1 < argc ) {
+            rawRate = atoi( argv[ ++argi ] );
+            if ( rawRate <= 0 ) {
+                usage( argv[ 0 ] );
+                return 1;
+            }
+        }
+        else if ( strcmp( opt, "-R" ) == 0 ) {
+            rawOutput = true;
+        }
+        else if ( strcmp( opt, "-q" ) == 0 ) {
+            quiet = true;
+        }
+        else if ( strcmp( opt, "-o" ) == 0 && argi + 1 < argc ) {
+            if ( !parseOutputs( argv[ ++argi ], outputs ) ) {
+                fprintf( stderr, "unknown outputs: %s\n", argv[ argi ] );
+                return 1;
+            }
+        }
+        else if ( strcmp( opt, "-i" ) == 0 && argi + 1 < argc ) {
+            const char* impl = argv[ ++argi ];
+            if ( strcmp( impl, "cpp" ) == 0 ) {
+                useNeon = false;
+            }
+            else if ( strcmp( impl, "neon" ) == 0 ) {
+#ifdef HAVE_NEON
+                useNeon = true;
+#else
+                fprintf( stderr, "NEON is not available in this build\n" );
+                return 1;
+#endif
+            }
+            else {
+                usage( argv[ 0 ] );
+                return 1;
+            }
+        }
+        else if ( strcmp( opt, "-k" ) == 0 ) {
+            compatible = true;
+        }
+        else if ( strcmp( opt, "-d" ) == 0 && argi + 1 < argc ) {
+            dither = atof( argv[ ++argi ] );
+            if ( dither < 0.0 ) {
+                usage( argv[ 0 ] );
+                return 1;
+            }
+        }
+        else if ( strcmp( opt, "-c" ) == 0 && argi + 1 < argc ) {
+            numCepstra = atoi( argv[ ++argi ] );
+            if ( numCepstra < 1 || numCepstra > MFCC::cNumFilterBanks + 1 ) {
+                usage( argv[ 0 ] );
+                return 1;
+            }
+        }
+        else if ( strcmp( opt, "-m" ) == 0 && argi + 1 < argc ) {
+            numFbank = atoi( argv[ ++argi ] );
+            if ( numFbank < 1 || numFbank > MFCC::cMaxFbankBins ) {
+                usage( argv[ 0 ] );
+                return 1;
+            }
+        }
+        else if ( strcmp( opt, "-b" ) == 0 && argi + 1 < argc ) {
+            blockSize = atoi( argv[ ++argi ] );
+            if ( blockSize <= 0 ) {
+                usage( argv[ 0 ] );
+                return 1;
+            }
+        }
+        else {
+            usage( argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    if ( argc - argi < 2 ) {
+        usage( argv[ 0 ] );
+        return 1;
+    }
+
+    outputs |= MFCC::outputNumCepstra( numCepstra ) | MFCC::outputNumFbankBins( numFbank );
+
+    const int   numInputs   = argc - argi - 1;
+    const char* outPath     = argv[ argc - 1 ];
+    const int   numFeatures = MFCC::numFeatures( outputs );
+
+    FrontEndParameters frontEnd = FrontEndParameters::original();
+    if ( compatible ) {
+        frontEnd        = FrontEndParameters::kaldi();
+        frontEnd.dither = dither;
+    }
+
+    FILE*              out = nullptr;
+    FeatureStoreWriter store;
+
+    if ( rawOutput ) {
+        out = ( strcmp( outPath, "-" ) == 0 ) ? stdout : fopen( outPath, "wb" );
+        if ( out == nullptr ) {
+            fprintf( stderr, "%s: cannot open the output\n", outPath );
+            return 1;
+        }
+    }
+    else if ( !store.open( outPath, MFCC::configHash( outputs, frontEnd ), outputs, (uint32_t)MFCC::cSampleRate,
+                           MFCC::cFrameSizeSamples, MFCC::cFrameShiftSamples, numFeatures ) ) {
+        fprintf( stderr, "%s: cannot create the feature store\n", outPath );
+        return 1;
+    }
+
+    // Everything below is allocated once. The frame buffer keeps the overlap of
+    // cFrameSizeSamples - cFrameShiftSamples samples between blocks.
+    static MFCC          mfcc;
+    mfcc.setFrontEndParameters( frontEnd );
+    mfcc.prepareOutputs( outputs );
+    StreamingFrameBuffer frames( MFCC::cFrameSizeSamples, MFCC::cFrameShiftSamples, blockSize + MFCC::cFrameSizeSamples );
+    const int            maxFrames    = ( blockSize + MFCC::cFrameSizeSamples ) / MFCC::cFrameShiftSamples + 1;
+    int16_t*             pcm          = new int16_t[ blockSize ];
+    float*               features     = new float  [ (size_t)maxFrames * numFeatures ];
+
+    double   audioSeconds = 0.0;
+    uint64_t totalFrames  = 0;
+    double   computeTime  = 0.0;
+    bool     failed       = false;
+
+    const double startTime = getTimeStampInSeconds();
+
+    for ( int input = 0; input < numInputs && !failed; input++ ) {
+
+        const char* inPath = argv[ argi + input ];
+
+        PCMReader reader;
+        const char* err = reader.open( inPath, raw, rawRate );
+        if ( err != nullptr ) {
+            fprintf( stderr, "%s: %s\n", inPath, err );
+            failed = true;
+            break;
+        }
+        if ( reader.numChannels() != 1 || reader.sampleRate() <= 0 ) {
+            fprintf( stderr, "%s: %d channels at %d[Hz]. Only mono is supported.\n",
+                     inPath, reader.numChannels(), reader.sampleRate() );
+            failed = true;
+            break;
+        }
+
+        std::unique_ptr< PolyphaseResampler > resampler;
+        if ( reader.sampleRate() != (int)MFCC::cSampleRate ) {
+            resampler.reset( new PolyphaseResampler( reader.sampleRate(), (int)MFCC::cSampleRate ) );
+            if ( !quiet ) {
+                fprintf( stderr, "%s: resampling from %d[Hz]\n", inPath, reader.sampleRate() );
+            }
+        }
+
+        // Frames do not straddle two inputs.
+        frames.reset();
+        if ( !rawOutput ) {
+            store.beginChunk( input );
+        }
+
+        int numRead;
+        while ( !failed && ( numRead = reader.read( pcm, blockSize ) ) > 0 ) {
+
+            audioSeconds += (double)numRead / reader.sampleRate();
+
+            for ( int pos = 0; pos < numRead; ) {
+
+                const double t0 = getTimeStampInSeconds();
+
+                if ( resampler ) {
+#ifdef HAVE_NEON
+                    pos += useNeon ? resampler->process_neon( &pcm[ pos ], numRead - pos, frames )
+                                   : resampler->process_cpp ( &pcm[ pos ], numRead - pos, frames );
+#else
+                    pos += resampler->process_cpp( &pcm[ pos ], numRead - pos, frames );
+#endif
+                }
+                else {
+                    pos += frames.putSamples( &pcm[ pos ], numRead - pos );
+                }
+#ifdef HAVE_NEON
+                const int n = useNeon ? mfcc.generateFeaturesBatch_neon( frames.samples(), frames.numSamples(), outputs, features )
+                                      : mfcc.generateFeaturesBatch_cpp ( frames.samples(), frames.numSamples(), outputs, features );
+#else
+                const int n = mfcc.generateFeaturesBatch_cpp( frames.samples(), frames.numSamples(), outputs, features );
+#endif
+                computeTime += getTimeStampInSeconds() - t0;
+
+                frames.consumeFrames( n );
+                totalFrames += n;
+
+                const bool written = rawOutput ? fwrite( features, sizeof(float) * numFeatures, n, out ) == (size_t)n
+                                               : store.appendFrames( features, n );
+                if ( !written ) {
+                    fprintf( stderr, "%s: write error\n", outPath );
+                    failed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    const double totalTime = getTimeStampInSeconds() - startTime;
+
+    if ( rawOutput ) {
+        failed |= ( out != stdout ) ? ( fclose( out ) != 0 ) : ( fflush( out ) != 0 );
+    }
+    else {
+        failed |= !store.close();
+    }
+
+    delete[] pcm;
+    delete[] features;
+
+    if ( !quiet ) {
+
+        fprintf( stderr, "frames          : %llu x %d floats (%s)\n",
+                 (unsigned long long)totalFrames, numFeatures, useNeon ? "neon" : "cpp" );
+        fprintf( stderr, "audio           : %.3f[s]\n", audioSeconds );
+        fprintf( stderr, "processing      : %.3f[s] total, %.3f[s] features\n", totalTime, computeTime );
+        fprintf( stderr, "realtime factor : %.5f total, %.5f features (%.1fx faster than realtime)\n",
+                 totalTime   / std::max( audioSeconds, 1.0e-9 ),
+                 computeTime / std::max( audioSeconds, 1.0e-9 ),
+                 audioSeconds / std::max( totalTime,   1.0e-9 ) );
+    }
+
+    return failed ? 1 : 0;
+}
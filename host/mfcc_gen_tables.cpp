@@ -0,0 +1,107 @@
+//
+// Generates app/src/main/cpp/mfcc_tables.h, the coefficient tables of the default configuration,
+// so that the library does not run cos/sin/log/exp loops when it is loaded and the tables sit in
+// read-only data shared between processes.
+//
+// Built with MFCC_RUNTIME_TABLES, so that mfcc.h computes its tables with the same code as
+// the non-default configurations instead of including the generated ones. The values are printed
+// with enough digits to round trip, so that the features do not change by a bit.
+//
+// The host build runs it into the build tree and fails if app/src/main/cpp/mfcc_tables.h, which
+// the Android build includes, differs. The mfcc_tables_update target of the host build copies the
+// generated file over it.
+//
+// Usage: mfcc_gen_tables [output]  (standard output if omitted)
+//
+
+#include <stdio.h>
+#include <vector>
+
+#include "mfcc.h"
+
+static void printFloats( const char* name, const float* values, const int n ) {
+
+    printf( "alignas( 16 ) static constexpr float %s[ %d ] = {\n", name, n );
+    for ( int i = 0; i < n; i++ ) {
+        printf( "%s%.9ef,%s", ( i % 6 == 0 ) ? "    " : " ", values[ i ], ( i % 6 == 5 || i == n - 1 ) ? "\n" : "" );
+    }
+    printf( "};\n\n" );
+}
+
+static void printInts( const char* name, const int* values, const int n ) {
+
+    printf( "static constexpr int %s[ %d ] = {\n", name, n );
+    for ( int i = 0; i < n; i++ ) {
+        printf( "%s%3d,%s", ( i % 16 == 0 ) ? "    " : " ", values[ i ], ( i % 16 == 15 || i == n - 1 ) ? "\n" : "" );
+    }
+    printf( "};\n\n" );
+}
+
+int main( int argc, char* argv[] ) {
+
+    if ( argc > 1 && freopen( argv[ 1 ], "w", stdout ) == nullptr ) {
+        fprintf( stderr, "cannot create %s\n", argv[ 1 ] );
+        return 1;
+    }
+
+    const int windowSize   = MFCC::cFrameSizeSamples;
+    const int dctNumPoints = MFCC::cNumFilterBanks;
+
+    printf( "//\n" );
+    printf( "// Coefficient tables of the default configuration. Generated by host/mfcc_gen_tables.cpp.\n" );
+    printf( "// Do not edit. The host build fails if it is out of date. After changing the construction of\n" );
+    printf( "// the tables in mfcc.h, regenerate it from the host build directory with:\n" );
+    printf( "//   cmake --build . --target mfcc_tables_update\n" );
+    printf( "//\n\n" );
+    printf( "#ifndef ANDROIDMFCC_MFCC_TABLES_H\n" );
+    printf( "#define ANDROIDMFCC_MFCC_TABLES_H\n\n" );
+
+    printf( "static constexpr int cTableWindowSize   = %d;\n", windowSize );
+    printf( "static constexpr int cTableDCTNumPoints = %d;\n\n", dctNumPoints );
+
+    // HammingWindow, Hamming window over 400 samples
+    {
+        std::vector< float > window( windowSize );
+        HammingWindow::makeWindow( window.data(), windowSize, FrontEndParameters::cWindowHamming );
+        printFloats( "cTableHammingWindow", window.data(), windowSize );
+    }
+
+    // FFT512
+    {
+        std::vector< float > twiddles( FFT512::cTwiddleTableSize );
+        FFT512::makeTwiddleTable( twiddles.data() );
+        printFloats( "cTableFFT512Twiddles", twiddles.data(), FFT512::cTwiddleTableSize );
+    }
+
+    // PrunedFFT512
+    {
+        std::vector< float > table( PrunedFFT512::cTableSize );
+        std::vector< int >   bitReverse( PrunedFFT512::cNumComplex );
+        PrunedFFT512::makeTables( table.data(), bitReverse.data() );
+        printFloats( "cTablePrunedFFT512", table.data(), PrunedFFT512::cTableSize );
+        printInts( "cTablePrunedFFT512BitReverse", bitReverse.data(), PrunedFFT512::cNumComplex );
+    }
+
+    // MelFilterBanks
+    {
+        std::vector< sampleToBin > table( MelFilterBanks::cNumSamples );
+        MelFilterBanks::constructSampleToBin( table.data() );
+
+        printf( "static constexpr sampleToBin cTableMelSampleToBin[ %d ] = {\n", MelFilterBanks::cNumSamples );
+        for ( size_t i = 0; i < table.size(); i++ ) {
+            printf( "    sampleToBin( %3d, %3d, %.17e ),\n", table[ i ].bin1(), table[ i ].bin2(), table[ i ].coeff1() );
+        }
+        printf( "};\n\n" );
+    }
+
+    // DCT without lifter
+    {
+        std::vector< float > table( DCT::tableSize( dctNumPoints ) );
+        DCT::makeDCTTable( table.data(), dctNumPoints, 0.0, false );
+        printFloats( "cTableDCT", table.data(), (int)table.size() );
+    }
+
+    printf( "#endif //ANDROIDMFCC_MFCC_TABLES_H\n" );
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+//
+// Hardware performance counters of the calling thread for the host benchmark.
+//
+// One perf_event_open(2) group of cycles, instructions, L1D read misses and branch misses,
+// counted in user space only, which the default perf_event_paranoid of 2 allows. A counter the
+// PMU does not have, e.g., in a VM, is left out and the others still count. The group is
+// scheduled as a whole, and the values are scaled up if the kernel multiplexed it.
+//
+// Linux only. Elsewhere available() is false.
+//
+
+#ifndef MFCC_HOST_PERF_COUNTERS_H
+#define MFCC_HOST_PERF_COUNTERS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+class PerfCounters {
+
+public:
+
+    static constexpr int cCycles       = 0;
+    static constexpr int cInstructions = 1;
+    static constexpr int cL1DMisses    = 2;
+    static constexpr int cBranchMisses = 3;
+    static constexpr int cNumCounters  = 4;
+
+    /** @brief counts accumulated over start()/stop() pairs.
+     */
+    struct Counts {
+
+        double value  [ cNumCounters ];
+        bool   counted[ cNumCounters ];
+
+        Counts() {
+            for ( int i = 0; i < cNumCounters; i++ ) {
+                value  [ i ] = 0.0;
+                counted[ i ] = false;
+            }
+        }
+
+        /** @brief instructions per cycle, or 0.0 if either is not counted.
+         */
+        double ipc() const {
+            return ( counted[ cCycles ] && counted[ cInstructions ] && value[ cCycles ] > 0.0 )
+                   ? value[ cInstructions ] / value[ cCycles ] : 0.0;
+        }
+    };
+
+    /** @brief constructor. Opens the counters for the calling thread, disabled.
+     */
+    PerfCounters()
+        :mLeader( -1 )
+        ,mNumOpen( 0 )
+        ,mError( 0 )
+    {
+        for ( int i = 0; i < cNumCounters; i++ ) {
+            mFds  [ i ] = -1;
+            mSlots[ i ] = -1;
+        }
+#if defined(__linux__)
+        static const uint32_t types[ cNumCounters ] = {
+            PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE };
+        static const uint64_t configs[ cNumCounters ] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_L1D | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ),
+            PERF_COUNT_HW_BRANCH_MISSES };
+
+        for ( int i = 0; i < cNumCounters; i++ ) {
+
+            struct perf_event_attr attr;
+            memset( &attr, 0, sizeof(attr) );
+            attr.size           = sizeof(attr);
+            attr.type           = types[ i ];
+            attr.config         = configs[ i ];
+            attr.disabled       = ( mLeader == -1 ) ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const int fd = (int)syscall( __NR_perf_event_open, &attr, 0, -1, mLeader, 0 );
+            if ( fd == -1 ) {
+                if ( i == cCycles ) {
+                    // Without the leader there is no group.
+                    mError = errno;
+                    return;
+                }
+                continue;
+            }
+            if ( mLeader == -1 ) {
+                mLeader = fd;
+            }
+            mFds  [ i ] = fd;
+            mSlots[ i ] = mNumOpen++;
+        }
+#else
+        mError = ENOSYS;
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for ( int i = 0; i < cNumCounters; i++ ) {
+            if ( mFds[ i ] != -1 ) {
+                close( mFds[ i ] );
+            }
+        }
+#endif
+    }
+
+    bool        available()     const { return mLeader != -1;                         }
+    bool        counts( int i ) const { return mFds[ i ] != -1;                       }
+    const char* error()         const { return available() ? "" : strerror( mError ); }
+
+    /** @brief resets and starts the group.
+     */
+    void start() {
+#if defined(__linux__)
+        if ( available() ) {
+            ioctl( mLeader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP );
+            ioctl( mLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+        }
+#endif
+    }
+
+    /** @brief stops the group and adds the counts since start().
+     *
+     *  @param counts : (in/out) accumulated counts
+     *  @return false if the counters could not be read
+     */
+    bool stop( Counts& counts ) {
+#if defined(__linux__)
+        if ( !available() ) {
+            return false;
+        }
+        ioctl( mLeader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+
+        // nr, time enabled, time running, then one value per counter in the order of opening.
+        uint64_t buf[ 3 + cNumCounters ];
+        if ( read( mLeader, buf, sizeof(buf) ) < (ssize_t)( sizeof(uint64_t) * ( 3 + mNumOpen ) ) ) {
+            return false;
+        }
+
+        const double scale = ( buf[ 2 ] > 0 ) ? (double)buf[ 1 ] / (double)buf[ 2 ] : 0.0;
+
+        for ( int i = 0; i < cNumCounters; i++ ) {
+            if ( mSlots[ i ] != -1 ) {
+                counts.value  [ i ] += scale * (double)buf[ 3 + mSlots[ i ] ];
+                counts.counted[ i ]  = true;
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+
+    int mFds  [ cNumCounters ];
+    int mSlots[ cNumCounters ];  // position of each counter in the group read, -1 if not open
+    int mLeader;
+    int mNumOpen;
+    int mError;
+};
+
+#endif //MFCC_HOST_PERF_COUNTERS_H
@@ -0,0 +1,138 @@
+//
+// Round-trip test of FeatureStoreWriter and FeatureStoreReader.
+//
+// Writes stores of each dtype with and without row padding, and with and without chunks,
+// reads them back and fails if a header field, a frame or a chunk differs from what was
+// written. Also checks that a store made with another configHash and a truncated store
+// are rejected.
+//
+// Usage: test_feature_store [directory for the temporary files]
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "feature_store.h"
+
+static constexpr uint64_t cConfigHash = 0x0123456789abcdefULL;
+
+static int numFailures = 0;
+
+static void check( const bool ok, const char* name ) {
+
+    printf( "%s %s\n", ok ? "ok  " : "FAIL", name );
+    if ( !ok ) {
+        numFailures++;
+    }
+}
+
+/** @brief writes numFrames rows of random bytes in up to three chunks, reads them back and compares.
+ */
+static void roundTrip(
+    const std::string& path,
+    const uint32_t     dtype,
+    const uint32_t     numFeatures,
+    const uint64_t     numFrames,
+    const bool         withChunks,
+    const char*        name
+) {
+    const size_t           rowBytes = numFeatures * featureStoreElementSize( dtype );
+    std::vector< uint8_t > rows( rowBytes * numFrames );
+    uint32_t               seed = numFeatures * 7919u + dtype;
+
+    for ( auto& b : rows ) {
+        seed = seed * 1664525u + 1013904223u;
+        b    = (uint8_t)( seed >> 24 );
+    }
+
+    // Chunks [0, n/3), [n/3, 2n/3), then frames in no chunk, appended a few at a time.
+    const uint64_t chunkEnd[ 2 ] = { numFrames / 3, numFrames * 2 / 3 };
+
+    FeatureStoreWriter writer;
+    bool ok = writer.open( path.c_str(), cConfigHash, 0x5, 16000, 400, 160, numFeatures, dtype, 0.125f, -3 );
+
+    uint64_t written = 0;
+    for ( int c = 0; c < 3 && ok; c++ ) {
+
+        const uint64_t end = ( c < 2 ) ? chunkEnd[ c ] : numFrames;
+        if ( withChunks ) {
+            if ( c < 2 ) {
+                writer.beginChunk( 1000 + c );
+            }
+            else {
+                writer.endChunk();
+            }
+        }
+        while ( written < end && ok ) {
+            const uint64_t n = std::min< uint64_t >( 5, end - written );
+            ok      = writer.appendFrames( rows.data() + written * rowBytes, n );
+            written += n;
+        }
+    }
+    ok = writer.close() && ok;
+
+    FeatureStoreReader reader;
+    ok = ok && reader.open( path.c_str(), cConfigHash );
+
+    if ( ok ) {
+        const FeatureStoreHeader& h = reader.header();
+
+        ok = h.outputs == 0x5 && h.sampleRate == 16000 && h.frameSizeSamples == 400 && h.frameShiftSamples == 160
+             && reader.numFeatures() == numFeatures && reader.dtype() == dtype && reader.numFrames() == numFrames
+             && reader.rowStrideBytes() % cFeatureStoreRowAlignment == 0 && reader.rowStrideBytes() >= rowBytes
+             && h.dataOffset % cFeatureStoreAlignment == 0
+             && ( dtype != FEATURE_DTYPE_INT8 || ( h.int8Scale == 0.125f && h.int8ZeroPoint == -3 ) )
+             && ( reader.frameFloat( 0 ) != nullptr ) == ( dtype == FEATURE_DTYPE_FLOAT32 );
+
+        for ( uint64_t i = 0; i < numFrames && ok; i++ ) {
+            ok = memcmp( reader.frame( i ), rows.data() + i * rowBytes, rowBytes ) == 0;
+        }
+
+        if ( withChunks ) {
+            ok = ok && reader.numChunks() == 2;
+            for ( uint64_t c = 0; c < 2 && ok; c++ ) {
+                const uint64_t first = ( c == 0 ) ? 0 : chunkEnd[ 0 ];
+                ok = reader.chunk( c ).firstFrame == first && reader.chunk( c ).numFrames == chunkEnd[ c ] - first
+                     && reader.chunk( c ).tag == 1000 + c;
+            }
+        }
+        else {
+            ok = ok && reader.numChunks() == 0;
+        }
+    }
+    check( ok, name );
+}
+
+int main( int argc, char* argv[] ) {
+
+    const std::string dir  = ( argc > 1 ) ? argv[ 1 ] : "/tmp";
+    const std::string path = dir + "/test_feature_store_" + std::to_string( getpid() ) + ".mfs";
+
+    // 27 MFCCs leave row padding in every dtype, 32 fill the rows exactly.
+    roundTrip( path, FEATURE_DTYPE_FLOAT32, 27, 100, false, "float32, padded rows"          );
+    roundTrip( path, FEATURE_DTYPE_FLOAT32, 32, 100, true,  "float32, chunks"               );
+    roundTrip( path, FEATURE_DTYPE_FP16,    27, 100, true,  "fp16, padded rows, chunks"     );
+    roundTrip( path, FEATURE_DTYPE_INT8,    27, 100, true,  "int8, padded rows, chunks"     );
+    roundTrip( path, FEATURE_DTYPE_INT8,    32, 0,   false, "int8, no frames"               );
+
+    // The last store has no frames; make one with frames for the rejection checks.
+    roundTrip( path, FEATURE_DTYPE_FLOAT32, 27, 10,  false, "float32, 10 frames"            );
+
+    FeatureStoreReader reader;
+    check( !reader.open( path.c_str(), cConfigHash + 1 ), "rejects another configHash" );
+    check(  reader.open( path.c_str(), 0 ),               "accepts any configHash with 0" );
+    reader.close();
+
+    check( truncate( path.c_str(), cFeatureStoreAlignment + 5 * 128 ) == 0 && !reader.open( path.c_str() ),
+           "rejects a truncated store" );
+
+    unlink( path.c_str() );
+
+    printf( "%s\n", numFailures == 0 ? "passed" : "failed" );
+    return numFailures == 0 ? 0 : 1;
+}
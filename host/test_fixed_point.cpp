@@ -0,0 +1,144 @@
+//
+// Test of MFCCFixedPoint against the float MFCC::generateMFCC_cpp().
+//
+// Runs pure tones, tones with noise and clipped tones over the band at amplitudes from 100 to
+// full scale, and a few edge frames, and fails if any of the 27 MFCCs is further than
+// cMaxDifference from the float one, or the mean difference exceeds cMaxMeanDifference.
+// With NEON, the C++ and NEON versions must agree bit for bit.
+//
+// Usage: test_fixed_point
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <algorithm>
+
+#include "mfcc.h"
+
+static constexpr double cMaxDifference     = 0.05;
+static constexpr double cMaxMeanDifference = 0.01;
+
+static int numFailures = 0;
+
+/** @brief largest and mean difference of the MFCCs of a set of frames.
+ */
+struct Differences {
+
+    double maxDiff;
+    double sumDiff;
+    long   numValues;
+
+    Differences() : maxDiff( 0.0 ), sumDiff( 0.0 ), numValues( 0 ) {;}
+
+    void add( MFCC& mfcc, MFCCFixedPoint& fixed, const int16_t* frame, const char* name ) {
+
+        float   samples[ MFCC::cFrameSizeSamples ];
+        float   reference[ MFCC::cNumFilterBanks + 1 ];
+        int32_t cepstra[ MFCC::cNumFilterBanks + 1 ];
+
+        for ( int i = 0; i < MFCC::cFrameSizeSamples; i++ ) {
+            samples[ i ] = (float)frame[ i ];
+        }
+        mfcc.generateMFCC_cpp( samples, reference );
+        fixed.generateMFCC_cpp( frame, cepstra );
+
+        for ( int i = 0; i < MFCC::cNumFilterBanks + 1; i++ ) {
+
+            const double diff = fabs( (double)reference[ i ] - (double)cepstra[ i ] / ( 1 << MFCCFixedPoint::cMFCCFracBits ) );
+            maxDiff  = std::max( maxDiff, diff );
+            sumDiff += diff;
+            numValues++;
+        }
+#ifdef HAVE_NEON
+        int32_t cepstraNeon[ MFCC::cNumFilterBanks + 1 ];
+        fixed.generateMFCC_neon( frame, cepstraNeon );
+        if ( memcmp( cepstra, cepstraNeon, sizeof(cepstra) ) != 0 ) {
+            printf( "FAIL %s: C++ and NEON differ\n", name );
+            numFailures++;
+        }
+#else
+        (void)name;
+#endif
+    }
+
+    void check( const char* name ) const {
+
+        const double mean = numValues > 0 ? sumDiff / numValues : 0.0;
+        const bool   ok   = maxDiff <= cMaxDifference && mean <= cMaxMeanDifference;
+
+        printf( "%s %-12s max difference %6.3f, mean %6.3f\n", ok ? "ok  " : "FAIL", name, maxDiff, mean );
+        if ( !ok ) {
+            numFailures++;
+        }
+    }
+};
+
+/** @brief a tone of 400 samples with uniform noise at noiseRatio of the amplitude, clipped to int16.
+ */
+static void makeTone( const double freq, const double amplitude, const double noiseRatio, uint32_t& seed, int16_t* frame ) {
+
+    for ( int i = 0; i < MFCC::cFrameSizeSamples; i++ ) {
+
+        seed = seed * 1664525u + 1013904223u;
+        const double noise = (double)( (int32_t)( seed >> 16 ) - 32768 ) / 32768.0;
+        const double v     = amplitude * ( sin( 2.0 * M_PI * freq * i / MFCC::cSampleRate ) + noiseRatio * noise );
+
+        frame[ i ] = (int16_t)lrint( std::max( -32768.0, std::min( 32767.0, v ) ) );
+    }
+}
+
+int main() {
+
+    static const double amplitudes[] = { 100.0, 300.0, 1000.0, 3000.0, 10000.0, 30000.0 };
+
+    MFCC           mfcc;
+    MFCCFixedPoint fixed;
+    int16_t        frame[ MFCC::cFrameSizeSamples ];
+    uint32_t       seed = 1;
+
+    Differences tones, noisy, clipped, edges;
+
+    for ( const double amplitude : amplitudes ) {
+        for ( double freq = 100.0; freq < MFCC::cSampleRate / 2; freq += 50.0 ) {
+
+            makeTone( freq, amplitude, 0.0, seed, frame );
+            tones.add( mfcc, fixed, frame, "tones" );
+
+            makeTone( freq, amplitude, 0.05, seed, frame );
+            noisy.add( mfcc, fixed, frame, "tones+noise" );
+        }
+    }
+    for ( double freq = 100.0; freq < MFCC::cSampleRate / 2; freq += 50.0 ) {
+
+        makeTone( freq, 60000.0, 0.0, seed, frame );
+        clipped.add( mfcc, fixed, frame, "clipped" );
+    }
+
+    // Full-scale square wave at Nyquist, full-scale DC, a full-scale impulse and silence.
+    for ( int i = 0; i < MFCC::cFrameSizeSamples; i++ ) {
+        frame[ i ] = ( i % 2 == 0 ) ? 32767 : -32768;
+    }
+    edges.add( mfcc, fixed, frame, "edges" );
+
+    for ( int i = 0; i < MFCC::cFrameSizeSamples; i++ ) {
+        frame[ i ] = -32768;
+    }
+    edges.add( mfcc, fixed, frame, "edges" );
+
+    memset( frame, 0, sizeof(frame) );
+    frame[ MFCC::cFrameSizeSamples / 2 ] = 32767;
+    edges.add( mfcc, fixed, frame, "edges" );
+
+    memset( frame, 0, sizeof(frame) );
+    edges.add( mfcc, fixed, frame, "edges" );
+
+    tones  .check( "tones" );
+    noisy  .check( "tones+noise" );
+    clipped.check( "clipped" );
+    edges  .check( "edges" );
+
+    printf( "%s\n", numFailures == 0 ? "passed" : "failed" );
+    return numFailures == 0 ? 0 : 1;
+}
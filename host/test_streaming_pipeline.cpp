@@ -0,0 +1,224 @@
+//
+// Test of the frame order and the drop accounting of StreamingPipeline.
+//
+// Pushes a synthetic stream in chunks of odd sizes and fails if:
+//
+//   - with cDropPolicyBlock and a slow consumer, a frame is lost or out of order, or its
+//     MFCCs and log spectrum are further than cMaxDifference from MFCC::generateFeaturesBatch_cpp(),
+//   - with cPostDeltas, the frames but the last cDeltaWindow do not come out in order,
+//   - with the drop policies and no consumer while pushing, the frame indices do not
+//     increase, or the frames out and the drops do not add up to the frames in.
+//
+// Usage: test_streaming_pipeline
+//
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "streaming_pipeline.h"
+
+static constexpr float  cMaxDifference = 1.0e-3;
+static constexpr double cTimeoutSec    = 20.0;
+
+static int numFailures = 0;
+
+static void check( const bool ok, const char* name ) {
+
+    printf( "%s %s\n", ok ? "ok  " : "FAIL", name );
+    if ( !ok ) {
+        numFailures++;
+    }
+}
+
+static double elapsedSec( const std::chrono::steady_clock::time_point t0 ) {
+
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - t0 ).count();
+}
+
+/** @brief a chirp from 200Hz to 4KHz with uniform noise.
+ */
+static void makeStream( const int numSamples, std::vector< int16_t >& samples ) {
+
+    samples.resize( numSamples );
+
+    uint32_t seed  = 12345u;
+    double   phase = 0.0;
+
+    for ( int i = 0; i < numSamples; i++ ) {
+
+        seed = seed * 1664525u + 1013904223u;
+        const double noise = (double)( (int32_t)( seed >> 16 ) - 32768 ) / 32768.0;
+        const double f     = 200.0 + 3800.0 * (double)i / (double)numSamples;
+
+        phase += 2.0 * M_PI * f / MFCC::cSampleRate;
+        samples[ i ] = (int16_t)( 8000.0 * sin( phase ) + 1000.0 * noise );
+    }
+}
+
+/** @brief pushes the stream in chunks of 1 to 997 samples.
+ */
+static void pushStream( StreamingPipeline& pipeline, const std::vector< int16_t >& samples ) {
+
+    static const int chunkSizes[] = { 1, 37, 160, 399, 400, 401, 997 };
+
+    size_t pos = 0;
+    for ( int c = 0; pos < samples.size(); c++ ) {
+
+        const int n = (int)std::min< size_t >( chunkSizes[ c % 7 ], samples.size() - pos );
+        pipeline.pushSamples( &samples[ pos ], n );
+        pos += n;
+    }
+}
+
+/** @brief cDropPolicyBlock: every frame comes out once and in order, with the serial features.
+ */
+static void testBlock( const std::vector< int16_t >& samples, const std::vector< float >& reference, const int numFrames ) {
+
+    StreamingPipeline pipeline( 4, StreamingPipeline::cDropPolicyBlock, 0, false );
+
+    bool     inOrder = true;
+    int      numOut  = 0;
+    float    maxDiff = 0.0;
+    bool     timeout = false;
+
+    std::thread consumer( [ & ] {
+
+        float      features[ StreamingPipeline::cNumOutputs ];
+        uint64_t   index;
+        const auto t0 = std::chrono::steady_clock::now();
+
+        while ( numOut < numFrames ) {
+
+            if ( elapsedSec( t0 ) > cTimeoutSec ) {
+                timeout = true;
+                pipeline.stop();
+                break;
+            }
+            if ( !pipeline.popFeatures( features, &index ) ) {
+                std::this_thread::yield();
+                continue;
+            }
+            inOrder = inOrder && index == (uint64_t)numOut;
+
+            const float* expected = &reference[ (size_t)std::min( (int)index, numFrames - 1 ) * ( StreamingPipeline::cNumMFCC + StreamingPipeline::cNumSpectrum ) ];
+            for ( int i = 0; i < StreamingPipeline::cNumMFCC + StreamingPipeline::cNumSpectrum; i++ ) {
+                maxDiff = std::max( maxDiff, fabsf( features[ i ] - expected[ i ] ) );
+            }
+            numOut++;
+
+            // Slower than the stages every few frames, so that the queues fill up and block.
+            if ( numOut % 16 == 0 ) {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+            }
+        }
+    } );
+
+    pushStream( pipeline, samples );
+    consumer.join();
+
+    printf( "     block: %d of %d frames, %llu dropped, max difference %g\n", numOut, numFrames,
+            (unsigned long long)pipeline.numDropped(), maxDiff );
+
+    check( !timeout,                                                        "block: no timeout"         );
+    check( inOrder && numOut == numFrames && pipeline.numDropped() == 0
+           && pipeline.numFramesIn() == (uint64_t)numFrames,                "block: no loss, in order"  );
+    check( maxDiff <= cMaxDifference,                                       "block: serial features"    );
+}
+
+/** @brief cPostDeltas: the frames come out in order, cDeltaWindow frames behind.
+ */
+static void testDeltas( const std::vector< int16_t >& samples, const int numFrames ) {
+
+    StreamingPipeline pipeline( 4, StreamingPipeline::cDropPolicyBlock,
+                                StreamingPipeline::cPostDeltas | StreamingPipeline::cPostMeanNormalization, false );
+
+    const int numExpected = numFrames - StreamingPipeline::cDeltaWindow;
+    bool      inOrder     = true;
+    int       numOut      = 0;
+
+    std::thread consumer( [ & ] {
+
+        float      features[ StreamingPipeline::cNumOutputs ];
+        uint64_t   index;
+        const auto t0 = std::chrono::steady_clock::now();
+
+        while ( numOut < numExpected && elapsedSec( t0 ) <= cTimeoutSec ) {
+
+            if ( !pipeline.popFeatures( features, &index ) ) {
+                std::this_thread::yield();
+                continue;
+            }
+            inOrder = inOrder && index == (uint64_t)numOut;
+            numOut++;
+        }
+        pipeline.stop();
+    } );
+
+    pushStream( pipeline, samples );
+    consumer.join();
+
+    check( inOrder && numOut == numExpected && pipeline.numDropped() == 0, "deltas: no loss, in order" );
+}
+
+/** @brief a drop policy with a queue of 2 and no consumer until the stream is pushed.
+ */
+static void testDrop( const std::vector< int16_t >& samples, const int numFrames, const int dropPolicy, const char* name ) {
+
+    StreamingPipeline pipeline( 2, dropPolicy, 0, false );
+
+    pushStream( pipeline, samples );
+
+    float      features[ StreamingPipeline::cNumOutputs ];
+    uint64_t   index;
+    uint64_t   prevIndex = 0;
+    bool       first     = true;
+    bool       inOrder   = true;
+    const auto t0        = std::chrono::steady_clock::now();
+
+    while ( pipeline.numFramesOut() + pipeline.numDropped() < pipeline.numFramesIn() && elapsedSec( t0 ) <= cTimeoutSec ) {
+
+        if ( !pipeline.popFeatures( features, &index ) ) {
+            std::this_thread::yield();
+            continue;
+        }
+        inOrder   = inOrder && ( first || index > prevIndex ) && index < (uint64_t)numFrames;
+        prevIndex = index;
+        first     = false;
+    }
+
+    printf( "     %s: %llu in, %llu out, %llu dropped\n", name, (unsigned long long)pipeline.numFramesIn(),
+            (unsigned long long)pipeline.numFramesOut(), (unsigned long long)pipeline.numDropped() );
+
+    check( inOrder && pipeline.numFramesIn() == (uint64_t)numFrames
+           && pipeline.numFramesOut() + pipeline.numDropped() == (uint64_t)numFrames
+           && pipeline.numFramesOut() > 0, name );
+}
+
+int main() {
+
+    const int numSamples = 3 * (int)MFCC::cSampleRate;
+    const int numFrames  = MFCC::numFrames( numSamples );
+
+    std::vector< int16_t > samples;
+    makeStream( numSamples, samples );
+
+    // The batch computes each frame on its own, as the spectral stage does.
+    const unsigned int   outputs = MFCC::cOutputMFCC | MFCC::cOutputLogSpectrum;
+    std::vector< float > samplesFloat( samples.begin(), samples.end() );
+    std::vector< float > reference( (size_t)numFrames * MFCC::numFeatures( outputs ) );
+    MFCC                 mfcc;
+    mfcc.generateFeaturesBatch_cpp( samplesFloat.data(), numSamples, outputs, reference.data() );
+
+    testBlock ( samples, reference, numFrames );
+    testDeltas( samples, numFrames );
+    testDrop  ( samples, numFrames, StreamingPipeline::cDropPolicyDropNewest, "drop newest: accounted, in order" );
+    testDrop  ( samples, numFrames, StreamingPipeline::cDropPolicyDropOldest, "drop oldest: accounted, in order" );
+
+    printf( "%s\n", numFailures == 0 ? "passed" : "failed" );
+    return numFailures == 0 ? 0 : 1;
+}
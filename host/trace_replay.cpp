@@ -0,0 +1,351 @@
+//
+// Replays a capture trace (capture_trace.h) through StreamingPipeline the way the app runs the
+// pipelined mode: each chunk is pushed with pushSamples() at the rate of the trace, which
+// resamples it to 16KHz if needed, and a consumer thread takes the features with popFeatures().
+//
+//   default : max speed, the chunks are pushed back to back.
+//   -r      : real time, each chunk is pushed at its arrival time in the trace, relative to the
+//             first chunk, so that the chunk sizes and the gaps between them are those of the device.
+//
+// A frame is due when the chunk that completes it is pushed. Its latency is from then until
+// popFeatures() returns it, and it misses the deadline if that takes longer than -D. Reports the
+// latency mean, percentiles and max, the jitter (standard deviation of the latency), the deadline
+// misses and the drops, and the chunk sizes and inter-arrival jitter of the trace itself.
+//
+// With -g, writes a synthetic trace instead: a sweep plus noise in chunks of -C samples that
+// arrive with jitter and an occasional stall, as AudioRecord.read() does.
+//
+// Usage: trace_replay [options] <trace>
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "mfcc.h"
+#include "streaming_pipeline.h"
+#include "capture_trace.h"
+
+static void usage( const char* prog ) {
+
+    fprintf( stderr,
+        "Usage: %s [options] <trace>\n"
+        "  -r             : real time (default: max speed)\n"
+        "  -q <frames>    : frames per pipeline queue (default: 32)\n"
+        "  -d <policy>    : drop policy, 0 block, 1 drop newest, 2 drop oldest (default: 0)\n"
+        "  -D <ms>        : deadline per frame in milli seconds (default: 20)\n"
+        "  -M <frames>    : exit with 1 if more frames than this miss the deadline (default: no limit)\n"
+        "  -c <channel>   : channel to replay from a multichannel trace (default: 0)\n"
+        "  -i cpp|neon    : implementation (default: neon if available)\n"
+        "  -g <seconds>   : write a synthetic trace of this length to <trace> instead\n"
+        "  -R <rate>      : sample rate of the synthetic trace (default: 48000)\n"
+        "  -C <samples>   : samples per chunk of the synthetic trace (default: 1920)\n",
+        prog );
+}
+
+static int64_t nowNs() {
+
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(
+               std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/** @brief writes a synthetic trace. The chunks are due every chunkSamples / sampleRate seconds,
+ *         arrive up to 3[ms] late, and every 50th read stalls for 3 chunk periods, after which
+ *         the reads return back to back until they have caught up.
+ */
+static bool writeSyntheticTrace( const char* path, const double seconds, const int sampleRate, const int chunkSamples ) {
+
+    CaptureTraceWriter writer;
+    if ( !writer.open( path, sampleRate, 1, chunkSamples, 0 ) ) {
+        return false;
+    }
+
+    const int64_t periodNs  = (int64_t)chunkSamples * 1000000000LL / sampleRate;
+    const int     numChunks = (int)( seconds * sampleRate / chunkSamples );
+
+    std::vector< int16_t > chunk( chunkSamples );
+
+    uint32_t seed    = 24680u;
+    double   phase   = 0.0;
+    int64_t  lastNs  = 0;
+    int64_t  stallNs = 0;
+
+    for ( int c = 0; c < numChunks; c++ ) {
+
+        for ( int i = 0; i < chunkSamples; i++ ) {
+
+            seed = seed * 1664525u + 1013904223u;
+            const double noise = (double)( (int32_t)( seed >> 16 ) - 32768 ) / 32768.0;
+            const double t     = (double)( c * chunkSamples + i ) / sampleRate;
+            const double f     = 200.0 + 3800.0 * fmod( t, 5.0 ) / 5.0;
+
+            phase += 2.0 * M_PI * f / sampleRate;
+            chunk[ i ] = (int16_t)( 8000.0 * sin( phase ) + 1000.0 * noise );
+        }
+
+        seed = seed * 1664525u + 1013904223u;
+        const int64_t jitterNs = (int64_t)( seed >> 8 ) % 3000000;
+
+        if ( c % 50 == 49 ) {
+            stallNs = 3 * periodNs;
+        }
+
+        // Data is never delivered before it has been captured, nor before the previous chunk.
+        const int64_t dueNs     = (int64_t)( c + 1 ) * periodNs;
+        const int64_t arrivalNs = std::max( dueNs + jitterNs + stallNs, lastNs );
+
+        stallNs = std::max( (int64_t)0, stallNs - periodNs );
+        lastNs  = arrivalNs;
+
+        if ( !writer.append( arrivalNs, chunk.data(), chunkSamples, chunkSamples ) ) {
+            return false;
+        }
+    }
+    printf( "wrote %d chunks of %d samples @ %d[Hz] to %s\n", numChunks, chunkSamples, sampleRate, path );
+    return writer.close();
+}
+
+static double percentile( const std::vector< double >& sorted, const double p ) {
+
+    if ( sorted.empty() ) {
+        return 0.0;
+    }
+    const size_t i = std::min( sorted.size() - 1, (size_t)( p * ( sorted.size() - 1 ) + 0.5 ) );
+    return sorted[ i ];
+}
+
+int main( int argc, char* argv[] ) {
+
+    bool        realTime     = false;
+    int         queueFrames  = 32;
+    int         dropPolicy   = StreamingPipeline::cDropPolicyBlock;
+    double      deadlineMs   = 20.0;
+    long        maxMisses    = -1;
+    int         channel      = 0;
+    double      synthSeconds = 0.0;
+    int         synthRate    = 48000;
+    int         synthChunk   = 1920;
+    const char* path         = nullptr;
+#ifdef HAVE_NEON
+    bool        useNeon      = true;
+#else
+    bool        useNeon      = false;
+#endif
+
+    for ( int argi = 1; argi < argc; argi++ ) {
+
+        const char* opt = argv[ argi ];
+
+        if ( strcmp( opt, "-r" ) == 0 ) {
+            realTime = true;
+        }
+        else if ( strcmp( opt, "-q" ) == 0 && argi + 1 < argc ) {
+            queueFrames = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-d" ) == 0 && argi + 1 < argc ) {
+            dropPolicy = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-D" ) == 0 && argi + 1 < argc ) {
+            deadlineMs = atof( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-M" ) == 0 && argi + 1 < argc ) {
+            maxMisses = atol( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-c" ) == 0 && argi + 1 < argc ) {
+            channel = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-g" ) == 0 && argi + 1 < argc ) {
+            synthSeconds = atof( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-R" ) == 0 && argi + 1 < argc ) {
+            synthRate = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-C" ) == 0 && argi + 1 < argc ) {
+            synthChunk = atoi( argv[ ++argi ] );
+        }
+        else if ( strcmp( opt, "-i" ) == 0 && argi + 1 < argc ) {
+            const char* impl = argv[ ++argi ];
+            if ( strcmp( impl, "cpp" ) == 0 ) {
+                useNeon = false;
+            }
+            else if ( strcmp( impl, "neon" ) == 0 ) {
+#ifdef HAVE_NEON
+                useNeon = true;
+#else
+                fprintf( stderr, "NEON is not available in this build\n" );
+                return 1;
+#endif
+            }
+            else {
+                usage( argv[ 0 ] );
+                return 1;
+            }
+        }
+        else if ( opt[ 0 ] != '-' && path == nullptr ) {
+            path = opt;
+        }
+        else {
+            usage( argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    if ( path == nullptr || queueFrames <= 0 || deadlineMs <= 0.0 || synthSeconds < 0.0 ) {
+        usage( argv[ 0 ] );
+        return 1;
+    }
+
+    if ( synthSeconds > 0.0 ) {
+        if ( synthRate <= 0 || synthChunk <= 0 ) {
+            usage( argv[ 0 ] );
+            return 1;
+        }
+        return writeSyntheticTrace( path, synthSeconds, synthRate, synthChunk ) ? 0 : 1;
+    }
+
+    CaptureTraceReader trace;
+    if ( !trace.open( path ) ) {
+        return 1;
+    }
+    if ( channel < 0 || channel >= (int)trace.numChannels() || trace.numChunks() == 0 ) {
+        fprintf( stderr, "%s: channel %d of %u, %zu chunks\n", path, channel, trace.numChannels(), trace.numChunks() );
+        return 1;
+    }
+
+    const int numChannels = (int)trace.numChannels();
+    const int inputRate   = (int)trace.sampleRate();
+    const int outputRate  = (int)MFCC::cSampleRate;
+
+    // The trace itself.
+    uint64_t numInputSamples = 0;
+    uint32_t minChunk        = UINT32_MAX;
+    uint32_t maxChunk        = 0;
+    int      numReadErrors   = 0;
+    double   sumGap          = 0.0;
+    double   sumGapSq        = 0.0;
+    double   maxGap          = 0.0;
+
+    for ( size_t c = 0; c < trace.numChunks(); c++ ) {
+
+        const CaptureTraceChunk& chunk = trace.chunk( c );
+
+        numInputSamples += chunk.numSamples / numChannels;
+        minChunk         = std::min( minChunk, chunk.numSamples );
+        maxChunk         = std::max( maxChunk, chunk.numSamples );
+        numReadErrors   += ( chunk.readResult < 0 ) ? 1 : 0;
+
+        if ( c > 0 ) {
+            const double gap = 1.0e-6 * ( chunk.timestampNs - trace.chunk( c - 1 ).timestampNs );
+            sumGap   += gap;
+            sumGapSq += gap * gap;
+            maxGap    = std::max( maxGap, gap );
+        }
+    }
+
+    const double numGaps  = std::max( (double)trace.numChunks() - 1.0, 1.0 );
+    const double meanGap  = sumGap / numGaps;
+    const double gapSigma = sqrt( std::max( 0.0, sumGapSq / numGaps - meanGap * meanGap ) );
+
+    printf( "trace           : %zu chunks of %u to %u samples, %u channel(s) @ %d[Hz], %.1f[s], %d read errors\n",
+            trace.numChunks(), minChunk, maxChunk, trace.numChannels(), inputRate,
+            (double)numInputSamples / inputRate, numReadErrors );
+    printf( "arrivals        : every %.2f[ms] on average, jitter %.2f[ms], longest gap %.2f[ms]\n",
+            meanGap, gapSigma, maxGap );
+
+    // Replay
+    StreamingPipeline pipeline( queueFrames, dropPolicy, 0, useNeon, inputRate );
+
+    std::vector< double > latenciesMs;
+    latenciesMs.reserve( MFCC::numFrames( (int)( numInputSamples * outputRate / inputRate ) ) + 1 );
+
+    std::atomic< bool > producerDone( false );
+
+    std::thread consumer( [ & ] {
+
+        float   features[ StreamingPipeline::cNumOutputs ];
+        int64_t arrivalNs;
+
+        while ( true ) {
+
+            if ( pipeline.popFeatures( features, nullptr, &arrivalNs ) ) {
+                latenciesMs.push_back( 1.0e-6 * ( nowNs() - arrivalNs ) );
+                continue;
+            }
+            if ( producerDone.load() && pipeline.numFramesOut() + pipeline.numDropped() >= pipeline.numFramesIn() ) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    } );
+
+    std::vector< int16_t > mono;
+
+    const int64_t traceStartNs  = trace.chunk( 0 ).timestampNs;
+    const int64_t replayStartNs = nowNs();
+    int64_t       maxLagNs      = 0;
+
+    for ( size_t c = 0; c < trace.numChunks(); c++ ) {
+
+        const CaptureTraceChunk& chunk = trace.chunk( c );
+        const int                n     = (int)( chunk.numSamples / numChannels );
+        const int16_t*           in    = trace.samples( c );
+
+        if ( realTime ) {
+            const int64_t scheduledNs = replayStartNs + ( chunk.timestampNs - traceStartNs );
+            std::this_thread::sleep_for( std::chrono::nanoseconds( scheduledNs - nowNs() ) );
+            maxLagNs = std::max( maxLagNs, nowNs() - scheduledNs );
+        }
+
+        mono.resize( n );
+        for ( int i = 0; i < n; i++ ) {
+            mono[ i ] = in[ i * numChannels + channel ];
+        }
+        pipeline.pushSamples( mono.data(), n );
+    }
+    producerDone.store( true );
+    consumer.join();
+
+    const double   elapsed   = 1.0e-9 * ( nowNs() - replayStartNs );
+    const uint64_t numFrames = pipeline.numFramesIn();
+
+    // Results
+    std::sort( latenciesMs.begin(), latenciesMs.end() );
+
+    double sum    = 0.0;
+    double sumSq  = 0.0;
+    long   misses = 0;
+    for ( const double l : latenciesMs ) {
+        sum    += l;
+        sumSq  += l * l;
+        misses += ( l > deadlineMs ) ? 1 : 0;
+    }
+    const double count = std::max( (double)latenciesMs.size(), 1.0 );
+    const double mean  = sum / count;
+    const double sigma = sqrt( std::max( 0.0, sumSq / count - mean * mean ) );
+
+    // Dropped frames never arrive, so they count as misses too.
+    misses += (long)pipeline.numDropped();
+
+    printf( "replay          : %s, %s, %.2f[s], %llu frames, %llu out, %llu dropped",
+            realTime ? "real time" : "max speed", useNeon ? "neon" : "cpp", elapsed,
+            (unsigned long long)numFrames, (unsigned long long)latenciesMs.size(),
+            (unsigned long long)pipeline.numDropped() );
+    if ( realTime ) {
+        printf( ", replay lag max %.2f[ms]", 1.0e-6 * maxLagNs );
+    }
+    printf( "\n" );
+    printf( "latency         : mean %.3f[ms], p50 %.3f[ms], p99 %.3f[ms], max %.3f[ms], jitter %.3f[ms]\n",
+            mean, percentile( latenciesMs, 0.5 ), percentile( latenciesMs, 0.99 ),
+            latenciesMs.empty() ? 0.0 : latenciesMs.back(), sigma );
+    printf( "deadline        : %.1f[ms], %ld misses (%.2f%%)\n", deadlineMs, misses,
+            100.0 * misses / std::max( (double)numFrames, 1.0 ) );
+
+    return ( maxMisses >= 0 && misses > maxMisses ) ? 1 : 0;
+}